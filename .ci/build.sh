@@ -62,6 +62,15 @@ elif [[ ${TASK} == "addons" ]]; then
 	/usr/bin/time make ${MAKE_PARALLEL} || return 1
 	/usr/bin/time make -j1 CTEST_OUTPUT_ON_FAILURE=1 test || return 1
 	
+elif [[ ${TASK} == "threadsafe" ]]; then
+	
+	cmake -D THREAD_SAFE=ON -D DEVELOPER=ON -D USE_CLN_NUMBERS=ON -D USE_GINAC=ON -D USE_COCOA=ON ../ || return 1
+	
+	/usr/bin/time make ${MAKE_PARALLEL} resources || return 1
+	/usr/bin/time make ${MAKE_PARALLEL} lib_carl || return 1
+	/usr/bin/time make ${MAKE_PARALLEL} || return 1
+	/usr/bin/time make -j1 CTEST_OUTPUT_ON_FAILURE=1 test || return 1
+	
 else
 	/usr/bin/time make ${MAKE_PARALLEL} resources || return 1
 	/usr/bin/time make ${MAKE_PARALLEL} lib_carl || return 1
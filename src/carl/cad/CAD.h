@@ -35,12 +35,16 @@
 #include <unordered_map>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "../core/UnivariatePolynomial.h"
 #include "../core/MultivariatePolynomial.h"
 #include "../core/Variable.h"
 #include "../formula/model/ran/RealAlgebraicNumber.h"
 #include "../formula/model/ran/RealAlgebraicPoint.h"
 #include "../util/carlTree.h"
+#include "../util/CopyOnWriteVector.h"
+#include "../util/ThreadPool.h"
 
 #include "CADConstraints.h"
 #include "CADPolynomials.h"
@@ -72,18 +76,54 @@ public:
 	/// Type of a map of variable bounds.
 	typedef std::unordered_map<std::size_t, Interval<Number>> BoundMap;
 private:
+	/**
+	 * Copy of the variables, the sample tree, the elimination sets and the input polynomials.
+	 */
+	struct State {
+		const CAD<Number>* owner;
+		cad::Variables variables;
+		std::shared_ptr<Tree> sampleTree;
+		CopyOnWriteVector<cad::EliminationSet<Number>> eliminationSets;
+		typename cad::CADPolynomials<Number>::State polynomials;
+		bool iscomplete;
+	};
+public:
+	/**
+	 * Immutable snapshot of the state of a CAD, used to return to an earlier CAD when backtracking.
+	 * Snapshots share their data with each other and with the CAD: every elimination level and every chunk of the sample tree (see tree::chunkSize) is only copied when the CAD modifies it.
+	 * Hence, a check that only touches a few elimination levels and samples after a snapshot only copies these levels and the chunks holding these samples.
+	 * Detaching the sample tree from a snapshot still copies one pointer per chunk.
+	 * A snapshot can only be restored into the CAD it was taken from, as it refers to polynomials owned by this CAD.
+	 */
+	class Snapshot {
+		friend class CAD<Number>;
+		std::shared_ptr<State> mState;
+		Snapshot(const std::shared_ptr<State>& state): mState(state) {}
+	public:
+		Snapshot() {}
+		/**
+		 * @return true if this snapshot was taken from a CAD.
+		 */
+		bool valid() const {
+			return mState != nullptr;
+		}
+	};
+private:
 	
+
 	cad::Variables mVariables;
 	
 	/**
 	 * Sample components built during the CAD lifting arranged in a tree.
+	 * The tree is shared with snapshots and copied by detachSampleTree() before it is modified.
 	 */
-	carl::tree<RealAlgebraicNumber<Number>> sampleTree;
+	std::shared_ptr<Tree> sampleTree;
 
 	/**
 	 * Lists of polynomials occurring in every elimination level (immutable; new polynomials are appended at the tail)
+	 * The levels are shared with snapshots, a level is only copied when it is modified.
 	 */
-	std::vector<cad::EliminationSet<Number>> eliminationSets;
+	CopyOnWriteVector<cad::EliminationSet<Number>> eliminationSets;
 	
 	/**
 	 * Stores the original polynomials and the queue of polynomials that are scheduled.
@@ -112,7 +152,47 @@ private:
 	
 	cad::CADConstraints<Number> mConstraints;
 	
+	/**
+	 * equational constraints the projection is restricted to, see updateEquations()
+	 */
+	std::vector<cad::Constraint<Number>> mEquationalConstraints;
+	
+	/**
+	 * threads computing the projection if setting.projectionThreads is positive, created on first use
+	 */
+	std::unique_ptr<ThreadPool> mProjectionPool;
+	
+	/**
+	 * threads checking the samples of the last lifting level if setting.liftingThreads is positive, created on first use
+	 */
+	std::unique_ptr<ThreadPool> mLiftingPool;
+	
+	/**
+	 * state this CAD is equal to, if it was not modified since the last snapshot or restore
+	 */
+	std::shared_ptr<State> mSnapshot;
+	
 	static unsigned checkCallCount;
+	
+	/**
+	 * Copies the sample tree if it is shared with a snapshot. Has to be called before the tree is modified and before iterators to it are taken.
+	 * The copy shares the chunks of nodes and samples with the snapshot, modified chunks are copied by the tree itself.
+	 */
+	void detachSampleTree() {
+		if (this->sampleTree.use_count() > 1) {
+			this->sampleTree = std::make_shared<Tree>(*this->sampleTree);
+		}
+	}
+	
+	ThreadPool& projectionPool() {
+		if (!mProjectionPool) mProjectionPool.reset(new ThreadPool(this->setting.projectionThreads));
+		return *mProjectionPool;
+	}
+	
+	ThreadPool& liftingPool() {
+		if (!mLiftingPool) mLiftingPool.reset(new ThreadPool(this->setting.liftingThreads));
+		return *mLiftingPool;
+	}
 
 public:
 	//////////////////////////////////
@@ -177,7 +257,7 @@ public:
 	}
 	
 	const Tree& getSampleTree() const {
-		return sampleTree;
+		return *sampleTree;
 	}
 
 	/**
@@ -192,7 +272,7 @@ public:
 	 * <br/ >For i>0, the i-th set was obtained by eliminating the variable i-1.
 	 * @return all eliminations of the polynomials and the polynomials themselves (at position 0) computed so far
 	 */
-	const std::vector<cad::EliminationSet<Number>>& getEliminationSets() const {
+	const CopyOnWriteVector<cad::EliminationSet<Number>>& getEliminationSets() const {
 		return this->eliminationSets;
 	}
 
@@ -289,6 +369,16 @@ public:
 	
 	void tryEquationSeparation(bool useBounds, bool onlyStrictBounds);
 	
+	/**
+	 * Marks the polynomials of the first elimination level that are factors of equational constraints as equations, if setting.equationalProjection is set.
+	 * The projection from the first level is then restricted to the equations, the projection of the lower levels is semi-restricted to the propagated equations,
+	 * see cad::EquationalRestriction.
+	 * An equational constraint is only used if all its factors are well oriented and are polynomials of the first level, otherwise it is treated as any other constraint.
+	 * The samples then only represent the sections of the equations, hence the used equational constraints are required in every conflict, see mEquationalConstraints.
+	 * If the equations differ from the ones of the previous call, the projections skipped so far are queued again.
+	 */
+	void updateEquations();
+	
 	
 	/**
 	 * Checks an arbitrary constraint for satisfiability on this set of samples. The cad is extended if there are still samples not computed.
@@ -361,6 +451,30 @@ public:
 	 */
 	void removePolynomial(const UPolynomial* p, unsigned level = 0, bool childrenOnly = false);
 	
+	/**
+	 * Takes a snapshot of the variables, the elimination sets, the sample tree and the input polynomials.
+	 * The sample tree and the elimination levels are shared with the CAD, only the variables and the list of input polynomials are copied.
+	 * If the CAD was not modified since the last snapshot or restore, the snapshot shares all its data with the previous one.
+	 * @return Snapshot of the current state.
+	 * @complexity constant if unmodified, otherwise linear in the number of elimination levels and input polynomials
+	 */
+	Snapshot snapshot();
+	
+	/**
+	 * Restores the state stored in the given snapshot, replacing addPolynomial() and removePolynomial() calls since the snapshot was taken.
+	 * The sample tree and the elimination levels are shared with the snapshot instead of being copied.
+	 * Polynomials created since the snapshot was taken stay owned by this CAD.
+	 * @param s Snapshot taken from this CAD.
+	 */
+	void restore(const Snapshot& s);
+	
+	/**
+	 * Restores the state stored in the given snapshot.
+	 * If s is the only reference to its data, the data is moved instead of shared, such that the CAD does not need to copy the levels it modifies afterwards.
+	 * @param s Snapshot taken from this CAD.
+	 */
+	void restore(Snapshot&& s);
+	
 	/**
 	 * Get the boundaries of the cad cell intervals in each level for the solution point r.
 	 * @param r
@@ -461,9 +575,9 @@ private:
 	 *
 	 * @param node
 	 * @param root of the sample tree
-	 * @return RealAlgebraicPoint as list belonging to leaf
+	 * @return components of the sample point belonging to node, the component of node first
 	 */
-	std::list<RealAlgebraicNumber<Number>> constructSampleAt(sampleIterator node, const sampleIterator& root) const;
+	std::vector<RealAlgebraicNumber<Number>> constructSampleAt(sampleIterator node, const sampleIterator& root) const;
 
 	/**
 	 * Helper method for mainCheck() routine.
@@ -542,6 +656,34 @@ public:
 		cad::ConflictGraph<Number>& conflictGraph
 	);
 
+	/**
+	 * Helper method for liftCheck() at the last level.
+	 *
+	 * Stores all samples as children of node and checks the resulting full-dimensional sample points on the lifting pool.
+	 * The samples are given in the order of the SampleOrdering and the result is the same as if they were lifted one after another in this order:
+	 * the first satisfying sample is returned and the conflict graph contains exactly the samples up to this one.
+	 * As soon as a sample is satisfying, the samples after it are skipped, and all workers stop if an interruption flag is set.
+	 * @param node
+	 * @param samples samples for the last variable, in the order they shall be lifted
+	 * @param bounds
+	 * @param boundsActive
+	 * @param checkBounds
+	 * @param r
+	 * @param conflictGraph
+	 * @param satPath
+	 * @return the answer of liftCheck() if lifting stops at one of the samples, none if all samples are unsatisfying
+	 */
+	boost::optional<cad::Answer> liftCheckLastLevel(
+		sampleIterator node,
+		const std::vector<RealAlgebraicNumber<Number>>& samples,
+		const BoundMap& bounds,
+		bool boundsActive,
+		bool checkBounds,
+		RealAlgebraicPoint<Number>& r,
+		cad::ConflictGraph<Number>& conflictGraph,
+		std::stack<std::size_t>& satPath
+	);
+
 	/**
 	 * Constructs sample points for the given number of open variables openVariableCount by lifting
 	 * the polynomials available in the lifting queue in the corresponding level of CAD::eliminationSets.
@@ -620,6 +762,17 @@ public:
 	 */
 	void shrinkBounds(BoundMap& bounds, const RealAlgebraicPoint<Number>& r);
 
+	/**
+	 * Determines whether p (of elimination set at level) has a root in the given box without constructing a nested CAD, if this is cheap.
+	 * First, p is evaluated over the box by interval arithmetic on doubles with outward rounding, which may prove that p has no root.
+	 * Otherwise, if p is univariate and its variable is bounded, the roots within the bounds are counted exactly by a Sturm sequence.
+	 * @param p
+	 * @param box
+	 * @param level
+	 * @return true if p has a root in the given box, false if it has none, boost::none if undecided
+	 */
+	boost::optional<bool> hasRootsInBox(const UPolynomial* p, const BoundMap& box, std::size_t level) const;
+
 	/**
 	 * Determines whether p (of elimination set at level) has a root in the given box.
 	 * @param p
@@ -644,7 +797,7 @@ public:
 	template<typename It>
 	bool isSampleConsistent(It node) const {
 		bool lastRoot = false;
-		for (auto cur = sampleTree.begin_children(node); cur != sampleTree.end_children(node); cur++) {
+		for (auto cur = sampleTree->begin_children(node); cur != sampleTree->end_children(node); cur++) {
 			if (cur->isRoot() && lastRoot) return false;
 			lastRoot = cur->isRoot();
 			if (!isSampleConsistent(cur)) return false;
@@ -653,9 +806,9 @@ public:
 	}
 
 	bool isSampleTreeConsistent() const {
-		bool isOk = isSampleConsistent(this->sampleTree.begin());
+		bool isOk = isSampleConsistent(this->sampleTree->begin());
 		if (!isOk) {
-			CARL_LOG_ERROR("carl.cad", "SampleTree: " << this->sampleTree);
+			CARL_LOG_ERROR("carl.cad", "SampleTree: " << *this->sampleTree);
 		}
 		return true;
 		assert(isOk);
@@ -669,7 +822,7 @@ public:
 	 */
 	template<typename It>
 	bool checkIntegrality(It node) const {
-		for (auto pit = sampleTree.begin_path(node); pit.depth() != 0; ++pit) {
+		for (auto pit = sampleTree->begin_path(node); pit.depth() != 0; ++pit) {
 			Variable var = mVariables[pit.depth() - 1];
 			if ((var.getType() == VariableType::VT_INT) && (!pit->isIntegral())) return false;
 		}
@@ -28,7 +28,7 @@ unsigned CAD<Number>::checkCallCount = 0;
 template<typename Number>
 CAD<Number>::CAD():
 		mVariables(),
-		sampleTree(),
+		sampleTree(std::make_shared<Tree>()),
 		eliminationSets(),
 		polynomials(),
 		iscomplete(false),
@@ -37,13 +37,13 @@ CAD<Number>::CAD():
 		setting(cad::CADSettings::getSettings())
 {
 	// initialize root with empty node
-	this->sampleTree.setRoot(RealAlgebraicNumber<Number>(0, false));
+	this->sampleTree->setRoot(RealAlgebraicNumber<Number>(0, false));
 }
 
 template<typename Number>
 CAD<Number>::CAD(cad::PolynomialOwner<Number>* parent):
 		mVariables(),
-		sampleTree(),
+		sampleTree(std::make_shared<Tree>()),
 		eliminationSets(),
 		polynomials(parent),
 		iscomplete(false),
@@ -52,7 +52,7 @@ CAD<Number>::CAD(cad::PolynomialOwner<Number>* parent):
 		setting(cad::CADSettings::getSettings())
 {
 	// initialize root with empty node
-	this->sampleTree.setRoot(RealAlgebraicNumber<Number>(0, false));
+	this->sampleTree->setRoot(RealAlgebraicNumber<Number>(0, false));
 }
 
 template<typename Number>
@@ -101,7 +101,7 @@ CAD<Number>::CAD(const CAD<Number>& cad):
 template<typename Number>
 cad::SampleSet<Number> CAD<Number>::samplesAt(const sampleIterator& node) const {
 	cad::SampleSet<Number> samples(setting.sampleOrdering);
-	samples.insert(this->sampleTree.begin(node), this->sampleTree.end(node));
+	samples.insert(this->sampleTree->begin(node), this->sampleTree->end(node));
 	return samples;
 }
 
@@ -109,9 +109,9 @@ template<typename Number>
 std::vector<RealAlgebraicPoint<Number>> CAD<Number>::samples() const {
 	size_t dim  = mVariables.size();
 	std::vector<RealAlgebraicPoint<Number>> s;
-	for (auto leaf = this->sampleTree.begin_leaf(); leaf != this->sampleTree.end_leaf(); leaf++) {
+	for (auto leaf = this->sampleTree->begin_leaf(); leaf != this->sampleTree->end_leaf(); leaf++) {
 		// for each leaf construct the path by iterating back to the root
-		RealAlgebraicPoint<Number> sample(this->constructSampleAt(leaf, this->sampleTree.begin()));
+		RealAlgebraicPoint<Number> sample(this->constructSampleAt(leaf, this->sampleTree->begin()));
 
 		// discard points which are ill-formed (possible by intermediate nodes which did not yield valid child nodes)
 		if (sample.dim() == dim) {
@@ -123,8 +123,8 @@ std::vector<RealAlgebraicPoint<Number>> CAD<Number>::samples() const {
 
 template<typename Number>
 void CAD<Number>::printSampleTree(std::ostream& os) const {
-	for (auto i = this->sampleTree.begin(); i != this->sampleTree.end(); i++) {
-		for (unsigned d = 0; d != this->sampleTree.depth(i); d++) {
+	for (auto i = this->sampleTree->begin(); i != this->sampleTree->end(); i++) {
+		for (unsigned d = 0; d != this->sampleTree->depth(i); d++) {
 			os << " [";
 		}
 		print(*i, os);
@@ -193,7 +193,7 @@ std::ostream& operator<<(std::ostream& os, const CAD<Number>& cad) {
 		os << level++ << ":\tP: " << i << std::endl;
 	}
 	os << "Sample tree:" << std::endl;
-	os << cad.sampleTree << std::endl;
+	os << *cad.sampleTree << std::endl;
 	os << "Number of samples computed: " << cad.samples().size() << std::endl;
 	os << "CAD complete: " << cad.isComplete() << std::endl;
 	return os;
@@ -201,6 +201,7 @@ std::ostream& operator<<(std::ostream& os, const CAD<Number>& cad) {
 
 template<typename Number>
 bool CAD<Number>::prepareElimination() {
+	mSnapshot.reset();
 	CARL_LOG_TRACE("carl.cad", __func__ << "()");
 	if (mVariables.newEmpty() && (!polynomials.hasScheduled() || mVariables.empty())) {
 		return false;
@@ -229,13 +230,8 @@ bool CAD<Number>::prepareElimination() {
 		// variables, newVariables = newVariables:variables, []
 		mVariables.appendNewToCur();
 
-		// (1)
-		/// @todo make this more efficient
-		std::vector<cad::EliminationSet<Number>> sets(mVariables.size(), cad::EliminationSet<Number>(&this->polynomials, typename cad::EliminationSet<Number>::PolynomialComparator(this->setting.order), typename cad::EliminationSet<Number>::PolynomialComparator(this->setting.order)));
-		for (std::size_t i = newVariableCount; i < sets.size(); i++) {
-			std::swap(sets[i], this->eliminationSets[i - newVariableCount]);
-		}
-		std::swap(this->eliminationSets, sets);
+		// (2)
+		this->eliminationSets.insert(0, newVariableCount, cad::EliminationSet<Number>(&this->polynomials, typename cad::EliminationSet<Number>::PolynomialComparator(this->setting.order), typename cad::EliminationSet<Number>::PolynomialComparator(this->setting.order)));
 	}
 
 	// add new polynomials to level 0, unifying their variables, and the list of all polynomials
@@ -246,18 +242,18 @@ bool CAD<Number>::prepareElimination() {
 			this->polynomials.take(tmp);
 		}
 		this->polynomials.addPolynomial(tmp);
-		this->eliminationSets.front().insert(tmp);
+		this->eliminationSets.modify(0).insert(tmp);
 	}
 
 	// optimizations for the first elimination level
 	if (this->setting.simplifyByFactorization) {
-		this->eliminationSets.front().factorize();
+		this->eliminationSets.modify(0).factorize();
 	}
-	this->eliminationSets.front().makePrimitive();
-	this->eliminationSets.front().makeSquarefree();
+	this->eliminationSets.modify(0).makePrimitive();
+	this->eliminationSets.modify(0).makeSquarefree();
 	if (this->setting.simplifyByRootcounting && mVariables.size() == 1) {
 		// this simplification is done for the base level in liftCheck
-		this->eliminationSets.front().removePolynomialsWithoutRealRoots();
+		this->eliminationSets.modify(0).removePolynomialsWithoutRealRoots();
 	}
 	// done for the current scheduled polynomials
 	polynomials.clearScheduled();
@@ -267,19 +263,22 @@ bool CAD<Number>::prepareElimination() {
 
 template<typename Number>
 void CAD<Number>::clearElimination() {
+	mSnapshot.reset();
 	this->iscomplete = false;
-	this->eliminationSets.front().clear();
+	this->eliminationSets.modify(0).clear();
 
 	// re-add the input polynomials to the front level
-	this->eliminationSets.front().insert(this->polynomials.begin(), this->polynomials.end());
+	this->eliminationSets.modify(0).insert(this->polynomials.begin(), this->polynomials.end());
 }
 
 #ifdef __VS
 template<typename Number>
 void CAD<Number>::completeElimination(const typename CAD<Number>::BoundMap& bounds) {
+	mSnapshot.reset();
 #else
 template<typename Number>
 void CAD<Number>::completeElimination(const CAD<Number>::BoundMap& bounds) {
+	mSnapshot.reset();
 #endif
 	this->prepareElimination();
 	bool useBounds = !bounds.empty();
@@ -298,14 +297,14 @@ void CAD<Number>::completeElimination(const CAD<Number>::BoundMap& bounds) {
 				tmp.push_back(this->polynomials.take(new UPolynomial(mVariables[l], {MPolynomial(-b.second.lower()), MPolynomial(1)})));
 				if (!this->setting.earlyLiftingPruningByBounds) {
 					// need to add bound polynomial if no bounds are generated automatically
-					this->eliminationSets[b.first].insert(tmp.back());
+					this->eliminationSets.modify(b.first).insert(tmp.back());
 				}
 			}
 			if (b.second.upperBoundType() != BoundType::INFTY) {
 				tmp.push_back(this->polynomials.take(new UPolynomial(mVariables[l], {MPolynomial(-b.second.upper()), MPolynomial(1)})));
 				if (!this->setting.earlyLiftingPruningByBounds) {
 					// need to add bound polynomial if no bounds are generated automatically
-					this->eliminationSets[l].insert(tmp.back());
+					this->eliminationSets.modify(l).insert(tmp.back());
 				}
 			}
 
@@ -314,7 +313,7 @@ void CAD<Number>::completeElimination(const CAD<Number>::BoundMap& bounds) {
 			while (!tmp.empty() && l < mVariables.size()) {
 				std::list<const UPolynomial*> tmp2;
 				for (const auto& p: tmp) {
-					auto res = this->eliminationSets[l-1].eliminateInto(p, this->eliminationSets[l], mVariables[l], this->setting);
+					auto res = this->eliminationSets.modify(l-1).eliminateInto(p, this->eliminationSets.modify(l), mVariables[l], this->setting);
 					tmp2.insert(tmp2.begin(), res.begin(), res.end());
 				}
 				std::swap(tmp, tmp2);
@@ -327,22 +326,28 @@ void CAD<Number>::completeElimination(const CAD<Number>::BoundMap& bounds) {
 		for (unsigned l = 1; l < this->eliminationSets.size(); l++) {
 			while (! this->eliminationSets[l-1].emptySingleEliminationQueue()) {
 				// the polynomial can be analyzed for zeros
-				auto p = this->eliminationSets[l-1].popNextSingleEliminationPosition();
+				auto p = this->eliminationSets.modify(l-1).popNextSingleEliminationPosition();
 				CARL_LOG_DEBUG("carl.cad", "Checking whether " << *p << " vanishes in " << bounds);
 				if (!this->vanishesInBox(p, bounds, l-1)) {
-					this->eliminationSets[l-1].erase(p);
+					this->eliminationSets.modify(l-1).erase(p);
 				}
 			}
+			if (this->setting.projectionThreads > 0) {
+				this->eliminationSets.modify(l-1).eliminateAllInto(this->eliminationSets.modify(l), mVariables[l], this->setting, this->projectionPool());
+			}
 			while (!this->eliminationSets[l-1].emptyPairedEliminationQueue()) {
-				this->eliminationSets[l-1].eliminateNextInto(this->eliminationSets[l], mVariables[l], this->setting);
+				this->eliminationSets.modify(l-1).eliminateNextInto(this->eliminationSets.modify(l), mVariables[l], this->setting);
 			}
 		}
 	} else {
 		// unbounded elimination from level l-1 to level l
 		for (unsigned l = 1; l < this->eliminationSets.size(); l++) {
+			if (this->setting.projectionThreads > 0) {
+				this->eliminationSets.modify(l-1).eliminateAllInto(this->eliminationSets.modify(l), mVariables[l], this->setting, this->projectionPool());
+			}
 			while (	!this->eliminationSets[l-1].emptySingleEliminationQueue() ||
 					!this->eliminationSets[l-1].emptyPairedEliminationQueue()) {
-				this->eliminationSets[l-1].eliminateNextInto(this->eliminationSets[l], mVariables[l], this->setting, false);
+				this->eliminationSets.modify(l-1).eliminateNextInto(this->eliminationSets.modify(l), mVariables[l], this->setting, false);
 			}
 		}
 	}
@@ -350,10 +355,12 @@ void CAD<Number>::completeElimination(const CAD<Number>::BoundMap& bounds) {
 
 template<typename Number>
 void CAD<Number>::clear() {
+	mSnapshot.reset();
 	mVariables.clear();
-	this->sampleTree.clear();
+	this->detachSampleTree();
+	this->sampleTree->clear();
 	// Add empty root node
-	this->sampleTree.insert(this->sampleTree.begin(), nullptr);
+	this->sampleTree->insert(this->sampleTree->begin(), nullptr);
 	this->eliminationSets.clear();
 	this->polynomials.clear();
 	this->polynomials.clearScheduled();
@@ -373,6 +380,7 @@ void CAD<Number>::complete() {
 
 template<typename Number>
 void CAD<Number>::tryEquationSeparation(bool useBounds, bool onlyStrictBounds) {
+	mSnapshot.reset();
 	bool hasEquations = false;
 	bool hasStrict = false;
 	bool hasWeak = false;
@@ -397,6 +405,73 @@ void CAD<Number>::tryEquationSeparation(bool useBounds, bool onlyStrictBounds) {
 }
 
 
+template<typename Number>
+void CAD<Number>::updateEquations() {
+	mSnapshot.reset();
+	if (this->eliminationSets.empty()) return;
+	const auto& front = this->eliminationSets.front();
+	cad::ProjectionOperator<const UPolynomial*> projection;
+	std::list<const UPolynomial*> equations;
+	mEquationalConstraints.clear();
+	if (this->setting.equationalProjection) {
+		for (const auto& c: mConstraints) {
+			if (c.getSign() != Sign::ZERO || c.isNegated()) continue;
+			if (!c.getPolynomial().has(mVariables.first())) continue;
+			// the polynomials of the first level are factors of the input polynomials
+			std::list<const UPolynomial*> factors;
+			MPolynomial rest = c.getPolynomial();
+			bool wellOriented = true;
+			for (auto p: front.getPolynomials()) {
+				MPolynomial quotient;
+				bool factor = false;
+				while (rest.divideBy(MPolynomial(*p), quotient)) {
+					rest = quotient;
+					factor = true;
+				}
+				if (!factor) continue;
+				factors.push_back(p);
+				wellOriented = wellOriented && projection.isWellOriented(*p);
+			}
+			// the restricted projection is only valid on the zeros of all factors
+			if (!wellOriented || !rest.isConstant()) {
+				CARL_LOG_DEBUG("carl.cad", "Not restricting the projection to " << c);
+				continue;
+			}
+			mEquationalConstraints.push_back(c);
+			for (auto p: factors) {
+				if (std::find(equations.begin(), equations.end(), p) == equations.end()) equations.push_back(p);
+			}
+		}
+	}
+	cad::EquationalRestriction restriction = equations.empty() ? cad::EquationalRestriction::None : cad::EquationalRestriction::Restricted;
+	bool unchanged = front.getRestriction() == restriction && front.getEquations().size() == equations.size();
+	for (auto e: equations) {
+		unchanged = unchanged && front.isEquation(e);
+	}
+	if (unchanged) return;
+	CARL_LOG_DEBUG("carl.cad", "Restricting the projection to " << equations.size() << " equations");
+	bool requeued = this->eliminationSets.modify(0).setEquations(equations, restriction);
+	for (std::size_t l = 1; l < this->eliminationSets.size(); l++) {
+		// the resultants of two equations that are already computed are equations of this level
+		const auto& upper = this->eliminationSets[l-1];
+		std::list<const UPolynomial*> propagated;
+		if (!equations.empty()) {
+			for (auto p: this->eliminationSets[l].getPolynomials()) {
+				auto parents = this->eliminationSets[l].getParentsOf(p);
+				for (auto it = parents.begin(); it != parents.end(); std::advance(it, 2)) {
+					auto q = std::next(it);
+					if (*q != nullptr && upper.isEquation(*it) && upper.isEquation(*q)) {
+						if (projection.isWellOriented(*p)) propagated.push_back(p);
+						break;
+					}
+				}
+			}
+		}
+		requeued = this->eliminationSets.modify(l).setEquations(propagated, equations.empty() ? cad::EquationalRestriction::None : cad::EquationalRestriction::SemiRestricted) || requeued;
+	}
+	if (requeued) this->iscomplete = false;
+}
+
 template<typename Number>
 cad::Answer CAD<Number>::check(
 	std::vector<cad::Constraint<Number>>& _constraints,
@@ -406,10 +481,15 @@ cad::Answer CAD<Number>::check(
 	bool next,
 	bool checkBounds)
 {
-	assert(this->sampleTree.isConsistent());
+	mSnapshot.reset();
+	assert(this->sampleTree->isConsistent());
 	this->prepareElimination();
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 	mConstraints.set(_constraints, mVariables);
+	this->updateEquations();
+	for (const auto& c: mEquationalConstraints) {
+		conflictGraph.require(conflictGraph.getConstraint(c));
+	}
     #ifdef LOGGING
 	CARL_LOG_DEBUG("carl.cad", "Checking the system");
 	for (const auto& c: mConstraints) CARL_LOG_DEBUG("carl.cad", "  " << c);
@@ -423,7 +503,7 @@ cad::Answer CAD<Number>::check(
 	}
     #endif
 	assert(this->isSampleTreeConsistent());
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 
 	//////////////////////
 	// Initialization
@@ -442,7 +522,7 @@ cad::Answer CAD<Number>::check(
 
 	//////////////////////
 	// Preprocessing
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 
 	// check bounds for empty interval
 	for (const auto& b: bounds) {
@@ -502,7 +582,7 @@ cad::Answer CAD<Number>::check(
 			if (b.second.lowerBoundType() != BoundType::INFTY) {
 				UPolynomial p(mVariables[b.first], {MPolynomial(Term<Number>(-b.second.lower())), MPolynomial(Term<Number>(1))});
 				tmp.push_back(this->polynomials.take(new UPolynomial(p.pseudoPrimpart())));
-				this->eliminationSets[b.first].insert(tmp.back());
+				this->eliminationSets.modify(b.first).insert(tmp.back());
 				this->iscomplete = false; // new polynomials induce new sample points
 				assert(b.first < boundPolynomials.size());
 				boundPolynomials[b.first].first = tmp.back();
@@ -510,7 +590,7 @@ cad::Answer CAD<Number>::check(
 			if (b.second.upperBoundType() != BoundType::INFTY) {
 				UPolynomial p(mVariables[b.first], {MPolynomial(Term<Number>(-b.second.upper())), MPolynomial(Term<Number>(1))});
 				tmp.push_back(this->polynomials.take(new UPolynomial(p.pseudoPrimpart())));
-				this->eliminationSets[b.first].insert(tmp.back());
+				this->eliminationSets.modify(b.first).insert(tmp.back());
 				this->iscomplete = false; // new polynomials induce new sample points
 				boundPolynomials[b.first].first = tmp.back();
 			}
@@ -521,7 +601,7 @@ cad::Answer CAD<Number>::check(
 			while (!tmp.empty() && l < mVariables.size()) {
 				std::list<const UPolynomial*> tmp2;
 				for (const auto& p: tmp) {
-					auto res = this->eliminationSets[l-1].eliminateInto(p, this->eliminationSets[l], mVariables[l], this->setting);
+					auto res = this->eliminationSets.modify(l-1).eliminateInto(p, this->eliminationSets.modify(l), mVariables[l], this->setting);
 					tmp2.insert(tmp2.begin(), res.begin(), res.end());
 				}
 				std::swap(tmp, tmp2);
@@ -532,9 +612,9 @@ cad::Answer CAD<Number>::check(
 
 	// call the main check function according to the settings
 	CARL_LOG_DEBUG("carl.cad", "Calling mainCheck...");
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 	cad::Answer satisfiable = this->mainCheck(bounds, r, conflictGraph, next, useBounds, checkBounds);
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 	CARL_LOG_DEBUG("carl.cad", "mainCheck returned " << satisfiable);
 
 	if (useBounds) {
@@ -547,7 +627,7 @@ cad::Answer CAD<Number>::check(
 				this->widenBounds(bounds);
 			}
 		}
-		assert(this->sampleTree.isConsistent());
+		assert(this->sampleTree->isConsistent());
 		// restore elimination polynomials to their previous state due to possible bound-related simplifications
 		for (unsigned l = 0; l < mVariables.size(); l++) {
 			// remove bound polynomials and their children
@@ -560,27 +640,27 @@ cad::Answer CAD<Number>::check(
 				this->removePolynomial(boundPolynomials[l].second, l, this->setting.earlyLiftingPruningByBounds);
 			}
 		}
-		assert(this->sampleTree.isConsistent());
+		assert(this->sampleTree->isConsistent());
 		if (this->setting.simplifyEliminationByBounds) {
 			// re-add the input polynomials to the top-level (for they could have been deleted)
-			this->eliminationSets.front().clear();
+			this->eliminationSets.modify(0).clear();
 			for (const auto& p: this->polynomials.getPolynomials()) {
 				if (p->mainVar() == mVariables.front()) {
-					this->eliminationSets.front().insert(p);
+					this->eliminationSets.modify(0).insert(p);
 				} else {
-					this->eliminationSets.front().insert(this->polynomials.take(new UPolynomial(p->switchVariable(mVariables.front()))));
+					this->eliminationSets.modify(0).insert(this->polynomials.take(new UPolynomial(p->switchVariable(mVariables.front()))));
 				}
 			}
 		} else {
 			// only reset the first elimination level
-			this->eliminationSets.front().resetLiftingPositionsFully();
-			this->eliminationSets.front().setLiftingPositionsReset();
+			this->eliminationSets.modify(0).resetLiftingPositionsFully();
+			this->eliminationSets.modify(0).setLiftingPositionsReset();
 		}
-		assert(this->sampleTree.isConsistent());
+		assert(this->sampleTree->isConsistent());
 		for (unsigned l = 1; l < this->eliminationSets.size(); l++) {
 			// reset every lifting queue besides the first elimination level
-			this->eliminationSets[l].resetLiftingPositionsFully();
-			this->eliminationSets[l].setLiftingPositionsReset();
+			this->eliminationSets.modify(l).resetLiftingPositionsFully();
+			this->eliminationSets.modify(l).setLiftingPositionsReset();
 		}
 	}
 
@@ -594,12 +674,13 @@ cad::Answer CAD<Number>::check(
 	CARL_LOG_TRACE("carl.cad", "Status:" << std::endl << *this);
 
 	this->alterSetting(backup);
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 	return satisfiable;
 }
 
 template<typename Number>
 void CAD<Number>::addPolynomial(const MPolynomial& p, const std::vector<Variable>& v) {
+	mSnapshot.reset();
 	CARL_LOG_TRACE("carl.cad", __func__ << "( " << p << ", " << v << " )");
 	Variable var = v.front();
 	if (!mVariables.empty()) var = mVariables.first();
@@ -627,6 +708,7 @@ void CAD<Number>::addPolynomial(const MPolynomial& p, const std::vector<Variable
 
 template<typename Number>
 void CAD<Number>::removePolynomial(const MPolynomial& polynomial) {
+	mSnapshot.reset();
 	CARL_LOG_TRACE("carl.cad", __func__ << "( " << polynomial << " )");
 
 	auto up = polynomials.removePolynomial(polynomial);
@@ -647,18 +729,19 @@ void CAD<Number>::removePolynomial(const MPolynomial& polynomial) {
 
 template<typename Number>
 void CAD<Number>::removePolynomial(const UPolynomial* p, unsigned level, bool childrenOnly) {
+	mSnapshot.reset();
 	// no equivalent polynomial for p in any level
 	if (p == nullptr) return;
 	CARL_LOG_FUNC("carl.cad", *p << ", " << level << ", " << childrenOnly);
 	assert(this->isSampleTreeConsistent());
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 
 	/* Delete
 	 * 1. the polynomial from the given level in the elimination sets,
 	 * 2. all its parents from previous levels,
 	 */
 
-	if (!childrenOnly && (this->eliminationSets[level].hasParents(p) || !this->eliminationSets[level].erase(p))) {
+	if (!childrenOnly && (this->eliminationSets[level].hasParents(p) || !this->eliminationSets.modify(level).erase(p))) {
 		// polynomial did not exist in the given level or it stems from another polynomial as well
 		return;
 	}
@@ -669,7 +752,7 @@ void CAD<Number>::removePolynomial(const UPolynomial* p, unsigned level, bool ch
 	for (unsigned l = level+1; !parents.empty() && l < dim; l++) {
 		std::forward_list<const UPolynomial*> newParents(parents);
 		for (const auto& parent: parents) {
-			std::forward_list<const UPolynomial*> curParents = this->eliminationSets[l].removeByParent(parent);
+			std::forward_list<const UPolynomial*> curParents = this->eliminationSets.modify(l).removeByParent(parent);
 			newParents.insert_after(newParents.before_begin(), curParents.begin(), curParents.end());
 		}
 		newParents.sort(std::less<UPolynomial>(this->setting.order));
@@ -684,44 +767,93 @@ void CAD<Number>::removePolynomial(const UPolynomial* p, unsigned level, bool ch
 	 * - Add all Children of the level which are not present yet (merging).
 	 *
 	 */
-	std::size_t maxDepth = this->sampleTree.max_depth();
-	auto sampleTreeRoot = this->sampleTree.begin();
+	std::size_t maxDepth = this->sampleTree->max_depth();
+	auto sampleTreeRoot = this->sampleTree->begin();
 	for (int l = (int)dim - 1; l >= (int)level; l--) {
-		assert(this->sampleTree.isConsistent());
+		assert(this->sampleTree->isConsistent());
 		// iterate from the leaves to the root (more efficient if several levels are to be cleaned)
 		if (this->eliminationSets[(size_t)l].empty()) {
 			// there is nothing more to be done for this level, so erase all samples
 			unsigned depth = dim - (unsigned)l;
-			assert(maxDepth <= this->sampleTree.max_depth());
+			assert(maxDepth <= this->sampleTree->max_depth());
 			if (depth <= maxDepth) {
+				this->detachSampleTree();
 				// erase all samples on this level
-				for (auto node = this->sampleTree.begin_depth(depth); node != this->sampleTree.end_depth(); ) {
-					node = this->sampleTree.erase(node);
+				for (auto node = this->sampleTree->begin_depth(depth); node != this->sampleTree->end_depth(); ) {
+					node = this->sampleTree->erase(node);
 				}
 				maxDepth = depth-1;
 			}
 		}
 	}
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
+}
+
+template<typename Number>
+typename CAD<Number>::Snapshot CAD<Number>::snapshot() {
+	if (!mSnapshot) {
+		CARL_LOG_DEBUG("carl.cad", "Taking snapshot of " << this->eliminationSets.size() << " elimination levels");
+		// the sample tree and the elimination levels are shared, they are copied when they are modified
+		mSnapshot = std::make_shared<State>(State({this, mVariables, this->sampleTree, this->eliminationSets, this->polynomials.getState(), this->iscomplete}));
+	}
+	return Snapshot(mSnapshot);
+}
+
+template<typename Number>
+void CAD<Number>::restore(const Snapshot& s) {
+	assert(s.valid());
+	assert(s.mState->owner == this);
+	if (mSnapshot == s.mState) {
+		CARL_LOG_DEBUG("carl.cad", "Restoring unmodified snapshot");
+		return;
+	}
+	CARL_LOG_DEBUG("carl.cad", "Restoring snapshot");
+	const State& state = *s.mState;
+	mVariables = state.variables;
+	this->sampleTree = state.sampleTree;
+	this->eliminationSets = state.eliminationSets;
+	this->polynomials.setState(typename cad::CADPolynomials<Number>::State(state.polynomials));
+	this->iscomplete = state.iscomplete;
+	mSnapshot = s.mState;
+}
+
+template<typename Number>
+void CAD<Number>::restore(Snapshot&& s) {
+	assert(s.valid());
+	assert(s.mState->owner == this);
+	if (mSnapshot == s.mState || s.mState.use_count() > 1) {
+		restore(static_cast<const Snapshot&>(s));
+		s.mState.reset();
+		return;
+	}
+	CARL_LOG_DEBUG("carl.cad", "Restoring snapshot by moving");
+	State& state = *s.mState;
+	mVariables = std::move(state.variables);
+	this->sampleTree = std::move(state.sampleTree);
+	this->eliminationSets = std::move(state.eliminationSets);
+	this->polynomials.setState(std::move(state.polynomials));
+	this->iscomplete = state.iscomplete;
+	s.mState.reset();
+	mSnapshot.reset();
 }
 
 template<typename Number>
 std::vector<Interval<Number>> CAD<Number>::getBounds(const RealAlgebraicPoint<Number>& r) const {
 	std::vector<Interval<Number>> bounds(mVariables.size());
 	// initially, parent is the root
-	auto parent = this->sampleTree.begin();
+	auto parent = this->sampleTree->begin();
 
 	for (int index = mVariables.size()-1; index >= 0; index--) {
 		// tree is build upside down, index is in [mVariables.size()-1, 0]
 		RealAlgebraicNumber<Number> sample = r[index];
-		if (this->sampleTree.begin(parent) == this->sampleTree.end(parent)) {
+		if (this->sampleTree->begin(parent) == this->sampleTree->end(parent)) {
 			// this tree level is empty
 			bounds[index] = Interval<Number>::unboundedInterval();
 			continue;
 		}
 		// search for the left and right boundaries in the first variable eliminated
 		// does not compare less than r
-		auto node = std::lower_bound(this->sampleTree.begin(parent), this->sampleTree.end(parent), sample);
+		auto node = std::lower_bound(this->sampleTree->begin(parent), this->sampleTree->end(parent), sample);
 
 		bounds[index] = this->getBounds(node, sample);
 		parent = node;
@@ -751,17 +883,28 @@ cad::SampleSet<Number> CAD<Number>::samples(
 
 	bool boundsActive = !bounds.isEmpty() && !bounds.isInfinite();
 
+	std::vector<RealAlgebraicNumber<Number>> batch;
 	for (const auto& root: roots) {
-		CARL_LOG_TRACE("carl.cad", "\tWorking on " << root);
 		if (!root.containedIn(bounds)) {
-			CARL_LOG_TRACE("carl.cad", "\tout of bounds " << bounds << " -> ignoring");
+			CARL_LOG_TRACE("carl.cad", "\t" << root << " out of bounds " << bounds << " -> ignoring");
 			continue;
 		}
-		auto insertValue = currentSamples.insert(root);
+		batch.push_back(root);
+	}
+	// insert all roots at once, the results are ordered by their value
+	auto inserted = currentSamples.insertBatch(std::move(batch));
+
+	// samples which shall be added to currentSamples and newSampleSet in the end
+	std::vector<RealAlgebraicNumber<Number>> newRoots;
+	std::vector<RealAlgebraicNumber<Number>> newSamples;
+	auto previous = currentSamples.end();
+	for (const auto& insertValue: inserted) {
 		auto insertIt = std::get<0>(insertValue);
+		CARL_LOG_TRACE("carl.cad", "\tWorking on " << *insertIt);
+		if (insertIt == previous) continue;
 		if (!std::get<1>(insertValue)) {
 			if (std::get<2>(insertValue)) {
-				newSampleSet.insert(*insertIt);
+				newRoots.push_back(*insertIt);
 				replacedSamples.push_front(*insertIt);
 				CARL_LOG_TRACE("carl.cad", "\treplaced another sample");
 			} else {
@@ -770,11 +913,9 @@ cad::SampleSet<Number> CAD<Number>::samples(
 		} else {
 			// we found a new sample
 			// add the root to new samples (with root switch on)
-			newSampleSet.insert(*insertIt);
+			newRoots.push_back(*insertIt);
 			CARL_LOG_TRACE("carl.cad", "\tadded as new sample");
 		}
-		// local set storing the elements which shall be added to currentSampleSet and newSampleSet in the end
-		std::list<RealAlgebraicNumber<Number>> newSamples;
 
 		/** Situation: One, next or previous, has to be a root (assumption) or we meet one of the outmost positions.
 		 * --------|-------------------|-----------------|---
@@ -782,43 +923,38 @@ cad::SampleSet<Number> CAD<Number>::samples(
 		 *     (root?)              (root)            (root?)
 		 */
 
-		//std::cout << *this << std::endl;
-		//carl::VariableType type = mVariables[openVariableCount].getType();
-		//if (!this->setting.exploreInteger) type = VariableType::VT_REAL;
-		//std::cout << "Current var: " << openVariableCount << " -> " << mVariables[openVariableCount] << std::endl;
-		//REGISTERED_ASSERT(openVariableCount > 1);
 		// next: right neighbor
 		auto neighbor = insertIt;
 		// -> next (safe here, but need to check for end() later)
 		neighbor++;
 		if (neighbor == currentSamples.end()) {
-			newSamples.push_front(RealAlgebraicNumber<Number>::sampleAbove(*insertIt));
+			newSamples.push_back(RealAlgebraicNumber<Number>::sampleAbove(*insertIt));
 		} else if (neighbor->isRoot()) {
-			newSamples.push_front(RealAlgebraicNumber<Number>::sampleBetween(*insertIt, *neighbor));
+			newSamples.push_back(RealAlgebraicNumber<Number>::sampleBetween(*insertIt, *neighbor));
 		}
 
 		// previous: left neighbor
 		neighbor = insertIt;
 		if (neighbor == currentSamples.begin()) {
-			newSamples.push_front(RealAlgebraicNumber<Number>::sampleBelow(*insertIt));
+			newSamples.push_back(RealAlgebraicNumber<Number>::sampleBelow(*insertIt));
 		} else {
 			neighbor--;
 			// now neighbor is the left bound (can be safely determined now)
-			if (neighbor->isRoot()) {
-				newSamples.push_front(RealAlgebraicNumber<Number>::sampleBetween(*neighbor, *insertIt));
+			// if it is the previous root, the sample in between was already constructed as its right neighbor
+			if (neighbor->isRoot() && neighbor != previous) {
+				newSamples.push_back(RealAlgebraicNumber<Number>::sampleBetween(*neighbor, *insertIt));
 			}
 		}
+		previous = insertIt;
+	}
 
-		if (boundsActive) {
-			// remove samples which do not lie within the (weak) bounds
-			for (auto sit = newSamples.begin(); sit != newSamples.end(); ) {
-				if (bounds.meets(sit->value())) sit++;
-				else sit = newSamples.erase(sit);
-			}
-		}
-		newSampleSet.insert(newSamples.begin(), newSamples.end());
-		currentSamples.insert(newSamples.begin(), newSamples.end());
+	if (boundsActive) {
+		// remove samples which do not lie within the (weak) bounds
+		newSamples.erase(std::remove_if(newSamples.begin(), newSamples.end(), [&bounds](const RealAlgebraicNumber<Number>& s){ return !bounds.meets(s.value()); }), newSamples.end());
 	}
+	newRoots.insert(newRoots.end(), newSamples.begin(), newSamples.end());
+	newSampleSet.insert(newRoots.begin(), newRoots.end());
+	currentSamples.insert(newSamples.begin(), newSamples.end());
 	CARL_LOG_TRACE("carl.cad", " -> " << currentSamples);
 	return newSampleSet;
 }
@@ -834,7 +970,7 @@ cad::SampleSet<Number> CAD<Number>::samples(
 ) {
 	assert(mVariables.size() == node.depth() + openVariableCount + 1);
 	std::map<Variable, RealAlgebraicNumber<Number>> m;
-	auto valit = sampleTree.begin_path(node);
+	auto valit = sampleTree->begin_path(node);
 	for (std::size_t i = node.depth(); i > 0; i--) {
 		m[mVariables[mVariables.size() - i]] = *valit;
 		valit++;
@@ -908,21 +1044,22 @@ std::vector<Variable> CAD<Number>::orderVariablesGreedily(
 
 template<typename Number>
 void CAD<Number>::alterSetting(const cad::CADSettings& _setting) {
+	mSnapshot.reset();
 	// settings that require re-computation
 	if (_setting.order != this->setting.order) {
 		// switch the order relation in all elimination sets
-		for (auto& i: this->eliminationSets) {
-			i.setLiftingOrder(typename cad::EliminationSet<Number>::PolynomialComparator(_setting.order));
+		for (std::size_t l = 0; l < this->eliminationSets.size(); l++) {
+			this->eliminationSets.modify(l).setLiftingOrder(typename cad::EliminationSet<Number>::PolynomialComparator(_setting.order));
 		}
 	}
 	if (!this->setting.simplifyByRootcounting && _setting.simplifyByRootcounting) {
-		for (auto& i: this->eliminationSets) {
-			i.removePolynomialsWithoutRealRoots();
+		for (std::size_t l = 0; l < this->eliminationSets.size(); l++) {
+			this->eliminationSets.modify(l).removePolynomialsWithoutRealRoots();
 		}
 	}
 	if (!this->setting.simplifyByFactorization && _setting.simplifyByFactorization) {
-		for (auto& i: this->eliminationSets) {
-			i.factorize();
+		for (std::size_t l = 0; l < this->eliminationSets.size(); l++) {
+			this->eliminationSets.modify(l).factorize();
 		}
 	}
 
@@ -930,37 +1067,38 @@ void CAD<Number>::alterSetting(const cad::CADSettings& _setting) {
 }
 
 template<typename Number>
-std::list<RealAlgebraicNumber<Number>> CAD<Number>::constructSampleAt(sampleIterator node, const sampleIterator& root) const {
+std::vector<RealAlgebraicNumber<Number>> CAD<Number>::constructSampleAt(sampleIterator node, const sampleIterator& root) const {
 	/* Main sample construction loop macro augmented by a conditional argument for termination with an empty sample.
 	 * @param _condition which has to be false for every node of the sample, otherwise an empty list is returned
 	 */
-	assert(this->sampleTree.begin() == root);
-	if ((!this->sampleTree.is_valid(node) && node.isRoot()) || node == root) {
+	assert(this->sampleTree->begin() == root);
+	if ((!this->sampleTree->is_valid(node) && node.isRoot()) || node == root) {
 		// node is invalid
 		return {};
 	}
 
-	std::list<RealAlgebraicNumber<Number>> v;
+	std::vector<RealAlgebraicNumber<Number>> v;
+	v.reserve(node.depth());
 	// proceed from the leaf up to the root while the children of root represent the last component of the sample point and the leaf the first
 	if (this->setting.equationsOnly) {
 		while (node != root) {
 			if (!node->isRoot()) return {};
 			v.push_back(*node);
-			node = this->sampleTree.get_parent(node);
+			node = this->sampleTree->get_parent(node);
 		}
 	} else if (this->setting.inequalitiesOnly) {
 		while (node != root) {
 			if (node->isRoot()) return {};
 			v.push_back(*node);
-			node = this->sampleTree.get_parent(node);
+			node = this->sampleTree->get_parent(node);
 		}
 	} else {
 		while (node != root) {
-			assert(sampleTree.is_valid(node));
+			assert(sampleTree->is_valid(node));
 			v.push_back(*node);
-			node = this->sampleTree.get_parent(node);
-			assert(sampleTree.is_valid(node));
-			assert(node != sampleTree.end());
+			node = this->sampleTree->get_parent(node);
+			assert(sampleTree->is_valid(node));
+			assert(node != sampleTree->end());
 		}
 	}
 	return v;
@@ -978,10 +1116,10 @@ typename CAD<Number>::CheckNodeResult CAD<Number>::checkNode(
 		bool checkBounds,
 		std::size_t dim
 ) {
-	assert(this->sampleTree.is_valid(node));
+	assert(this->sampleTree->is_valid(node));
 	CARL_LOG_TRACE("carl.cad", __func__ << "( " << *node << ", " << bounds << " )");
 	// for each node construct the path by iterating back to the root (no way to check the bounds from here since the depth of the leaf is still unknown)
-	auto sampleList = this->constructSampleAt(node, this->sampleTree.begin());
+	auto sampleList = this->constructSampleAt(node, this->sampleTree->begin());
 	// settings demand not to take this sample (e.g., because only real roots are solutions)
 	if (sampleList.empty()) {
 		CARL_LOG_TRACE("carl.cad", "sample is empty");
@@ -1058,7 +1196,7 @@ cad::Answer CAD<Number>::mainCheck(
 		bool checkBounds
 ) {
 	CARL_LOG_TRACE("carl.cad", __func__ << "( " << mConstraints << ", " << bounds << " )");
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 
 	if (mVariables.empty()) {
 		// there are no valid samples available
@@ -1069,8 +1207,10 @@ cad::Answer CAD<Number>::mainCheck(
 
 	const std::size_t dim = mVariables.size();
 	CARL_LOG_TRACE("carl.cad", "mainCheck: dimension is " << dim);
-	auto sampleTreeRoot = this->sampleTree.begin();
-	std::size_t tmp = this->sampleTree.max_depth(sampleTreeRoot);
+	// the lifting extends the sample tree
+	this->detachSampleTree();
+	auto sampleTreeRoot = this->sampleTree->begin();
+	std::size_t tmp = this->sampleTree->max_depth(sampleTreeRoot);
 	assert(tmp >= 0);
 	unsigned maxDepth = (unsigned)tmp;
 	// if the elimination sets were extended (i.e. the sample tree is not developed completely), we obtain new samples already in phase one
@@ -1110,16 +1250,16 @@ cad::Answer CAD<Number>::mainCheck(
 				CARL_LOG_TRACE("carl.cad", "Lifting");
 				// eliminate will not be able to produce a new polynomial.
 				std::stack<std::size_t> satPath;
-				CARL_LOG_DEBUG("carl.cad", "lifting on " << *this->sampleTree.begin_leaf());
-				return this->liftCheck(this->sampleTree.begin_leaf(), dim-this->sampleTree.begin_leaf().depth(), true, {}, bounds, boundsNontrivial, checkBounds, r, conflictGraph, satPath);
+				CARL_LOG_DEBUG("carl.cad", "lifting on " << *this->sampleTree->begin_leaf());
+				return this->liftCheck(this->sampleTree->begin_leaf(), dim-this->sampleTree->begin_leaf().depth(), true, {}, bounds, boundsNontrivial, checkBounds, r, conflictGraph, satPath);
 			}
 			CARL_LOG_DEBUG("carl.cad", "Waiting for something to lift, lastRes = " << lastRes << std::endl << *this);
 		};
 
 		// perform an initial lifting step in order to fill the tree once
 		std::stack<std::size_t> satPath;
-		CARL_LOG_DEBUG("carl.cad", "lifting on " << *this->sampleTree.begin_leaf());
-		cad::Answer status = this->liftCheck(this->sampleTree.begin_leaf(), dim-this->sampleTree.begin_leaf().depth(), true, {}, bounds, boundsNontrivial, checkBounds, r, conflictGraph, satPath);
+		CARL_LOG_DEBUG("carl.cad", "lifting on " << *this->sampleTree->begin_leaf());
+		cad::Answer status = this->liftCheck(this->sampleTree->begin_leaf(), dim-this->sampleTree->begin_leaf().depth(), true, {}, bounds, boundsNontrivial, checkBounds, r, conflictGraph, satPath);
 		if (status == cad::Answer::True) {
 			// lifting yields a satisfying sample
 			return cad::Answer::True;
@@ -1129,7 +1269,7 @@ cad::Answer CAD<Number>::mainCheck(
 	} else {
 		CARL_LOG_TRACE("carl.cad", "maxDepth != 0, maxDepth = " << maxDepth);
 		std::vector<typename Tree::template LeafIterator<false>> leafs;
-		for (auto it = this->sampleTree.begin_leaf(); it != this->sampleTree.end_leaf(); it++) leafs.push_back(it);
+		for (auto it = this->sampleTree->begin_leaf(); it != this->sampleTree->end_leaf(); it++) leafs.push_back(it);
 		typename cad::SampleSet<Number>::SampleComparator comp(setting.sampleOrdering);
 		//std::cout << "Before:";
 		//for (const auto& it: leafs) std::cout << " " << *it << "(" << (void*)&it << ")";
@@ -1138,8 +1278,8 @@ cad::Answer CAD<Number>::mainCheck(
 		//std::cout << "Sorting from [" << (void*)(&*leafs.begin()) << " to " << (void*)(&*leafs.end()) << ")" << std::endl;
 		std::sort(leafs.begin(), leafs.end(), [&](const LeafIterator& lhs, const LeafIterator& rhs){ 
 			std::stack<bool> l, r;
-			for (auto it = sampleTree.begin_path(lhs); it != sampleTree.end_path(); it++) l.push(it->isIntegral());
-			for (auto it = sampleTree.begin_path(rhs); it != sampleTree.end_path(); it++) r.push(it->isIntegral());
+			for (auto it = sampleTree->begin_path(lhs); it != sampleTree->end_path(); it++) l.push(it->isIntegral());
+			for (auto it = sampleTree->begin_path(rhs); it != sampleTree->end_path(); it++) r.push(it->isIntegral());
 			while (!l.empty() && !r.empty()) {
 				if (l.top() != r.top()) return l.top();
 				l.pop();
@@ -1165,10 +1305,10 @@ cad::Answer CAD<Number>::mainCheck(
 		//for (const auto& it: leafs) std::cout << " " << *it << "(" << (void*)&it << ")";
 		//std::cout << std::endl;
 		// the sample tree contains valid sample points
-		//for (auto leaf = this->sampleTree.begin_leaf(); leaf != this->sampleTree.end_leaf(); leaf++) {
+		//for (auto leaf = this->sampleTree->begin_leaf(); leaf != this->sampleTree->end_leaf(); leaf++) {
 		for (const auto& leaf: leafs) {
 			// traverse the current sample tree leaves for satisfying samples
-			CARL_LOG_TRACE("carl.cad", this->sampleTree);
+			CARL_LOG_TRACE("carl.cad", *this->sampleTree);
 			auto res = this->checkNode(leaf, true, next, bounds, r, conflictGraph, boundsNontrivial, checkBounds, dim);
 			if (res == CNR_TRUE) return cad::Answer::True;
 			if (res == CNR_UNKNOWN) return cad::Answer::Unknown;
@@ -1191,7 +1331,7 @@ cad::Answer CAD<Number>::mainCheck(
 	 * - We start from the smallest level (0, 2, ..., dim-1) where lifting is still possible.
 	 */
 
-	maxDepth = (unsigned)this->sampleTree.max_depth(sampleTreeRoot);
+	maxDepth = (unsigned)this->sampleTree->max_depth(sampleTreeRoot);
 	// invariant: either the last level is completely developed (dim or 0), or something in between due to bounds
 	assert(maxDepth == (unsigned)dim || maxDepth == (unsigned)0 || boundsNontrivial);
 	CARL_LOG_TRACE("carl.cad", __func__ << ": Phase 3");
@@ -1216,20 +1356,20 @@ cad::Answer CAD<Number>::mainCheck(
 			}
 			// reset all lifting positions before this level
 			for (unsigned l = 0; (int)l < level; l++) {
-				this->eliminationSets[l].resetLiftingPositionsFully();
-				this->eliminationSets[l].setLiftingPositionsReset();
+				this->eliminationSets.modify(l).resetLiftingPositionsFully();
+				this->eliminationSets.modify(l).setLiftingPositionsReset();
 			}
 		}
 
 		// lift all nodes at the corresponding tree depth according to the found lifting positions
 		unsigned depth = (unsigned)((int)dim - level - 1);
 		CARL_LOG_TRACE("carl.cad", "Current depth = " << depth << ", level = " << level);
-		CARL_LOG_TRACE("carl.cad", this->sampleTree);
+		CARL_LOG_TRACE("carl.cad", *this->sampleTree);
 		assert(depth >= 0 && depth < dim);
-		assert(depth <= (unsigned)this->sampleTree.max_depth());
-		for (auto node = this->sampleTree.begin_depth(depth); node != this->sampleTree.end_depth(); node++) {
+		assert(depth <= (unsigned)this->sampleTree->max_depth());
+		for (auto node = this->sampleTree->begin_depth(depth); node != this->sampleTree->end_depth(); node++) {
 			// traverse all nodes at depth, i.e., sample points of dimension dim - level - 1 equaling the number of coefficient variables of the lifting position at level
-			std::list<RealAlgebraicNumber<Number>> sampleList = this->constructSampleAt(node, sampleTreeRoot);
+			std::vector<RealAlgebraicNumber<Number>> sampleList = this->constructSampleAt(node, sampleTreeRoot);
 			// no degenerate sample points are considered here because they were already discarded in Phase 2
 			if (depth != sampleList.size()) continue;
 
@@ -1277,7 +1417,7 @@ cad::Answer CAD<Number>::mainCheck(
 				return cad::Answer::Unknown;
 			}
 		}
-		this->eliminationSets[(unsigned)level].setLiftingPositionsReset();
+		this->eliminationSets.modify((unsigned)level).setLiftingPositionsReset();
 		//if (!didProgress) break;
 	}
 
@@ -1286,8 +1426,10 @@ cad::Answer CAD<Number>::mainCheck(
 		// CAD is computed completely if there were no bounds used during elimination and lifting
 		this->iscomplete = true;
 		// all liftings were considered, so store the reset states
-		for (auto& i: this->eliminationSets) {
-			i.setLiftingPositionsReset();
+		for (std::size_t l = 0; l < this->eliminationSets.size(); l++) {
+			// avoid copying levels that are shared with a snapshot
+			if (this->eliminationSets[l].isLiftingPositionsReset()) continue;
+			this->eliminationSets.modify(l).setLiftingPositionsReset();
 		}
 	}
 
@@ -1298,18 +1440,18 @@ cad::Answer CAD<Number>::mainCheck(
 template<typename Number>
 typename CAD<Number>::sampleIterator CAD<Number>::storeSampleInTree(RealAlgebraicNumber<Number> newSample, sampleIterator node) {
 	CARL_LOG_FUNC("carl.cad", newSample << ", " << *node);
-	auto newNode = std::lower_bound(this->sampleTree.begin_children(node), this->sampleTree.end_children(node), newSample);
-	if (newNode == this->sampleTree.end_children(node)) {
-		newNode = this->sampleTree.append(node, newSample);
+	auto newNode = std::lower_bound(this->sampleTree->begin_children(node), this->sampleTree->end_children(node), newSample);
+	if (newNode == this->sampleTree->end_children(node)) {
+		newNode = this->sampleTree->append(node, newSample);
 	} else if (*newNode == newSample) {
 		assert(newSample.isRoot() || (!newNode->isRoot()));
-		newNode = this->sampleTree.replace(newNode, newSample);
+		newNode = this->sampleTree->replace(newNode, newSample);
 		assert(newNode.depth() <= mVariables.size());
 	} else {
-		newNode = this->sampleTree.insert(newNode, newSample);
+		newNode = this->sampleTree->insert(newNode, newSample);
 		assert(newNode.depth() <= mVariables.size());
 	}
-	assert(this->sampleTree.isConsistent());
+	assert(this->sampleTree->isConsistent());
 	return newNode;
 }
 
@@ -1323,11 +1465,11 @@ cad::Answer CAD<Number>::baseLiftCheck(
 	if (this->anAnswerFound()) {
 		// interrupt the check procedure
 		this->interrupted = true;
-		assert(this->sampleTree.isConsistent());
+		assert(this->sampleTree->isConsistent());
 		CARL_LOG_TRACE("carl.cad", "Returning true as an answer was found");
 		return cad::Answer::True;
 	}
-	std::vector<RealAlgebraicNumber<Number>> sample(sampleTree.begin_path(node), sampleTree.end_path());
+	std::vector<RealAlgebraicNumber<Number>> sample(sampleTree->begin_path(node), sampleTree->end_path());
 	sample.pop_back();
 	RealAlgebraicPoint<Number> t(std::move(sample));
 	if ((this->setting.computeConflictGraph && mConstraints.satisfiedBy(t, getVariables(), conflictGraph)) ||
@@ -1345,7 +1487,7 @@ cad::Answer CAD<Number>::partialLiftCheck(
 		sampleIterator node,
 		cad::ConflictGraph<Number>& conflictGraph
 ) {
-	std::vector<RealAlgebraicNumber<Number>> sample(sampleTree.begin_path(node), sampleTree.end_path());
+	std::vector<RealAlgebraicNumber<Number>> sample(sampleTree->begin_path(node), sampleTree->end_path());
 	sample.pop_back();
 	RealAlgebraicPoint<Number> t(std::move(sample));
 	if ((this->setting.computeConflictGraph && mConstraints.satisfiedPartiallyBy(t, getVariables(), conflictGraph)) ||
@@ -1353,12 +1495,106 @@ cad::Answer CAD<Number>::partialLiftCheck(
 		return cad::Answer::True;
 	}
 	CARL_LOG_DEBUG("carl.cad", "Early abort for sample " << t);
-	//if (sampleTree.is_leaf(node)) {
-	//	sampleTree.append(node, RealAlgebraicNumber<Number>(0));
+	//if (sampleTree->is_leaf(node)) {
+	//	sampleTree->append(node, RealAlgebraicNumber<Number>(0));
 	//}
 	return cad::Answer::False;
 }
 
+template<typename Number>
+boost::optional<cad::Answer> CAD<Number>::liftCheckLastLevel(
+		sampleIterator node,
+		const std::vector<RealAlgebraicNumber<Number>>& samples,
+		const BoundMap& bounds,
+		bool boundsActive,
+		bool checkBounds,
+		RealAlgebraicPoint<Number>& r,
+		cad::ConflictGraph<Number>& conflictGraph,
+		std::stack<std::size_t>& satPath
+) {
+	CARL_LOG_FUNC("carl.cad", *node << ", " << samples.size() << " samples");
+	auto bound = (checkBounds && boundsActive) ? bounds.find(0) : bounds.end();
+	std::vector<sampleIterator> nodes;
+	// sample points to be checked, the components are copied such that no two points share a real algebraic number that may be refined
+	std::vector<RealAlgebraicPoint<Number>> points(samples.size());
+	std::vector<bool> active(samples.size(), false);
+	nodes.reserve(samples.size());
+	for (std::size_t i = 0; i < samples.size(); i++) {
+		nodes.push_back(this->storeSampleInTree(samples[i], node));
+		if (bound != bounds.end() && !samples[i].containedIn(bound->second)) continue;
+		if (setting.ignoreRoots && samples[i].isRoot() && !samples[i].isIntegral()) continue;
+		std::vector<RealAlgebraicNumber<Number>> sample;
+		sample.reserve(mVariables.size());
+		for (auto it = sampleTree->begin_path(nodes[i]); it.depth() > 0; ++it) {
+			if (it->isInterval()) {
+				sample.emplace_back(it->getIRPolynomial(), it->getInterval(), it->isRoot());
+			} else if (it->isThom()) {
+				sample.emplace_back(it->getThomEncoding(), it->isRoot());
+			} else {
+				sample.push_back(*it);
+			}
+		}
+		points[i] = RealAlgebraicPoint<Number>(std::move(sample));
+		active[i] = true;
+	}
+
+	// satisfied[i][j] is set if the sample i satisfies the constraint j, evaluated[i] if all constraints needed for the result were evaluated
+	std::vector<std::vector<bool>> satisfied(samples.size());
+	std::vector<char> evaluated(samples.size(), 0);
+	std::atomic<std::size_t> firstSatisfying(samples.size());
+	liftingPool().parallelFor(samples.size(), [&](std::size_t i){
+		if (!active[i] || i > firstSatisfying.load() || this->anAnswerFound()) return;
+		RealAlgebraicNumberEvaluation::BatchEvaluation<Number> evaluation(points[i], getVariables());
+		bool sat = true;
+		for (const auto& c: mConstraints) {
+			bool s = c.satisfiedBy(evaluation);
+			satisfied[i].push_back(s);
+			sat = sat && s;
+			if (!sat && !this->setting.computeConflictGraph) break;
+		}
+		evaluated[i] = 1;
+		if (!sat) return;
+		std::size_t first = firstSatisfying.load();
+		while (i < first && !firstSatisfying.compare_exchange_weak(first, i));
+	});
+
+	// replay the results in the order of the samples
+	for (std::size_t i = 0; i < samples.size(); i++) {
+		if (!active[i]) continue;
+		if (this->anAnswerFound() || !evaluated[i]) {
+			// the workers skip all remaining samples if an interruption flag is set
+			this->interrupted = true;
+			CARL_LOG_TRACE("carl.cad", "Returning true as an answer was found");
+			return cad::Answer::True;
+		}
+		if (this->setting.computeConflictGraph) {
+			std::size_t sampleID = conflictGraph.newSample();
+			std::size_t id = 0;
+			for (const auto& c: mConstraints) {
+				conflictGraph.set(conflictGraph.getConstraint(c), sampleID, !satisfied[i][id]);
+				id++;
+			}
+		}
+		if (i != firstSatisfying.load()) continue;
+		r = points[i];
+		if (this->setting.integerHandling == cad::IntegerHandling::BACKTRACK && !checkIntegrality(nodes[i])) {
+			CARL_LOG_ERROR("carl.cad", "Lifting was successful, but integrality is violated.");
+			std::size_t id = 0;
+			bool root = false;
+			for (auto it = sampleTree->begin_children(node); it != sampleTree->end_children(node); it++) {
+				if (*it == *nodes[i]) break;
+				if (it->isRoot() != root) id++;
+				root = it->isRoot();
+			}
+			satPath.push(id);
+			return cad::Answer::False;
+		}
+		CARL_LOG_TRACE("carl.cad", "Returning true as a satisfying sample was found");
+		return cad::Answer::True;
+	}
+	return boost::none;
+}
+
 template<typename Number>
 cad::Answer CAD<Number>::liftCheck(
 		sampleIterator node,
@@ -1374,13 +1610,13 @@ cad::Answer CAD<Number>::liftCheck(
 ) {
 	if (this->anAnswerFound()) {
 		this->interrupted = true;
-		assert(this->sampleTree.isConsistent());
+		assert(this->sampleTree->isConsistent());
 		return cad::Answer::True;
 	}
 	CARL_LOG_FUNC("carl.cad", *node << ", " << openVariableCount);
-	CARL_LOG_DEBUG("carl.cad", "Lifting " << std::vector<RealAlgebraicNumber<Number>>(sampleTree.begin_path(node), sampleTree.end_path()));
+	CARL_LOG_DEBUG("carl.cad", "Lifting " << std::vector<RealAlgebraicNumber<Number>>(sampleTree->begin_path(node), sampleTree->end_path()));
 	CARL_LOG_DEBUG("carl.cad", "Current state:" << std::endl << *this);
-	assert(this->sampleTree.is_valid(node));
+	assert(this->sampleTree->is_valid(node));
 
 	if (checkBounds && boundsActive && (!node.isRoot())) {
 		// bounds shall be checked and the level is non-empty
@@ -1410,7 +1646,7 @@ cad::Answer CAD<Number>::liftCheck(
 	//			assert(openVariableCount < mVariables.size());
 	//			CARL_LOG_DEBUG("carl.cad", "Variables: " << mVariables);
 	//			CARL_LOG_DEBUG("carl.cad", "OpenVariableCount = " << openVariableCount);
-	//			std::vector<RealAlgebraicNumber<Number>> sample(sampleTree.begin_path(node), sampleTree.end_path());
+	//			std::vector<RealAlgebraicNumber<Number>> sample(sampleTree->begin_path(node), sampleTree->end_path());
 	//			sample.pop_back();
 	//			r = RealAlgebraicPoint<Number>(std::move(sample));
 	//			CARL_LOG_DEBUG("carl.cad", "Lazy split at " << r);
@@ -1436,7 +1672,7 @@ cad::Answer CAD<Number>::liftCheck(
 	bool boundActive = bounds.end() != bound;
 
 	// restore the lifting queue.
-	this->eliminationSets[openVariableCount].resetLiftingPositions(restartLifting);
+	this->eliminationSets.modify(openVariableCount).resetLiftingPositions(restartLifting);
 
 	/*
 	 * Main loop: performs all operations possible in one level > 0, in particular, 2 phases.
@@ -1448,7 +1684,7 @@ cad::Answer CAD<Number>::liftCheck(
 	bool computeMoreSamples = false;
 	// the current list of samples at this position in the sample tree
 	cad::SampleSet<Number> currentSamples(setting.sampleOrdering);
-	currentSamples.insert(this->sampleTree.begin_children(node), this->sampleTree.end_children(node));
+	currentSamples.insert(this->sampleTree->begin_children(node), this->sampleTree->end_children(node));
 	CARL_LOG_DEBUG("carl.cad", "Getting old sample points: " << currentSamples);
 	// the current samples queue for this lifting process
 	cad::SampleSet<Number> sampleSetIncrement(setting.sampleOrdering);
@@ -1509,7 +1745,7 @@ cad::Answer CAD<Number>::liftCheck(
 				this->storeSampleInTree(replacedSample, node);
 			}
 			// discard lifting position just used for sample construction
-			this->eliminationSets[openVariableCount].popLiftingPosition();
+			this->eliminationSets.modify(openVariableCount).popLiftingPosition();
 			// try to simplify the current samples even further
 			auto simplification = sampleSetIncrement.simplify();
 			if (simplification.second) {
@@ -1532,7 +1768,7 @@ cad::Answer CAD<Number>::liftCheck(
 			for (const auto& newSample: sampleSetIncrement) {
 				if (!newSample.containedIn(bound)) continue;
 				if (!newSample.isIntegral()) {
-					std::vector<RealAlgebraicNumber<Number>> sample(sampleTree.begin_path(node), sampleTree.end_path());
+					std::vector<RealAlgebraicNumber<Number>> sample(sampleTree->begin_path(node), sampleTree->end_path());
 					sample.pop_back();
 					sample.insert(sample.begin(), newSample);
 					r = RealAlgebraicPoint<Number>(std::move(sample));
@@ -1552,6 +1788,27 @@ cad::Answer CAD<Number>::liftCheck(
 		 * Lifting of the current level.
 		 */
 		CARL_LOG_TRACE("carl.cad", __func__ << ": Phase 2");
+		if (openVariableCount == 0 && this->setting.liftingThreads > 0) {
+			// the samples of the last level only need to be checked, check all samples up to the next sample construction at once
+			std::vector<RealAlgebraicNumber<Number>> samples;
+			while (!sampleSetIncrement.empty()) {
+				if (!this->eliminationSets[openVariableCount].emptyLiftingQueue() && sampleSetIncrement.hasOptimal()) {
+					computeMoreSamples = true;
+					break;
+				}
+				samples.push_back(sampleSetIncrement.next());
+				sampleSetIncrement.pop();
+			}
+			auto answer = this->liftCheckLastLevel(node, samples, bounds, boundsActive, checkBounds, r, conflictGraph, satPath);
+			if (answer) {
+				// there might still be samples left but not stored yet
+				while (!sampleSetIncrement.empty()) {
+					this->storeSampleInTree(sampleSetIncrement.next(), node);
+					sampleSetIncrement.pop();
+				}
+				return *answer;
+			}
+		}
 		while (!sampleSetIncrement.empty()) {
 			// iterate through all samples found by the next() method
 			/*
@@ -1607,7 +1864,7 @@ cad::Answer CAD<Number>::liftCheck(
 			if (integralityBacktracking) {
 				std::size_t id = 0;
 				bool root = false;
-				for (auto it = sampleTree.begin_children(node); it != sampleTree.end_children(node); it++) {
+				for (auto it = sampleTree->begin_children(node); it != sampleTree->end_children(node); it++) {
 					if (*it == *newNode) break;
 					if (it->isRoot() != root) id++;
 					root = it->isRoot();
@@ -1662,18 +1919,18 @@ int CAD<Number>::eliminate(std::size_t level, const BoundMap& bounds, bool bound
 					CARL_LOG_DEBUG("carl.cad", "Checking whether " << *p << " vanishes in " << bounds);
 					if (this->vanishesInBox(p, bounds, l-1)) break;
 					// delete polynomial and try the next one
-					this->eliminationSets[l-1].erase(p);
+					this->eliminationSets.modify(l-1).erase(p);
 				}
-				this->eliminationSets[l-1].eliminateNextInto(this->eliminationSets[l], mVariables[l], this->setting);
+				this->eliminationSets.modify(l-1).eliminateNextInto(this->eliminationSets.modify(l), mVariables[l], this->setting);
 				// store level of successful elimination
 				level = (unsigned)l;
 
 				if (this->setting.removeConstants) {
 					// get rid of all constants moved to the current level
 					for (; l < this->eliminationSets.size(); l++) {
-						this->eliminationSets[l-1].moveConstants(this->eliminationSets[l], mVariables[l]);
+						this->eliminationSets.modify(l-1).moveConstants(this->eliminationSets.modify(l), mVariables[l]);
 					}
-					this->eliminationSets.back().removeConstants();
+					this->eliminationSets.modify(this->eliminationSets.size()-1).removeConstants();
 				}
 				// possible change to the completeness status
 				this->iscomplete = false;
@@ -1688,13 +1945,18 @@ int CAD<Number>::eliminate(std::size_t level, const BoundMap& bounds, bool bound
 					CARL_LOG_DEBUG("carl.cad", "Checking whether " << *p << " vanishes in " << bounds);
 					if (this->vanishesInBox(p, bounds, (unsigned)this->eliminationSets.size()-1)) break;
 					// delete polynomial and try the next one
-					this->eliminationSets.back().erase(p);
+					this->eliminationSets.modify(this->eliminationSets.size()-1).erase(p);
 				}
 			}
 		} else {
 			CARL_LOG_TRACE("carl.cad.elimination", "eliminate without bounds in level " << l);
 			for (; l <= level; l++) {
-				this->eliminationSets[l-1].eliminateNextInto(this->eliminationSets[l], mVariables[l], this->setting, false);
+				if (this->setting.projectionThreads > 0) {
+					// project the whole level at once
+					this->eliminationSets.modify(l-1).eliminateAllInto(this->eliminationSets.modify(l), mVariables[l], this->setting, this->projectionPool());
+				} else {
+					this->eliminationSets.modify(l-1).eliminateNextInto(this->eliminationSets.modify(l), mVariables[l], this->setting, false);
+				}
 				CARL_LOG_TRACE("carl.cad", "eliminated" << std::endl << (l-1) << ": " << this->eliminationSets[l-1] << std::endl << l << ": " << this->eliminationSets[l]);
 				level = (unsigned)l;
 				if (this->setting.removeConstants) {
@@ -1702,9 +1964,9 @@ int CAD<Number>::eliminate(std::size_t level, const BoundMap& bounds, bool bound
 					for (; l < this->eliminationSets.size(); l++) {
 						assert(l < this->eliminationSets.size());
 						assert(l < mVariables.size());
-						this->eliminationSets[l-1].moveConstants(this->eliminationSets[l], mVariables[l]);
+						this->eliminationSets.modify(l-1).moveConstants(this->eliminationSets.modify(l), mVariables[l]);
 					}
-					this->eliminationSets.back().removeConstants();
+					this->eliminationSets.modify(this->eliminationSets.size()-1).removeConstants();
 				}
 				// possible change to the completeness status
 				this->iscomplete = false;
@@ -1717,15 +1979,15 @@ int CAD<Number>::eliminate(std::size_t level, const BoundMap& bounds, bool bound
 
 template<typename Number>
 Interval<Number> CAD<Number>::getBounds(const typename CAD<Number>::sampleIterator& parent, const RealAlgebraicNumber<Number> sample) const {
-	if (this->sampleTree.begin(parent) == this->sampleTree.end(parent)) {
+	if (this->sampleTree->begin(parent) == this->sampleTree->end(parent)) {
 		// this tree level is empty
 		return Interval<Number>::unboundedExactInterval();
 	}
 	// search for the left and right boundaries in the first variable eliminated
-	auto node = std::lower_bound(this->sampleTree.begin(parent), this->sampleTree.end(parent), sample);
+	auto node = std::lower_bound(this->sampleTree->begin(parent), this->sampleTree->end(parent), sample);
 	auto neighbor = node;
 
-	if (node == this->sampleTree.end(parent)) {
+	if (node == this->sampleTree->end(parent)) {
 		// node is not in the tree level and all samples are smaller
 		// well-defined since level non-empty
 		neighbor--;
@@ -1735,11 +1997,11 @@ Interval<Number> CAD<Number>::getBounds(const typename CAD<Number>::sampleIterat
 			RealAlgebraicNumber<Number> nIR = static_cast<RealAlgebraicNumber<Number>>(*neighbor);
 			return Interval<Number>(nIR->upper(), BoundType::WEAK, nIR->upper()+1, BoundType::INFTY);
 		}
-	} else if (node == this->sampleTree.begin(parent)) {
+	} else if (node == this->sampleTree->begin(parent)) {
 		// node is the left-most (intermediate) sample
 		// well-defined since level non-empty
 		neighbor++;
-		if (neighbor == this->sampleTree.end(parent)) {
+		if (neighbor == this->sampleTree->end(parent)) {
 			return Interval<Number>::unboundedExactInterval();
 		} else if ((*neighbor)->isNumeric()) {
 			return Interval<Number>((*neighbor)->value()-1, BoundType::INFTY, (*neighbor)->value(), BoundType::STRICT);
@@ -1754,7 +2016,7 @@ Interval<Number> CAD<Number>::getBounds(const typename CAD<Number>::sampleIterat
 		// well-defined since level non-empty
 		neighbor++;
 
-		if (neighbor == this->sampleTree.end(parent)) {
+		if (neighbor == this->sampleTree->end(parent)) {
 			if ((*leftNeighbor)->isNumeric()) {
 				return Interval<Number>((*leftNeighbor)->value(), BoundType::STRICT, (*leftNeighbor)->value()+1, BoundType::INFTY);
 			} else {
@@ -1821,8 +2083,59 @@ void CAD<Number>::shrinkBounds(BoundMap& bounds, const RealAlgebraicPoint<Number
 	}
 }
 
+template<typename Number>
+boost::optional<bool> CAD<Number>::hasRootsInBox(const UPolynomial* p, const BoundMap& box, std::size_t level) const {
+	MultivariatePolynomial<Number> polynomial(*p);
+	std::map<Variable, Interval<double>> intervals;
+	std::vector<std::size_t> indices;
+	for (std::size_t i = level; i < mVariables.size(); i++) {
+		if (!p->has(mVariables[i])) continue;
+		indices.push_back(i);
+		auto bound = box.find(i);
+		if (bound == box.end()) {
+			intervals.emplace(mVariables[i], Interval<double>::unboundedInterval());
+		} else {
+			// the conversion rounds outwards
+			const auto& b = bound->second;
+			intervals.emplace(mVariables[i], Interval<double>(b.lower(), b.lowerBoundType(), b.upper(), b.upperBoundType()));
+		}
+	}
+	Interval<double> value = IntervalEvaluation::evaluate(polynomial, intervals);
+	if (!value.isEmpty()) {
+		bool positive = value.lowerBoundType() != BoundType::INFTY && value.lower() > 0;
+		bool negative = value.upperBoundType() != BoundType::INFTY && value.upper() < 0;
+		if (positive || negative) {
+			CARL_LOG_DEBUG("carl.cad", *p << " evaluates to " << value << " within " << intervals);
+			return false;
+		}
+	}
+	if (indices.size() != 1) return boost::none;
+	auto bound = box.find(indices.front());
+	if (bound == box.end() || bound->second.lowerBoundType() == BoundType::INFTY || bound->second.upperBoundType() == BoundType::INFTY) {
+		return boost::none;
+	}
+	const auto& b = bound->second;
+	UnivariatePolynomial<Number> up = polynomial.toUnivariatePolynomial();
+	// Sturm sequences require the bounds not to be roots
+	if (up.isRoot(b.lower())) {
+		if (b.lowerBoundType() == BoundType::WEAK) return true;
+		return boost::none;
+	}
+	if (up.isRoot(b.upper())) {
+		if (b.upperBoundType() == BoundType::WEAK) return true;
+		return boost::none;
+	}
+	int roots = up.countRealRoots(b);
+	CARL_LOG_DEBUG("carl.cad", *p << " has " << roots << " roots within " << b);
+	return roots > 0;
+}
+
 template<typename Number>
 bool CAD<Number>::vanishesInBox(const UPolynomial* p, const BoundMap& box, std::size_t level, bool recuperate) {
+	if (this->setting.prefilterByIntervals) {
+		auto roots = this->hasRootsInBox(p, box, level);
+		if (roots) return *roots;
+	}
 	cad::CADSettings boxSetting = cad::CADSettings::getSettings();
 	boxSetting.simplifyEliminationByBounds = false; // would cause recursion in vanishesInBox
 	boxSetting.earlyLiftingPruningByBounds = true; // important for efficiency
@@ -1872,7 +2185,7 @@ bool CAD<Number>::vanishesInBox(const UPolynomial* p, const BoundMap& box, std::
 				if (k >= cadbox.mVariables.size()) break;
 				// recuperate the elimination polynomials corresponding to i
 				// insert NOT avoiding single elimination (there might be elimination steps not done yet)
-				this->eliminationSets[i].insert(cadbox.eliminationSets[k], false);
+				this->eliminationSets.modify(i).insert(cadbox.eliminationSets[k], false);
 			}
 		}
 		CARL_LOG_INFO("carl.core", "Back from nested CAD " << &cadbox);
@@ -72,9 +72,10 @@ public:
 		if (r.dim() == 0) return true;
 		std::vector<Variable> vars(variables.begin() + (long)(variables.size() - r.dim()), variables.end());
 		std::size_t dim = vars.size()-1;
+		RealAlgebraicNumberEvaluation::BatchEvaluation<Number> evaluation(r, vars);
 		for (const auto& cid: mVariableLookup[dim]) {
 			const auto& c = mConstraints[cid];
-			if (!c.satisfiedBy(r, vars)) return false;
+			if (!c.satisfiedBy(evaluation)) return false;
 		}
 		return true;
 	}
@@ -85,11 +86,12 @@ public:
 		std::vector<Variable> vars(variables.begin() + (long)(variables.size() - r.dim()), variables.end());
 		std::size_t dim = vars.size()-1;
 		std::size_t sampleID = conflictGraph.newSample();
+		RealAlgebraicNumberEvaluation::BatchEvaluation<Number> evaluation(r, vars);
 		for (const auto& cid: mVariableLookup[dim]) {
 			const auto& c = mConstraints[cid];
 			std::size_t constraintID = conflictGraph.getConstraint(c);
 			CARL_LOG_DEBUG("carl.cad", "Checking if " << c << " is satisfied by " << r << " over " << vars);
-			bool sat = c.satisfiedBy(r, vars);
+			bool sat = c.satisfiedBy(evaluation);
 			conflictGraph.set(constraintID, sampleID, !sat);
 			satisfied = satisfied && sat;
 		}
@@ -97,18 +99,20 @@ public:
 	}
 	
 	bool satisfiedBy(RealAlgebraicPoint<Number>& r, const std::vector<Variable>& variables) const {
+		RealAlgebraicNumberEvaluation::BatchEvaluation<Number> evaluation(r, variables);
 		for (const auto& c: mConstraints) {
-			if (!c.satisfiedBy(r, variables)) return false;
+			if (!c.satisfiedBy(evaluation)) return false;
 		}
 		return true;
 	}
 	bool satisfiedBy(RealAlgebraicPoint<Number>& r, const std::vector<Variable>& variables, cad::ConflictGraph<Number>& conflictGraph) const {
 		bool satisfied = true;
 		std::size_t sampleID = conflictGraph.newSample();
+		RealAlgebraicNumberEvaluation::BatchEvaluation<Number> evaluation(r, variables);
 		for (const auto& c: mConstraints) {
 			std::size_t constraintID = conflictGraph.getConstraint(c);
 			CARL_LOG_DEBUG("carl.cad", "Checking if " << c << " is satisfied by " << r << " over " << variables);
-			bool sat = c.satisfiedBy(r, variables);
+			bool sat = c.satisfiedBy(evaluation);
 			conflictGraph.set(constraintID, sampleID, !sat);
 			satisfied = satisfied && sat;
 		}
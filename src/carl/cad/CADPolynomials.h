@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <list>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "CADTypes.h"
 
@@ -37,6 +39,15 @@ private:
 	 */
 	std::vector<const UPolynomial*> scheduled;
 public:
+	/**
+	 * The polynomials, the map of input polynomials and the scheduled polynomials.
+	 * The state does not own any polynomial, hence it stays valid as long as the CADPolynomials object exists.
+	 */
+	struct State {
+		std::list<const UPolynomial*> polynomials;
+		std::unordered_map<const MPolynomial, const UPolynomial*, std::hash<MPolynomial>> map;
+		std::vector<const UPolynomial*> scheduled;
+	};
 	CADPolynomials(): cad::PolynomialOwner<Number>() {}
 	CADPolynomials(cad::PolynomialOwner<Number>* parent): cad::PolynomialOwner<Number>(parent) {}
 	
@@ -96,6 +107,15 @@ public:
 	void clear() {
 		polynomials.clear();
 	}
+	
+	State getState() const {
+		return State({polynomials, map, scheduled});
+	}
+	void setState(State&& state) {
+		polynomials = std::move(state.polynomials);
+		map = std::move(state.map);
+		scheduled = std::move(state.scheduled);
+	}
 };
 
 template<typename Number>
@@ -132,6 +132,8 @@ public:
 	bool earlyLiftingPruningByBounds;
 	/// given bounds to the check method, these bounds are used to cancel out elimination polynomials
 	bool simplifyEliminationByBounds;
+	/// if simplifyEliminationByBounds is set, elimination polynomials are first evaluated by interval arithmetic and univariate ones are checked by root counting, before a nested CAD decides whether they vanish within the bounds
+	bool prefilterByIntervals;
 	/// given bounds to the check method, the bounds are widened after determining unsatisfiability by check, or shrunk after determining satisfiability by check
 	bool improveBounds;
 	bool exploreInteger;
@@ -142,6 +144,14 @@ public:
 	PolynomialComparisonOrder order;
 	/// standard strategy to be used for real root isolation
 	rootfinder::SplittingStrategy splittingStrategy;
+	/// flag indicating that projection factors are looked up in and stored to the process-wide ProjectionCache
+	bool useProjectionCache;
+	/// flag indicating that the projection is restricted to the equational constraints of a check, see EquationalRestriction; these are then required in every conflict, see ConflictGraph
+	bool equationalProjection;
+	/// number of threads computing the projection of a whole level at once, 0 projects one polynomial at a time (only effective if carl is built with THREAD_SAFE)
+	std::size_t projectionThreads;
+	/// number of threads checking the samples of the last lifting level, 0 checks one sample at a time (only effective if carl is built with THREAD_SAFE)
+	std::size_t liftingThreads;
 
 	/**
 	 * Generate a CADSettings instance of the respective preset type.
@@ -240,8 +250,18 @@ public:
 			settingStrs.push_back( "Given bounds to the check method, these bounds are used to reduce the sample sets during the lifting and to reduce the elimination polynomials if simplifyEliminationByBounds is set." );
 		if (settings.simplifyEliminationByBounds)
 			settingStrs.push_back( "Given bounds to the check method, these bounds are used to cancel out elimination polynomials." );
+		if (settings.prefilterByIntervals)
+			settingStrs.push_back( "Elimination polynomials are canceled out by interval arithmetic and root counting before using a nested CAD." );
 		if (settings.improveBounds)
 			settingStrs.push_back( "Given bounds to the check method, the bounds are widened after determining unsatisfiability by check, or shrunk after determining satisfiability by check." );
+		if (settings.equationalProjection)
+			settingStrs.push_back( "Restrict the projection to the equational constraints." );
+		if (settings.useProjectionCache)
+			settingStrs.push_back( "Reuse projection factors of earlier CAD objects from a process-wide cache." );
+		if (settings.projectionThreads > 0)
+			settingStrs.push_back( "Project whole levels at once using " + std::to_string(settings.projectionThreads) + " threads." );
+		if (settings.liftingThreads > 0)
+			settingStrs.push_back( "Check the samples of the last lifting level at once using " + std::to_string(settings.liftingThreads) + " threads." );
 		std::string orderStr = "Polynomial order: ";
 
 		if (settings.order == PolynomialComparisonOrder::CauchyBound)
@@ -279,13 +299,18 @@ private:
 		preSolveByBounds( false ),
 		earlyLiftingPruningByBounds( true ),
 		simplifyEliminationByBounds( true ),
+		prefilterByIntervals( true ),
 		improveBounds( true ),
 		exploreInteger(false),
 		splitInteger(true),
 		ignoreRoots(false),
 		integerHandling(IntegerHandling::SPLIT_ASSIGNMENT),
 		order(PolynomialComparisonOrder::Default),
-		splittingStrategy(rootfinder::SplittingStrategy::DEFAULT)
+		splittingStrategy(rootfinder::SplittingStrategy::DEFAULT),
+		useProjectionCache(false),
+		equationalProjection(false),
+		projectionThreads(0),
+		liftingThreads(0)
 	{}
 
 public:
@@ -305,13 +330,18 @@ public:
 		preSolveByBounds( s.preSolveByBounds ),
 		earlyLiftingPruningByBounds( s.earlyLiftingPruningByBounds ),
 		simplifyEliminationByBounds( s.simplifyEliminationByBounds ),
+		prefilterByIntervals( s.prefilterByIntervals ),
 		improveBounds( s.improveBounds ),
 		exploreInteger(s.exploreInteger),
 		splitInteger(s.splitInteger),
 		ignoreRoots(s.ignoreRoots),
 		integerHandling(s.integerHandling),
 		order(PolynomialComparisonOrder::Default),
-		splittingStrategy(rootfinder::SplittingStrategy::DEFAULT)
+		splittingStrategy(rootfinder::SplittingStrategy::DEFAULT),
+		useProjectionCache(s.useProjectionCache),
+		equationalProjection(s.equationalProjection),
+		projectionThreads(s.projectionThreads),
+		liftingThreads(s.liftingThreads)
 	{}
 };
 
@@ -8,13 +8,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <bitset>
 #include <iostream>
 #include <map>
+#include <utility>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "Constraint.h"
+#include "../util/Covering.h"
 
 namespace carl {
 namespace cad {
@@ -39,18 +43,67 @@ enum ConflictType
  * corresponding sample point. This information is fixed, however, we can invert the reading behavior by using invert().
  *
  * There is no explicit storage of sample point information. Thus, the graph cannot be used for memoaization of satisfiability results.
- * 
+ *
+ * Some constraints may be marked as required, they are part of every infeasible subset derived from the graph.
+ * This is the case for the equational constraints if the projection was restricted to them, see EquationalRestriction.
+ * computeCover() adds them automatically, callers that build a cover themselves must add them as well.
  */
 
 template<typename Number>
 class ConflictGraph {
 private:
-	/// Maps constraints to IDs used in mData
+	/// Type of a single block of the matrix.
+	typedef boost::dynamic_bitset<>::block_type Block;
+	/// Number of bits per block.
+	static constexpr std::size_t bitsPerBlock = boost::dynamic_bitset<>::bits_per_block;
+	/// Maps constraints to IDs used in mMatrix
 	std::map<Constraint<Number>, std::size_t> mConstraints;
-	/// Stores for each constraints, which sample points violate the constraint
-	std::vector<boost::dynamic_bitset<>> mData;
+	/// Maps IDs to the entries of mConstraints
+	std::vector<typename std::map<Constraint<Number>, std::size_t>::iterator> mIDs;
+	/// Stores for each constraint ID whether the constraint is required
+	std::vector<bool> mRequired;
+	/**
+	 * Stores for each constraint, which sample points violate the constraint.
+	 * The rows are stored consecutively, each consisting of mStride blocks, such that operations on a row work on whole blocks.
+	 */
+	std::vector<Block> mMatrix;
+	/// Number of blocks per row
+	std::size_t mStride = 0;
 	/// Stores the number of samples that have been registered
 	std::size_t mSampleCount = 0;
+
+	static std::size_t popcount(Block b) {
+		return std::bitset<bitsPerBlock>(b).count();
+	}
+	Block* row(std::size_t id) {
+		return mMatrix.data() + id * mStride;
+	}
+	const Block* row(std::size_t id) const {
+		return mMatrix.data() + id * mStride;
+	}
+	/**
+	 * Makes sure that each row can store the given number of samples.
+	 * The stride grows geometrically, hence the rows are rarely moved.
+	 */
+	void reserveSamples(std::size_t samples) {
+		std::size_t stride = (samples + bitsPerBlock - 1) / bitsPerBlock;
+		if (stride <= mStride) return;
+		stride = std::max(stride, 2 * mStride);
+		std::vector<Block> matrix(mIDs.size() * stride, 0);
+		for (std::size_t id = 0; id < mIDs.size(); id++) {
+			std::copy(row(id), row(id) + mStride, matrix.begin() + (long)(id * stride));
+		}
+		mMatrix.swap(matrix);
+		mStride = stride;
+	}
+	/**
+	 * Returns the row of the given constraint as a bitset with one bit per sample.
+	 */
+	boost::dynamic_bitset<> toBitset(std::size_t id) const {
+		boost::dynamic_bitset<> res(row(id), row(id) + mStride);
+		res.resize(mSampleCount);
+		return res;
+	}
 public:
 
 	/**
@@ -63,11 +116,39 @@ public:
 	 */
 	ConflictGraph(const ConflictGraph& g):
 		mConstraints(g.mConstraints),
-		mData(g.mData),
+		mRequired(g.mRequired),
+		mMatrix(g.mMatrix),
+		mStride(g.mStride),
 		mSampleCount(g.mSampleCount)
 	{
+		mIDs.resize(mConstraints.size());
+		for (auto it = mConstraints.begin(); it != mConstraints.end(); it++) {
+			mIDs[it->second] = it;
+		}
 		CARL_LOG_FUNC("carl.cad.cg", "Copied " << *this);
 	}
+	/**
+	 * Move constructor.
+	 */
+	ConflictGraph(ConflictGraph&& g) noexcept {
+		swap(g);
+	}
+	/**
+	 * Assignment operator, for both copy and move assignment.
+	 * The iterators in mIDs are rebuilt by the copy constructor, swapping keeps them valid.
+	 */
+	ConflictGraph& operator=(ConflictGraph g) noexcept {
+		swap(g);
+		return *this;
+	}
+	void swap(ConflictGraph& g) noexcept {
+		std::swap(mConstraints, g.mConstraints);
+		std::swap(mIDs, g.mIDs);
+		std::swap(mRequired, g.mRequired);
+		std::swap(mMatrix, g.mMatrix);
+		std::swap(mStride, g.mStride);
+		std::swap(mSampleCount, g.mSampleCount);
+	}
 	/**
 	 * Returns the constraint ID for the given constraint.
 	 */
@@ -75,6 +156,9 @@ public:
 		auto it = mConstraints.find(c);
 		if (it == mConstraints.end()) {
 			it = mConstraints.insert(std::make_pair(c, mConstraints.size())).first;
+			mIDs.push_back(it);
+			mRequired.push_back(false);
+			mMatrix.resize(mIDs.size() * mStride, 0);
 		}
 		CARL_LOG_TRACE("carl.cad.cg", c << " -> " << it->second);
 		return it->second;
@@ -83,37 +167,77 @@ public:
 	 * Returns the constraint for the given constraint ID.
 	 */
 	const cad::Constraint<Number>& getConstraint(std::size_t id) const {
-		for (const auto& it: mConstraints) {
-			if (it.second == id) return it.first;
-		}
-		assert(false);
-		return mConstraints.begin()->first;
+		assert(id < mIDs.size());
+		return mIDs[id]->first;
+	}
+	/**
+	 * Marks the given constraint as required, i.e. it is part of every infeasible subset.
+	 */
+	void require(std::size_t id) {
+		assert(id < mIDs.size());
+		mRequired[id] = true;
+	}
+	/**
+	 * Checks whether the given constraint is required.
+	 */
+	bool isRequired(std::size_t id) const {
+		assert(id < mIDs.size());
+		return mRequired[id];
+	}
+	/**
+	 * Returns the number of constraints.
+	 */
+	std::size_t constraintCount() const {
+		return mIDs.size();
+	}
+	/**
+	 * Returns the number of samples that have been registered.
+	 */
+	std::size_t sampleCount() const {
+		return mSampleCount;
 	}
 	/**
 	 * Registers a new sample point and returns its ID.
 	 */
 	std::size_t newSample() {
+		reserveSamples(mSampleCount + 1);
 		return mSampleCount++;
 	}
 	void set(std::size_t constraint, std::size_t sample, bool value) {
-		if (constraint >= mData.size()) {
-			mData.resize(constraint+1);
-		}
-		if (sample >= mData[constraint].size()) {
-			mData[constraint].resize(sample+1);
-		}
+		assert(constraint < mIDs.size());
+		if (sample >= mSampleCount) mSampleCount = sample + 1;
+		reserveSamples(mSampleCount);
 		CARL_LOG_TRACE("carl.cad.cg", "Set " << constraint << " / " << sample << " to " << value);
-		mData[constraint][sample] = value;
+		Block mask = Block(1) << (sample % bitsPerBlock);
+		Block& b = row(constraint)[sample / bitsPerBlock];
+		if (value) b |= mask;
+		else b &= Block(~mask);
+	}
+	/**
+	 * Checks whether the given sample violates the given constraint.
+	 */
+	bool get(std::size_t constraint, std::size_t sample) const {
+		assert(constraint < mIDs.size());
+		if (sample >= mSampleCount) return false;
+		return (row(constraint)[sample / bitsPerBlock] >> (sample % bitsPerBlock)) & 1;
+	}
+	/**
+	 * Returns the number of samples violating the given constraint.
+	 */
+	std::size_t degree(std::size_t id) const {
+		std::size_t res = 0;
+		for (const Block* b = row(id); b != row(id) + mStride; b++) res += popcount(*b);
+		return res;
 	}
 	/**
 	 * Retrieves the constraint that covers the most samples.
 	 */
 	std::size_t getMaxDegreeConstraint() const {
-		assert(mData.size() > 0);
+		assert(mIDs.size() > 0);
 		std::size_t maxID = 0;
-		std::size_t maxDegree = mData[0].count();
-		for (std::size_t id = 1; id < mData.size(); id++) {
-			std::size_t deg = mData[id].count();
+		std::size_t maxDegree = degree(0);
+		for (std::size_t id = 1; id < mIDs.size(); id++) {
+			std::size_t deg = degree(id);
 			if (deg > maxDegree) {
 				maxDegree = deg;
 				maxID = id;
@@ -125,32 +249,19 @@ public:
 	 * Removes the given constraint and disable all sample points covered by this constraint.
 	 */
 	void selectConstraint(std::size_t id) {
-		assert(mData.size() > id);
-		// Store all samples point IDs
-		std::vector<std::size_t> queue;
-		queue.reserve(mData[id].count());
-		for (std::size_t i = mData[id].find_first(); i != boost::dynamic_bitset<>::npos; i = mData[id].find_next(i)) {
-			assert(mData[id][i]);
-			queue.push_back(i);
-		}
-		// Remove this constraint
-		mData[id].clear();
-		// Disable sample points for other constraints
-		for (auto& d: mData) {
-			for (std::size_t i: queue) {
-				if (i >= d.size()) continue;
-				d[i] = false;
-			}
+		assert(mIDs.size() > id);
+		std::vector<Block> mask(row(id), row(id) + mStride);
+		// Disable sample points for all constraints, including this one
+		for (std::size_t r = 0; r < mIDs.size(); r++) {
+			Block* b = row(r);
+			for (std::size_t i = 0; i < mStride; i++) b[i] &= Block(~mask[i]);
 		}
 	}
 	/**
 	 * Checks if there are samples still uncovered.
 	 */
 	bool hasRemainingSamples() const {
-		for (const auto& d: mData) {
-			if (!d.none()) return true;
-		}
-		return false;
+		return std::any_of(mMatrix.begin(), mMatrix.end(), [](Block b){ return b != 0; });
 	}
 
 	
@@ -158,7 +269,7 @@ public:
 	 * Remove the specified constraint vertex by removing the respective index.
 	 * All other constraint indices are decreased by one.
 	 * @param i constraint vertex index
-	 * @complexity constant
+	 * @complexity linear in the size of the matrix
 	 */
 	void removeConstraint(const cad::Constraint<Number>& c) {
 		auto it = mConstraints.find(c);
@@ -166,24 +277,57 @@ public:
 		CARL_LOG_FUNC("carl.cad.cg", c);
 		std::size_t cid = it->second;
 		mConstraints.erase(it);
-		assert(mData.size() > cid);
-		mData.erase(mData.begin() + (long)cid);
+		assert(mIDs.size() > cid);
+		mIDs.erase(mIDs.begin() + (long)cid);
+		mRequired.erase(mRequired.begin() + (long)cid);
+		mMatrix.erase(mMatrix.begin() + (long)(cid * mStride), mMatrix.begin() + (long)((cid + 1) * mStride));
 		
 		for (auto& it: mConstraints) {
 			if (it.second > cid) it.second--;
 		}
 	}
+
+	/**
+	 * Computes a set of constraints that together violate all samples that are violated by any constraint.
+	 * If all samples are violated, the constraints form an infeasible subset.
+	 * The required constraints are always part of the cover, the other constraints only cover the samples not violated by them.
+	 * By default, the cover is computed greedily and is irredundant, i.e. no constraint can be removed from it.
+	 * The exact mode computes a cover of minimum size and is meant for small graphs, as it falls back to the greedy cover after the given number of search nodes.
+	 * @param exact Compute a cover of minimum size.
+	 * @param maxNodes Maximum number of search nodes for the exact mode.
+	 * @return Constraint IDs of the cover.
+	 */
+	std::vector<std::size_t> computeCover(bool exact = false, std::size_t maxNodes = 10000) const {
+		std::vector<std::size_t> res;
+		boost::dynamic_bitset<> required(mSampleCount);
+		for (std::size_t id = 0; id < mIDs.size(); id++) {
+			if (!mRequired[id]) continue;
+			res.push_back(id);
+			required |= toBitset(id);
+		}
+		Covering<std::size_t> covering(mSampleCount);
+		for (std::size_t id = 0; id < mIDs.size(); id++) {
+			if (!mRequired[id]) covering.add(id, Bitset(toBitset(id) - required, false));
+		}
+		if (exact) {
+			bool minimal = covering.buildMinimumConflictingCore(res, maxNodes);
+			CARL_LOG_DEBUG("carl.cad.cg", "Cover of size " << res.size() << (minimal ? " is minimal" : " may not be minimal"));
+		} else {
+			covering.buildConflictingCore(res);
+		}
+		std::sort(res.begin(), res.end());
+		return res;
+	}
 	
 	template<typename T>
 	friend std::ostream& operator<<(std::ostream& os, const ConflictGraph<T>& cg) {
-		os << "Print CG with " << cg.mData.size() << " constraints" << std::endl;
-		for (std::size_t i = 0; i < cg.mData.size(); i++) {
-			os << cg.getConstraint(i) << ":" << std::endl;
-			os << "\t" << cg.mData[i] << std::endl;
+		os << "Print CG with " << cg.mIDs.size() << " constraints" << std::endl;
+		for (std::size_t i = 0; i < cg.mIDs.size(); i++) {
+			os << cg.getConstraint(i) << (cg.isRequired(i) ? " (required)" : "") << ":" << std::endl;
+			os << "\t" << cg.toBitset(i) << std::endl;
 		}
 		return os;
 	}
 };
-
 }
 }
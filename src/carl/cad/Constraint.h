@@ -111,12 +111,28 @@ public:
 	bool satisfiedBy(const RealAlgebraicPoint<Number>& r, const std::vector<Variable>& _variables) const {
 		assert(_variables.size() == r.dim());
 		
-		auto res = RealAlgebraicNumberEvaluation::evaluate(this->polynomial, r, _variables);
-		CARL_LOG_DEBUG("carl.cad.constraint", *this << " evaluates to " << res << " on " << r);
+		Sign s = RealAlgebraicNumberEvaluation::evaluateSign(this->polynomial, r, _variables);
+		CARL_LOG_DEBUG("carl.cad.constraint", *this << " has sign " << s << " on " << r);
 		if (this->negated) {
-			return res.sgn() != this->sign;
+			return s != this->sign;
 		} else {
-			return res.sgn() == this->sign;
+			return s == this->sign;
+		}
+	}
+
+	/**
+	 * Test if the point of the given batch evaluation satisfies this constraint.
+	 * Using the same batch evaluation for all constraints shares the work that only depends on the point.
+	 * @param evaluation evaluation at the test point
+	 * @return false if the constraint was not satisfied by the point, true otherwise.
+	 */
+	bool satisfiedBy(RealAlgebraicNumberEvaluation::BatchEvaluation<Number>& evaluation) const {
+		Sign s = evaluation.sgn(this->polynomial);
+		CARL_LOG_DEBUG("carl.cad.constraint", *this << " has sign " << s);
+		if (this->negated) {
+			return s != this->sign;
+		} else {
+			return s == this->sign;
 		}
 	}
 
@@ -13,14 +13,17 @@
 #include <utility>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "../util/pointerOperations.h"
+#include "../util/ThreadPool.h"
 #include "../core/UnivariatePolynomial.h"
 #include "../core/logging.h"
 
 #include "CADTypes.h"
 #include "CADSettings.h"
 #include "Projection.h"
+#include "ProjectionCache.h"
 
 namespace carl {
 namespace cad {
@@ -146,6 +149,75 @@ private:
 		projection(projectionType, std::forward<Args>(args)...);
 	}
 
+	/**
+	 * Equations of this level and the restriction of the projection imposed by them.
+	 */
+	PolynomialSet mEquations;
+	EquationalRestriction mRestriction = EquationalRestriction::None;
+	/**
+	 * Polynomials whose single or paired projection was skipped due to the equations.
+	 * They are queued again as soon as the equations change.
+	 */
+	std::list<const UPolynomial*> mDeferredSingle;
+	std::list<const UPolynomial*> mDeferredPaired;
+
+	/// Checks whether the single projection of p is needed, see ProjectionOperator::needsSingle().
+	bool needsSingle(const UPolynomial* p) const {
+		return ProjectionOperator<const UPolynomial*>::needsSingle(mRestriction, !mEquations.empty(), isEquation(p));
+	}
+	/// Checks whether p needs to be paired with all polynomials or only with the equations, see ProjectionOperator::needsPair().
+	bool needsAllPairs(const UPolynomial* p) const {
+		return ProjectionOperator<const UPolynomial*>::needsPair(mRestriction, !mEquations.empty(), isEquation(p));
+	}
+	/// Marks the polynomials in this set that equal one of the given ones as equations, if they are well oriented, see ProjectionOperator::isWellOriented().
+	void addEquations(const std::vector<UPolynomial>& equations);
+
+	/**
+	 * Collects the polynomials produced by the projection operator.
+	 */
+	struct ProjectionCollector {
+		std::vector<UPolynomial> polynomials;
+		void insert(const UPolynomial& p, const std::list<const UPolynomial*>&, bool) {
+			polynomials.push_back(p);
+		}
+	};
+
+	/**
+	 * Splits a polynomial into its irreducible factors if it has only numeric coefficients.
+	 * Other polynomials are returned unchanged, as there is no multivariate factorization available.
+	 * @param p Polynomial.
+	 * @return Non-constant factors of p.
+	 */
+	static std::vector<UPolynomial> factors(const UPolynomial& p);
+
+	/**
+	 * Computes the projection of p, or of the pair p and q if q is not nullptr, and simplifies the result:
+	 * it is factorized if setting.simplifyByFactorization is set, made primitive and made square-free, numbers are discarded.
+	 * If setting.useProjectionCache is set, the result is looked up in the ProjectionCache.
+	 *
+	 * This method does not modify any shared state except for the ProjectionCache, hence it can be called concurrently.
+	 * @param p Polynomial.
+	 * @param q Second polynomial or nullptr.
+	 * @param variable the main variable of the result
+	 * @param setting
+	 * @return the simplified projection factors
+	 */
+	std::vector<UPolynomial> projectionFactors(const UPolynomial* p, const UPolynomial* q, Variable::Arg variable, const CADSettings& setting) const;
+
+	/**
+	 * Inserts the projectionFactors() of p, or of the pair p and q if q is not nullptr, into destination with the parents p and q.
+	 */
+	void projectInto(const UPolynomial* p, const UPolynomial* q, Variable::Arg variable, const CADSettings& setting, EliminationSet<Coefficient>& destination, std::vector<UPolynomial>& equations) const {
+		std::list<const UPolynomial*> parents({p});
+		if (q != nullptr) parents.push_back(q);
+		// the resultant of two equations is an equation of the next level
+		bool propagate = q != nullptr && isEquation(p) && isEquation(q);
+		for (const auto& f: projectionFactors(p, q, variable, setting)) {
+			destination.insert(f, parents);
+			if (propagate) equations.push_back(f);
+		}
+	}
+
 	/**
 	 * Elimination queue containing all polynomials not yet considered for non-paired elimination.
 	 * Access permits reset of the queue, automatic update after insertion of new elements and a pop method.
@@ -365,12 +437,38 @@ public:
 	 * @param p
 	 * @return set entry for the given polynomial p if exists, otherwise nullptr
 	 */
-	const UPolynomial* find(const UPolynomial* p);
+	const UPolynomial* find(const UPolynomial* p) const;
 
 	/**
 	 * Remove every data from this set.
 	 */
 	void clear();
+
+	/**
+	 * Sets the equations of this level and the restriction of the projection they impose.
+	 * The single and paired projections that were skipped due to the previous equations are queued again.
+	 * @param equations polynomials of this set that are equations, others are ignored
+	 * @param restriction restriction of the projection, in effect only if there are equations
+	 * @return true if projections were queued again
+	 */
+	bool setEquations(const std::list<const UPolynomial*>& equations, EquationalRestriction restriction);
+
+	/**
+	 * Checks if p is an equation of this level.
+	 * @param p
+	 * @return true if p is an equation.
+	 */
+	bool isEquation(const UPolynomial* p) const {
+		return this->mEquations.count(p) > 0;
+	}
+
+	const PolynomialSet& getEquations() const {
+		return this->mEquations;
+	}
+
+	EquationalRestriction getRestriction() const {
+		return this->mRestriction;
+	}
 	
 	/////////////////////////////////
 	// LIFTING POSITION MANAGEMENT //
@@ -384,7 +482,7 @@ public:
 	 * @return the smallest (w.r.t. set order) elimination polynomial not yet considered for lifting
 	 * @complexity constant
 	 */
-	const UPolynomial* nextLiftingPosition() {
+	const UPolynomial* nextLiftingPosition() const {
 		return this->mLiftingQueue.front();
 	}
 
@@ -440,12 +538,20 @@ public:
 	void setLiftingPositionsReset() {
 		this->mLiftingQueueReset = this->mLiftingQueue;
 	}
+
+	/**
+	 * Checks whether the reset state for lifting positions equals the current lifting positions queue, i.e. whether setLiftingPositionsReset() has no effect.
+	 * @return true if the reset state equals the current lifting positions queue.
+	 */
+	bool isLiftingPositionsReset() const {
+		return this->mLiftingQueueReset == this->mLiftingQueue;
+	}
 	
 	/////////////////////////////////////
 	// ELIMINATION POSITION MANAGEMENT //
 	/////////////////////////////////////
 	
-	const UPolynomial* nextSingleEliminationPosition();
+	const UPolynomial* nextSingleEliminationPosition() const;
 
 	/**
 	 * Return the next position in the single-elimination queue and remove it from the queue.
@@ -529,6 +635,28 @@ public:
 			bool synchronous = false
 			);
 
+	/**
+	 * Does the elimination of all polynomials in both elimination queues and stores the resulting polynomials into the specified
+	 * destination set, just like calling eliminateNextInto() until both queues are empty.
+	 *
+	 * The projections of the single polynomials and of the pairs are independent of each other, hence they are computed by the given thread pool.
+	 * Every projection is simplified by the thread that computed it, see projectionFactors().
+	 * The results are then inserted into destination in a fixed order by the calling thread, such that the result and the parents in destination do not depend on the scheduling.
+	 *
+	 * Constant polynomials are moved to destination before. Every pair of polynomials is projected only once.
+	 * @param destination
+	 * @param variable the main variable of the destination elimination set
+	 * @param setting special settings for simplifications etc.
+	 * @param pool threads computing the projections
+	 * @return list of polynomials added to destination
+	 */
+	std::list<const UPolynomial*> eliminateAllInto(
+			EliminationSet<Coefficient>& destination,
+			Variable::Arg variable,
+			const CADSettings& setting,
+			ThreadPool& pool
+			);
+
 
 	
 	////////////////
@@ -567,8 +695,8 @@ public:
 	void makePrimitive();
 	
 	/**
-	 * Replaces all polynomials by their factors (currently uses GiNaC::factor).
-	 * In order to work properly, GiNaC::factor should receive integer polynomials. Thus, before the factorization, all polynomials are transformed to integral polynomials.
+	 * Replaces all polynomials by their factors.
+	 * Only polynomials with numeric coefficients are factorized, see factors().
 	 * @complexity linear in the number of elements stored in the set
 	 */
 	void factorize();
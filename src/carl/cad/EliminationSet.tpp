@@ -207,6 +207,9 @@ size_t EliminationSet<Coefficient>::erase(const UPolynomial* p) {
 	queuePosition = std::lower_bound(mPairedEliminationQueue.begin(), mPairedEliminationQueue.end(), p, this->eliminationOrder);
 	if( queuePosition != mPairedEliminationQueue.end() && *queuePosition == p )
 		mPairedEliminationQueue.erase(queuePosition);
+	this->mDeferredSingle.remove(p);
+	this->mDeferredPaired.remove(p);
+	this->mEquations.erase(p);
 	// remove from main structure
 	return this->polynomials.erase(p);
 }
@@ -257,7 +260,7 @@ std::forward_list<const typename EliminationSet<Coefficient>::UPolynomial*> Elim
 }
 
 template<typename Coefficient>
-const typename EliminationSet<Coefficient>::UPolynomial* EliminationSet<Coefficient>::find(const UPolynomial* p) {
+const typename EliminationSet<Coefficient>::UPolynomial* EliminationSet<Coefficient>::find(const UPolynomial* p) const {
 	auto position = this->polynomials.find(p);
 	return (position == this->polynomials.end() ? nullptr : *position);
 }
@@ -271,6 +274,42 @@ void EliminationSet<Coefficient>::clear() {
 	this->mPairedEliminationQueue.clear();
 	this->childrenPerParent.clear();
 	this->parentsPerChild.clear();
+	this->mEquations.clear();
+	this->mDeferredSingle.clear();
+	this->mDeferredPaired.clear();
+}
+
+template<typename Coefficient>
+bool EliminationSet<Coefficient>::setEquations(const std::list<const UPolynomial*>& equations, EquationalRestriction restriction) {
+	bool requeued = !this->mDeferredSingle.empty() || !this->mDeferredPaired.empty();
+	// the skipped projections are needed for other equations
+	auto requeue = [this](std::list<const UPolynomial*>& deferred, std::list<const UPolynomial*>& queue) {
+		for (auto p: deferred) {
+			if (std::find(queue.begin(), queue.end(), p) != queue.end()) continue;
+			queue.insert(std::lower_bound(queue.begin(), queue.end(), p, this->eliminationOrder), p);
+		}
+		deferred.clear();
+	};
+	requeue(this->mDeferredSingle, this->mSingleEliminationQueue);
+	requeue(this->mDeferredPaired, this->mPairedEliminationQueue);
+	this->mEquations.clear();
+	for (auto e: equations) {
+		auto it = this->polynomials.find(e);
+		if (it != this->polynomials.end()) this->mEquations.insert(*it);
+	}
+	this->mRestriction = restriction;
+	CARL_LOG_DEBUG("carl.cad.elimination", "Equations: " << this->mEquations.size() << ", requeued: " << requeued);
+	return requeued;
+}
+
+template<typename Coefficient>
+void EliminationSet<Coefficient>::addEquations(const std::vector<UPolynomial>& equations) {
+	ProjectionOperator<const UPolynomial*> projection;
+	for (const auto& e: equations) {
+		if (!projection.isWellOriented(e)) continue;
+		auto it = this->polynomials.find(&e);
+		if (it != this->polynomials.end()) this->mEquations.insert(*it);
+	}
 }
 
 template<typename Coefficient>
@@ -280,7 +319,7 @@ void EliminationSet<Coefficient>::resetLiftingPositionsFully() {
 }
 
 template<typename Coefficient>
-const typename EliminationSet<Coefficient>::UPolynomial* EliminationSet<Coefficient>::nextSingleEliminationPosition() {
+const typename EliminationSet<Coefficient>::UPolynomial* EliminationSet<Coefficient>::nextSingleEliminationPosition() const {
 	return mSingleEliminationQueue.front();
 }
 
@@ -325,15 +364,19 @@ std::list<const typename EliminationSet<Coefficient>::UPolynomial*> EliminationS
 	}
 
 	EliminationSet<Coefficient> newEliminationPolynomials(this->polynomialOwner, this->liftingOrder, this->eliminationOrder);
+	std::vector<UPolynomial> equations;
 
 	// PAIRED elimination with the new polynomials: (1) together with the existing ones (2) among themselves
 
+	// in the presence of equations, p is possibly paired with the equations only
+	bool allPairs = this->needsAllPairs(p);
 	if( setting.equationsOnly ) {
 		// (1) elimination with existing polynomials
 		for (auto pol_it1: this->polynomials) {
 			assert(p->mainVar() == pol_it1->mainVar());
+			if (!allPairs && !this->isEquation(pol_it1)) continue;
 			//eliminationEq( p, pol_it1, variable, newEliminationPolynomials, false );
-			project(p, pol_it1, variable, newEliminationPolynomials);
+			projectInto(p, pol_it1, variable, setting, newEliminationPolynomials, equations);
 		}
 		// (2) elimination with polynomial itself @todo: proof that we do not need that
 		// eliminationEq( p, p, variable, newEliminationPolynomials, setting );
@@ -341,34 +384,36 @@ std::list<const typename EliminationSet<Coefficient>::UPolynomial*> EliminationS
 		// (1) elimination with existing polynomials
 		for (auto pol_it1: this->polynomials) {
 			assert(p->mainVar() == pol_it1->mainVar());
+			if (!allPairs && !this->isEquation(pol_it1)) continue;
 			//elimination( p, pol_it1, variable, newEliminationPolynomials, false );
-			project(p, pol_it1, variable, newEliminationPolynomials);
+			projectInto(p, pol_it1, variable, setting, newEliminationPolynomials, equations);
 		}
 		// (2) elimination with polynomial itself @todo: proof that we do not need that
 		// elimination( p, p, variable, newEliminationPolynomials, setting );
 
 	}
+	if (!allPairs) this->mDeferredPaired.push_back(p);
 
 	// !PAIRED (single) elimination
 
-	if( setting.equationsOnly ) {
+	if (!this->needsSingle(p)) {
+		this->mDeferredSingle.push_back(p);
+	} else if( setting.equationsOnly ) {
 		//eliminationEq( p, variable, newEliminationPolynomials, false );
-		project(p, variable, newEliminationPolynomials);
+		projectInto(p, nullptr, variable, setting, newEliminationPolynomials, equations);
 	} else {
 		//elimination( p, variable, newEliminationPolynomials, false );
-		project(p, variable, newEliminationPolynomials);
+		projectInto(p, nullptr, variable, setting, newEliminationPolynomials, equations);
 	}
 
 
-	// optimizations
-	if( setting.simplifyByFactorization )
-		newEliminationPolynomials.factorize();
-	newEliminationPolynomials.makePrimitive();
-	newEliminationPolynomials.makeSquarefree();
+	// optimizations (factorization, primitive and square-free parts are already done by projectionFactors)
 	if( setting.simplifyByRootcounting )
 		newEliminationPolynomials.removePolynomialsWithoutRealRoots();
 	// insert the new polynomials of the last step into the new level (now currentLevel)
-	return destination.insert( newEliminationPolynomials );
+	auto inserted = destination.insert( newEliminationPolynomials );
+	destination.addEquations(equations);
+	return inserted;
 }
 
 template<typename Coefficient>
@@ -429,22 +474,30 @@ std::list<const typename EliminationSet<Coefficient>::UPolynomial*> EliminationS
 	}
 
 	EliminationSet<Coefficient> newEliminationPolynomials(this->polynomialOwner, this->liftingOrder, this->eliminationOrder);
+	std::vector<UPolynomial> equations;
 
 	// PAIRED elimination with the new polynomials: (1) together with the existing ones (2) among themselves
 	if (!mPairedEliminationQueue.empty()) {
+		// in the presence of equations, p is possibly paired with the equations only
+		bool allPairs = this->needsAllPairs(p);
 		if( setting.equationsOnly ) {
 			// (1) elimination with existing polynomials
-			for (auto pol_it1: this->polynomials)
-				project( p, pol_it1, variable, newEliminationPolynomials);
+			for (auto pol_it1: this->polynomials) {
+				if (!allPairs && !this->isEquation(pol_it1)) continue;
+				projectInto( p, pol_it1, variable, setting, newEliminationPolynomials, equations);
+			}
 			// (2) elimination with polynomial itself @todo: proof that we do not need that
 			// eliminationEq( p, p, variable, newEliminationPolynomials, setting );
 		} else {
 			// (1) elimination with existing polynomials
-			for (auto pol_it1: this->polynomials)
-				project( p, pol_it1, variable, newEliminationPolynomials);
+			for (auto pol_it1: this->polynomials) {
+				if (!allPairs && !this->isEquation(pol_it1)) continue;
+				projectInto( p, pol_it1, variable, setting, newEliminationPolynomials, equations);
+			}
 			// (2) elimination with polynomial itself @todo: proof that we do not need that
 			// elimination( p, p, variable, newEliminationPolynomials, setting );
 		}
+		if (!allPairs) this->mDeferredPaired.push_back(p);
 		mPairedEliminationQueue.pop_front();
 	}
 
@@ -453,23 +506,144 @@ std::list<const typename EliminationSet<Coefficient>::UPolynomial*> EliminationS
 			( ( !synchronous || p == mSingleEliminationQueue.front() ) || mPairedEliminationQueue.empty() ) )
 	{
 		p = mSingleEliminationQueue.front();
-		if (setting.equationsOnly) {
-			project( p, variable, newEliminationPolynomials );
+		if (!this->needsSingle(p)) {
+			this->mDeferredSingle.push_back(p);
+		} else if (setting.equationsOnly) {
+			projectInto( p, nullptr, variable, setting, newEliminationPolynomials, equations );
 		} else {
-			project( p, variable, newEliminationPolynomials );
+			projectInto( p, nullptr, variable, setting, newEliminationPolynomials, equations );
 		}
 		mSingleEliminationQueue.pop_front();
 	}
 
-	// optimizations
-	if( setting.simplifyByFactorization )
-		newEliminationPolynomials.factorize();
-	newEliminationPolynomials.makePrimitive();
-	newEliminationPolynomials.makeSquarefree();
+	// optimizations (factorization, primitive and square-free parts are already done by projectionFactors)
 	if( setting.simplifyByRootcounting )
 		newEliminationPolynomials.removePolynomialsWithoutRealRoots();
 	// insert the new polynomials of the last step into the new level (now currentLevel)
-	return destination.insert( newEliminationPolynomials, avoidSingle );
+	auto inserted = destination.insert( newEliminationPolynomials, avoidSingle );
+	destination.addEquations(equations);
+	return inserted;
+}
+
+template<typename Coefficient>
+std::vector<typename EliminationSet<Coefficient>::UPolynomial> EliminationSet<Coefficient>::factors(const UPolynomial& p) {
+	if (!p.isUnivariate() || p.degree() < 2) return { p };
+	std::vector<UPolynomial> res;
+	for (const auto& f: p.toNumberCoefficients().factorization()) {
+		if (f.first.isConstant()) continue;
+		res.push_back(f.first.template convert<MPolynomial<Coefficient>>());
+	}
+	return res;
+}
+
+template<typename Coefficient>
+std::vector<typename EliminationSet<Coefficient>::UPolynomial> EliminationSet<Coefficient>::projectionFactors(
+		const UPolynomial* p,
+		const UPolynomial* q,
+		Variable::Arg variable,
+		const CADSettings& setting
+		) const
+{
+	auto compute = [&]() {
+		ProjectionCollector collector;
+		if (q == nullptr) project(p, variable, collector);
+		else project(p, q, variable, collector);
+		std::vector<UPolynomial> res;
+		for (const auto& r: collector.polynomials) {
+			for (const auto& f: setting.simplifyByFactorization ? factors(r) : std::vector<UPolynomial>({ r })) {
+				if (f.isNumber()) continue; // numbers are discarded
+				UPolynomial g = f.pseudoPrimpart().squareFreePart();
+				if (std::find(res.begin(), res.end(), g) == res.end()) res.push_back(std::move(g));
+			}
+		}
+		return res;
+	};
+	if (!setting.useProjectionCache) return compute();
+	// the resultant is symmetric up to its sign, hence pairs are only cached in one order
+	if (q != nullptr && *q < *p) std::swap(p, q);
+	return ProjectionCache<Coefficient>::getInstance().get(this->projectionType, variable, setting.simplifyByFactorization, *p, q, compute);
+}
+
+template<typename Coefficient>
+std::list<const typename EliminationSet<Coefficient>::UPolynomial*> EliminationSet<Coefficient>::eliminateAllInto(
+		EliminationSet<Coefficient>& destination,
+		Variable::Arg variable,
+		const CADSettings& setting,
+		ThreadPool& pool
+		)
+{
+	std::list<const UPolynomial*> inserted;
+
+	// constants are only moved to the next level
+	std::vector<const UPolynomial*> constants;
+	for (auto queue: {&this->mPairedEliminationQueue, &this->mSingleEliminationQueue}) {
+		for (auto p: *queue) {
+			if (p->isConstant() && std::find(constants.begin(), constants.end(), p) == constants.end()) {
+				constants.push_back(p);
+			}
+		}
+		queue->remove_if([](const UPolynomial* p){ return p->isConstant(); });
+	}
+	for (auto p: constants) {
+		if (!p->isNumber()) { /* discard numerics completely */
+			const UPolynomial* pNewVar = this->polynomialOwner->take(new UPolynomial(p->switchVariable(variable)));
+			if (destination.insert(pNewVar, this->getParentsOf(p)).second) {
+				inserted.push_back(pNewVar);
+			}
+			DOT_EDGE("elimination", p, pNewVar, "label=\"constant\"");
+		}
+		if (p->isNumber() || setting.removeConstants) {
+			DOT_NODE("elimination", p, "shape=box");
+			this->erase(p);
+		}
+	}
+
+	// collect the projections: single ones first, then every unordered pair only once
+	// in the presence of equations, projections that are not needed are deferred
+	std::vector<std::pair<const UPolynomial*, const UPolynomial*>> tasks;
+	for (auto p: this->mSingleEliminationQueue) {
+		if (this->needsSingle(p)) tasks.emplace_back(p, nullptr);
+		else this->mDeferredSingle.push_back(p);
+	}
+	std::set<std::pair<const UPolynomial*, const UPolynomial*>> pairs;
+	for (auto p: this->mPairedEliminationQueue) {
+		bool allPairs = this->needsAllPairs(p);
+		for (auto q: this->polynomials) {
+			if (!allPairs && !this->isEquation(q)) continue;
+			if (p == q || !pairs.emplace(std::min(p, q), std::max(p, q)).second) continue;
+			tasks.emplace_back(p, q);
+		}
+		if (!allPairs) this->mDeferredPaired.push_back(p);
+	}
+	this->mSingleEliminationQueue.clear();
+	this->mPairedEliminationQueue.clear();
+
+	std::vector<std::vector<UPolynomial>> results(tasks.size());
+	pool.parallelFor(tasks.size(), [&](std::size_t i){
+		for (auto& q: projectionFactors(tasks[i].first, tasks[i].second, variable, setting)) {
+			// as in removePolynomialsWithoutRealRoots()
+			if (setting.simplifyByRootcounting && q.degree() % 2 == 0 && q.isUnivariate() && rootfinder::countRealRoots(q) == 0) continue;
+			results[i].push_back(std::move(q));
+		}
+	});
+
+	// merge in the order of the tasks
+	std::vector<UPolynomial> equations;
+	for (std::size_t i = 0; i < tasks.size(); i++) {
+		std::list<const UPolynomial*> parents({tasks[i].first});
+		if (tasks[i].second != nullptr) parents.push_back(tasks[i].second);
+		// the resultant of two equations is an equation of the next level
+		bool propagate = tasks[i].second != nullptr && this->isEquation(tasks[i].first) && this->isEquation(tasks[i].second);
+		for (const auto& p: results[i]) {
+			auto insertValue = destination.insert(p, parents);
+			if (insertValue.second) {
+				inserted.push_back(*insertValue.first);
+			}
+			if (propagate) equations.push_back(p);
+		}
+	}
+	destination.addEquations(equations);
+	return inserted;
 }
 
 template<typename Coefficient>
@@ -561,11 +735,9 @@ void EliminationSet<Coefficient>::factorize() {
 	EliminationSet<Coefficient> factorizedSet(this->polynomialOwner, this->liftingOrder, this->eliminationOrder);
 	for (auto p: this->polynomials) {
 		// insert the factors and omit the original
-		// TODO: Perform multivariate factorization here.
-		/*for (auto factor: p->factorization()) {
-			factorizedSet.insert(factor.first, this->getParentsOf(p));
-		}*/
-		factorizedSet.insert(p, this->getParentsOf(p));
+		for (const auto& factor: factors(*p)) {
+			factorizedSet.insert(factor, this->getParentsOf(p));
+		}
 	}
 	std::swap(*this, factorizedSet);
 }
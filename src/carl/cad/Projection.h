@@ -10,6 +10,23 @@ namespace cad {
         Brown, McCallum, Hong
     };
 
+    /**
+     * Restriction of the projection in the presence of equational constraints, see
+     * [McCallum - "On projection in CAD-based quantifier elimination with equational constraint"] and
+     * [McCallum - "On Propagation of Equational Constraints in CAD-Based Quantifier Elimination"].
+     *
+     * None: all polynomials and all pairs of polynomials are projected.
+     * Restricted: only the equations and the pairs containing an equation are projected, which suffices in the first projection.
+     * SemiRestricted: all polynomials, but only the pairs containing an equation are projected, which is used in later projections.
+     * If there is no equation, all variants project everything.
+     * The equations must be well oriented, see ProjectionOperator::isWellOriented().
+     * The resulting samples only represent the cells on the sections of the equations,
+     * hence a set of constraints is only shown to be infeasible if it contains the equational constraints.
+     */
+    enum class EquationalRestriction: unsigned {
+        None, Restricted, SemiRestricted
+    };
+
     template<typename Poly>
     struct ProjectionOperator {
         template<typename Inserter>
@@ -33,6 +50,25 @@ namespace cad {
             }
         }
 
+        /**
+         * Checks whether the projection of a single polynomial is needed under the given restriction.
+         * @param r Restriction.
+         * @param hasEquations If there are equations.
+         * @param isEquation If the polynomial is an equation.
+         */
+        static bool needsSingle(EquationalRestriction r, bool hasEquations, bool isEquation) {
+            return r != EquationalRestriction::Restricted || !hasEquations || isEquation;
+        }
+        /**
+         * Checks whether the projection of a pair of polynomials is needed under the given restriction.
+         * @param r Restriction.
+         * @param hasEquations If there are equations.
+         * @param isEquation If one of the polynomials is an equation.
+         */
+        static bool needsPair(EquationalRestriction r, bool hasEquations, bool isEquation) {
+            return r == EquationalRestriction::None || !hasEquations || isEquation;
+        }
+
         /**
          * Tries to determine whether the given polynomial vanishes for some assignment.
          * Returns true if the polynomial is guaranteed not to vanish.
@@ -47,6 +83,19 @@ namespace cad {
             if (def == Definiteness::NEGATIVE) return true;
             return false;
         }
+        /**
+         * Checks whether the given polynomial is well oriented, i.e. it is not nullified over any cell of the lower levels.
+         * This holds if some coefficient is guaranteed not to vanish.
+         * The restricted projections are only valid for equations that are well oriented.
+         * Returns false if this can not be guaranteed.
+         */
+        template<typename UPoly>
+        bool isWellOriented(const UPoly& p) const {
+            for (const auto& c: p.coefficients()) {
+                if (doesNotVanish(c)) return true;
+            }
+            return false;
+        }
 
 		template<typename Inserter>
 		void Brown(const Poly& p, const Poly& q, Variable::Arg variable, Inserter& i) const {
@@ -0,0 +1,109 @@
+/**
+ * @file ProjectionCache.h
+ * @ingroup cad
+ *
+ * A process-wide cache of simplified projection results.
+ */
+
+#pragma once
+
+#include "../core/Variable.h"
+#include "../util/LRUCache.h"
+#include "../util/Singleton.h"
+#include "../util/hash.h"
+
+#include "CADTypes.h"
+#include "Projection.h"
+
+#include <vector>
+
+namespace carl {
+namespace cad {
+
+/**
+ * Stores the simplified projection factors of single polynomials and of pairs of polynomials for all CAD objects.
+ *
+ * The entries are keyed by the values of the polynomials, hence a CAD that is constructed for an overlapping set of polynomials reuses the projections of earlier ones,
+ * independently of the level or the CAD object the polynomials are stored in.
+ * The key also contains the projection operator, the main variable of the result and whether the result is factorized.
+ * Pairs are stored in the order of std::less, the callers are expected to pass them in this order.
+ *
+ * The number of entries is bounded, the least recently used entry is evicted first, see LRUCache.
+ */
+template<typename Coefficient>
+class ProjectionCache: public Singleton<ProjectionCache<Coefficient>>
+{
+	friend Singleton<ProjectionCache<Coefficient>>;
+public:
+	typedef cad::UPolynomial<Coefficient> UPolynomial;
+	typedef std::vector<UPolynomial> Factors;
+private:
+	struct Key {
+		ProjectionType type;
+		Variable variable;
+		bool factorize;
+		UPolynomial first;
+		/// The second polynomial of a pair, equals first for single projections.
+		UPolynomial second;
+		bool paired;
+		bool operator==(const Key& k) const {
+			return type == k.type && variable == k.variable && factorize == k.factorize && paired == k.paired && first == k.first && second == k.second;
+		}
+	};
+	struct KeyHash {
+		std::size_t operator()(const Key& k) const {
+			return hash_all(static_cast<unsigned>(k.type), k.variable, k.factorize, k.paired, k.first, k.second);
+		}
+	};
+	LRUCache<Key, Factors, KeyHash> mEntries;
+
+protected:
+	ProjectionCache(): mEntries(10000) {}
+
+public:
+	/**
+	 * Returns the projection factors of p, or of the pair p and q if q is not nullptr.
+	 * If they are not stored yet, they are computed by compute() and stored.
+	 * @param type Projection operator.
+	 * @param variable Main variable of the factors.
+	 * @param factorize Whether compute() factorizes the result.
+	 * @param p Polynomial.
+	 * @param q Second polynomial of a pair or nullptr.
+	 * @param compute Function computing the factors.
+	 * @return Projection factors.
+	 */
+	template<typename F>
+	Factors get(ProjectionType type, Variable::Arg variable, bool factorize, const UPolynomial& p, const UPolynomial* q, F&& compute) {
+		return mEntries.get(Key{type, variable, factorize, p, q == nullptr ? p : *q, q != nullptr}, std::forward<F>(compute));
+	}
+
+	/**
+	 * Sets the maximal number of entries, evicting the least recently used ones if necessary.
+	 * @param capacity Maximal number of entries.
+	 */
+	void setCapacity(std::size_t capacity) {
+		mEntries.setCapacity(capacity);
+	}
+	std::size_t capacity() const {
+		return mEntries.capacity();
+	}
+	std::size_t size() const {
+		return mEntries.size();
+	}
+	std::size_t hits() const {
+		return mEntries.hits();
+	}
+	std::size_t misses() const {
+		return mEntries.misses();
+	}
+
+	/**
+	 * Removes all entries and resets the statistics.
+	 */
+	void clear() {
+		mEntries.clear();
+	}
+};
+
+}
+}
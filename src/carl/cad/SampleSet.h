@@ -8,8 +8,9 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <list>
-#include <queue>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -22,10 +23,17 @@
 namespace carl {
 namespace cad {
 
+/**
+ * Stores the samples of a single lifting step.
+ *
+ * The samples are stored in a vector sorted by their value, while the order in which they are processed is kept in a heap of indices into this vector.
+ * Inserting or removing a sample only shifts these indices, but does not compare any samples except for the ones on the heap path.
+ * Batches of samples are sorted and merged with the stored samples at once.
+ */
 template<typename Number>
 class SampleSet {
 public:
-	typedef typename std::set<RealAlgebraicNumber<Number>>::iterator Iterator;
+	class Iterator;
 	typedef std::unordered_map<RealAlgebraicNumber<Number>, RealAlgebraicNumber<Number>> SampleSimplification;
 	/**
 	 * A functor compatible to std::less<RealAlgebraicNumber<Number>> that compares two samples according to a given order.
@@ -128,18 +136,103 @@ public:
 			return compare(lhs.isRoot(), rhs.isRoot());
 		}
 	};
-	
+
+	/**
+	 * A functor that compares two samples by their value like std::less<RealAlgebraicNumber<Number>>.
+	 * It first tries to decide the comparison by the isolating intervals, which avoids refining interval-represented samples in most cases.
+	 */
+	struct ValueComparator {
+		bool operator()(const RealAlgebraicNumber<Number>& lhs, const RealAlgebraicNumber<Number>& rhs) const;
+	};
+
+	/**
+	 * Iterator over the samples in the order of their value.
+	 * It refers to the samples by their index, hence it stays valid when samples with a larger value are inserted or removed.
+	 */
+	class Iterator {
+		friend class SampleSet<Number>;
+		const std::vector<RealAlgebraicNumber<Number>>* mSamples;
+		std::size_t mIndex;
+		Iterator(const std::vector<RealAlgebraicNumber<Number>>* samples, std::size_t index): mSamples(samples), mIndex(index) {}
+	public:
+		typedef std::bidirectional_iterator_tag iterator_category;
+		typedef RealAlgebraicNumber<Number> value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const RealAlgebraicNumber<Number>* pointer;
+		typedef const RealAlgebraicNumber<Number>& reference;
+
+		reference operator*() const {
+			return (*mSamples)[mIndex];
+		}
+		pointer operator->() const {
+			return &(*mSamples)[mIndex];
+		}
+		Iterator& operator++() {
+			mIndex++;
+			return *this;
+		}
+		Iterator operator++(int) {
+			Iterator res(*this);
+			mIndex++;
+			return res;
+		}
+		Iterator& operator--() {
+			mIndex--;
+			return *this;
+		}
+		Iterator operator--(int) {
+			Iterator res(*this);
+			mIndex--;
+			return res;
+		}
+		bool operator==(const Iterator& it) const {
+			return mSamples == it.mSamples && mIndex == it.mIndex;
+		}
+		bool operator!=(const Iterator& it) const {
+			return !(*this == it);
+		}
+	};
+private:
 	/// Contains all samples in the order of their value.
-	std::set<RealAlgebraicNumber<Number>> mSamples;
+	std::vector<RealAlgebraicNumber<Number>> mSamples;
 
 	SampleComparator mComp;
-	std::vector<RealAlgebraicNumber<Number>> mHeap;
+	/// Indices of the samples, arranged as a heap with respect to mComp.
+	std::vector<std::size_t> mHeap;
+	/// Position of each sample within mHeap.
+	std::vector<std::size_t> mHeapPosition;
+
+	bool heapLess(std::size_t lhs, std::size_t rhs) const {
+		return mComp(mSamples[mHeap[lhs]], mSamples[mHeap[rhs]]);
+	}
+	void heapSwap(std::size_t lhs, std::size_t rhs) {
+		std::swap(mHeap[lhs], mHeap[rhs]);
+		mHeapPosition[mHeap[lhs]] = lhs;
+		mHeapPosition[mHeap[rhs]] = rhs;
+	}
+	void siftUp(std::size_t pos);
+	void siftDown(std::size_t pos);
+	/**
+	 * Restores the heap after the sample at the given index has changed.
+	 */
+	void update(std::size_t index) {
+		siftUp(mHeapPosition[index]);
+		siftDown(mHeapPosition[index]);
+	}
+	/**
+	 * Inserts a sample at the given index of mSamples and adds it to the heap.
+	 */
+	void insertAt(std::size_t index, const RealAlgebraicNumber<Number>& r);
+	/**
+	 * Removes the sample at the given index of mSamples from the heap and from mSamples.
+	 */
+	void eraseAt(std::size_t index);
 	
 	/**
 	 * Restore the ordering.
      */
 	void restoreOrdering() {
-		std::make_heap(mHeap.begin(), mHeap.end(), mComp);
+		for (std::size_t pos = mHeap.size() / 2; pos-- > 0;) siftDown(pos);
 	}
 	/**
 	 * Reset the ordering.
@@ -157,9 +250,19 @@ public:
 	{
 		CARL_LOG_TRACE("carl.cad.sampleset", this << " " << __func__ << "( " << ordering << " )");
 	}
+	SampleSet(const SampleSet& s) = default;
+	SampleSet(SampleSet&& s) = default;
+	SampleSet& operator=(const SampleSet& s) = default;
+	SampleSet& operator=(SampleSet&& s) = default;
 	
-	const std::vector<RealAlgebraicNumber<Number>>& getHeap() const {
-		return mHeap;
+	/**
+	 * Returns the samples in the order of the heap.
+	 */
+	std::vector<RealAlgebraicNumber<Number>> getHeap() const {
+		std::vector<RealAlgebraicNumber<Number>> res;
+		res.reserve(mHeap.size());
+		for (auto i: mHeap) res.push_back(mSamples[i]);
+		return res;
 	}
 
 	/**
@@ -171,10 +274,10 @@ public:
 	}
 
 	/**
-	 * Retrieves the set of samples stored.
-     * @return Sample set.
+	 * Retrieves the samples stored, ordered by their value.
+     * @return Samples.
      */
-	const std::set<RealAlgebraicNumber<Number>>& samples() const {
+	const std::vector<RealAlgebraicNumber<Number>>& samples() const {
 		return this->mSamples;
 	}
 
@@ -185,17 +288,24 @@ public:
      * @return An iterator to the inserted sample, a flag that indicates if the insertion changed something and a flag that indicates if a value has been replaced or was new altogether.
      */
 	std::tuple<Iterator, bool, bool> insert(const RealAlgebraicNumber<Number>& r);
+
+	/**
+	 * Inserts a batch of samples.
+	 * The batch is sorted and merged with the stored samples, which needs fewer comparisons than inserting the samples one by one.
+	 * Samples of equal value are handled as by insert(r), in the order given by the batch.
+	 * @param batch Samples to insert.
+	 * @return For each sample of the batch, in the order of their value, the result as returned by insert(r).
+	 */
+	std::vector<std::tuple<Iterator, bool, bool>> insertBatch(std::vector<RealAlgebraicNumber<Number>>&& batch);
 	
 	/**
-	 * Inserts a range of samples. Actually calls insert(s) for each sample s in the range.
+	 * Inserts a range of samples as a batch.
 	 * @param first Start of range.
 	 * @param last End of range.
 	 */
 	template<class InputIterator>
 	void insert(InputIterator first, InputIterator last) {
-		for (InputIterator i = first; i != last; i++) {
-			this->insert(*i);
-		}
+		this->insertBatch(std::vector<RealAlgebraicNumber<Number>>(first, last));
 	}
 	
 	/**
@@ -216,15 +326,11 @@ public:
 #else
 	SampleSet::Iterator remove(SampleSet::Iterator position) {
 #endif
-		assert(position != mSamples.end());
+		assert(position != end());
 		CARL_LOG_TRACE("carl.cad.sampleset", this << " " << __func__ << "( " << *position << " )");
-		auto it = std::find(mHeap.begin(), mHeap.end(), *position);
-		std::swap(*it, mHeap.back());
-		mHeap.pop_back();
-		restoreOrdering();
-		auto res = mSamples.erase(position);
+		eraseAt(position.mIndex);
 		assert(this->isConsistent());
-		return res;
+		return Iterator(&mSamples, position.mIndex);
 	}
 
 	/**
@@ -232,22 +338,11 @@ public:
 	 * @return Iterator to first sample.
 	 */
 #ifdef __VS
-	typename SampleSet::Iterator begin() {
+	typename SampleSet::Iterator begin() const {
 #else
-	SampleSet::Iterator begin() {
+	SampleSet::Iterator begin() const {
 #endif
-		return this->mSamples.begin();
-	}
-	/**
-	 * Returns an iterator to the first sample in this sample set.
-	 * @return Iterator to first sample.
-	 */
-#ifdef __VS
-	const typename SampleSet::Iterator begin() const {
-#else
-	const SampleSet::Iterator begin() const {
-#endif
-		return this->mSamples.begin();
+		return Iterator(&mSamples, 0);
 	}
 
 	/**
@@ -255,22 +350,11 @@ public:
 	 * @return Iterator to end.
 	 */
 #ifdef __VS
-	typename SampleSet::Iterator end() {
-#else
-	SampleSet::Iterator end() {
-#endif
-		return this->mSamples.end();
-	}
-	/**
-	 * Returns an iterator to the element after the last sample in this sample set.
-	 * @return Iterator to end.
-	 */
-#ifdef __VS
-	const typename SampleSet::Iterator end() const {
+	typename SampleSet::Iterator end() const {
 #else
-	const SampleSet::Iterator end() const {
+	SampleSet::Iterator end() const {
 #endif
-		return this->mSamples.end();
+		return Iterator(&mSamples, mSamples.size());
 	}
 
 	/**
@@ -279,7 +363,7 @@ public:
 	 */
 	inline RealAlgebraicNumber<Number> next() const {
 		assert(!mHeap.empty());
-		return mHeap.front();
+		return mSamples[mHeap.front()];
 	}
 
 	/**
@@ -288,7 +372,7 @@ public:
 	 */
 	inline bool hasOptimal() const {
 		if (mHeap.empty()) return false;
-		return mComp.isOptimal(next());
+		return mComp.isOptimal(mSamples[mHeap.front()]);
 	}
 
 	/**
@@ -303,7 +387,7 @@ public:
 
 	/**
 	 * Removes the element returned by next() from the list.
-	 * @complexity at most linear in the size of the list
+	 * @complexity logarithmic comparisons and linear moves in the size of the list
 	 */
 	void pop();
 	
@@ -331,8 +415,9 @@ public:
 	 * Determines containment of r in the list.
 	 * @return true if r is contained in the list, false otherwise
 	 */
-	bool contains(const RealAlgebraicNumber<Number> r) const {
-		return mSamples.find(r) != mSamples.end();
+	bool contains(const RealAlgebraicNumber<Number>& r) const {
+		auto it = std::lower_bound(mSamples.begin(), mSamples.end(), r, ValueComparator());
+		return it != mSamples.end() && !ValueComparator()(r, *it);
 	}
 
 	/**
@@ -366,14 +451,14 @@ private:
 	/**
 	 * Checks if this sample set fulfills the following conditions:
 	 * <ul>
-	 * <li>mSamples and mQueue contain the same samples.</li>
+	 * <li>mHeap contains every sample exactly once and mHeapPosition refers to the positions in mHeap.</li>
+	 * <li>mHeap is a heap with respect to mComp.</li>
 	 * <li>The samples in mSamples are ordered by their value.</li>
 	 * </ul>
 	 * @return True, if this SampleSet is consistent.
 	 */
 	bool isConsistent() const;
 };
-
 }
 }
 
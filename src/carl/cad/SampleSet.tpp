@@ -80,25 +80,174 @@ bool SampleSet<Number>::SampleComparator::isOptimal(const RealAlgebraicNumber<Nu
 	}
 }
 
+template<typename Number>
+bool SampleSet<Number>::ValueComparator::operator()(const RealAlgebraicNumber<Number>& lhs, const RealAlgebraicNumber<Number>& rhs) const {
+	if (lhs.isThom() || rhs.isThom()) return lhs < rhs;
+	if (lhs.isNumeric()) {
+		if (rhs.isNumeric()) return lhs.value() < rhs.value();
+		if (lhs.value() < rhs.lower()) return true;
+		if (rhs.upper() < lhs.value()) return false;
+	} else if (rhs.isNumeric()) {
+		if (lhs.upper() < rhs.value()) return true;
+		if (rhs.value() < lhs.lower()) return false;
+	} else {
+		if (lhs.upper() < rhs.lower()) return true;
+		if (rhs.upper() < lhs.lower()) return false;
+	}
+	// the isolating intervals overlap
+	return lhs < rhs;
+}
+
+template<typename Number>
+void SampleSet<Number>::siftUp(std::size_t pos) {
+	while (pos > 0) {
+		std::size_t parent = (pos - 1) / 2;
+		if (!heapLess(parent, pos)) break;
+		heapSwap(parent, pos);
+		pos = parent;
+	}
+}
+
+template<typename Number>
+void SampleSet<Number>::siftDown(std::size_t pos) {
+	while (true) {
+		std::size_t child = 2 * pos + 1;
+		if (child >= mHeap.size()) break;
+		if (child + 1 < mHeap.size() && heapLess(child, child + 1)) child++;
+		if (!heapLess(pos, child)) break;
+		heapSwap(pos, child);
+		pos = child;
+	}
+}
+
+template<typename Number>
+void SampleSet<Number>::insertAt(std::size_t index, const RealAlgebraicNumber<Number>& r) {
+	mSamples.insert(mSamples.begin() + (long)index, r);
+	for (auto& i: mHeap) {
+		if (i >= index) i++;
+	}
+	mHeapPosition.insert(mHeapPosition.begin() + (long)index, mHeap.size());
+	mHeap.push_back(index);
+	siftUp(mHeap.size() - 1);
+}
+
+template<typename Number>
+void SampleSet<Number>::eraseAt(std::size_t index) {
+	std::size_t pos = mHeapPosition[index];
+	heapSwap(pos, mHeap.size() - 1);
+	mHeap.pop_back();
+	if (pos < mHeap.size()) {
+		update(mHeap[pos]);
+	}
+	mSamples.erase(mSamples.begin() + (long)index);
+	mHeapPosition.erase(mHeapPosition.begin() + (long)index);
+	for (auto& i: mHeap) {
+		if (i > index) i--;
+	}
+}
+
 template<typename Number>
 std::tuple<typename SampleSet<Number>::Iterator, bool, bool> SampleSet<Number>::insert(const RealAlgebraicNumber<Number>& r) {
 	CARL_LOG_TRACE("carl.cad.sampleset", this << " " << __func__ << "( " << r << " )");
 	CARL_LOG_TRACE("carl.cad.sampleset", *this);
 	assert(this->isConsistent());
-	auto res = this->mSamples.insert(r);
-	auto result = std::make_tuple(res.first, res.second, false);
-	CARL_LOG_TRACE("carl.cad.sampleset", "\tinsert(): " << *res.first << ", " << res.second);
-	if (res.second) {
-		mHeap.push_back(r);
-		std::push_heap(mHeap.begin(), mHeap.end(), mComp);
-	} else if (!(*res.first).isRoot() && r.isRoot()) {
-		this->remove(res.first);
-		std::get<0>(result) = std::get<0>(this->insert(r));
-		std::get<2>(result) = true;
-	} else if (!(*res.first).isNumeric() && r.isNumeric()) {
-		this->remove(res.first);
-		std::get<0>(result) = std::get<0>(this->insert(RealAlgebraicNumber<Number>(r.value(), true)));
-		std::get<2>(result) = true;
+	ValueComparator less;
+	std::size_t index = std::size_t(std::lower_bound(mSamples.begin(), mSamples.end(), r, less) - mSamples.begin());
+	auto result = std::make_tuple(Iterator(&mSamples, index), true, false);
+	if (index < mSamples.size() && !less(r, mSamples[index])) {
+		// a sample of this value already exists
+		std::get<1>(result) = false;
+		RealAlgebraicNumber<Number>& existing = mSamples[index];
+		if (!existing.isRoot() && r.isRoot()) {
+			existing = r;
+			update(index);
+			std::get<2>(result) = true;
+		} else if (!existing.isNumeric() && r.isNumeric()) {
+			existing = RealAlgebraicNumber<Number>(r.value(), true);
+			update(index);
+			std::get<2>(result) = true;
+		}
+	} else {
+		insertAt(index, r);
+	}
+	CARL_LOG_TRACE("carl.cad.sampleset", "\tinsert(): " << mSamples[index] << ", " << std::get<1>(result));
+	assert(this->isConsistent());
+	CARL_LOG_TRACE("carl.cad.sampleset", *this);
+	return result;
+}
+
+template<typename Number>
+std::vector<std::tuple<typename SampleSet<Number>::Iterator, bool, bool>> SampleSet<Number>::insertBatch(std::vector<RealAlgebraicNumber<Number>>&& batch) {
+	CARL_LOG_TRACE("carl.cad.sampleset", this << " " << __func__ << "( " << batch << " )");
+	assert(this->isConsistent());
+	std::vector<std::tuple<Iterator, bool, bool>> result;
+	if (batch.empty()) return result;
+	if (batch.size() == 1) {
+		result.push_back(insert(batch.front()));
+		return result;
+	}
+	ValueComparator less;
+	if (!std::is_sorted(batch.begin(), batch.end(), less)) {
+		std::stable_sort(batch.begin(), batch.end(), less);
+	}
+	result.reserve(batch.size());
+	// merge the batch into the samples, remembering where the old samples went and which samples are new or replaced
+	std::vector<RealAlgebraicNumber<Number>> merged;
+	merged.reserve(mSamples.size() + batch.size());
+	std::vector<std::size_t> moved(mSamples.size());
+	std::vector<bool> fresh;
+	fresh.reserve(mSamples.size() + batch.size());
+	std::vector<std::size_t> replaced;
+	std::size_t i = 0;
+	for (const auto& r: batch) {
+		while (i < mSamples.size() && less(mSamples[i], r)) {
+			moved[i] = merged.size();
+			merged.push_back(mSamples[i++]);
+			fresh.push_back(false);
+		}
+		if (i < mSamples.size() && !less(r, mSamples[i])) {
+			// equal to the next old sample
+			moved[i] = merged.size();
+			merged.push_back(mSamples[i++]);
+			fresh.push_back(false);
+		} else if (merged.empty() || less(merged.back(), r)) {
+			merged.push_back(r);
+			fresh.push_back(true);
+			result.emplace_back(Iterator(&mSamples, merged.size() - 1), true, false);
+			continue;
+		}
+		// a sample of this value already exists as merged.back()
+		std::size_t index = merged.size() - 1;
+		auto res = std::make_tuple(Iterator(&mSamples, index), false, false);
+		RealAlgebraicNumber<Number>& existing = merged.back();
+		if (!existing.isRoot() && r.isRoot()) {
+			existing = r;
+			std::get<2>(res) = true;
+		} else if (!existing.isNumeric() && r.isNumeric()) {
+			existing = RealAlgebraicNumber<Number>(r.value(), true);
+			std::get<2>(res) = true;
+		}
+		if (std::get<2>(res) && !fresh[index]) replaced.push_back(index);
+		result.push_back(res);
+	}
+	while (i < mSamples.size()) {
+		moved[i] = merged.size();
+		merged.push_back(mSamples[i++]);
+		fresh.push_back(false);
+	}
+	// rebuild the heap: move the indices of the old samples, then restore the replaced ones and add the new ones
+	mSamples.swap(merged);
+	mHeapPosition.assign(mSamples.size(), 0);
+	for (std::size_t pos = 0; pos < mHeap.size(); pos++) {
+		mHeap[pos] = moved[mHeap[pos]];
+		mHeapPosition[mHeap[pos]] = pos;
+	}
+	for (auto index: replaced) update(index);
+	for (std::size_t index = 0; index < mSamples.size(); index++) {
+		if (!fresh[index]) continue;
+		mHeapPosition[index] = mHeap.size();
+		mHeap.push_back(index);
+		siftUp(mHeap.size() - 1);
 	}
 	assert(this->isConsistent());
 	CARL_LOG_TRACE("carl.cad.sampleset", *this);
@@ -109,9 +258,7 @@ template<typename Number>
 void SampleSet<Number>::pop() {
 	CARL_LOG_TRACE("carl.cad.sampleset", this << " " << __func__ << "()");
 	if (this->mHeap.empty()) return;
-	this->mSamples.erase(mHeap.front());
-	std::pop_heap(mHeap.begin(), mHeap.end(), mComp);
-	mHeap.pop_back();
+	eraseAt(mHeap.front());
 	assert(this->isConsistent());
 }
 
@@ -119,11 +266,11 @@ template<typename Number>
 bool SampleSet<Number>::simplify(const RealAlgebraicNumber<Number>& from, RealAlgebraicNumber<Number>& to) {
 	CARL_LOG_TRACE("carl.cad.sampleset", this << " " << __func__ << "( " << from << " -> " << to << " )");
 	assert(this->isConsistent());
-	if (mSamples.count(from) > 0) {
-		mSamples.erase(from);
-		mSamples.insert(to);
-		auto it = std::find(mHeap.begin(), mHeap.end(), from);
+	ValueComparator less;
+	auto it = std::lower_bound(mSamples.begin(), mSamples.end(), from, less);
+	if (it != mSamples.end() && !less(from, *it)) {
 		*it = to;
+		update(std::size_t(it - mSamples.begin()));
 		assert(this->isConsistent());
 		return true;
 	}
@@ -169,29 +316,27 @@ bool SampleSet<Number>::isConsistent() const {
 	CARL_LOG_TRACE("carl.cad.sampleset", this << " " << __func__ << "()");
 	CARL_LOG_TRACE("carl.cad.sampleset", "samples: " << mSamples);
 	CARL_LOG_TRACE("carl.cad.sampleset", "heap:    " << mHeap);
-	std::set<RealAlgebraicNumber<Number>> queue(mHeap.begin(), mHeap.end());
-	for (auto n: this->mSamples) {
-		auto it = queue.find(n);
-		if (it == queue.end()) {
-			CARL_LOG_ERROR("carl.cad.sampleset", "Sample " << n << " is not in queue.");
-			assert(queue.find(n) != queue.end());
+	if (mHeap.size() != mSamples.size() || mHeapPosition.size() != mSamples.size()) {
+		CARL_LOG_ERROR("carl.cad.sampleset", "Heap of size " << mHeap.size() << " for " << mSamples.size() << " samples.");
+		assert(mHeap.size() == mSamples.size());
+		assert(mHeapPosition.size() == mSamples.size());
+	}
+	for (std::size_t pos = 0; pos < mHeap.size(); pos++) {
+		if (mHeapPosition[mHeap[pos]] != pos) {
+			CARL_LOG_ERROR("carl.cad.sampleset", "Sample " << mSamples[mHeap[pos]] << " is not in heap.");
+			assert(mHeapPosition[mHeap[pos]] == pos);
+		}
+		if (pos > 0 && heapLess((pos - 1) / 2, pos)) {
+			CARL_LOG_ERROR("carl.cad.sampleset", "Heap is not ordered at " << mSamples[mHeap[pos]]);
+			assert(!heapLess((pos - 1) / 2, pos));
 		}
-		queue.erase(it);
 	}
-	RealAlgebraicNumber<Number> lastSample;
-	bool first = true;
-	for (const auto& n: this->mSamples) {
-		if (!first && !(lastSample < n)) {
+	for (std::size_t i = 1; i < mSamples.size(); i++) {
+		if (!(mSamples[i-1] < mSamples[i])) {
 			CARL_LOG_ERROR("carl.cad.sampleset", "samples: " << mSamples);
-			CARL_LOG_ERROR("carl.cad.sampleset", "Samples in samples not in order: " << lastSample << " < " << n);
-			assert(lastSample < n);
+			CARL_LOG_ERROR("carl.cad.sampleset", "Samples in samples not in order: " << mSamples[i-1] << " < " << mSamples[i]);
+			assert(mSamples[i-1] < mSamples[i]);
 		}
-		lastSample = n;
-		first = false;
-	}
-	if (!queue.empty()) {
-		CARL_LOG_ERROR("carl.cad.sampleset", "Additional samples in queue: " << queue);
-		assert(queue.empty());
 	}
 	return true;
 }
@@ -200,7 +345,9 @@ bool SampleSet<Number>::isConsistent() const {
 template<typename Num>
 void swap(carl::cad::SampleSet<Num>& lhs, carl::cad::SampleSet<Num>& rhs) {
 	std::swap(lhs.mSamples, rhs.mSamples);
+	std::swap(lhs.mComp, rhs.mComp);
 	std::swap(lhs.mHeap, rhs.mHeap);
+	std::swap(lhs.mHeapPosition, rhs.mHeapPosition);
 }
 #endif
 
@@ -213,7 +360,9 @@ namespace std {
 template<typename Num>
 void swap(carl::cad::SampleSet<Num>& lhs, carl::cad::SampleSet<Num>& rhs) {
 	std::swap(lhs.mSamples, rhs.mSamples);
+	std::swap(lhs.mComp, rhs.mComp);
 	std::swap(lhs.mHeap, rhs.mHeap);
+	std::swap(lhs.mHeapPosition, rhs.mHeapPosition);
 }
 
 }
@@ -0,0 +1,136 @@
+/**
+ * @file SingleCell.h
+ * @ingroup cad
+ *
+ * Construction of the single cylindrical cell that contains a given sample point.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <list>
+#include <map>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "../core/MultivariatePolynomial.h"
+#include "../core/Variable.h"
+#include "../formula/model/ran/RealAlgebraicNumber.h"
+
+#include "CADTypes.h"
+#include "Constraint.h"
+#include "Projection.h"
+
+namespace carl {
+namespace cad {
+
+/**
+ * A bound of a cell in one variable: the index-th real root (counting from one) of a polynomial in this variable,
+ * whose coefficients are evaluated at the lower components of a point.
+ */
+template<typename Number>
+struct RootBound {
+	/// Polynomial in the variable of the bound.
+	UPolynomial<Number> polynomial;
+	/// Index of the root, starting with one.
+	std::size_t index;
+	/// Value of the root at the sample point the cell was constructed for.
+	RealAlgebraicNumber<Number> value;
+};
+
+/**
+ * The restriction of a cell to one variable, given the lower components.
+ * It is either a section, i.e. a single root of a polynomial, or a sector between two roots, where either bound may be missing.
+ */
+template<typename Number>
+struct CellComponent {
+	Variable variable;
+	/// If set, the component is the section given by lower, which equals upper.
+	bool section = false;
+	boost::optional<RootBound<Number>> lower;
+	boost::optional<RootBound<Number>> upper;
+	explicit CellComponent(Variable::Arg v): variable(v) {}
+};
+
+/**
+ * A cylindrical cell, given by one component for every variable, the lowest variable first.
+ * All polynomials the cell was constructed for are sign-invariant on the cell, hence the cell is a generalization of the sample point
+ * that can be used as an explanation of a conflict, similar to NLSAT.
+ */
+template<typename Number>
+struct Cell {
+	std::vector<CellComponent<Number>> components;
+
+	/**
+	 * Checks whether the cell contains the given point.
+	 * @param point Assignment of all variables of the cell.
+	 * @return true, if the point is in the cell.
+	 */
+	bool contains(const std::map<Variable, RealAlgebraicNumber<Number>>& point) const;
+};
+
+template<typename Number>
+std::ostream& operator<<(std::ostream& os, const Cell<Number>& cell);
+
+/**
+ * Computes the cell containing a sample point on which a set of polynomials is sign-invariant, without decomposing the whole space.
+ *
+ * Starting with the highest variable, the real roots of the polynomials of each level are isolated at the lower components of the sample point
+ * and the closest roots below and above the sample component (or a root at the sample component) determine the bounds of the cell.
+ * Only the projections needed to keep these bounds well-defined are passed on to the lower levels:
+ * the discriminants and the coefficients as determined by the Brown projection operator, the leading coefficients until one does not vanish at the sample,
+ * and the resultants of every polynomial with the bounding polynomials.
+ * Polynomials that vanish identically at the sample are replaced by their coefficients.
+ *
+ * Polynomials sharing a factor have a vanishing resultant; they are split into their greatest common divisor and the cofactors.
+ */
+template<typename Number>
+class SingleCell {
+public:
+	typedef cad::MPolynomial<Number> MPolynomial;
+	typedef cad::UPolynomial<Number> UPolynomial;
+	typedef std::map<Variable, RealAlgebraicNumber<Number>> Assignment;
+private:
+	/// Variables, the lowest first.
+	std::vector<Variable> mVariables;
+	/// Polynomials by the index of their main variable.
+	std::vector<std::vector<UPolynomial>> mLevels;
+	ProjectionOperator<const UPolynomial*> mProjection;
+
+	/// Index of the highest variable of p or mVariables.size() if p is constant.
+	std::size_t levelOf(const MPolynomial& p) const;
+	/// Adds p to the level of its highest variable if it is not constant.
+	void add(const MPolynomial& p);
+	/// Adds the squarefree part of p to its level, p is given in its main variable.
+	void add(const UPolynomial& p, std::size_t level);
+	/// Adds the projection of p that does not depend on other polynomials.
+	void projectSingle(const UPolynomial& p, std::size_t level, const Assignment& lower);
+	/// Computes the component of the given level and projects the polynomials to the lower levels.
+	CellComponent<Number> processLevel(std::size_t level, const Assignment& sample);
+public:
+	/**
+	 * @param variables Variables, the lowest first.
+	 */
+	explicit SingleCell(const std::vector<Variable>& variables);
+
+	/**
+	 * Constructs the cell containing the sample on which all polynomials are sign-invariant.
+	 * @param polynomials Polynomials over the variables.
+	 * @param sample Assignment of all variables.
+	 * @return Cell.
+	 */
+	Cell<Number> construct(const std::vector<MPolynomial>& polynomials, const Assignment& sample);
+	/**
+	 * Constructs the cell containing the sample on which the truth values of all constraints are invariant.
+	 * @param constraints Constraints over the variables.
+	 * @param sample Assignment of all variables.
+	 * @return Cell.
+	 */
+	Cell<Number> construct(const std::vector<Constraint<Number>>& constraints, const Assignment& sample);
+};
+
+}
+}
+
+#include "SingleCell.tpp"
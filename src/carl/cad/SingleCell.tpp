@@ -0,0 +1,251 @@
+/**
+ * @file SingleCell.tpp
+ * @ingroup cad
+ */
+
+#pragma once
+
+#include "SingleCell.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "../core/logging.h"
+#include "../core/rootfinder/RootFinder.h"
+#include "../formula/model/ran/RealAlgebraicNumberEvaluation.h"
+
+namespace carl {
+namespace cad {
+
+template<typename Number>
+bool Cell<Number>::contains(const std::map<Variable, RealAlgebraicNumber<Number>>& point) const {
+	std::map<Variable, RealAlgebraicNumber<Number>> lower;
+	for (const auto& c: components) {
+		const auto& value = point.at(c.variable);
+		auto root = [&lower](const RootBound<Number>& b) -> boost::optional<RealAlgebraicNumber<Number>> {
+			auto roots = rootfinder::realRoots(b.polynomial, lower);
+			if (!roots || roots->size() < b.index) return boost::none;
+			std::sort(roots->begin(), roots->end());
+			return (*roots)[b.index - 1];
+		};
+		if (c.lower) {
+			auto r = root(*c.lower);
+			if (!r) return false;
+			if (c.section && !(*r == value)) return false;
+			if (!c.section && !(*r < value)) return false;
+		}
+		if (c.upper && !c.section) {
+			auto r = root(*c.upper);
+			if (!r || !(value < *r)) return false;
+		}
+		lower.emplace(c.variable, value);
+	}
+	return true;
+}
+
+template<typename Number>
+std::ostream& operator<<(std::ostream& os, const RootBound<Number>& b) {
+	return os << "root(" << b.polynomial << ", " << b.index << ")";
+}
+
+template<typename Number>
+std::ostream& operator<<(std::ostream& os, const Cell<Number>& cell) {
+	os << "(";
+	bool first = true;
+	for (const auto& c: cell.components) {
+		if (!first) os << ", ";
+		first = false;
+		if (c.section) {
+			os << c.variable << " = " << *c.lower;
+			continue;
+		}
+		if (c.lower) os << *c.lower << " < ";
+		os << c.variable;
+		if (c.upper) os << " < " << *c.upper;
+	}
+	return os << ")";
+}
+
+template<typename Number>
+SingleCell<Number>::SingleCell(const std::vector<Variable>& variables):
+	mVariables(variables),
+	mLevels(variables.size())
+{
+}
+
+template<typename Number>
+std::size_t SingleCell<Number>::levelOf(const MPolynomial& p) const {
+	std::size_t res = mVariables.size();
+	for (auto v: p.gatherVariables()) {
+		auto it = std::find(mVariables.begin(), mVariables.end(), v);
+		assert(it != mVariables.end());
+		std::size_t level = std::size_t(std::distance(mVariables.begin(), it));
+		if (res == mVariables.size() || level > res) res = level;
+	}
+	return res;
+}
+
+template<typename Number>
+void SingleCell<Number>::add(const MPolynomial& p) {
+	if (p.isConstant()) return;
+	std::size_t level = levelOf(p);
+	add(p.toUnivariatePolynomial(mVariables[level]), level);
+}
+
+template<typename Number>
+void SingleCell<Number>::add(const UPolynomial& p, std::size_t level) {
+	UPolynomial q = p.squareFreePart();
+	if (q.lcoeff().lcoeff() < 0) q = -q;
+	auto& polys = mLevels[level];
+	if (std::find(polys.begin(), polys.end(), q) == polys.end()) {
+		CARL_LOG_TRACE("carl.cad.singlecell", "Adding " << q << " to level " << level);
+		polys.push_back(std::move(q));
+	}
+}
+
+template<typename Number>
+void SingleCell<Number>::projectSingle(const UPolynomial& p, std::size_t level, const Assignment& lower) {
+	struct Inserter {
+		SingleCell<Number>* cell;
+		void insert(const UPolynomial& r, const std::list<const UPolynomial*>&, bool) {
+			cell->add(MPolynomial(r));
+		}
+	} inserter{this};
+	mProjection(ProjectionType::Brown, &p, mVariables[level - 1], inserter);
+	// the degree must not drop within the cell: add the leading coefficients until one does not vanish at the sample
+	for (std::size_t d = p.coefficients().size(); d-- > 0;) {
+		const auto& coeff = p.coefficients()[d];
+		if (coeff.isConstant()) {
+			if (coeff.isZero()) continue;
+			break;
+		}
+		add(coeff);
+		if (RealAlgebraicNumberEvaluation::evaluateSign(coeff, lower) != Sign::ZERO) break;
+	}
+}
+
+template<typename Number>
+CellComponent<Number> SingleCell<Number>::processLevel(std::size_t level, const Assignment& sample) {
+	Variable variable = mVariables[level];
+	Assignment lower;
+	for (std::size_t l = 0; l < level; l++) {
+		lower.emplace(mVariables[l], sample.at(mVariables[l]));
+	}
+	const auto& value = sample.at(variable);
+	auto& polys = mLevels[level];
+	while (true) {
+		// closest roots at and around the sample, together with the index of their polynomial
+		typedef std::pair<RootBound<Number>, std::size_t> Candidate;
+		boost::optional<Candidate> section;
+		boost::optional<Candidate> below;
+		boost::optional<Candidate> above;
+		std::vector<std::size_t> active;
+		std::vector<std::size_t> nullified;
+		for (std::size_t i = 0; i < polys.size(); i++) {
+			auto roots = rootfinder::realRoots(polys[i], lower);
+			if (!roots) {
+				CARL_LOG_DEBUG("carl.cad.singlecell", polys[i] << " vanishes at the sample");
+				nullified.push_back(i);
+				continue;
+			}
+			active.push_back(i);
+			std::sort(roots->begin(), roots->end());
+			for (std::size_t j = 0; j < roots->size(); j++) {
+				const auto& r = (*roots)[j];
+				if (r == value) {
+					if (!section) section = Candidate(RootBound<Number>{polys[i], j + 1, r}, i);
+				} else if (r < value) {
+					if (!below || below->first.value < r) below = Candidate(RootBound<Number>{polys[i], j + 1, r}, i);
+				} else {
+					if (!above || r < above->first.value) above = Candidate(RootBound<Number>{polys[i], j + 1, r}, i);
+					break;
+				}
+			}
+		}
+
+		CellComponent<Number> component(variable);
+		std::vector<std::size_t> bounds;
+		if (section) {
+			component.section = true;
+			component.lower = section->first;
+			component.upper = section->first;
+			bounds.push_back(section->second);
+		} else {
+			if (below) {
+				component.lower = below->first;
+				bounds.push_back(below->second);
+			}
+			if (above) {
+				component.upper = above->first;
+				if (!below || below->second != above->second) bounds.push_back(above->second);
+			}
+		}
+		if (level == 0) return component;
+
+		// the roots of all polynomials must not cross the bounds: resultants with the bounding polynomials
+		bool split = false;
+		for (std::size_t b: bounds) {
+			for (std::size_t i: active) {
+				if (i == b) continue;
+				UPolynomial res = polys[b].resultant(polys[i]);
+				if (res.isZero()) {
+					// common factor: replace both polynomials by the gcd and the cofactors and start over
+					CARL_LOG_DEBUG("carl.cad.singlecell", polys[b] << " and " << polys[i] << " have a common factor");
+					// the last nonzero subresultant is similar to the gcd
+					UPolynomial g = UPolynomial::subresultants(polys[b], polys[i]).front().pseudoPrimpart();
+					MPolynomial divisor(g);
+					std::vector<MPolynomial> parts({divisor});
+					for (std::size_t j: {b, i}) {
+						MPolynomial cofactor;
+						bool divides = MPolynomial(polys[j]).divideBy(divisor, cofactor);
+						assert(divides);
+						(void)divides;
+						parts.push_back(cofactor);
+					}
+					polys.erase(polys.begin() + (long)std::max(b, i));
+					polys.erase(polys.begin() + (long)std::min(b, i));
+					for (const auto& part: parts) add(part);
+					split = true;
+					break;
+				}
+				add(MPolynomial(res));
+			}
+			if (split) break;
+		}
+		if (split) continue;
+
+		for (std::size_t i: active) {
+			projectSingle(polys[i], level, lower);
+		}
+		// polynomials that vanish at the sample must keep vanishing
+		for (std::size_t i: nullified) {
+			for (const auto& coeff: polys[i].coefficients()) add(coeff);
+		}
+		return component;
+	}
+}
+
+template<typename Number>
+Cell<Number> SingleCell<Number>::construct(const std::vector<MPolynomial>& polynomials, const Assignment& sample) {
+	for (auto& l: mLevels) l.clear();
+	for (const auto& p: polynomials) add(p);
+	Cell<Number> cell;
+	cell.components.reserve(mVariables.size());
+	for (std::size_t level = mVariables.size(); level-- > 0;) {
+		cell.components.push_back(processLevel(level, sample));
+		CARL_LOG_DEBUG("carl.cad.singlecell", "Level " << level << ": " << mLevels[level].size() << " polynomials");
+	}
+	std::reverse(cell.components.begin(), cell.components.end());
+	return cell;
+}
+
+template<typename Number>
+Cell<Number> SingleCell<Number>::construct(const std::vector<Constraint<Number>>& constraints, const Assignment& sample) {
+	std::vector<MPolynomial> polynomials;
+	polynomials.reserve(constraints.size());
+	for (const auto& c: constraints) polynomials.push_back(c.getPolynomial());
+	return construct(polynomials, sample);
+}
+
+}
+}
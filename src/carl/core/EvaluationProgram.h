@@ -0,0 +1,237 @@
+/**
+ * @file EvaluationProgram.h
+ *
+ * Compiles polynomials into flat programs that evaluate them on many exact assignments.
+ */
+
+#pragma once
+
+#include "MultivariateHorner.h"
+#include "MultivariatePolynomial.h"
+#include "Relation.h"
+#include "Variable.h"
+#include "logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace carl {
+
+/**
+ * The strategy used to obtain the Horner scheme of a polynomial for an EvaluationProgram.
+ * Variables are chosen to minimize the number of operations and nested occurrences of the same variable are merged into powers, which are then shared within the program.
+ */
+struct EvaluationProgramStrategy
+{
+	static CONSTEXPR variableSelectionHeurisics selectionType = COST_MODELs;
+#ifdef __VS
+	static double targetDiameter() { return 0.1; }
+#else
+	static constexpr double targetDiameter = 0.1;
+#endif
+	static CONSTEXPR bool use_arithmeticOperationsCounter = false;
+};
+
+/**
+ * A polynomial compiled into a sequence of arithmetic instructions on registers.
+ *
+ * The instructions follow the Horner scheme obtained from MultivariateHornerCache.
+ * Every variable is bound to a slot, i.e. an index into the vector of values that is passed to evaluate().
+ * The powers of the variables that occur in the scheme are computed once at the beginning of every evaluation and shared by all instructions using them.
+ *
+ * Evaluation does not construct any polynomial and reuses the registers of the previous evaluation,
+ * hence evaluating a program over many assignments does not allocate memory once the registers have grown.
+ * The evaluate() methods without explicit registers use registers owned by the program and must not be called concurrently.
+ */
+template<typename Pol>
+class EvaluationProgram
+{
+public:
+	using Coeff = typename Pol::CoeffType;
+	using Horner = MultivariateHorner<Pol, EvaluationProgramStrategy>;
+private:
+	enum class OpCode: std::uint8_t {
+		/// dst = constant[a]
+		CONST,
+		/// dst = value[a]^b
+		POW,
+		/// dst = dst[a] * dst[b]
+		MUL,
+		/// dst = dst[a] * constant[b]
+		MULC,
+		/// dst = dst[a] + dst[b]
+		ADD,
+		/// dst = dst[a] + constant[b]
+		ADDC
+	};
+	struct Instruction {
+		OpCode mOp;
+		std::size_t mDst;
+		std::size_t mA;
+		std::size_t mB;
+	};
+
+	/// Variable of every slot.
+	std::vector<Variable> mVariables;
+	std::vector<Coeff> mConstants;
+	/// Computation of the powers, executed before mCode.
+	std::vector<Instruction> mPowers;
+	std::vector<Instruction> mCode;
+	/// Register of every (slot, exponent) pair that has been computed.
+	std::map<std::pair<std::size_t, unsigned>, std::size_t> mPowerRegisters;
+	std::size_t mNrRegisters = 0;
+	/// Register holding the result.
+	std::size_t mResult = 0;
+	mutable std::vector<Coeff> mRegisters;
+
+	std::size_t slot(Variable::Arg v) const {
+		auto it = std::lower_bound(mVariables.begin(), mVariables.end(), v);
+		assert(it != mVariables.end() && *it == v);
+		return std::size_t(it - mVariables.begin());
+	}
+	std::size_t emit(std::vector<Instruction>& code, OpCode op, std::size_t a, std::size_t b) {
+		code.push_back(Instruction{op, mNrRegisters, a, b});
+		return mNrRegisters++;
+	}
+	std::size_t constant(const Coeff& c) {
+		mConstants.push_back(c);
+		return mConstants.size() - 1;
+	}
+	std::size_t power(Variable::Arg v, unsigned exp) {
+		auto key = std::make_pair(slot(v), exp);
+		auto it = mPowerRegisters.find(key);
+		if (it != mPowerRegisters.end()) return it->second;
+		std::size_t res = emit(mPowers, OpCode::POW, key.first, exp);
+		mPowerRegisters.emplace(key, res);
+		return res;
+	}
+	/// Emits the instructions for the given Horner scheme and returns the register holding its value.
+	std::size_t compile(const Horner& h) {
+		if (h.getVariable() == Variable::NO_VARIABLE) {
+			return emit(mCode, OpCode::CONST, constant(h.getIndepConstant()), 0);
+		}
+		std::size_t res = power(h.getVariable(), h.getExponent());
+		if (h.getDependent()) {
+			res = emit(mCode, OpCode::MUL, res, compile(*h.getDependent()));
+		} else if (!isOne(h.getDepConstant())) {
+			res = emit(mCode, OpCode::MULC, res, constant(h.getDepConstant()));
+		}
+		if (h.getIndependent()) {
+			res = emit(mCode, OpCode::ADD, res, compile(*h.getIndependent()));
+		} else if (!isZero(h.getIndepConstant())) {
+			res = emit(mCode, OpCode::ADDC, res, constant(h.getIndepConstant()));
+		}
+		return res;
+	}
+	void init(const Pol& p) {
+		assert(std::is_sorted(mVariables.begin(), mVariables.end()));
+		if (p.isConstant()) {
+			mResult = emit(mCode, OpCode::CONST, constant(p.constantPart()), 0);
+		} else {
+			mResult = compile(*cachedHornerScheme<EvaluationProgramStrategy>(p));
+		}
+		mPowerRegisters.clear();
+		CARL_LOG_DEBUG("carl.core.evaluationprogram", "Compiled " << p << " into " << mPowers.size() << " powers and " << mCode.size() << " instructions");
+	}
+
+	static void pow(Coeff& dst, const Coeff& base, unsigned exp) {
+		dst = base;
+		if (exp == 1) return;
+		// Left-to-right binary exponentiation, uses dst as the only temporary.
+		unsigned mask = 1;
+		while (mask <= exp / 2) mask <<= 1;
+		for (mask >>= 1; mask > 0; mask >>= 1) {
+			dst *= dst;
+			if (exp & mask) dst *= base;
+		}
+	}
+	static void execute(const Instruction& i, const std::vector<Coeff>& constants, const std::vector<Coeff>& values, std::vector<Coeff>& r) {
+		switch (i.mOp) {
+			case OpCode::CONST: r[i.mDst] = constants[i.mA]; break;
+			case OpCode::POW: pow(r[i.mDst], values[i.mA], unsigned(i.mB)); break;
+			case OpCode::MUL: r[i.mDst] = r[i.mA] * r[i.mB]; break;
+			case OpCode::MULC: r[i.mDst] = r[i.mA] * constants[i.mB]; break;
+			case OpCode::ADD: r[i.mDst] = r[i.mA] + r[i.mB]; break;
+			case OpCode::ADDC: r[i.mDst] = r[i.mA] + constants[i.mB]; break;
+		}
+	}
+
+public:
+	/**
+	 * Compiles the given polynomial, its variables are bound to slots in ascending order.
+	 */
+	explicit EvaluationProgram(const Pol& p) {
+		std::set<Variable> vars;
+		p.gatherVariables(vars);
+		mVariables.assign(vars.begin(), vars.end());
+		init(p);
+	}
+	/**
+	 * Compiles the given polynomial with the given variables bound to slots.
+	 * This allows a set of programs to be evaluated on the same vector of values.
+	 * @param p The polynomial.
+	 * @param variables The variables of all slots, must be sorted and contain all variables of p.
+	 */
+	EvaluationProgram(const Pol& p, const std::vector<Variable>& variables): mVariables(variables) {
+		init(p);
+	}
+
+	/**
+	 * @return The variables of all slots.
+	 */
+	const std::vector<Variable>& variables() const {
+		return mVariables;
+	}
+	/**
+	 * @return The number of instructions, including the computation of powers.
+	 */
+	std::size_t size() const {
+		return mPowers.size() + mCode.size();
+	}
+
+	/**
+	 * Evaluates the polynomial.
+	 * @param values The value of every slot.
+	 * @param registers The registers to use, may be shared by several programs.
+	 * @return The value of the polynomial.
+	 */
+	const Coeff& evaluate(const std::vector<Coeff>& values, std::vector<Coeff>& registers) const {
+		assert(values.size() >= mVariables.size());
+		if (registers.size() < mNrRegisters) registers.resize(mNrRegisters);
+		for (const auto& i: mPowers) execute(i, mConstants, values, registers);
+		for (const auto& i: mCode) execute(i, mConstants, values, registers);
+		return registers[mResult];
+	}
+	/**
+	 * Evaluates the polynomial using the registers of this program.
+	 */
+	const Coeff& evaluate(const std::vector<Coeff>& values) const {
+		return evaluate(values, mRegisters);
+	}
+	/**
+	 * Evaluates the polynomial on the assignment given as a map, which must contain all variables of the slots.
+	 */
+	Coeff evaluate(const std::map<Variable, Coeff>& assignment) const {
+		std::vector<Coeff> values;
+		values.reserve(mVariables.size());
+		for (auto v: mVariables) values.push_back(assignment.at(v));
+		return evaluate(values);
+	}
+
+	/**
+	 * Checks whether the relation holds for the value of the polynomial and zero.
+	 */
+	bool satisfies(const std::vector<Coeff>& values, Relation relation) const {
+		return carl::evaluate(evaluate(values), relation);
+	}
+	bool satisfies(const std::vector<Coeff>& values, Relation relation, std::vector<Coeff>& registers) const {
+		return carl::evaluate(evaluate(values, registers), relation);
+	}
+};
+
+}
@@ -723,9 +723,7 @@ namespace carl
     template<typename P>
     void FactorizedPolynomial<P>::substituteIn( Variable::Arg _var, const FactorizedPolynomial<P>& _value )
     {
-        FactorizedPolynomial<P> res( *this );
-        res.substitute( _var, _value );
-        return res;
+        *this = substitute( _var, _value );
     }
     
     template<typename P>
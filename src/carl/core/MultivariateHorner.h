@@ -7,7 +7,11 @@
 #pragma once
 #include <vector>
 #include "Variable.h"
+#include <limits>
+#include <memory>
 #include <set>
+#include "../util/LRUCache.h"
+#include "../util/Singleton.h"
 #include "MultivariatePolynomial.h"
 #include "../interval/Interval.h"
 #include "../interval/IntervalEvaluation.h"
@@ -156,6 +160,67 @@ public:
 
 }; //Class MultivarHorner
 
+/**
+ * Stores the Horner schemes of polynomials, such that every scheme is only constructed once.
+ *
+ * The schemes are shared and must not be modified.
+ * The number of schemes is bounded, the least recently used scheme is evicted first; schemes that are still in use stay valid.
+ */
+template<typename PolynomialType, class strategy>
+class MultivariateHornerCache : public Singleton<MultivariateHornerCache<PolynomialType, strategy>>
+{
+	friend Singleton<MultivariateHornerCache<PolynomialType, strategy>>;
+public:
+	typedef MultivariateHorner<PolynomialType, strategy> Horner;
+private:
+	LRUCache<PolynomialType, std::shared_ptr<const Horner>> mSchemes;
+
+	MultivariateHornerCache(): mSchemes(10000) {}
+public:
+	/**
+	 * Returns the Horner scheme of the given polynomial, constructs it if it is not cached yet.
+	 * The scheme is constructed without holding the lock, if another thread was faster, its scheme is used.
+	 */
+	std::shared_ptr<const Horner> get(const PolynomialType& p)
+	{
+		return mSchemes.get(p, [&p](){ return std::make_shared<const Horner>(p); });
+	}
+
+	void setCapacity(std::size_t capacity)
+	{
+		mSchemes.setCapacity(capacity);
+	}
+
+	void clear()
+	{
+		mSchemes.clear();
+	}
+
+	std::size_t size() const
+	{
+		return mSchemes.size();
+	}
+
+	std::size_t hits() const
+	{
+		return mSchemes.hits();
+	}
+
+	std::size_t misses() const
+	{
+		return mSchemes.misses();
+	}
+};
+
+/**
+ * Returns the cached Horner scheme of the given polynomial, see MultivariateHornerCache.
+ */
+template<class strategy, typename PolynomialType>
+std::shared_ptr<const MultivariateHorner<PolynomialType, strategy>> cachedHornerScheme(const PolynomialType& p)
+{
+	return MultivariateHornerCache<PolynomialType, strategy>::getInstance().get(p);
+}
+
 }//namespace carl
 #include "MultivariateHorner.tpp"
 
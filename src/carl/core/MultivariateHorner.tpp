@@ -56,7 +56,7 @@ namespace carl
 	MultivariateHorner< PolynomialType, strategy > root ( std::move(inPut), mMap, arithmeticOperationsReductionCounter );
 
  	//Part after recursion
- 	if (strategy::selectionType == variableSelectionHeurisics::GREEDY_Is || strategy::selectionType == variableSelectionHeurisics::GREEDY_IIs)
+ 	if (strategy::selectionType == variableSelectionHeurisics::GREEDY_Is || strategy::selectionType == variableSelectionHeurisics::GREEDY_IIs || strategy::selectionType == variableSelectionHeurisics::COST_MODELs)
  	{
  		auto root_ptr =std::make_shared<MultivariateHorner< PolynomialType, strategy > >(root);
  		root_ptr = simplify( root_ptr );
@@ -89,7 +89,7 @@ namespace carl
 	MultivariateHorner< PolynomialType, strategy > root (std::move(inPut), true, map);
 
  	//Part after recursion
- 	if (strategy::selectionType == variableSelectionHeurisics::GREEDY_Is || strategy::selectionType == variableSelectionHeurisics::GREEDY_IIs)
+ 	if (strategy::selectionType == variableSelectionHeurisics::GREEDY_Is || strategy::selectionType == variableSelectionHeurisics::GREEDY_IIs || strategy::selectionType == variableSelectionHeurisics::COST_MODELs)
  	{
  		auto root_ptr =std::make_shared<MultivariateHorner< PolynomialType, strategy > >(root);
  		root_ptr = simplify( root_ptr );
@@ -117,6 +117,7 @@ namespace carl
 		CoeffType bestDelta = constant_zero<CoeffType>::get();
 
 		unsigned int monomials_containingChoosenVar = 0;
+		std::size_t bestCost = std::numeric_limits<std::size_t>::max();
 
 		if (allVariablesinPolynome.size() != 0)
 		{
@@ -142,6 +143,42 @@ namespace carl
 					}
 				}
 
+				if (s == variableSelectionHeurisics::COST_MODEL || s == variableSelectionHeurisics::COST_MODELs)
+				{
+					//Operations for evaluating the dependent and the independent part naively, plus multiplying by the variable
+					std::size_t cost = 1;
+					std::size_t dependentTerms = 0;
+					std::size_t independentTerms = 0;
+					typename PolynomialType::TermsType::const_iterator polynomialIt;
+					for (polynomialIt = inPut.begin(); polynomialIt != inPut.end(); polynomialIt++)
+					{
+						std::size_t degree = polynomialIt->tdeg();
+						if (polynomialIt->has(*variableIt))
+						{
+							dependentTerms++;
+							degree--;
+						}
+						else
+						{
+							independentTerms++;
+						}
+						if (degree > 0)
+						{
+							cost += degree - 1;
+							if (!isOne(polynomialIt->coeff())) cost++;
+						}
+					}
+					cost += dependentTerms - 1;
+					cost += independentTerms;
+
+					if (cost < bestCost || (cost == bestCost && dependentTerms > monomials_containingChoosenVar))
+					{
+						bestCost = cost;
+						monomials_containingChoosenVar = (unsigned int)dependentTerms;
+						selectedVariable = variableIt;
+					}
+				}
+
 				if (s == variableSelectionHeurisics::GREEDY_II || s == variableSelectionHeurisics::GREEDY_IIs)
 				{
 					typename PolynomialType::TermsType::const_iterator polynomialIt;
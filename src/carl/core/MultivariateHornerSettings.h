@@ -7,8 +7,12 @@ enum variableSelectionHeurisics {
 		//GREEDY_Is does the same as GREEDY_I, but adds a simplifyer at the end.
 		GREEDY_II = 2,
 		//GREEDY_II minimizes the solution space, by evaluating each monome.
-		GREEDY_IIs = 3
+		GREEDY_IIs = 3,
 		//GREEDY_IIs does the same as GREEDY_II, but adds a simplifyer at the end.
+		COST_MODEL = 4,
+		//COST_MODEL chooses the variable that minimizes the number of arithmetic operations after factoring it out, ties are broken by the number of monomials.
+		COST_MODELs = 5
+		//COST_MODELs does the same as COST_MODEL, but adds a simplifyer at the end.
 };
 
 #ifdef __VS
@@ -0,0 +1,254 @@
+/**
+ * @file CNFConverter.h
+ *
+ * An iterative conversion to conjunctive normal form that emits the clauses one by one.
+ */
+
+#pragma once
+
+#include "../core/logging.h"
+#include "Formula.h"
+#include "FormulaPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Converts formulas to conjunctive normal form and hands every clause to a callback as soon as it is created.
+ *
+ * Subformulas that are neither atoms nor negations are abstracted by Tseitin variables, which are obtained from the FormulaPool.
+ * The encoding follows Plaisted and Greenbaum: if a subformula only occurs positively, only the clauses for
+ * (tseitin -> subformula) are emitted, if it only occurs negatively, only those for (subformula -> tseitin).
+ * The clauses for a subformula are emitted at most once per polarity, even if it is shared by several formulas that are added.
+ *
+ * The conversion uses an explicit work list instead of recursion and never constructs the conjunction of all clauses,
+ * hence it is suitable for very large and deeply nested formulas.
+ *
+ * A clause is a vector of literals, i.e. atoms and negated atoms. It never contains TRUE, FALSE, duplicate literals or
+ * a literal together with its negation. If the added formulas are unsatisfiable for trivial reasons, the empty clause is emitted.
+ */
+template<typename Pol>
+class CNFConverter
+{
+public:
+	using Clause = std::vector<Formula<Pol>>;
+	using ClauseCallback = std::function<void(const Clause&)>;
+private:
+	/// Flags for the polarities in which a subformula occurs.
+	enum Polarity: std::uint8_t { NONE = 0, POSITIVE = 1, NEGATIVE = 2, BOTH = 3 };
+
+	/// A formula whose clauses have yet to be emitted: guard -> formula (or guard -> not formula, if negated).
+	struct Task {
+		Formula<Pol> mFormula;
+		bool mNegated;
+		/// The guard, TRUE for formulas that are asserted at the top level.
+		Formula<Pol> mGuard;
+	};
+
+	ClauseCallback mCallback;
+	/// The polarities in which the clauses of a subformula have been emitted already.
+	FastMap<Formula<Pol>, std::uint8_t> mEncoded;
+	std::vector<Task> mTasks;
+	Clause mClause;
+	std::size_t mNrClauses = 0;
+	bool mEmptyClauseEmitted = false;
+
+	static bool isCompound(const Formula<Pol>& f) {
+		switch (f.getType()) {
+			case FormulaType::AND:
+			case FormulaType::OR:
+			case FormulaType::IMPLIES:
+			case FormulaType::IFF:
+			case FormulaType::XOR:
+			case FormulaType::ITE:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/**
+	 * Returns a literal that is equivalent to the given formula under the clauses emitted for it.
+	 * @param f The formula.
+	 * @param negated Whether the negation of f is requested.
+	 * @param polarity The polarities in which the returned literal occurs in clauses.
+	 * @return The literal.
+	 */
+	Formula<Pol> literal(const Formula<Pol>& f, bool negated, std::uint8_t polarity) {
+		const Formula<Pol>* cur = &f;
+		while (cur->getType() == FormulaType::NOT) {
+			cur = &cur->subformula();
+			negated = !negated;
+		}
+		if (!isCompound(*cur)) {
+			return negated ? cur->negated() : *cur;
+		}
+		// The literal of the negation is used in the opposite polarity.
+		if (negated) polarity = std::uint8_t(((polarity & POSITIVE) << 1) | ((polarity & NEGATIVE) >> 1));
+		Formula<Pol> tseitinVar = FormulaPool<Pol>::getInstance().createTseitinVar(*cur);
+		std::uint8_t& encoded = mEncoded[*cur];
+		std::uint8_t missing = std::uint8_t(polarity & ~encoded);
+		encoded |= missing;
+		if (missing & POSITIVE) {
+			// tseitinVar -> cur
+			mTasks.push_back(Task{*cur, false, tseitinVar});
+		}
+		if (missing & NEGATIVE) {
+			// cur -> tseitinVar, i.e. (not tseitinVar) -> (not cur)
+			mTasks.push_back(Task{*cur, true, tseitinVar.negated()});
+		}
+		return negated ? tseitinVar.negated() : tseitinVar;
+	}
+
+	/**
+	 * Emits the current clause, after adding the negated guard and removing redundant literals.
+	 */
+	void emit(const Formula<Pol>& guard) {
+		if (!guard.isTrue()) mClause.push_back(guard.negated());
+		auto end = std::remove_if(mClause.begin(), mClause.end(), [](const Formula<Pol>& l){ return l.isFalse(); });
+		mClause.erase(end, mClause.end());
+		bool tautology = std::any_of(mClause.begin(), mClause.end(), [](const Formula<Pol>& l){ return l.isTrue(); });
+		if (!tautology) {
+			std::sort(mClause.begin(), mClause.end(), [](const Formula<Pol>& a, const Formula<Pol>& b){ return a.getId() < b.getId(); });
+			mClause.erase(std::unique(mClause.begin(), mClause.end()), mClause.end());
+			for (std::size_t i = 1; i < mClause.size() && !tautology; ++i) {
+				// A formula and its negation have consecutive ids.
+				tautology = mClause[i-1].negated() == mClause[i];
+			}
+		}
+		if (!tautology) {
+			if (mClause.empty()) mEmptyClauseEmitted = true;
+			++mNrClauses;
+			mCallback(mClause);
+		}
+		mClause.clear();
+	}
+
+	/**
+	 * Emits the clauses for guard -> f, or guard -> (not f) if negated.
+	 * Subformulas are abstracted by literals, the clauses defining them are scheduled as further tasks.
+	 */
+	void process(const Task& task) {
+		const Formula<Pol>& f = task.mFormula;
+		bool n = task.mNegated;
+		const Formula<Pol>& guard = task.mGuard;
+		switch (f.getType()) {
+			case FormulaType::TRUE:
+			case FormulaType::FALSE:
+				if (f.isTrue() == n) emit(guard);
+				break;
+			case FormulaType::NOT:
+				mTasks.push_back(Task{f.subformula(), !n, guard});
+				break;
+			case FormulaType::AND:
+			case FormulaType::OR:
+				if ((f.getType() == FormulaType::AND) != n) {
+					// A conjunction: every subformula is asserted on its own.
+					for (const auto& sub: f.subformulas()) mTasks.push_back(Task{sub, n, guard});
+				} else {
+					// A disjunction: one clause.
+					for (const auto& sub: f.subformulas()) mClause.push_back(literal(sub, n, POSITIVE));
+					emit(guard);
+				}
+				break;
+			case FormulaType::IMPLIES:
+				if (n) {
+					// premise and (not conclusion)
+					mTasks.push_back(Task{f.premise(), false, guard});
+					mTasks.push_back(Task{f.conclusion(), true, guard});
+				} else {
+					mClause.push_back(literal(f.premise(), true, POSITIVE));
+					mClause.push_back(literal(f.conclusion(), false, POSITIVE));
+					emit(guard);
+				}
+				break;
+			case FormulaType::ITE: {
+				// (ite c t e) is (or (not c) t) and (or c e), its negation is (or (not c) (not t)) and (or c (not e)).
+				Formula<Pol> c = literal(f.condition(), false, BOTH);
+				mClause.push_back(c.negated());
+				mClause.push_back(literal(f.firstCase(), n, POSITIVE));
+				emit(guard);
+				mClause.push_back(c);
+				mClause.push_back(literal(f.secondCase(), n, POSITIVE));
+				emit(guard);
+				break;
+			}
+			case FormulaType::IFF:
+			case FormulaType::XOR: {
+				std::vector<Formula<Pol>> lits;
+				if (f.getType() == FormulaType::XOR && f.subformulas().size() > 2) {
+					// (xor a_1 .. a_n) is (xor (xor a_1 .. a_n-1) a_n).
+					lits.push_back(literal(f.connectPrecedingSubformulas(), false, BOTH));
+					lits.push_back(literal(f.back(), false, BOTH));
+				} else {
+					for (const auto& sub: f.subformulas()) lits.push_back(literal(sub, false, BOTH));
+				}
+				// Whether all literals must be equal.
+				bool equal = (f.getType() == FormulaType::IFF) != n;
+				if (equal) {
+					// A cycle of implications.
+					for (std::size_t i = 0; i < lits.size(); ++i) {
+						mClause.push_back(lits[i].negated());
+						mClause.push_back(lits[(i + 1) % lits.size()]);
+						emit(guard);
+					}
+				} else if (lits.size() == 2) {
+					mClause.push_back(lits[0]);
+					mClause.push_back(lits[1]);
+					emit(guard);
+					mClause.push_back(lits[0].negated());
+					mClause.push_back(lits[1].negated());
+					emit(guard);
+				} else {
+					// Not all equal: at least one is true and at least one is false.
+					mClause = lits;
+					emit(guard);
+					for (const auto& l: lits) mClause.push_back(l.negated());
+					emit(guard);
+				}
+				break;
+			}
+			default:
+				// An atom.
+				mClause.push_back(n ? f.negated() : f);
+				emit(guard);
+				break;
+		}
+	}
+
+public:
+	/**
+	 * @param callback Called for every clause, the clause is only valid during the call.
+	 */
+	explicit CNFConverter(ClauseCallback callback): mCallback(std::move(callback)) {}
+
+	/**
+	 * Asserts the given formula, i.e. emits the clauses of its conversion to CNF.
+	 * The Tseitin variables introduced for subformulas of previously added formulas are reused.
+	 * @param formula The formula to add.
+	 * @return false, if the empty clause has been emitted so far.
+	 */
+	bool add(const Formula<Pol>& formula) {
+		mTasks.push_back(Task{formula, false, Formula<Pol>(FormulaType::TRUE)});
+		while (!mTasks.empty()) {
+			Task task = std::move(mTasks.back());
+			mTasks.pop_back();
+			process(task);
+		}
+		CARL_LOG_DEBUG("carl.formula.cnf", "Emitted " << mNrClauses << " clauses so far");
+		return !mEmptyClauseEmitted;
+	}
+
+	/**
+	 * @return The number of clauses emitted so far.
+	 */
+	std::size_t nrClauses() const {
+		return mNrClauses;
+	}
+};
+
+}
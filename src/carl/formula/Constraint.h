@@ -22,10 +22,14 @@
 #include "../util/Common.h"
 #include "config.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
+#include <memory>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 
 namespace carl
@@ -165,8 +169,8 @@ namespace carl
             std::size_t mID;
             /// The hash value.
             std::size_t mHash;
-            /// A unique id.
-            mutable std::size_t mUsages;
+            /// The number of usages, zero once the constraint content is being destructed.
+            mutable std::atomic<std::size_t> mUsages;
             /// The relation symbol comparing the polynomial considered by this constraint to zero.
             Relation mRelation;
             /// The polynomial which is compared by this constraint to zero.
@@ -175,12 +179,14 @@ namespace carl
             mutable Factors<Pol> mFactorization;
             /// A container which includes all variables occurring in the polynomial considered by this constraint.
             Variables mVariables;
-            /// A map which stores information about properties of the variables in this constraint.
-            mutable VarInfoMap<Pol> mVarInfoMap;
+            /// The variables of this constraint in ascending order, the keys for the variable information.
+            std::vector<Variable> mVarInfoVariables;
+            /// The degrees and occurrences of the variables in mVarInfoVariables, stored at the same positions, without coefficients.
+            std::vector<VarInfo<Pol>> mVarInfos;
+            /// The variable information including the coefficients, which are computed on the first request.
+            std::unique_ptr<std::atomic<const VarInfo<Pol>*>[]> mVarInfosWithCoeffs;
             /// Definiteness of the polynomial in this constraint.
             mutable Definiteness mLhsDefinitess;
-            /// Mutex for access to variable information map.
-            mutable std::mutex mVarInfoMapMutex;
             /// Mutex for access to the factorization.
             mutable std::mutex mFactorizationMutex;
 
@@ -246,9 +252,36 @@ namespace carl
             void initVariableInformations()
             {
                 VariablesInformation<false,Pol> varinfos = mLhs.template getVarInfo<false>();
+                mVarInfoVariables.reserve( mVariables.size() );
+                mVarInfos.reserve( mVariables.size() );
                 for( auto varInfo = varinfos.begin(); varInfo != varinfos.end(); ++varInfo )
-                    mVarInfoMap.emplace_hint( mVarInfoMap.end(), varInfo->first, varInfo->second );
+                {
+                    mVarInfoVariables.push_back( varInfo->first );
+                    mVarInfos.push_back( varInfo->second );
+                }
+                mVarInfosWithCoeffs.reset( new std::atomic<const VarInfo<Pol>*>[mVarInfos.size()] );
+                for( std::size_t i = 0; i < mVarInfos.size(); ++i )
+                    mVarInfosWithCoeffs[i].store( nullptr, std::memory_order_relaxed );
+            }
+            
+            /**
+             * @param _variable The variable to look for.
+             * @return The position of the information about the given variable, or the number of variables if it does not occur.
+             */
+            std::size_t varInfoIndex( const Variable& _variable ) const
+            {
+                auto pos = std::lower_bound( mVarInfoVariables.begin(), mVarInfoVariables.end(), _variable );
+                if( pos == mVarInfoVariables.end() || *pos != _variable )
+                    return mVarInfoVariables.size();
+                return std::size_t( pos - mVarInfoVariables.begin() );
             }
+            
+            /**
+             * @param _index The position of the variable information.
+             * @return The variable information at the given position including the coefficients.
+             *         They are computed on the first call and shared by all later calls.
+             */
+            const VarInfo<Pol>& varInfoWithCoeffs( std::size_t _index ) const;
                
             /**
              * Applies some cheap simplifications to the constraints.
@@ -279,9 +312,31 @@ namespace carl
              */
             uint maxDegree( const Variable& _variable ) const
             {
-                auto varInfo = mVarInfoMap.find(_variable);
-                if (varInfo == mVarInfoMap.end()) return 0;
-                return varInfo->second.maxDegree();
+                std::size_t index = varInfoIndex( _variable );
+                if( index == mVarInfos.size() ) return 0;
+                return mVarInfos[index].maxDegree();
+            }
+            
+            /**
+             * @param _variable The variable for which to determine the minimal degree.
+             * @return The minimal degree of the given variable in this constraint content. (Monomial-wise)
+             */
+            uint minDegree( const Variable& _variable ) const
+            {
+                std::size_t index = varInfoIndex( _variable );
+                if( index == mVarInfos.size() ) return 0;
+                return mVarInfos[index].minDegree();
+            }
+            
+            /**
+             * @param _variable The variable for which to determine the number of occurrences.
+             * @return The number of monomials of this constraint content the given variable occurs in.
+             */
+            uint occurences( const Variable& _variable ) const
+            {
+                std::size_t index = varInfoIndex( _variable );
+                if( index == mVarInfos.size() ) return 0;
+                return mVarInfos[index].occurence();
             }
             
             /**
@@ -290,9 +345,8 @@ namespace carl
             uint maxDegree() const
             {
                 uint result = 0;
-                for (const auto& var: mVariables) {
-                    uint deg = maxDegree(var);
-                    if (deg > result) result = deg;
+                for (const auto& info: mVarInfos) {
+                    if (info.maxDegree() > result) result = info.maxDegree();
                 }
                 return result;
             }
@@ -384,15 +438,17 @@ namespace carl
             /// The content of this constraint.
             const ConstraintContent<Pol>* mpContent;
             
+            /**
+             * Constructs a constraint from content created by the constraint pool.
+             * @param _content The content, the usage registered for it by the pool is taken over.
+             */
             explicit Constraint( const ConstraintContent<Pol>* _content );
             
             #ifdef THREAD_SAFE
-            #define VARINFOMAP_LOCK_GUARD std::lock_guard<std::mutex> lock1( mpContent->mVarInfoMapMutex );
             #define FACTORIZATION_LOCK_GUARD std::lock_guard<std::mutex> lock1( mpContent->mFactorizationMutex );
             #define FACTORIZATION_LOCK mpContent->mFactorizationMutex.lock();
             #define FACTORIZATION_UNLOCK mpContent->mFactorizationMutex.unlock();
             #else
-            #define VARINFOMAP_LOCK_GUARD
             #define FACTORIZATION_LOCK_GUARD
             #define FACTORIZATION_LOCK
             #define FACTORIZATION_UNLOCK
@@ -499,7 +555,6 @@ namespace carl
              */
             uint maxDegree( const Variable& _variable ) const
             {   
-                VARINFOMAP_LOCK_GUARD
                 return mpContent->maxDegree( _variable );
             }
 
@@ -508,7 +563,6 @@ namespace carl
              */
             uint maxDegree() const
             {
-                VARINFOMAP_LOCK_GUARD
                 return mpContent->maxDegree();
             }
 
@@ -518,10 +572,7 @@ namespace carl
              */
             uint minDegree( const Variable& _variable ) const
             {
-                VARINFOMAP_LOCK_GUARD
-                auto varInfo = mpContent->mVarInfoMap.find( _variable );
-                if( varInfo == mpContent->mVarInfoMap.end() ) return 0;
-                return varInfo->second.minDegree();
+                return mpContent->minDegree( _variable );
             }
             
             /**
@@ -531,10 +582,7 @@ namespace carl
              */
             uint occurences( const Variable& _variable ) const
             {
-                VARINFOMAP_LOCK_GUARD
-                auto varInfo = mpContent->mVarInfoMap.find( _variable );
-                if( varInfo == mpContent->mVarInfoMap.end() ) return 0;
-                return varInfo->second.occurence();
+                return mpContent->occurences( _variable );
             }
             
             /**
@@ -543,18 +591,16 @@ namespace carl
              * @return The whole variable information object.
              * Note, that if the given variable is not in this constraints, this method fails.
              * Furthermore, the variable information returned do provide coefficients only, if
-             * the given flag _withCoefficients is set to true.
+             * the given flag _withCoefficients is set to true or they have been requested before.
              */
             const VarInfo<Pol>& varInfo( const Variable& _variable, bool _withCoefficients = false ) const
             {
-                VARINFOMAP_LOCK_GUARD
-                auto varInfo = mpContent->mVarInfoMap.find( _variable );
-                assert( varInfo != mpContent->mVarInfoMap.end() );
-                if( _withCoefficients && !varInfo->second.hasCoeff() )
-                {
-                    varInfo->second = mpContent->mLhs.template getVarInfo<true>( _variable );
-                }
-                return varInfo->second;
+                std::size_t index = mpContent->varInfoIndex( _variable );
+                assert( index != mpContent->mVarInfos.size() );
+                if( _withCoefficients )
+                    return mpContent->varInfoWithCoeffs( index );
+                const VarInfo<Pol>* withCoeffs = mpContent->mVarInfosWithCoeffs[index].load( std::memory_order_acquire );
+                return withCoeffs != nullptr ? *withCoeffs : mpContent->mVarInfos[index];
             }
 			
 			bool relationIsStrict() const {
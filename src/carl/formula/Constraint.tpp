@@ -38,7 +38,9 @@ namespace carl
         mLhs( typename Pol::NumberType( 0 ) ),
         mFactorization(),
         mVariables(),
-        mVarInfoMap(),
+        mVarInfoVariables(),
+        mVarInfos(),
+        mVarInfosWithCoeffs(),
         mLhsDefinitess( Definiteness::NON )
     {}
 
@@ -51,7 +53,9 @@ namespace carl
         mLhs( std::move(_lhs) ),
         mFactorization(),
         mVariables(),
-        mVarInfoMap(),
+        mVarInfoVariables(),
+        mVarInfos(),
+        mVarInfosWithCoeffs(),
         mLhsDefinitess( Definiteness::NON )
     {
         if (mRelation == Relation::GREATER) {
@@ -82,7 +86,27 @@ namespace carl
 
     template<typename Pol>
     ConstraintContent<Pol>::~ConstraintContent()
-    {}
+    {
+        for( std::size_t i = 0; i < mVarInfos.size(); ++i )
+            delete mVarInfosWithCoeffs[i].load( std::memory_order_relaxed );
+    }
+    
+    template<typename Pol>
+    const VarInfo<Pol>& ConstraintContent<Pol>::varInfoWithCoeffs( std::size_t _index ) const
+    {
+        assert( _index < mVarInfos.size() );
+        const VarInfo<Pol>* result = mVarInfosWithCoeffs[_index].load( std::memory_order_acquire );
+        if( result == nullptr )
+        {
+            // Several threads may compute the coefficients concurrently, only the first one publishes its result.
+            const VarInfo<Pol>* varInfo = new VarInfo<Pol>( mLhs.template getVarInfo<true>( mVarInfoVariables[_index] ) );
+            if( mVarInfosWithCoeffs[_index].compare_exchange_strong( result, varInfo, std::memory_order_acq_rel ) )
+                result = varInfo;
+            else
+                delete varInfo;
+        }
+        return *result;
+    }
 
     template<typename Pol>
     unsigned ConstraintContent<Pol>::isConsistent() const
@@ -339,9 +363,7 @@ namespace carl
     template<typename Pol>
     Constraint<Pol>::Constraint( const ConstraintContent<Pol>* _content ):
         mpContent( _content )
-    {
-        ConstraintPool<Pol>::getInstance().reg( mpContent );
-    }
+    {}
     
     template<typename Pol>
     Constraint<Pol>::Constraint( bool _valid ):
@@ -733,15 +755,9 @@ namespace carl
     template<typename Pol>
     Pol Constraint<Pol>::coefficient( const Variable& _var, uint _degree ) const
     {
-        VARINFOMAP_LOCK_GUARD
-        auto varInfo = mpContent->mVarInfoMap.find( _var );
-        assert( varInfo != mpContent->mVarInfoMap.end() );
-        if( !varInfo->second.hasCoeff() )
-        {
-            varInfo->second = lhs().template getVarInfo<true>( _var );
-        }
-        auto d = varInfo->second.coeffs().find( _degree );
-        return d != varInfo->second.coeffs().end() ? d->second : Pol( typename Pol::NumberType( 0 ) );
+        const VarInfo<Pol>& varInfo = this->varInfo( _var, true );
+        auto d = varInfo.coeffs().find( _degree );
+        return d != varInfo.coeffs().end() ? d->second : Pol( typename Pol::NumberType( 0 ) );
     }
 
     template<typename Pol>
@@ -749,21 +765,18 @@ namespace carl
     {
         if( (!_negated && relation() != Relation::EQ) || (_negated && relation() != Relation::NEQ) )
             return false;
-        VARINFOMAP_LOCK_GUARD
-        for( typename map<Variable, VarInfo<Pol>>::iterator varInfoPair = mpContent->mVarInfoMap.begin(); varInfoPair != mpContent->mVarInfoMap.end(); ++varInfoPair )
+        for( std::size_t i = 0; i < mpContent->mVarInfos.size(); ++i )
         {
-			if (varInfoPair->first == _exclude) continue;
-            if( varInfoPair->second.maxDegree() == 1 )
+            const Variable& var = mpContent->mVarInfoVariables[i];
+			if (var == _exclude) continue;
+            if( mpContent->mVarInfos[i].maxDegree() == 1 )
             {
-                if( !varInfoPair->second.hasCoeff() )
-                {
-                    varInfoPair->second = lhs().template getVarInfo<true>( varInfoPair->first );
-                }
-                auto d = varInfoPair->second.coeffs().find( 1 );
-                assert( d != varInfoPair->second.coeffs().end() );
-                if( d->second.isConstant() && (varInfoPair->first.getType() != carl::VariableType::VT_INT || carl::isOne(carl::abs( d->second.constantPart() ))) )
+                const VarInfo<Pol>& varInfo = mpContent->varInfoWithCoeffs( i );
+                auto d = varInfo.coeffs().find( 1 );
+                assert( d != varInfo.coeffs().end() );
+                if( d->second.isConstant() && (var.getType() != carl::VariableType::VT_INT || carl::isOne(carl::abs( d->second.constantPart() ))) )
                 {
-                    _substitutionVariable = varInfoPair->first;
+                    _substitutionVariable = var;
                     _substitutionTerm = makePolynomial<Pol>( _substitutionVariable ) * d->second - lhs();
                     _substitutionTerm /= d->second.constantPart();
                     return true;
@@ -820,11 +833,12 @@ namespace carl
         _out << "   The maximal degree:      " << (lhs().isZero() ? 0 : lhs().totalDegree()) << endl;
         _out << "   The constant part:       " << constantPart() << endl;
         _out << "   Variables:" << endl;
-        for( auto vi = mpContent->mVarInfoMap.begin(); vi != mpContent->mVarInfoMap.end(); ++vi )
+        for( std::size_t i = 0; i < mpContent->mVarInfos.size(); ++i )
         {
-            _out << "        " << vi->first << " has " << vi->second.occurence() << " occurences." << endl;
-            _out << "        " << vi->first << " has the maximal degree of " << vi->second.maxDegree() << "." << endl;
-            _out << "        " << vi->first << " has the minimal degree of " << vi->second.minDegree() << "." << endl;
+            const Variable& var = mpContent->mVarInfoVariables[i];
+            _out << "        " << var << " has " << mpContent->mVarInfos[i].occurence() << " occurences." << endl;
+            _out << "        " << var << " has the maximal degree of " << mpContent->mVarInfos[i].maxDegree() << "." << endl;
+            _out << "        " << var << " has the minimal degree of " << mpContent->mVarInfos[i].minDegree() << "." << endl;
         }
     }
 }    // namespace carl
@@ -11,9 +11,11 @@
 
 #include "../util/Singleton.h"
 #include "../util/Common.h"
+#include "../util/ConcurrentPointerSet.h"
 #include "Constraint.h"
+#include <atomic>
 #include <limits>
-#include <mutex>
+#include <vector>
 
 namespace carl
 {
@@ -24,35 +26,22 @@ namespace carl
         private:
             // Members:
 
-            /// A flag indicating whether the last constraint which has been tried to add to the pool, was already an element of it.
-            bool mLastConstructedConstraintWasKnown;
+            /// A flag indicating whether the last constraint which has been tried to add to the pool by this thread, was already an element of it.
+            static thread_local bool tLastConstructedConstraintWasKnown;
             /// id allocator
-            unsigned mIdAllocator;
+            std::atomic<std::size_t> mIdAllocator;
             /// The constraint (0=0) representing a valid constraint.
             const ConstraintContent<Pol>* mConsistentConstraint;
             /// The constraint (0>0) representing an inconsistent constraint.
             const ConstraintContent<Pol>* mInconsistentConstraint;
-            /// Mutex to avoid multiple access to the pool
-            mutable std::recursive_mutex mMutexPool;
-            /// The constraint pool.
-            FastPointerSet<ConstraintContent<Pol>> mConstraints;
+            /// The constraint pool, which can be searched without locking.
+            ConcurrentPointerSet<ConstraintContent<Pol>> mConstraints;
             /// Pointer to the polynomial cache, if cache is needed of the polynomial type, otherwise, it is nullptr.
             std::shared_ptr<typename Pol::CACHE> mpPolynomialCache;
             
-            #ifdef THREAD_SAFE
-            #define CONSTRAINT_POOL_LOCK_GUARD std::lock_guard<std::recursive_mutex> lock1( mMutexPool );
-            #define CONSTRAINT_POOL_LOCK mMutexPool.lock();
-            #define CONSTRAINT_POOL_UNLOCK mMutexPool.unlock();
-            #else
-            #define CONSTRAINT_POOL_LOCK_GUARD
-            #define CONSTRAINT_POOL_LOCK
-            #define CONSTRAINT_POOL_UNLOCK
-            #endif
-            
             /**
              * Creates a normalized constraint, which has the same solutions as the constraint consisting of the given
              * left-hand side and relation symbol.
-             * Note, that this method uses the allocator which is locked before calling.
              * @param _var The left-hand side of the constraint before normalization,
              * @param _rel The relation symbol of the constraint before normalization,
              * @param _bound
@@ -63,7 +52,6 @@ namespace carl
             /**
              * Creates a normalized constraint, which has the same solutions as the constraint consisting of the given
              * left-hand side and relation symbol.
-             * Note, that this method uses the allocator which is locked before calling.
              * @param _lhs The left-hand side of the constraint before normalization,
              * @param _rel The relation symbol of the constraint before normalization,
              * @return The constructed constraint.
@@ -72,14 +60,49 @@ namespace carl
             
             /**
              * Adds the given constraint to the pool, if it does not yet occur in there.
-             * Note, that this method uses the allocator which is locked before calling.
              * @sideeffect The given constraint will be deleted, if it already occurs in the pool.
              * @param _constraint The constraint to add to the pool.
              * @return The given constraint, if it did not yet occur in the pool;
              *          The equivalent constraint already occurring in the pool.
+             *          A usage of the returned constraint is registered for the caller.
              */
             const ConstraintContent<Pol>* addConstraintToPool( ConstraintContent<Pol>* _constraint );
             
+            /**
+             * Looks up the given constraint and inserts it, if it is not yet contained.
+             * @sideeffect The given constraint will be deleted, if it already occurs in the pool.
+             * @param _constraint A constraint that contains variables and is already simplified.
+             * @return The constraint in the pool, a usage of which is registered for the caller.
+             */
+            const ConstraintContent<Pol>* insert( ConstraintContent<Pol>* _constraint );
+            
+            /**
+             * Registers a usage of the given constraint, which has been found in the pool without holding a reference to it.
+             * @param _cc The constraint to register.
+             * @return false, if the constraint is currently being destructed.
+             */
+            static bool tryReg( const ConstraintContent<Pol>* _cc )
+            {
+                std::size_t usages = _cc->mUsages.load();
+                do
+                {
+                    if( usages == 0 )
+                        return false;
+                }
+                while( !_cc->mUsages.compare_exchange_weak( usages, usages + 1 ) );
+                return true;
+            }
+            
+            /**
+             * Destructs the removed constraints, as soon as no concurrent lookup can access them anymore.
+             */
+            void collectGarbage()
+            {
+                mConstraints.collect( []( const ConstraintContent<Pol>* _cc ) {
+                    delete _cc;
+                } );
+            }
+            
             /**
              * @return A pointer to the constraint which represents any constraint for which it is easy to 
              *          decide, whether it is consistent, e.g. 0=0, -1!=0, x^2+1>0
@@ -114,24 +137,31 @@ namespace carl
             ~ConstraintPool();
 
             /**
+             * The iteration does not lock the pool: constraints that are added or freed concurrently may or may not be visited.
+             * The visited constraints are not destructed while the iterator exists, but a usage must be registered to keep them beyond.
              * @return An iterator to the first constraint in this pool.
              */
-            typename FastPointerSet<ConstraintContent<Pol>>::const_iterator begin() const
+            typename ConcurrentPointerSet<ConstraintContent<Pol>>::const_iterator begin() const
             {
-                // TODO: Will begin() be valid if we insert elements?
-                CONSTRAINT_POOL_LOCK_GUARD
-                auto result = mConstraints.begin();
-                return result;
+                return mConstraints.begin();
             }
 
             /**
              * @return An iterator to the end of the container of the constraints in this pool.
              */
-            typename FastPointerSet<ConstraintContent<Pol>>::const_iterator end() const
+            typename ConcurrentPointerSet<ConstraintContent<Pol>>::const_iterator end() const
+            {
+                return mConstraints.end();
+            }
+
+            /**
+             * @return Copies of all constraints currently stored in the pool, each of which holds a usage.
+             */
+            std::vector<Constraint<Pol>> allConstraints() const
             {
-                // TODO: Will end() be changed if we insert elements?
-                CONSTRAINT_POOL_LOCK_GUARD
-                auto result = mConstraints.end();
+                std::vector<Constraint<Pol>> result;
+                for( const ConstraintContent<Pol>* cc : mConstraints.snapshot( &ConstraintPool<Pol>::tryReg ) )
+                    result.push_back( Constraint<Pol>( cc ) );
                 return result;
             }
 
@@ -140,9 +170,7 @@ namespace carl
              */
             size_t size() const
             {
-                CONSTRAINT_POOL_LOCK_GUARD
-                size_t result = mConstraints.size();
-                return result;
+                return mConstraints.size();
             }
             
             /**
@@ -151,7 +179,7 @@ namespace carl
              */
             bool lastConstructedConstraintWasKnown() const
             {
-                return mLastConstructedConstraintWasKnown;
+                return tLastConstructedConstraintWasKnown;
             }
             
             const std::shared_ptr<typename Pol::CACHE>& pPolynomialCache() const
@@ -160,14 +188,12 @@ namespace carl
             }
 
             /**
-             * Note: This method makes the other accesses to the constraint pool waiting.
              * @return The highest degree occurring in all constraints
              */
             std::size_t maxDegree() const
             {
                 std::size_t result = 0;
-                CONSTRAINT_POOL_LOCK_GUARD
-                for( auto constraint = mConstraints.begin(); constraint != mConstraints.end(); ++constraint )
+                for( auto constraint = begin(); constraint != end(); ++constraint )
                 {
                     std::size_t maxdeg = (*constraint)->mLhs.isZero() ? 0 : (*constraint)->mLhs.totalDegree();
                     if(maxdeg > result) 
@@ -177,14 +203,12 @@ namespace carl
             }
             
             /**
-             * Note: This method makes the other accesses to the constraint pool waiting.
              * @return The number of non-linear constraints in the pool.
              */
             unsigned nrNonLinearConstraints() const
             {
                 unsigned nonlinear = 0;
-                CONSTRAINT_POOL_LOCK_GUARD
-                for( auto constraint = mConstraints.begin(); constraint != mConstraints.end(); ++constraint )
+                for( auto constraint = begin(); constraint != end(); ++constraint )
                 {
                     if( !(*constraint)->mLhs.isLinear() ) 
                         ++nonlinear;
@@ -230,7 +254,9 @@ namespace carl
              */
             const ConstraintContent<Pol>* create( bool _true )
             {
-                return _true ? consistentConstraint() : inconsistentConstraint();
+                const ConstraintContent<Pol>* result = _true ? consistentConstraint() : inconsistentConstraint();
+                reg( result );
+                return result;
             }
             
             const ConstraintContent<Pol>* create( carl::Variable::Arg _var, Relation _rel )
@@ -246,19 +272,18 @@ namespace carl
             
             void free( const ConstraintContent<Pol>* _cc ) noexcept
             {
-                CONSTRAINT_POOL_LOCK_GUARD
                 assert( _cc->mUsages > 0 );
-                --_cc->mUsages;
-                if( _cc->mUsages == 0 )
+                if( --_cc->mUsages == 0 )
                 {
-                    mConstraints.erase( _cc );
-                    delete _cc;
+                    // Lookups do not acquire the constraint anymore, hence nobody else removes it.
+                    mConstraints.erase( _cc, []( const ConstraintContent<Pol>* ) { return true; } );
+                    mConstraints.retire( _cc );
+                    collectGarbage();
                 }
             }
             
             void reg( const ConstraintContent<Pol>* _cc ) const
             {
-                CONSTRAINT_POOL_LOCK_GUARD
                 assert( _cc->mUsages < std::numeric_limits<size_t>::max() );
                 ++_cc->mUsages;
             }
@@ -277,6 +302,8 @@ namespace carl
      template<typename Pol>
      const ConstraintPool<Pol>& constraintPool();
     
+    template<typename Pol>
+    thread_local bool ConstraintPool<Pol>::tLastConstructedConstraintWasKnown = false;
 }    // namespace carl
 
 #include "ConstraintPool.tpp"
@@ -17,11 +17,10 @@ namespace carl
     template<typename Pol>
     ConstraintPool<Pol>::ConstraintPool( unsigned _capacity ):
         Singleton<ConstraintPool<Pol>>(),
-        mLastConstructedConstraintWasKnown( false ),
         mIdAllocator( 1 ),
         mConsistentConstraint( new ConstraintContent<Pol>( Pol( typename Pol::NumberType( 0 ) ), Relation::EQ, 1 ) ),
         mInconsistentConstraint( new ConstraintContent<Pol>( Pol( typename Pol::NumberType( 0 ) ), Relation::LESS, 2 ) ),
-        mConstraints(),
+        mConstraints( _capacity ),
         mpPolynomialCache(nullptr)
     {
         VariablePool::getInstance();
@@ -37,18 +36,19 @@ namespace carl
 		 * Thereby, destroying the constraints (and the Monomials contained) works correctly.
 		 */
 		MonomialPool::getInstance();
-        mConstraints.reserve( _capacity );
-        mConstraints.insert( mConsistentConstraint );
-        mConstraints.insert( mInconsistentConstraint );
         mConsistentConstraint->mUsages = 1; // avoids deleting it
         mInconsistentConstraint->mUsages = 1; // avoids deleting it
+        auto noAcquire = []( const ConstraintContent<Pol>* ) { return false; };
+        auto noPrepare = []( const ConstraintContent<Pol>* ) {};
+        mConstraints.insert( mConsistentConstraint, noAcquire, noPrepare );
+        mConstraints.insert( mInconsistentConstraint, noAcquire, noPrepare );
         mIdAllocator = 3;
     }
 
     template<typename Pol>
     ConstraintPool<Pol>::~ConstraintPool()
     {
-        mConstraints.clear();
+        collectGarbage();
         delete mConsistentConstraint;
         delete mInconsistentConstraint;
     }
@@ -56,38 +56,22 @@ namespace carl
     template<typename Pol>
     void ConstraintPool<Pol>::clear()
     {
-        CONSTRAINT_POOL_LOCK_GUARD
         mIdAllocator = 3;
     }
     
     template<typename Pol>
     const ConstraintContent<Pol>* ConstraintPool<Pol>::create( const Variable& _var, const Relation _rel, const typename Pol::NumberType& _bound )
     {
-        CONSTRAINT_POOL_LOCK_GUARD
         ConstraintContent<Pol>* constraint = createNormalizedBound( _var, _rel, _bound );
-        auto iterBoolPair = mConstraints.insert( constraint );
-        if( iterBoolPair.second )
-        {
-            constraint->mVariables.insert(_var);
-            constraint->initEager();
-            constraint->mID = mIdAllocator;
-            ++mIdAllocator;
-            mLastConstructedConstraintWasKnown = false;
-        }
-        else
-        {
-            mLastConstructedConstraintWasKnown = true;
-            delete constraint;
-        }
-        return *iterBoolPair.first;
+        constraint->mVariables.insert(_var);
+        return insert( constraint );
     }
 
     template<typename Pol>
     const ConstraintContent<Pol>* ConstraintPool<Pol>::create( const Pol& _lhs, Relation _rel )
     {
-        CONSTRAINT_POOL_LOCK_GUARD
         if( _lhs.isConstant() )
-            return evaluate( _lhs.constantPart(), _rel ) ? mConsistentConstraint : mInconsistentConstraint;
+            return create( evaluate( _lhs.constantPart(), _rel ) );
         if( _lhs.totalDegree() == 1 && (_rel != Relation::EQ && _rel != Relation::NEQ) && _lhs.isUnivariate() )
         {
             if( carl::isNegative( _lhs.lcoeff() ) )
@@ -214,66 +198,62 @@ namespace carl
     template<typename Pol>
     const ConstraintContent<Pol>* ConstraintPool<Pol>::addConstraintToPool( ConstraintContent<Pol>* _constraint )
     {
-        mLastConstructedConstraintWasKnown = false;
         unsigned constraintConsistent = _constraint->isConsistent();
 //        cout << *_constraint << " is consistent: " << constraintConsistent << endl;
 		///@todo Use appropriate constant instead of 2.
         if( constraintConsistent == 2 ) // Constraint contains variables.
         {
-            auto iterBoolPair = mConstraints.insert( _constraint );
-            if( !iterBoolPair.second ) // Constraint has already been generated.
+            const ConstraintContent<Pol>* result = mConstraints.find( _constraint, &ConstraintPool<Pol>::tryReg );
+            if( result != nullptr ) // Constraint has already been generated.
             {
-                mLastConstructedConstraintWasKnown = true;
+                tLastConstructedConstraintWasKnown = true;
                 delete _constraint;
+                return result;
             }
-            else
+            ConstraintContent<Pol>* constraint = _constraint->simplify();
+            if( constraint != nullptr ) // Constraint could be simplified.
             {
-                ConstraintContent<Pol>* constraint = _constraint->simplify();
-                if( constraint != nullptr ) // Constraint could be simplified.
-                {
-                    mConstraints.erase( iterBoolPair.first );
-                    delete _constraint;
-                    auto iterBoolPairB = mConstraints.insert( constraint );
-                    if( !iterBoolPairB.second ) // Simplified version already exists
-                    {
-                        mLastConstructedConstraintWasKnown = true;
-                        delete constraint;
-                    }
-                    else // Simplified version has not been generated before.
-                    {
-                        constraint->initLazy();
-                        constraint->initEager();
-                        constraint->mID = mIdAllocator;
-                        ++mIdAllocator;
-                    }
-                    assert( (*iterBoolPairB.first)->mUsages < std::numeric_limits<size_t>::max() );
-                    ++(*iterBoolPairB.first)->mUsages;
-                    return *iterBoolPairB.first;
-                }
-                else // Constraint could not be simplified.
-                {
-                    _constraint->initEager();
-                    _constraint->mID = mIdAllocator;
-                    ++mIdAllocator;
-                }
+                delete _constraint;
+                constraint->initLazy();
+                return insert( constraint );
             }
-            return *iterBoolPair.first;
+            return insert( _constraint );
         }
         else // Constraint contains no variables.
         {
-            mLastConstructedConstraintWasKnown = true;
+            tLastConstructedConstraintWasKnown = true;
             delete _constraint;
-            const ConstraintContent<Pol>* result = (constraintConsistent ? mConsistentConstraint : mInconsistentConstraint );
-            return result;
+            return create( constraintConsistent == 1 );
+        }
+    }
+
+    template<typename Pol>
+    const ConstraintContent<Pol>* ConstraintPool<Pol>::insert( ConstraintContent<Pol>* _constraint )
+    {
+        const ConstraintContent<Pol>* result = mConstraints.find( _constraint, &ConstraintPool<Pol>::tryReg );
+        if( result == nullptr )
+        {
+            // Compute the variable information before taking the lock of the pool. If another thread inserts
+            // the same constraint in the meantime, this has been done in vain.
+            _constraint->initEager();
+            result = mConstraints.insert( _constraint, &ConstraintPool<Pol>::tryReg, [this]( const ConstraintContent<Pol>* _cc ) {
+                ConstraintContent<Pol>* cc = const_cast<ConstraintContent<Pol>*>( _cc );
+                cc->mID = mIdAllocator.fetch_add( 1 );
+                // Hold the usage of the caller.
+                cc->mUsages = 1;
+            } ).first;
         }
+        tLastConstructedConstraintWasKnown = result != _constraint;
+        if( result != _constraint ) // Constraint has already been generated.
+            delete _constraint;
+        return result;
     }
 
     template<typename Pol>
     void ConstraintPool<Pol>::print( ostream& _out ) const
     {
-        CONSTRAINT_POOL_LOCK_GUARD
         _out << "Constraint pool:" << endl;
-        for( auto constraint = mConstraints.begin(); constraint != mConstraints.end(); ++constraint )
+        for( auto constraint = begin(); constraint != end(); ++constraint )
             _out << "    " << **constraint << "  [id=" << (*constraint)->mID << ", hash=" << (*constraint)->hash() << ", usages=" << (*constraint)->mUsages << "]" << endl;
         _out << "---------------------------------------------------" << endl;
     }
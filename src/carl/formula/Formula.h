@@ -9,10 +9,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstring>
 #include <functional>
 #include <string>
+#include <memory>
 #include <set>
+#include <typeindex>
+#include <unordered_map>
 #include <boost/dynamic_bitset.hpp>
 #include "Condition.h"
 #include "Constraint.h"
@@ -1066,6 +1070,7 @@ namespace carl
              * @param _tseitinWithEquivalence A flag, which is true, if variables, which are introduced by the tseitin encoding
              *                                are set to be equivalent to the formula they represent. Otherwise, they imply the formula,
              *                                which is also valid, as the current formula context is in NNF.
+             * @see CNFConverter for a conversion that emits the clauses one by one instead of constructing the conjunction.
              */
             Formula toCNF( bool _keepConstraints = true, bool _simplifyConstraintCombinations = false, bool _tseitinWithEquivalence = true ) const;
             
@@ -1160,6 +1165,27 @@ namespace carl
 	 */
 	template<typename Formula>
 	struct FormulaVisitor {
+	private:
+		/// The results of visitResult for the subformulas visited so far, indexed by their ids.
+		std::unordered_map<std::size_t, Formula> mCache;
+		/// Whether the cache is kept across calls of visitResult.
+		bool mKeepCache;
+		
+		Formula visitResultCached(const Formula& formula, const std::function<Formula(Formula)>& func);
+	public:
+		/**
+		 * @param keepCache If true, the results of visitResult are reused by later calls until clearCache() is called.
+		 *                  This is only correct if these calls use equivalent functions.
+		 */
+		explicit FormulaVisitor(bool keepCache = false): mKeepCache(keepCache) {}
+		
+		/**
+		 * Forgets the results of previous calls of visitResult.
+		 */
+		void clearCache() {
+			mCache.clear();
+		}
+		
 		/**
 		 * Recursively calls func on every subformula.
 		 * @param formula Formula to visit.
@@ -1169,6 +1195,7 @@ namespace carl
 		/**
 		 * Recursively calls func on every subformula and return a new formula.
 		 * On every call of func, the passed formula is replaced by the result.
+		 * Subformulas that occur several times are only visited once, hence func should not have side effects.
 		 * @param formula Formula to visit.
 		 * @param func Function to call.
 		 * @return New formula.
@@ -1180,6 +1207,27 @@ namespace carl
     struct FormulaSubstitutor {
     private:
         FormulaVisitor<Formula> visitor;
+        /// Whether the results are reused by later calls with the same replacements.
+        bool mKeepCache;
+        /// The replacements of the previous call, if the cache is kept.
+        std::shared_ptr<const void> mLastReplacements;
+        /// The type of mLastReplacements.
+        std::type_index mLastReplacementsType;
+        
+        /**
+         * Clears the cache of the visitor, unless it is kept and the given replacements equal those of the previous call.
+         */
+        template<typename Map>
+        void prepareCache(const Map& replacements) {
+            if (mKeepCache && mLastReplacementsType == std::type_index(typeid(Map))) {
+                if (*std::static_pointer_cast<const Map>(mLastReplacements) == replacements) return;
+            }
+            visitor.clearCache();
+            if (mKeepCache) {
+                mLastReplacements = std::make_shared<const Map>(replacements);
+                mLastReplacementsType = std::type_index(typeid(Map));
+            }
+        }
 		
 		struct Substitutor {
 			const std::map<Formula,Formula>& replacements;
@@ -1220,6 +1268,13 @@ namespace carl
             }
         };
     public:
+        /**
+         * @param keepCache If true, the results for subformulas are reused by later calls as long as the replacements do not change.
+         */
+        explicit FormulaSubstitutor(bool keepCache = false):
+            visitor(true), mKeepCache(keepCache), mLastReplacements(), mLastReplacementsType(typeid(void))
+        {}
+        
         template<typename Source, typename Target>
         Formula substitute(const Formula& formula, const Source& source, const Target& target) {
             std::map<Source,Target> tmp;
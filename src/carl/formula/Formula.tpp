@@ -1271,62 +1271,33 @@ namespace carl
     template<typename Pol>
     Formula<Pol> Formula<Pol>::substitute( const map<Variable, Formula<Pol>>& _booleanSubstitutions, const map<Variable, Pol>& _arithmeticSubstitutions ) const
     {
-        switch( getType() )
-        {
-            case FormulaType::TRUE:
-            {
-                return *this;
-            }
-            case FormulaType::FALSE:
-            {
-                return *this;
-            }
-            case FormulaType::BOOL:
+        // The visitor substitutes every shared subformula only once.
+        carl::FormulaVisitor<Formula<Pol>> visitor;
+        return visitor.visitResult( *this,
+            [&]( const Formula<Pol>& _f ) -> Formula<Pol>
             {
-                auto iter = _booleanSubstitutions.find( boolean() );
-                if( iter != _booleanSubstitutions.end() )
+                switch( _f.getType() )
                 {
-                    return iter->second;
+                    case FormulaType::BOOL:
+                    {
+                        auto iter = _booleanSubstitutions.find( _f.boolean() );
+                        if( iter != _booleanSubstitutions.end() )
+                        {
+                            return iter->second;
+                        }
+                        return _f;
+                    }
+                    case FormulaType::CONSTRAINT:
+                    {
+                        if( _arithmeticSubstitutions.empty() )
+                            return _f;
+                        Pol lhsSubstituted = _f.constraint().lhs().substitute( _arithmeticSubstitutions );
+                        return Formula<Pol>( lhsSubstituted, _f.constraint().relation() );
+                    }
+                    default:
+                        return _f;
                 }
-                return *this;
-            }
-            case FormulaType::CONSTRAINT:
-            {
-                Pol lhsSubstituted = constraint().lhs().substitute( _arithmeticSubstitutions );
-                return Formula<Pol>( lhsSubstituted, constraint().relation() );
-            }
-            case FormulaType::NOT:
-            {
-                return Formula<Pol>( FormulaType::NOT, subformula().substitute( _booleanSubstitutions, _arithmeticSubstitutions ) );
-            }
-            case FormulaType::IMPLIES:
-            {
-                Formula<Pol> premiseSubstituted = premise().substitute( _booleanSubstitutions, _arithmeticSubstitutions );
-                Formula<Pol> conclusionSubstituted = conclusion().substitute( _booleanSubstitutions, _arithmeticSubstitutions );
-                return Formula<Pol>( FormulaType::IMPLIES, {premiseSubstituted, conclusionSubstituted} );
-            }
-            case FormulaType::ITE:
-            {
-                Formula<Pol> conditionSubstituted = condition().substitute( _booleanSubstitutions, _arithmeticSubstitutions );
-                Formula<Pol> thenSubstituted = firstCase().substitute( _booleanSubstitutions, _arithmeticSubstitutions );
-                Formula<Pol> elseSubstituted = secondCase().substitute( _booleanSubstitutions, _arithmeticSubstitutions );
-                return Formula<Pol>( FormulaType::ITE, {conditionSubstituted, thenSubstituted, elseSubstituted} );
-            }
-            case FormulaType::EXISTS:
-            case FormulaType::FORALL:
-            {
-                std::vector<Variable> vars( quantifiedVariables() );
-                return Formula<Pol>(getType(), std::move( vars ), quantifiedFormula().substitute(_booleanSubstitutions, _arithmeticSubstitutions));
-            }
-            default:
-            {
-                assert( isNary() );
-                Formulas<Pol> subformulasSubstituted;
-                for( const Formula<Pol>& subFormula : subformulas() )
-                    subformulasSubstituted.push_back( subFormula.substitute( _booleanSubstitutions, _arithmeticSubstitutions ) );
-                return Formula<Pol>( getType(), subformulasSubstituted );
-            }
-        }
+            } );
     }
     
 //    #define CONSTRAINT_BOUND_DEBUG
@@ -1837,6 +1808,16 @@ namespace carl
 
 	template<typename Formula>
 	Formula FormulaVisitor<Formula>::visitResult(const Formula& formula, const std::function<Formula(Formula)>& func) {
+		if (!mKeepCache) mCache.clear();
+		Formula result = visitResultCached(formula, func);
+		if (!mKeepCache) mCache.clear();
+		return result;
+	}
+
+	template<typename Formula>
+	Formula FormulaVisitor<Formula>::visitResultCached(const Formula& formula, const std::function<Formula(Formula)>& func) {
+		auto cached = mCache.find(formula.getId());
+		if (cached != mCache.end()) return cached->second;
 		Formula newFormula = formula;
 		switch (formula.getType()) {
 		case AND:
@@ -1846,7 +1827,7 @@ namespace carl
 			Formulas<typename Formula::PolynomialType> newSubformulas;
 			bool changed = false;
 			for (const auto& cur: formula.subformulas()) {
-				Formula newCur = visitResult(cur, func);
+				Formula newCur = visitResultCached(cur, func);
 				if (newCur != cur) changed = true;
 				newSubformulas.push_back(newCur);
 			}
@@ -1856,24 +1837,24 @@ namespace carl
 			break;
 		}
 		case NOT: {
-			Formula cur = visitResult(formula.subformula(), func);
+			Formula cur = visitResultCached(formula.subformula(), func);
 			if (cur != formula.subformula()) {
 				newFormula = Formula(NOT, cur);
 			}
 			break;
 		}
 		case IMPLIES: {
-			Formula prem = visitResult(formula.premise(), func);
-			Formula conc = visitResult(formula.conclusion(), func);
+			Formula prem = visitResultCached(formula.premise(), func);
+			Formula conc = visitResultCached(formula.conclusion(), func);
 			if ((prem != formula.premise()) || (conc != formula.conclusion())) {
 				newFormula = Formula(IMPLIES, {prem, conc});
 			}
 			break;
 		}
 		case ITE: {
-			Formula cond = visitResult(formula.condition(), func);
-			Formula fCase = visitResult(formula.firstCase(), func);
-			Formula sCase = visitResult(formula.secondCase(), func);
+			Formula cond = visitResultCached(formula.condition(), func);
+			Formula fCase = visitResultCached(formula.firstCase(), func);
+			Formula sCase = visitResultCached(formula.secondCase(), func);
 			if ((cond != formula.condition()) || (fCase != formula.firstCase()) || (sCase != formula.secondCase())) {
 				newFormula = Formula(ITE, {cond, fCase, sCase});
 			}
@@ -1891,33 +1872,39 @@ namespace carl
 			break;
 		case EXISTS:
 		case FORALL: {
-			Formula sub = visitResult(formula.quantifiedFormula(), func);
+			Formula sub = visitResultCached(formula.quantifiedFormula(), func);
 			if (sub != formula.quantifiedFormula()) {
 				newFormula = Formula(formula.getType(), formula.quantifiedVariables(), sub);
 			}
 			break;
 		}
 		} 
-		return func(newFormula);
+		Formula result = func(newFormula);
+		mCache.emplace(formula.getId(), result);
+		return result;
 	}
     
 	template<typename Formula>
     Formula FormulaSubstitutor<Formula>::substitute(const Formula& formula, const std::map<Formula,Formula>& replacements) {
+        prepareCache(replacements);
         Substitutor subs(replacements);
         return visitor.visitResult(formula, std::function<Formula(Formula)>(subs));
     }
     template<typename Formula>
     Formula FormulaSubstitutor<Formula>::substitute(const Formula& formula, const std::map<Variable,typename Formula::PolynomialType>& replacements) {
+        prepareCache(replacements);
         PolynomialSubstitutor subs(replacements);
         return visitor.visitResult(formula, std::function<Formula(Formula)>(subs));
     }
     template<typename Formula>
     Formula FormulaSubstitutor<Formula>::substitute(const Formula& formula, const std::map<BVVariable,BVTerm>& replacements) {
+        prepareCache(replacements);
         BitvectorSubstitutor subs(replacements);
         return visitor.visitResult(formula, std::function<Formula(Formula)>(subs));
     }
     template<typename Formula>
     Formula FormulaSubstitutor<Formula>::substitute(const Formula& formula, const std::map<UVariable,UFInstance>& replacements) {
+        prepareCache(replacements);
         UninterpretedSubstitutor subs(replacements);
         return visitor.visitResult(formula, std::function<Formula(Formula)>(subs));
     }
@@ -153,8 +153,8 @@ namespace carl {
             mutable double mActivity = 0.0;
             /// Some value stating an expected difficulty of solving this formula for satisfiability.
             mutable double mDifficulty = 0.0;
-            /// The number of formulas existing with this content.
-            mutable size_t mUsages = 0;
+            /// The number of formulas existing with this content. It is zero once the content is being destructed.
+            mutable std::atomic<std::size_t> mUsages{0};
             /// The type of this formula.
             FormulaType mType;
             /// The content of this formula.
@@ -7,10 +7,13 @@
 
 #pragma once
 
+#include "../util/ConcurrentPointerSet.h"
+#include "../util/SlabArena.h"
 #include "../util/Singleton.h"
 #include "../core/VariablePool.h"
 #include "Formula.h"
 #include "ConstraintPool.h"
+#include <atomic>
 #include <mutex>
 #include <limits>
 #include <boost/variant.hpp>
@@ -22,6 +25,17 @@
 namespace carl
 {
     
+    /**
+     * The pool of all formula contents.
+     *
+     * Formula contents are hash-consed: creating a formula which already exists yields the existing content.
+     * Looking up an existing formula does not take any lock, only inserting a new formula locks a single shard of the pool.
+     * The usage counters are atomic, hence copying and destroying formulas does not lock either.
+     *
+     * The formula contents are allocated from a slab arena. A thread can start its own generation,
+     * such that its formulas are allocated from separate slabs which are given back once the generation
+     * has been released and all its formulas have been freed.
+     */
     template<typename Pol>
     class FormulaPool : public Singleton<FormulaPool<Pol>>
     {
@@ -32,14 +46,18 @@ namespace carl
             
             // Members:
             /// id allocator
-            unsigned mIdAllocator;
+            std::atomic<std::size_t> mIdAllocator;
             /// The unique formula representing true.
             FormulaContent<Pol>* mpTrue;
             /// The unique formula representing false.
             FormulaContent<Pol>* mpFalse;
+            /// The memory of the formula contents.
+            SlabArena<FormulaContent<Pol>> mArena;
             /// The formula pool.
-            FastPointerSet<FormulaContent<Pol>> mPool;
-            /// Mutex to avoid multiple access to the pool
+            ConcurrentPointerSet<FormulaContent<Pol>> mPool;
+            /// The generation the calling thread allocates its formulas from.
+            static thread_local std::size_t tGeneration;
+            /// Mutex to avoid multiple access to the Tseitin variables
             mutable std::recursive_mutex mMutexPool;
             ///
             FastPointerMap<FormulaContent<Pol>,const FormulaContent<Pol>*> mTseitinVars;
@@ -81,12 +99,39 @@ namespace carl
                 return mPool.size();
             }
             
+            /**
+             * Starts a new generation for the calling thread: the formulas created by this thread are
+             * allocated from separate memory from now on, until the generation is released.
+             * @return The new generation.
+             */
+            std::size_t beginGeneration()
+            {
+                tGeneration = mArena.newGeneration();
+                return tGeneration;
+            }
+            
+            /**
+             * Releases the given generation, e.g. when the solver instance using it has finished.
+             * The memory of the generation is given back as soon as its formulas have been freed.
+             * If it is the generation of the calling thread, the thread uses the default generation afterwards.
+             * @param _generation The generation to release.
+             */
+            void releaseGeneration( std::size_t _generation )
+            {
+                if( tGeneration == _generation )
+                    tGeneration = 0;
+                collectGarbage();
+                mArena.releaseGeneration( _generation );
+            }
+            
             void print() const
             {
                 std::cout << "Formula pool contains:" << std::endl;
-                for (const auto& ele: mPool) {
-                    std::cout << ele->mId << " @ " << static_cast<const void*>(ele) << " [usages=" << ele->mUsages << "]: " << *ele << ", negation " << static_cast<const void*>(ele->mNegation) << std::endl;
+                for (const auto& form: allFormulas()) {
+                    const FormulaContent<Pol>* ele = form.mpContent;
+                    std::cout << ele->mId << " @ " << static_cast<const void*>(ele) << " [usages=" << ele->mUsages.load() << "]: " << *ele << ", negation " << static_cast<const void*>(ele->mNegation) << std::endl;
                 }
+                FORMULA_POOL_LOCK_GUARD
                 std::cout << "Tseitin variables:" << std::endl;
                 for( const auto& tvVar : mTseitinVars )
                 {
@@ -110,23 +155,25 @@ namespace carl
             
             Formula<Pol> getTseitinVar( const Formula<Pol>& _formula )
             {
+                FORMULA_POOL_LOCK_GUARD
                 auto iter = mTseitinVars.find( _formula.mpContent );
                 if( iter != mTseitinVars.end() )
                 {
                     return Formula<Pol>( iter->second );
                 }
-                return trueFormula();
+                return Formula<Pol>( trueFormula() );
             }
             
             Formula<Pol> createTseitinVar( const Formula<Pol>& _formula )
             {
+                FORMULA_POOL_LOCK_GUARD
                 auto iter = mTseitinVars.insert( std::make_pair( _formula.mpContent, nullptr ) );
                 if( iter.second )
                 {
-                    const FormulaContent<Pol>* hi = create( carl::freshBooleanVariable() );
-                    hi->mDifficulty = _formula.difficulty();
-                    iter.first->second = hi;
-                    mTseitinVarToFormula[hi] = iter.first;
+                    Formula<Pol> hi = create( carl::freshBooleanVariable() );
+                    hi.mpContent->mDifficulty = _formula.difficulty();
+                    iter.first->second = hi.mpContent;
+                    mTseitinVarToFormula[hi.mpContent] = iter.first;
                 }
                 return Formula<Pol>( iter.first->second );
             }
@@ -166,15 +213,23 @@ namespace carl
                 return f;
             }
 
-            FormulaContent<Pol>* createNegatedContent(const FormulaContent<Pol>* f) const {
+            /**
+             * Allocates a new formula content in the generation of the calling thread.
+             */
+            template<typename... Args>
+            FormulaContent<Pol>* newContent(Args&&... _args) {
+                return new (mArena.allocate(tGeneration)) FormulaContent<Pol>(std::forward<Args>(_args)...);
+            }
+
+            FormulaContent<Pol>* createNegatedContent(const FormulaContent<Pol>* f) {
                 if (f->mType == FormulaType::CONSTRAINT) {
 #ifdef __VS
-                    return new FormulaContent<Pol>(f->mpConstraintVS->negation());
+                    return newContent(f->mpConstraintVS->negation());
 #else
-                    return new FormulaContent<Pol>(f->mConstraint.negation());
+                    return newContent(f->mConstraint.negation());
 #endif
                 } else {
-                    return new FormulaContent<Pol>(NOT, std::move(Formula<Pol>(f)));
+                    return newContent(NOT, std::move(Formula<Pol>(f)));
                 }
             }
 
@@ -185,9 +240,9 @@ namespace carl
              * @param _type Formula type, may be either TRUE or FALSE.
              * @return A formula representing the given bool.
              */
-            const FormulaContent<Pol>* create(FormulaType _type) {
+            Formula<Pol> create(FormulaType _type) {
                 assert(_type == TRUE || _type == FALSE);
-                return (_type == TRUE) ? trueFormula() : falseFormula();
+                return Formula<Pol>((_type == TRUE) ? trueFormula() : falseFormula());
             }
 
             /**
@@ -195,57 +250,57 @@ namespace carl
              * @param _booleanVar The Boolean variable wrapped by this formula.
              * @return A formula with wrapping the given Boolean variable.
              */
-            const FormulaContent<Pol>* create(Variable::Arg _variable) {
-                return add(new FormulaContent<Pol>(_variable));
+            Formula<Pol> create(Variable::Arg _variable) {
+                return add(newContent(_variable));
             }
             
             /**
              * @param _constraint The constraint wrapped by this formula.
              * @return A formula with wrapping the given constraint.
              */
-            const FormulaContent<Pol>* create(Constraint<Pol>&& _constraint) {
+            Formula<Pol> create(Constraint<Pol>&& _constraint) {
                 #ifdef SIMPLIFY_FORMULA
                 switch (_constraint.isConsistent()) {
-                    case 0: return falseFormula();
-                    case 1: return trueFormula();
+                    case 0: return Formula<Pol>(falseFormula());
+                    case 1: return Formula<Pol>(trueFormula());
                     default: ;
                 }
                 #endif
                 if (isBaseFormula(_constraint)) {
-                    return add(new FormulaContent<Pol>(std::move(_constraint)));
+                    return add(newContent(std::move(_constraint)));
                 } else {
-                    return add(new FormulaContent<Pol>(_constraint.negation()))->mNegation;
+                    return Formula<Pol>(add(newContent(_constraint.negation())).mpContent->mNegation);
                 }
             }
-            const FormulaContent<Pol>* create(const Constraint<Pol>& _constraint) {
+            Formula<Pol> create(const Constraint<Pol>& _constraint) {
                 return create(std::move(Constraint<Pol>(_constraint)));
             }
-			const FormulaContent<Pol>* create(VariableComparison<Pol>&& _variableComparison) {
-                return add(new FormulaContent<Pol>(std::move(_variableComparison)));
+			Formula<Pol> create(VariableComparison<Pol>&& _variableComparison) {
+                return add(newContent(std::move(_variableComparison)));
             }
-            const FormulaContent<Pol>* create(const VariableComparison<Pol>& _variableComparison) {
+            Formula<Pol> create(const VariableComparison<Pol>& _variableComparison) {
 				auto val = _variableComparison.asConstraint();
 				if (val) return create(*val);
                 return create(std::move(VariableComparison<Pol>(_variableComparison)));
             }
-			const FormulaContent<Pol>* create(VariableAssignment<Pol>&& _variableAssignment) {
-                return add(new FormulaContent<Pol>(std::move(_variableAssignment)));
+			Formula<Pol> create(VariableAssignment<Pol>&& _variableAssignment) {
+                return add(newContent(std::move(_variableAssignment)));
             }
-            const FormulaContent<Pol>* create(const VariableAssignment<Pol>& _variableAssignment) {
+            Formula<Pol> create(const VariableAssignment<Pol>& _variableAssignment) {
 				return create(std::move(VariableAssignment<Pol>(_variableAssignment)));
             }
             
-            const FormulaContent<Pol>* create(BVConstraint&& _constraint) {
+            Formula<Pol> create(BVConstraint&& _constraint) {
                 #ifdef SIMPLIFY_FORMULA
-                if (_constraint.isAlwaysConsistent()) return trueFormula();
-                if (_constraint.isAlwaysInconsistent()) return falseFormula();
+                if (_constraint.isAlwaysConsistent()) return Formula<Pol>(trueFormula());
+                if (_constraint.isAlwaysInconsistent()) return Formula<Pol>(falseFormula());
                 #endif
-                return add(new FormulaContent<Pol>(std::move(_constraint)));
+                return add(newContent(std::move(_constraint)));
             }
-            const FormulaContent<Pol>* create(const BVConstraint& _constraint) {
+            Formula<Pol> create(const BVConstraint& _constraint) {
                 return create(std::move(BVConstraint(_constraint)));
             }
-			const FormulaContent<Pol>* create(const PBConstraint<Pol>& _constraint) {
+			Formula<Pol> create(const PBConstraint<Pol>& _constraint) {
                 return create(std::move(PBConstraint<Pol>(_constraint)));
             }
             
@@ -256,7 +311,7 @@ namespace carl
              * @param _subFormula Formula representing the function argument.
              * @return A formula representing the given function call.
              */
-            const FormulaContent<Pol>* create(FormulaType _type, Formula<Pol>&& _subFormula) {
+            Formula<Pol> create(FormulaType _type, Formula<Pol>&& _subFormula) {
                 switch (_type) {
                     case ITE:
                     case EXISTS:
@@ -269,13 +324,13 @@ namespace carl
                     case BOOL:
                         assert(false); break;
                     case NOT:
-                        return _subFormula.mpContent->mNegation;
+                        return Formula<Pol>(_subFormula.mpContent->mNegation);
                     case IMPLIES:
                         assert(false); break;
                     case AND:
                     case OR:
                     case XOR:
-                        return _subFormula.mpContent;
+                        return std::move(_subFormula);
                     case IFF:
                         return create(TRUE);
 
@@ -290,7 +345,7 @@ namespace carl
 					case PBCONSTRAINT:
                         assert(false); break;
                 }
-                return nullptr;
+                return Formula<Pol>(static_cast<const FormulaContent<Pol>*>(nullptr));
             }
             
             /**
@@ -299,13 +354,13 @@ namespace carl
              * @param _subformulas Formula representing the function arguments.
              * @return A formula representing the given function call.
              */
-            const FormulaContent<Pol>* create(FormulaType _type, const Formulas<Pol>& _subformulas) {
+            Formula<Pol> create(FormulaType _type, const Formulas<Pol>& _subformulas) {
                 return create(_type, std::move(Formulas<Pol>(_subformulas)));
             }
-            const FormulaContent<Pol>* create(FormulaType _type, const std::initializer_list<Formula<Pol>>& _subformulas) {
+            Formula<Pol> create(FormulaType _type, const std::initializer_list<Formula<Pol>>& _subformulas) {
                 return create(_type, std::move(Formulas<Pol>(_subformulas.begin(), _subformulas.end())));
             }
-            const FormulaContent<Pol>* create(FormulaType _type, Formulas<Pol>&& _subformulas) {
+            Formula<Pol> create(FormulaType _type, Formulas<Pol>&& _subformulas) {
                 switch (_type) {
                     case ITE:
                         return createITE(std::move(_subformulas));
@@ -337,7 +392,7 @@ namespace carl
 					case PBCONSTRAINT:
                         assert(false); break;
                 }
-                return nullptr;
+                return Formula<Pol>(static_cast<const FormulaContent<Pol>*>(nullptr));
             }
     
             /**
@@ -345,11 +400,11 @@ namespace carl
              * @param _subformulas
              * @return 
              */
-            const FormulaContent<Pol>* createImplication(Formulas<Pol>&& _subformulas);
+            Formula<Pol> createImplication(Formulas<Pol>&& _subformulas);
             
-            const FormulaContent<Pol>* createNAry(FormulaType _type, Formulas<Pol>&& _subformulas);
+            Formula<Pol> createNAry(FormulaType _type, Formulas<Pol>&& _subformulas);
 
-            const FormulaContent<Pol>* createITE(Formulas<Pol>&& _subformulas);
+            Formula<Pol> createITE(Formulas<Pol>&& _subformulas);
             
 			/**
 			 *
@@ -358,12 +413,12 @@ namespace carl
 			 * @param _term
 			 * @return
 			 */
-			const FormulaContent<Pol>* create(FormulaType _type, std::vector<Variable>&& _vars, const Formula<Pol>& _term) {
+			Formula<Pol> create(FormulaType _type, std::vector<Variable>&& _vars, const Formula<Pol>& _term) {
 				assert(_type == FormulaType::EXISTS || _type == FormulaType::FORALL);
 				if (_vars.size() > 0) {
-					return add( new FormulaContent<Pol>(_type, std::move(_vars), _term ) );
+					return add( newContent(_type, std::move(_vars), _term ) );
 				} else {
-					return _term.mpContent;
+					return _term;
 				}
 			}
             
@@ -371,12 +426,12 @@ namespace carl
              * @param _subformulas The sub-formulas of the formula to create.
              * @return A formula with the given operator and sub-formulas.
              */
-            const FormulaContent<Pol>* create( const FormulasMulti<Pol>& _subformulas )
+            Formula<Pol> create( const FormulasMulti<Pol>& _subformulas )
             {
-                if( _subformulas.empty() ) return falseFormula();
+                if( _subformulas.empty() ) return Formula<Pol>( falseFormula() );
                 if( _subformulas.size() == 1 )
                 {
-                    return _subformulas.begin()->mpContent;
+                    return *_subformulas.begin();
                 }
                 Formulas<Pol> subFormulas;
                 auto lastSubFormula = _subformulas.begin();
@@ -407,77 +462,90 @@ namespace carl
                 return create( FormulaType::XOR, std::move( subFormulas ) );
             }
             
-			const FormulaContent<Pol>* create( const UEquality::Arg& _lhs, const UEquality::Arg& _rhs, bool _negated )
+			Formula<Pol> create( const UEquality::Arg& _lhs, const UEquality::Arg& _rhs, bool _negated )
 			{
                 #ifdef SIMPLIFY_FORMULA
                 if( boost::apply_visitor(UEquality::IsUVariable(), _lhs) && boost::apply_visitor(UEquality::IsUVariable(), _rhs) )
                 {
                     if( boost::get<UVariable>(_lhs) < boost::get<UVariable>(_rhs) )
-                        return add( new FormulaContent<Pol>( UEquality( boost::get<UVariable>(_lhs), boost::get<UVariable>(_rhs), _negated, true ) ) );
+                        return add( newContent( UEquality( boost::get<UVariable>(_lhs), boost::get<UVariable>(_rhs), _negated, true ) ) );
                     if( boost::get<UVariable>(_rhs) < boost::get<UVariable>(_lhs) )
-                        return add( new FormulaContent<Pol>( UEquality( boost::get<UVariable>(_rhs), boost::get<UVariable>(_lhs), _negated, true ) ) );
+                        return add( newContent( UEquality( boost::get<UVariable>(_rhs), boost::get<UVariable>(_lhs), _negated, true ) ) );
                     else if( _negated )
-                        return falseFormula();
+                        return Formula<Pol>( falseFormula() );
                     else
-                        return trueFormula();
+                        return Formula<Pol>( trueFormula() );
                 }
 				else if( boost::apply_visitor(UEquality::IsUVariable(), _lhs) && boost::apply_visitor(UEquality::IsUFInstance(), _rhs) )
                 {
-                    return add( new FormulaContent<Pol>( UEquality( boost::get<UVariable>(_lhs), boost::get<UFInstance>(_rhs), _negated ) ) );
+                    return add( newContent( UEquality( boost::get<UVariable>(_lhs), boost::get<UFInstance>(_rhs), _negated ) ) );
                 }
                 else if( boost::apply_visitor(UEquality::IsUFInstance(), _lhs) && boost::apply_visitor(UEquality::IsUVariable(), _rhs) )
                 {
-                    return add( new FormulaContent<Pol>( UEquality( boost::get<UVariable>(_rhs), boost::get<UFInstance>(_lhs), _negated ) ) );
+                    return add( newContent( UEquality( boost::get<UVariable>(_rhs), boost::get<UFInstance>(_lhs), _negated ) ) );
                 }
                 else
                 {
                     assert( boost::apply_visitor(UEquality::IsUFInstance(), _lhs) && boost::apply_visitor(UEquality::IsUFInstance(), _rhs) );
                     if( boost::get<UFInstance>(_lhs) < boost::get<UFInstance>(_rhs) )
-                        return add( new FormulaContent<Pol>( UEquality( boost::get<UFInstance>(_lhs), boost::get<UFInstance>(_rhs), _negated, true ) ) );
+                        return add( newContent( UEquality( boost::get<UFInstance>(_lhs), boost::get<UFInstance>(_rhs), _negated, true ) ) );
                     if( boost::get<UFInstance>(_rhs) < boost::get<UFInstance>(_lhs) )
-                        return add( new FormulaContent<Pol>( UEquality( boost::get<UFInstance>(_rhs), boost::get<UFInstance>(_lhs), _negated, true ) ) );
+                        return add( newContent( UEquality( boost::get<UFInstance>(_rhs), boost::get<UFInstance>(_lhs), _negated, true ) ) );
                     else if( _negated )
-                        return falseFormula();
+                        return Formula<Pol>( falseFormula() );
                     else
-                        return trueFormula();
+                        return Formula<Pol>( trueFormula() );
                 }
                 #else
-                return add( new FormulaContent<Pol>( UEquality( _lhs, _rhs, _negated ) ) );
+                return add( newContent( UEquality( _lhs, _rhs, _negated ) ) );
                 #endif
 			}
 
-			const FormulaContent<Pol>* create( UEquality&& eq )
+			Formula<Pol> create( UEquality&& eq )
 			{
-				return add( new FormulaContent<Pol>( std::move( eq ) ) );
+				return add( newContent( std::move( eq ) ) );
 			}
 			
-			const FormulaContent<Pol>* create( PBConstraint<Pol>&& pbc )
+			Formula<Pol> create( PBConstraint<Pol>&& pbc )
 			{
-				return add( new FormulaContent<Pol>( std::move( pbc ) ) );
+				return add( newContent( std::move( pbc ) ) );
 			}
             
             void free( const FormulaContent<Pol>* _elem )
             {
-                FORMULA_POOL_LOCK_GUARD
                 const FormulaContent<Pol>* tmp = getBaseFormula(_elem);
                 //const FormulaContent<Pol>* tmp = _elem->mType == FormulaType::NOT ? _elem->mNegation : _elem;
-                CARL_LOG_DEBUG("carl.formula", "Freeing " << static_cast<const void*>(tmp) << ", current usage: " << tmp->mUsages);
-                assert( tmp->mUsages > 0 );
-                --tmp->mUsages;
-                if( tmp->mUsages == 1 )
+                CARL_LOG_DEBUG("carl.formula", "Freeing " << static_cast<const void*>(tmp) << ", current usage: " << tmp->mUsages.load());
+                std::size_t usages = tmp->mUsages.load();
+                while( usages > 2 )
                 {
+                    if( tmp->mUsages.compare_exchange_weak( usages, usages - 1 ) )
+                        return;
+                }
+                {
+                    // We may drop the last usage. As another thread may revive the formula and remove it concurrently,
+                    // we pin the pool such that the formula is not destructed while we access it.
+                    typename ConcurrentPointerSet<FormulaContent<Pol>>::Pin pin( mPool );
+                    usages = tmp->mUsages.load();
+                    do
+                    {
+                        // The formula is already being destructed, this is the usage by its negation.
+                        if( usages == 0 )
+                            return;
+                    }
+                    while( !tmp->mUsages.compare_exchange_weak( usages, usages - 1 ) );
+                    if( usages != 2 )
+                        return;
+                    FORMULA_POOL_LOCK_GUARD
                     bool stillStoredAsTseitinVariable = false;
                     if( freeTseitinVariable( tmp ) )
                         stillStoredAsTseitinVariable = true;
                     if( freeTseitinVariable( tmp->mNegation ) )
                         stillStoredAsTseitinVariable = true;
                     if( !stillStoredAsTseitinVariable )
-                    {
-                        mPool.erase( tmp );
-                        delete tmp->mNegation;
-                        delete tmp;
-                    }
+                        remove( tmp );
                 }
+                collectGarbage();
             }
             
             bool freeTseitinVariable( const FormulaContent<Pol>* _toDelete )
@@ -487,16 +555,13 @@ namespace carl
                 if( tvIter != mTseitinVars.end() )
                 {
                     // if this formula HAS a tseitin variable
-                    if( tvIter->second->mUsages == 1 )
+                    const FormulaContent<Pol>* tmp = tvIter->second;
+                    if( remove( tmp ) )
                     {
                         // the tseitin variable is not used -> delete it
-                        const FormulaContent<Pol>* tmp = tvIter->second;
                         mTseitinVars.erase( tvIter );
                         assert( mTseitinVarToFormula.find( tmp ) != mTseitinVarToFormula.end() );
                         mTseitinVarToFormula.erase( tmp );
-                        mPool.erase( tmp );
-                        delete tmp->mNegation;
-                        delete tmp;
                     }
                     else // the tseitin variable is used, so we cannot delete the formula
                         stillStoredAsTseitinVariable = true;
@@ -506,18 +571,13 @@ namespace carl
                     auto tmpTVIter = mTseitinVarToFormula.find( _toDelete );
                     if( tmpTVIter != mTseitinVarToFormula.end() )
                     {
-                        const FormulaContent<Pol>* fcont = tmpTVIter->second->first;
                         // if this formula IS a tseitin variable
-                        if( fcont->mUsages == 1 )
+                        const FormulaContent<Pol>* tmp = getBaseFormula(tmpTVIter->second->first);
+                        if( remove( tmp ) )
                         {
                             // the formula variable is not used -> delete it
-                            const FormulaContent<Pol>* tmp = getBaseFormula(fcont);
-                            //const FormulaContent<Pol>* tmp = fcont->mType == FormulaType::NOT ? fcont->mNegation : fcont;
                             mTseitinVars.erase( tmpTVIter->second );
                             mTseitinVarToFormula.erase( tmpTVIter );
-                            mPool.erase( tmp );
-                            delete tmp->mNegation;
-                            delete tmp;
                         }
                         else // the formula is used, so we cannot delete the tseitin variable
                             stillStoredAsTseitinVariable = true;
@@ -526,32 +586,89 @@ namespace carl
                 return stillStoredAsTseitinVariable;
             }
             
+            /**
+             * Removes the given formula from the pool, if it is not used anymore, i.e., only by its negation.
+             * The formula and its negation are destructed by the next call of collectGarbage().
+             * @param _elem The base formula to remove.
+             * @return true, if the formula has been removed.
+             */
+            bool remove( const FormulaContent<Pol>* _elem )
+            {
+                bool removed = mPool.erase( _elem, []( const FormulaContent<Pol>* _f ) {
+                    std::size_t unused = 1;
+                    return _f->mUsages.compare_exchange_strong( unused, 0 );
+                } );
+                if( removed )
+                    mPool.retire( _elem );
+                return removed;
+            }
+            
+            /**
+             * Destructs the removed formulas, as soon as no concurrent lookup can access them anymore.
+             */
+            void collectGarbage()
+            {
+                mPool.collect( [this]( const FormulaContent<Pol>* _f ) {
+                    mArena.destroy( _f->mNegation );
+                    mArena.destroy( _f );
+                } );
+            }
+            
             void reg( const FormulaContent<Pol>* _elem ) const
             {
-                FORMULA_POOL_LOCK_GUARD
                 const FormulaContent<Pol>* tmp = getBaseFormula(_elem);
                 //const FormulaContent<Pol>* tmp = _elem->mType == FormulaType::NOT ? _elem->mNegation : _elem;
                 assert( tmp != nullptr );
                 assert( tmp->mUsages < std::numeric_limits<size_t>::max() );
-                CARL_LOG_DEBUG("carl.formula", "Registering " << static_cast<const void*>(tmp) << ", current usage: " << tmp->mUsages);
-                ++tmp->mUsages;
-                if (tmp->mUsages == 1 && _elem->mType == FormulaType::CONSTRAINT) {
+                CARL_LOG_DEBUG("carl.formula", "Registering " << static_cast<const void*>(tmp) << ", current usage: " << tmp->mUsages.load());
+                if (++tmp->mUsages == 1 && _elem->mType == FormulaType::CONSTRAINT) {
                     CARL_LOG_DEBUG("carl.formula", "Is a constraint, increasing again");
                     ++tmp->mUsages;
                 }
             }
             
+            /**
+             * Registers a usage of the given formula, which has been found in the pool without holding a reference to it.
+             * @param _elem The base formula to register.
+             * @return false, if the formula is currently being destructed.
+             */
+            static bool tryReg( const FormulaContent<Pol>* _elem )
+            {
+                std::size_t usages = _elem->mUsages.load();
+                do
+                {
+                    if( usages == 0 )
+                        return false;
+                }
+                while( !_elem->mUsages.compare_exchange_weak( usages, usages + 1 ) );
+                return true;
+            }
+            
+            /**
+             * @return All formulas currently stored in the pool, apart from the negations.
+             */
+            std::vector<Formula<Pol>> allFormulas() const
+            {
+                std::vector<Formula<Pol>> result;
+                for( const FormulaContent<Pol>* elem : mPool.snapshot( &FormulaPool<Pol>::tryReg ) )
+                {
+                    result.push_back( Formula<Pol>( elem ) );
+                    // Drop the usage registered by the snapshot, the formula in the result holds another one.
+                    --elem->mUsages;
+                }
+                return result;
+            }
+            
         public:
             template<typename ArgType>
             void forallDo( void (*_func)( ArgType*, const Formula<Pol>& ), ArgType* _arg ) const
             {
-                FORMULA_POOL_LOCK_GUARD
-                for( const FormulaContent<Pol>* formula : mPool )
+                for( const Formula<Pol>& formula : allFormulas() )
                 {
-                    (*_func)( _arg, Formula<Pol>( formula ) );
-                    if( formula != mpFalse )
+                    (*_func)( _arg, formula );
+                    if( formula.mpContent != mpFalse )
                     {
-                        (*_func)( _arg, Formula<Pol>( formula->mNegation ) );
+                        (*_func)( _arg, Formula<Pol>( formula.mpContent->mNegation ) );
                     }
                 }
             }
@@ -559,15 +676,13 @@ namespace carl
             template<typename ReturnType, typename ArgType>
             std::map<const Formula<Pol>,ReturnType> forallDo( ReturnType (*_func)( ArgType*, const Formula<Pol>& ), ArgType* _arg ) const
             {
-                FORMULA_POOL_LOCK_GUARD
                 std::map<const Formula<Pol>,ReturnType> result;
-                for( const FormulaContent<Pol>* elem : mPool )
+                for( const Formula<Pol>& form : allFormulas() )
                 {
-                    Formula<Pol> form(elem);
                     result[form] = (*_func)( _arg, form );
-                    if( elem != mpFalse )
+                    if( form.mpContent != mpFalse )
                     {
-                        Formula<Pol> form2(elem->mNegation);
+                        Formula<Pol> form2(form.mpContent->mNegation);
                         result[form2] = (*_func)( _arg, form2 );
                     }
                 }
@@ -587,27 +702,22 @@ namespace carl
              * sub-formula are condensed. You should only use it, if you can exlcude this 
              * possibility. Otherwise use the method newExclusiveDisjunction.
              */
-            //const FormulaContent<Pol>* create( FormulaType _type, Formulas<Pol>&& _subformulas );
+            //Formula<Pol> create( FormulaType _type, Formulas<Pol>&& _subformulas );
             
     private:
             
-            /**
-             * Inserts the given formula to the pool, if it does not yet occur in there.
-             * @param _formula The formula to add to the pool.
-             * @return The position of the given formula in the pool and true, if it did not yet occur in the pool;
-             *         The position of the equivalent formula in the pool and false, otherwise.
-             */
-            std::pair<typename FastPointerSet<FormulaContent<Pol>>::iterator,bool> insert( FormulaContent<Pol>* _formula );
-            
             /**
              * Adds the given formula to the pool, if it does not yet occur in there.
-             * Note, that this method uses the allocator which is locked before calling.
+             * If an equivalent formula already occurs in the pool, the given formula is discarded.
              * @param _formula The formula to add to the pool.
              * @return The given formula, if it did not yet occur in the pool;
              *         The equivalent formula already occurring in the pool, otherwise.
              */
-            const FormulaContent<Pol>* add( FormulaContent<Pol>* _formula );
+            Formula<Pol> add( FormulaContent<Pol>* _formula );
     };
+    
+    template<typename Pol>
+    thread_local std::size_t FormulaPool<Pol>::tGeneration = 0;
 }    // namespace carl
 
 #include "FormulaPool.tpp"
@@ -17,65 +17,65 @@ namespace carl
         mIdAllocator( 3 ),
         mpTrue( new FormulaContent<Pol>( TRUE, 1 ) ),
         mpFalse( new FormulaContent<Pol>( FALSE, 2 ) ),
-        mPool(),
+        mArena(),
+        mPool( _capacity ),
         mTseitinVars(),
         mTseitinVarToFormula()
     {
         ConstraintPool<Pol>::getInstance();
         mpTrue->mNegation = mpFalse;
      	mpFalse->mNegation = mpTrue;
-        mPool.reserve( _capacity );
-        mPool.insert( mpTrue );
-        mPool.insert( mpFalse );
         Formula<Pol>::init( *mpTrue );
         Formula<Pol>::init( *mpFalse );
         mpTrue->mUsages = 2; // avoids deleting it
         mpFalse->mUsages = 2; // avoids deleting it
+        auto noAcquire = []( const FormulaContent<Pol>* ) { return false; };
+        auto noPrepare = []( const FormulaContent<Pol>* ) {};
+        mPool.insert( mpTrue, noAcquire, noPrepare );
+        mPool.insert( mpFalse, noAcquire, noPrepare );
     }
     
     template<typename Pol>
     FormulaPool<Pol>::~FormulaPool()
     {
 //        assert( mPool.size() == 2 );
-        mPool.clear();
+        collectGarbage();
         delete mpTrue;
         delete mpFalse;
     }
     
     template<typename Pol>
-    std::pair<typename FastPointerSet<FormulaContent<Pol>>::iterator,bool> FormulaPool<Pol>::insert( FormulaContent<Pol>* _element )
+    Formula<Pol> FormulaPool<Pol>::add( FormulaContent<Pol>* _element )
     {
-        auto iterBoolPair = mPool.insert( _element );
-        if( !iterBoolPair.second ) // Formula has already been generated.
+        assert( _element->mType != FormulaType::NOT );
+        // Look for the formula without locking. If we find it, we hold a usage of it.
+        const FormulaContent<Pol>* result = mPool.find( _element, &FormulaPool<Pol>::tryReg );
+        if( result == nullptr )
         {
-            delete _element;
+            result = mPool.insert( _element, &FormulaPool<Pol>::tryReg, [this,_element]( const FormulaContent<Pol>* ) {
+                // Formula has not yet been generated.
+                // Add also the negation of the formula to the pool in order to ensure that it
+                // has the next id and hence would occur next to the formula in a set of sub-formula,
+                // which is sorted by the ids.
+                _element->mId = mIdAllocator.fetch_add( 2 );
+                Formula<Pol>::init( *_element );
+                auto negation = createNegatedContent( _element );
+                //auto negation = new FormulaContent<Pol>(NOT, std::move( Formula<Pol>( _element ) ) );
+                _element->mNegation = negation;
+                negation->mId = _element->mId + 1;
+                negation->mNegation = _element;
+                Formula<Pol>::init( *negation );
+                // Hold a usage until the resulting formula has been constructed.
+                reg( _element );
+            } ).first;
         }
-        return iterBoolPair;
-    }
-    
-    template<typename Pol>
-    const FormulaContent<Pol>* FormulaPool<Pol>::add( FormulaContent<Pol>* _element )
-    {
-        assert( _element->mType != FormulaType::NOT );
-        FORMULA_POOL_LOCK_GUARD
-        auto iterBoolPair = this->insert( _element );
-        if( iterBoolPair.second ) // Formula has not yet been generated.
+        if( result != _element ) // Formula has already been generated.
         {
-            // Add also the negation of the formula to the pool in order to ensure that it
-            // has the next id and hence would occur next to the formula in a set of sub-formula,
-            // which is sorted by the ids.
-            _element->mId = mIdAllocator; 
-            Formula<Pol>::init( *_element );
-            ++mIdAllocator;
-            auto negation = createNegatedContent(*iterBoolPair.first);
-            //auto negation = new FormulaContent<Pol>(NOT, std::move( Formula<Pol>( *iterBoolPair.first ) ) );
-            _element->mNegation = negation;
-            negation->mId = mIdAllocator; 
-            negation->mNegation = _element;
-            Formula<Pol>::init( *negation );
-            ++mIdAllocator;
+            mArena.discard( _element );
         }
-        return *iterBoolPair.first;
+        Formula<Pol> formula( result );
+        --result->mUsages;
+        return formula;
     }
     
     template<typename Pol>
@@ -88,7 +88,7 @@ namespace carl
     }
     
     template<typename Pol>
-    const FormulaContent<Pol>* FormulaPool<Pol>::createImplication(Formulas<Pol>&& _subformulas) {
+    Formula<Pol> FormulaPool<Pol>::createImplication(Formulas<Pol>&& _subformulas) {
         assert(_subformulas.size() >= 2);
         #ifdef SIMPLIFY_FORMULA
         // Conclusion
@@ -120,14 +120,14 @@ namespace carl
         }
         #endif
         if (_subformulas.empty()) {
-            return conclusion.mpContent;
+            return conclusion;
         }
         Formula<Pol> premise(AND, std::move(_subformulas));
-        return add(new FormulaContent<Pol>(IMPLIES, {premise, conclusion}));
+        return add(newContent(IMPLIES, Formulas<Pol>({premise, conclusion})));
     }
     
     template<typename Pol>
-    const FormulaContent<Pol>* FormulaPool<Pol>::createNAry(FormulaType _type, Formulas<Pol>&& _subformulas)
+    Formula<Pol> FormulaPool<Pol>::createNAry(FormulaType _type, Formulas<Pol>&& _subformulas)
     {
         assert( _type == FormulaType::AND || _type == FormulaType::OR || _type == FormulaType::XOR || _type == FormulaType::IFF );
 //        std::cout << __func__ << _type;
@@ -136,7 +136,7 @@ namespace carl
 //        std::cout << std::endl;
         if( _subformulas.size() == 1 )
         {
-            return _subformulas[0].mpContent;
+            return _subformulas[0];
         }
         if( _type != FormulaType::IFF )
         {
@@ -172,7 +172,7 @@ namespace carl
                     negateResult = !negateResult;
                     break;
                 case FormulaType::OR:
-                    return trueFormula();
+                    return Formula<Pol>( trueFormula() );
                 default:
                     assert( _type == FormulaType::AND || _type == FormulaType::IFF );
             }
@@ -184,11 +184,11 @@ namespace carl
             {
                 case FormulaType::IFF:
                     if( _subformulas[0].isTrue() )
-                        return falseFormula();
+                        return Formula<Pol>( falseFormula() );
                     negateResult = true;
                     break;
                 case FormulaType::AND:
-                    return falseFormula();
+                    return Formula<Pol>( falseFormula() );
                 default:
                     assert( _type == FormulaType::OR || _type == FormulaType::XOR );
             }
@@ -217,11 +217,11 @@ namespace carl
                     switch( _type )
                     {
                         case FormulaType::AND:
-                            return falseFormula();
+                            return Formula<Pol>( falseFormula() );
                         case FormulaType::OR:
-                            return trueFormula();
+                            return Formula<Pol>( trueFormula() );
                         case FormulaType::IFF:
-                            return falseFormula();
+                            return Formula<Pol>( falseFormula() );
                         default:
                             assert( _type == FormulaType::XOR );
                             negateResult = !negateResult;
@@ -244,34 +244,34 @@ namespace carl
         if( subformulas.empty() )
         {
             if( negateResult || _type == FormulaType::AND || _type == FormulaType::IFF )
-                return trueFormula();
-            return falseFormula();
+                return Formula<Pol>( trueFormula() );
+            return Formula<Pol>( falseFormula() );
         }
-        const FormulaContent<Pol>* result;
+        Formula<Pol> result;
         if( subformulas.size() == 1 )
         {
             if( _type == FormulaType::IFF && _subformulas[0] == *subformulas.begin() )
-                return trueFormula();
-            result = subformulas.begin()->mpContent;
+                return Formula<Pol>( trueFormula() );
+            result = *subformulas.begin();
         }
         else
         {
-            result = add( new FormulaContent<Pol>( _type, std::move( subformulas ) ) );
+            result = add( newContent( _type, std::move( subformulas ) ) );
         }
-        return negateResult ? result->mNegation : result;
+        return negateResult ? Formula<Pol>( result.mpContent->mNegation ) : result;
     }
     
     template<typename Pol>
-    const FormulaContent<Pol>* FormulaPool<Pol>::createITE(Formulas<Pol>&& _subformulas) {
+    Formula<Pol> FormulaPool<Pol>::createITE(Formulas<Pol>&& _subformulas) {
         assert(_subformulas.size() == 3);
         #ifdef SIMPLIFY_FORMULA
         Formula<Pol>& condition = _subformulas[0];
         Formula<Pol>& thencase = _subformulas[1];
         Formula<Pol>& elsecase = _subformulas[2];
         
-        if (condition.isTrue()) return thencase.mpContent;
-        if (condition.isFalse()) return elsecase.mpContent;
-        if (thencase == elsecase) return thencase.mpContent;
+        if (condition.isTrue()) return thencase;
+        if (condition.isFalse()) return elsecase;
+        if (thencase == elsecase) return thencase;
         
         if (condition.getType() == FormulaType::NOT) {
             _subformulas[0] = condition.subformula();
@@ -312,7 +312,7 @@ namespace carl
             return create(FormulaType::OR, std::move(subFormulas));
         }
         #endif
-        return add(new FormulaContent<Pol>(ITE, std::move(_subformulas)));
+        return add(newContent(ITE, std::move(_subformulas)));
     }
     
 }    // namespace carl
@@ -0,0 +1,490 @@
+/**
+ * @file BVBitBlaster.cpp
+ */
+
+#include "BVBitBlaster.h"
+
+#include "../../core/logging.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace carl
+{
+    BVBitBlaster::BVBitBlaster() :
+    mCallback()
+    {
+        emit({trueLit()});
+    }
+
+    BVBitBlaster::BVBitBlaster(ClauseCallback callback) :
+    mCallback(std::move(callback))
+    {
+        emit({trueLit()});
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::newVariable()
+    {
+        return Literal(++mNrVariables);
+    }
+
+    void BVBitBlaster::emit(Clause&& clause)
+    {
+        ++mNrClauses;
+        if(mCallback) {
+            mCallback(clause);
+        } else {
+            mClauses.push_back(std::move(clause));
+        }
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::makeAnd(Literal a, Literal b)
+    {
+        if(a == falseLit() || b == falseLit() || a == -b) return falseLit();
+        if(a == trueLit() || a == b) return b;
+        if(b == trueLit()) return a;
+        if(b < a) std::swap(a, b);
+        auto key = std::make_tuple(Gate::AND, a, b, Literal(0));
+        auto it = mGates.find(key);
+        if(it != mGates.end()) return it->second;
+        Literal o = newVariable();
+        emit({-o, a});
+        emit({-o, b});
+        emit({o, -a, -b});
+        mGates.emplace(key, o);
+        return o;
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::makeXor(Literal a, Literal b)
+    {
+        if(a == falseLit()) return b;
+        if(a == trueLit()) return -b;
+        if(b == falseLit()) return a;
+        if(b == trueLit()) return -a;
+        if(a == b) return falseLit();
+        if(a == -b) return trueLit();
+        // xor(-a,b) = -xor(a,b), hence only gates on positive literals are created.
+        bool negated = (a < 0) != (b < 0);
+        a = std::abs(a);
+        b = std::abs(b);
+        if(b < a) std::swap(a, b);
+        auto key = std::make_tuple(Gate::XOR, a, b, Literal(0));
+        auto it = mGates.find(key);
+        Literal o;
+        if(it != mGates.end()) {
+            o = it->second;
+        } else {
+            o = newVariable();
+            emit({-o, a, b});
+            emit({-o, -a, -b});
+            emit({o, -a, b});
+            emit({o, a, -b});
+            mGates.emplace(key, o);
+        }
+        return negated ? -o : o;
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::makeIte(Literal c, Literal t, Literal e)
+    {
+        if(c == trueLit() || t == e) return t;
+        if(c == falseLit()) return e;
+        if(t == -e) return -makeXor(c, t);
+        if(t == trueLit() || t == c) return makeOr(c, e);
+        if(t == falseLit() || t == -c) return makeAnd(-c, e);
+        if(e == trueLit() || e == -c) return makeOr(-c, t);
+        if(e == falseLit() || e == c) return makeAnd(c, t);
+        if(c < 0) {
+            c = -c;
+            std::swap(t, e);
+        }
+        auto key = std::make_tuple(Gate::ITE, c, t, e);
+        auto it = mGates.find(key);
+        if(it != mGates.end()) return it->second;
+        Literal o = newVariable();
+        emit({-o, -c, t});
+        emit({-o, c, e});
+        emit({o, -c, -t});
+        emit({o, c, -e});
+        // Redundant, but allow unit propagation if both branches agree.
+        emit({-o, t, e});
+        emit({o, -t, -e});
+        mGates.emplace(key, o);
+        return o;
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::makeMajority(Literal a, Literal b, Literal c)
+    {
+        if(isConstant(b) && !isConstant(a)) std::swap(a, b);
+        if(isConstant(c) && !isConstant(a)) std::swap(a, c);
+        if(a == trueLit()) return makeOr(b, c);
+        if(a == falseLit()) return makeAnd(b, c);
+        if(a == b || a == c) return a;
+        if(b == c) return b;
+        if(a == -b) return c;
+        if(a == -c) return b;
+        if(b == -c) return a;
+        if(b < a) std::swap(a, b);
+        if(c < b) std::swap(b, c);
+        if(b < a) std::swap(a, b);
+        auto key = std::make_tuple(Gate::MAJ, a, b, c);
+        auto it = mGates.find(key);
+        if(it != mGates.end()) return it->second;
+        Literal o = newVariable();
+        emit({-o, a, b});
+        emit({-o, a, c});
+        emit({-o, b, c});
+        emit({o, -a, -b});
+        emit({o, -a, -c});
+        emit({o, -b, -c});
+        mGates.emplace(key, o);
+        return o;
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::makeAnd(const Bits& bits)
+    {
+        Literal res = trueLit();
+        for(Literal l : bits) {
+            res = makeAnd(res, l);
+        }
+        return res;
+    }
+
+    BVBitBlaster::Bits BVBitBlaster::constant(std::size_t width, bool value)
+    {
+        return Bits(width, value ? trueLit() : falseLit());
+    }
+
+    BVBitBlaster::Bits BVBitBlaster::negate(const Bits& a)
+    {
+        Bits res(a.size());
+        std::transform(a.begin(), a.end(), res.begin(), [](Literal l){ return -l; });
+        return res;
+    }
+
+    BVBitBlaster::Bits BVBitBlaster::add(const Bits& a, const Bits& b, Literal carry, Literal* carryOut)
+    {
+        assert(a.size() == b.size());
+        Bits res(a.size());
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            res[i] = makeXor(makeXor(a[i], b[i]), carry);
+            carry = makeMajority(a[i], b[i], carry);
+        }
+        if(carryOut != nullptr) *carryOut = carry;
+        return res;
+    }
+
+    BVBitBlaster::Bits BVBitBlaster::neg(const Bits& a)
+    {
+        return add(negate(a), constant(a.size(), false), trueLit());
+    }
+
+    BVBitBlaster::Bits BVBitBlaster::ite(Literal c, const Bits& t, const Bits& e)
+    {
+        assert(t.size() == e.size());
+        Bits res(t.size());
+        for(std::size_t i = 0; i < t.size(); ++i) {
+            res[i] = makeIte(c, t[i], e[i]);
+        }
+        return res;
+    }
+
+    BVBitBlaster::Bits BVBitBlaster::multiply(const Bits& a, const Bits& b)
+    {
+        assert(a.size() == b.size());
+        std::size_t width = a.size();
+        // The rows are selected by the bits of the second factor, hence it should be the one with more constant bits.
+        auto constants = [](const Bits& bits) { return std::count_if(bits.begin(), bits.end(), isConstant); };
+        const Bits& x = constants(a) > constants(b) ? b : a;
+        const Bits& y = constants(a) > constants(b) ? a : b;
+
+        Bits res = constant(width, false);
+        for(std::size_t i = 0; i < width; ++i) {
+            if(y[i] == falseLit()) continue;
+            // Only the bits from i on are affected, the lower bits of the row are zero.
+            Bits row(x.begin(), x.begin() + Bits::difference_type(width - i));
+            if(y[i] != trueLit()) {
+                for(auto& l : row) l = makeAnd(l, y[i]);
+            }
+            Bits high(res.begin() + Bits::difference_type(i), res.end());
+            Bits sum = add(high, row, falseLit());
+            std::copy(sum.begin(), sum.end(), res.begin() + Bits::difference_type(i));
+        }
+        return res;
+    }
+
+    const std::pair<BVBitBlaster::Bits, BVBitBlaster::Bits>& BVBitBlaster::divide(const Bits& a, const Bits& b)
+    {
+        assert(a.size() == b.size());
+        auto key = std::make_pair(a, b);
+        auto it = mDivisions.find(key);
+        if(it != mDivisions.end()) return it->second;
+
+        std::size_t width = a.size();
+        Bits divisor = negate(b);
+        divisor.push_back(trueLit());
+        Bits quotient(width);
+        Bits remainder = constant(width, false);
+        for(std::size_t i = width; i-- > 0;) {
+            // The remainder is less than the divisor (or a prefix of a if b = 0), hence it fits into width bits
+            // and shifting it needs width+1 bits.
+            Bits shifted;
+            shifted.reserve(width + 1);
+            shifted.push_back(a[i]);
+            shifted.insert(shifted.end(), remainder.begin(), remainder.end());
+            Literal greaterEqual;
+            Bits difference = add(shifted, divisor, trueLit(), &greaterEqual);
+            quotient[i] = greaterEqual;
+            shifted.pop_back();
+            difference.pop_back();
+            remainder = ite(greaterEqual, difference, shifted);
+        }
+        return mDivisions.emplace(key, std::make_pair(std::move(quotient), std::move(remainder))).first->second;
+    }
+
+    BVBitBlaster::Bits BVBitBlaster::shift(const Bits& a, const Bits& b, BVTermType type)
+    {
+        assert(a.size() == b.size());
+        std::size_t width = a.size();
+        Literal fill = type == BVTermType::RSHIFT_ARITH ? a.back() : falseLit();
+        Bits res(a);
+        Literal overflow = falseLit();
+        for(std::size_t k = 0; k < width; ++k) {
+            std::size_t distance = k < 8 * sizeof(std::size_t) - 1 ? std::size_t(1) << k : width;
+            if(distance >= width) {
+                overflow = makeOr(overflow, b[k]);
+                continue;
+            }
+            Bits shifted(width, fill);
+            for(std::size_t i = 0; i < width; ++i) {
+                if(type == BVTermType::LSHIFT) {
+                    if(i >= distance) shifted[i] = res[i - distance];
+                } else {
+                    if(i + distance < width) shifted[i] = res[i + distance];
+                }
+            }
+            res = ite(b[k], shifted, res);
+        }
+        return ite(overflow, Bits(width, fill), res);
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::equal(const Bits& a, const Bits& b)
+    {
+        assert(a.size() == b.size());
+        Bits equalities(a.size());
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            equalities[i] = -makeXor(a[i], b[i]);
+        }
+        return makeAnd(equalities);
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::less(const Bits& a, const Bits& b, bool isSigned, bool orEqual)
+    {
+        assert(a.size() == b.size());
+        // Ripple comparison from the least significant bit: a < b holds on the bits up to i if the bits differ at i
+        // and b has the one, or if they agree at i and a < b holds on the lower bits.
+        Literal res = orEqual ? trueLit() : falseLit();
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            Literal x = a[i];
+            Literal y = b[i];
+            // The signed comparison is the unsigned comparison with the sign bits inverted.
+            if(isSigned && i + 1 == a.size()) {
+                x = -x;
+                y = -y;
+            }
+            res = makeIte(makeXor(x, y), y, res);
+        }
+        return res;
+    }
+
+    BVBitBlaster::Bits BVBitBlaster::translate(const BVTerm& term)
+    {
+        BVTermType type = term.type();
+        std::size_t width = term.width();
+        switch(type) {
+            case BVTermType::CONSTANT: {
+                Bits res(width);
+                for(std::size_t i = 0; i < width; ++i) {
+                    res[i] = term.value()[i] ? trueLit() : falseLit();
+                }
+                return res;
+            }
+            case BVTermType::VARIABLE:
+                return bits(term.variable());
+            case BVTermType::EXTRACT: {
+                const Bits& x = blast(term.operand());
+                return Bits(x.begin() + Bits::difference_type(term.lowest()), x.begin() + Bits::difference_type(term.highest() + 1));
+            }
+            case BVTermType::NOT:
+                return negate(blast(term.operand()));
+            case BVTermType::NEG:
+                return neg(blast(term.operand()));
+            case BVTermType::LROTATE:
+            case BVTermType::RROTATE: {
+                const Bits& x = blast(term.operand());
+                Bits res(width);
+                std::size_t n = term.index() % width;
+                for(std::size_t i = 0; i < width; ++i) {
+                    if(type == BVTermType::LROTATE) {
+                        res[(i + n) % width] = x[i];
+                    } else {
+                        res[i] = x[(i + n) % width];
+                    }
+                }
+                return res;
+            }
+            case BVTermType::EXT_U:
+            case BVTermType::EXT_S: {
+                Bits res(blast(term.operand()));
+                Literal fill = type == BVTermType::EXT_S ? res.back() : falseLit();
+                res.resize(width, fill);
+                return res;
+            }
+            case BVTermType::REPEAT: {
+                const Bits& x = blast(term.operand());
+                Bits res;
+                res.reserve(width);
+                for(std::size_t i = 0; i < term.index(); ++i) {
+                    res.insert(res.end(), x.begin(), x.end());
+                }
+                return res;
+            }
+            default:
+                break;
+        }
+        if(!typeIsBinary(type)) {
+            CARL_LOG_ERROR("carl.formula.bv", "Cannot bit-blast term of type " << type);
+            return Bits();
+        }
+
+        const Bits& x = blast(term.first());
+        const Bits& y = blast(term.second());
+        Bits res(x.size());
+        switch(type) {
+            case BVTermType::CONCAT:
+                res = y;
+                res.insert(res.end(), x.begin(), x.end());
+                return res;
+            case BVTermType::AND:
+            case BVTermType::NAND:
+                for(std::size_t i = 0; i < x.size(); ++i) res[i] = makeAnd(x[i], y[i]);
+                return type == BVTermType::AND ? res : negate(res);
+            case BVTermType::OR:
+            case BVTermType::NOR:
+                for(std::size_t i = 0; i < x.size(); ++i) res[i] = makeOr(x[i], y[i]);
+                return type == BVTermType::OR ? res : negate(res);
+            case BVTermType::XOR:
+            case BVTermType::XNOR:
+                for(std::size_t i = 0; i < x.size(); ++i) res[i] = makeXor(x[i], y[i]);
+                return type == BVTermType::XOR ? res : negate(res);
+            case BVTermType::EQ:
+                return Bits(1, equal(x, y));
+            case BVTermType::ADD:
+                return add(x, y, falseLit());
+            case BVTermType::SUB:
+                return add(x, negate(y), trueLit());
+            case BVTermType::MUL:
+                return multiply(x, y);
+            case BVTermType::DIV_U:
+                return divide(x, y).first;
+            case BVTermType::MOD_U:
+                return divide(x, y).second;
+            case BVTermType::DIV_S:
+            case BVTermType::MOD_S1:
+            case BVTermType::MOD_S2: {
+                // Signed division and remainder are reduced to the unsigned ones on the absolute values as in SMT-LIB.
+                Literal signX = x.back();
+                Literal signY = y.back();
+                Bits absX = ite(signX, neg(x), x);
+                Bits absY = ite(signY, neg(y), y);
+                const auto& qr = divide(absX, absY);
+                if(type == BVTermType::DIV_S) {
+                    return ite(makeXor(signX, signY), neg(qr.first), qr.first);
+                }
+                const Bits& r = qr.second;
+                if(type == BVTermType::MOD_S1) {
+                    return ite(signX, neg(r), r);
+                }
+                Bits negR = neg(r);
+                Bits mod = ite(signX,
+                    ite(signY, negR, add(negR, y, falseLit())),
+                    ite(signY, add(r, y, falseLit()), r)
+                );
+                return ite(equal(r, constant(r.size(), false)), r, mod);
+            }
+            case BVTermType::LSHIFT:
+            case BVTermType::RSHIFT_LOGIC:
+            case BVTermType::RSHIFT_ARITH:
+                return shift(x, y, type);
+            default:
+                CARL_LOG_ERROR("carl.formula.bv", "Cannot bit-blast term of type " << type);
+                return Bits();
+        }
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::translate(const BVConstraint& constraint)
+    {
+        if(constraint.isConstant()) {
+            return constraint.isAlwaysConsistent() ? trueLit() : falseLit();
+        }
+        const Bits& x = blast(constraint.lhs());
+        const Bits& y = blast(constraint.rhs());
+        switch(constraint.relation()) {
+            case BVCompareRelation::EQ: return equal(x, y);
+            case BVCompareRelation::NEQ: return -equal(x, y);
+            case BVCompareRelation::ULT: return less(x, y, false, false);
+            case BVCompareRelation::ULE: return less(x, y, false, true);
+            case BVCompareRelation::UGT: return less(y, x, false, false);
+            case BVCompareRelation::UGE: return less(y, x, false, true);
+            case BVCompareRelation::SLT: return less(x, y, true, false);
+            case BVCompareRelation::SLE: return less(x, y, true, true);
+            case BVCompareRelation::SGT: return less(y, x, true, false);
+            case BVCompareRelation::SGE: return less(y, x, true, true);
+        }
+        assert(false);
+        return falseLit();
+    }
+
+    const BVBitBlaster::Bits& BVBitBlaster::blast(const BVTerm& term)
+    {
+        auto it = mTerms.find(term.id());
+        if(it != mTerms.end()) return it->second;
+        Bits res = translate(term);
+        assert(res.size() == term.width());
+        return mTerms.emplace(term.id(), std::move(res)).first->second;
+    }
+
+    BVBitBlaster::Literal BVBitBlaster::blast(const BVConstraint& constraint)
+    {
+        if(constraint.id() == 0) return translate(constraint);
+        auto it = mConstraints.find(constraint.id());
+        if(it != mConstraints.end()) return it->second;
+        Literal res = translate(constraint);
+        mConstraints.emplace(constraint.id(), res);
+        CARL_LOG_DEBUG("carl.formula.bv", "Blasted " << constraint << " to " << mNrVariables << " variables and " << mNrClauses << " clauses");
+        return res;
+    }
+
+    void BVBitBlaster::assertConstraint(const BVConstraint& constraint)
+    {
+        emit({blast(constraint)});
+    }
+
+    const BVBitBlaster::Bits& BVBitBlaster::bits(const BVVariable& variable)
+    {
+        auto it = mVariables.find(variable);
+        if(it != mVariables.end()) return it->second;
+        Bits res(variable.width());
+        for(auto& l : res) l = newVariable();
+        return mVariables.emplace(variable, std::move(res)).first->second;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const BVBitBlaster& bb)
+    {
+        os << "p cnf " << bb.mNrVariables << " " << bb.mClauses.size() << std::endl;
+        for(const auto& clause : bb.mClauses) {
+            for(const auto& l : clause) os << l << " ";
+            os << "0" << std::endl;
+        }
+        return os;
+    }
+} // namespace carl
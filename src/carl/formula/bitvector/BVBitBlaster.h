@@ -0,0 +1,143 @@
+/**
+ * @file BVBitBlaster.h
+ *
+ * Translation of bit-vector terms and constraints to propositional clauses.
+ */
+
+#pragma once
+
+#include "BVConstraint.h"
+#include "BVTerm.h"
+
+#include <functional>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace carl
+{
+	/**
+	 * Translates bit-vector terms into circuits over propositional variables and hands every clause of their Tseitin
+	 * encoding to a callback as soon as it is created.
+	 *
+	 * Propositional variables are numbered from 1 on and literals are given as in the DIMACS format, i.e. as the number of
+	 * the variable, negated for negative literals. Variable 1 is fixed to true by a unit clause, which is used for constant bits.
+	 *
+	 * Every term and constraint is translated only once: the results are stored by the ids of the BVTermPool and the
+	 * BVConstraintPool, such that shared subterms share their circuits. Gates are simplified if some input is constant,
+	 * and gates with the same inputs are created only once.
+	 *
+	 * Multiplication uses a shift-and-add multiplier that only computes the low bits of the result and skips the rows for
+	 * constant zero bits; if one factor is constant, it selects the rows. Division and remainder share a restoring divider,
+	 * which already yields the results for division by zero that SMT-LIB prescribes.
+	 */
+	class BVBitBlaster
+	{
+	public:
+		typedef long long Literal;
+		/// The bits of a term, the least significant bit first.
+		typedef std::vector<Literal> Bits;
+		typedef std::vector<Literal> Clause;
+		typedef std::function<void(const Clause&)> ClauseCallback;
+
+	private:
+		enum class Gate : unsigned { AND, XOR, ITE, MAJ };
+
+		ClauseCallback mCallback;
+		/// The clauses, if no callback was given.
+		std::vector<Clause> mClauses;
+		std::size_t mNrVariables = 1;
+		std::size_t mNrClauses = 0;
+		/// Bits of the terms translated so far, by their ids.
+		std::unordered_map<std::size_t, Bits> mTerms;
+		/// Literals of the constraints translated so far, by their ids.
+		std::unordered_map<std::size_t, Literal> mConstraints;
+		/// Bits of the variables.
+		std::map<BVVariable, Bits> mVariables;
+		/// Outputs of the gates created so far.
+		std::map<std::tuple<Gate, Literal, Literal, Literal>, Literal> mGates;
+		/// Quotient and remainder of the unsigned division of two bit vectors.
+		std::map<std::pair<Bits, Bits>, std::pair<Bits, Bits>> mDivisions;
+
+		static Literal trueLit() { return 1; }
+		static Literal falseLit() { return -1; }
+		static bool isConstant(Literal l) { return l == trueLit() || l == falseLit(); }
+
+		Literal newVariable();
+		void emit(Clause&& clause);
+
+		// Gates
+		Literal makeAnd(Literal a, Literal b);
+		Literal makeOr(Literal a, Literal b) { return -makeAnd(-a, -b); }
+		Literal makeXor(Literal a, Literal b);
+		Literal makeIte(Literal c, Literal t, Literal e);
+		Literal makeMajority(Literal a, Literal b, Literal c);
+		Literal makeAnd(const Bits& bits);
+
+		// Arithmetic and logic on bit vectors
+		static Bits constant(std::size_t width, bool value);
+		static Bits negate(const Bits& a);
+		Bits add(const Bits& a, const Bits& b, Literal carry, Literal* carryOut = nullptr);
+		Bits neg(const Bits& a);
+		Bits ite(Literal c, const Bits& t, const Bits& e);
+		Bits multiply(const Bits& a, const Bits& b);
+		const std::pair<Bits, Bits>& divide(const Bits& a, const Bits& b);
+		Bits shift(const Bits& a, const Bits& b, BVTermType type);
+		Literal equal(const Bits& a, const Bits& b);
+		Literal less(const Bits& a, const Bits& b, bool isSigned, bool orEqual);
+
+		Bits translate(const BVTerm& term);
+		Literal translate(const BVConstraint& constraint);
+
+	public:
+		/**
+		 * Stores the clauses, they can be printed in the DIMACS format with operator<<.
+		 */
+		BVBitBlaster();
+		/**
+		 * @param callback Called for every clause, the clause is only valid during the call.
+		 */
+		explicit BVBitBlaster(ClauseCallback callback);
+
+		/**
+		 * @return The bits of the given term.
+		 */
+		const Bits& blast(const BVTerm& term);
+		/**
+		 * @return A literal that is true if and only if the given constraint holds.
+		 */
+		Literal blast(const BVConstraint& constraint);
+		/**
+		 * Asserts the given constraint, i.e. emits its clauses and a unit clause for its literal.
+		 */
+		void assertConstraint(const BVConstraint& constraint);
+
+		/**
+		 * @return The bits of the given variable, they are created if the variable has not occurred yet.
+		 */
+		const Bits& bits(const BVVariable& variable);
+		/**
+		 * @return The variables that have occurred so far with their bits.
+		 */
+		const std::map<BVVariable, Bits>& variables() const
+		{
+			return mVariables;
+		}
+
+		std::size_t nrVariables() const
+		{
+			return mNrVariables;
+		}
+		std::size_t nrClauses() const
+		{
+			return mNrClauses;
+		}
+
+		/**
+		 * Prints the stored clauses in the DIMACS format.
+		 */
+		friend std::ostream& operator<<(std::ostream& os, const BVBitBlaster& bb);
+	};
+}
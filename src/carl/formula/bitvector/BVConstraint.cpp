@@ -18,4 +18,39 @@ namespace carl
     {
         return *(BVConstraintPool::getInstance().create(_relation, _lhs, _rhs));
     }
+
+    bool evaluate(const BVValue& _lhs, BVCompareRelation _relation, const BVValue& _rhs)
+    {
+        assert(_lhs.width() == _rhs.width());
+        if(_relation == BVCompareRelation::EQ) {
+            return _lhs == _rhs;
+        } else if(_relation == BVCompareRelation::NEQ) {
+            return !(_lhs == _rhs);
+        }
+
+        bool less = _lhs < _rhs;
+
+        if(_relation == BVCompareRelation::ULT) {
+            return less;
+        } else if(_relation == BVCompareRelation::ULE) {
+            return less || (_lhs == _rhs);
+        } else if(_relation == BVCompareRelation::UGT) {
+            return ! less && !(_lhs == _rhs);
+        } else if(_relation == BVCompareRelation::UGE) {
+            return ! less;
+        }
+
+        bool lhsNegative = _lhs[_lhs.width()-1];
+        bool rhsNegative = _rhs[_rhs.width()-1];
+
+        if(_relation == BVCompareRelation::SLT) {
+            return (lhsNegative && ! rhsNegative) || (lhsNegative == rhsNegative && less);
+        } else if(_relation == BVCompareRelation::SLE) {
+            return (lhsNegative && ! rhsNegative) || (lhsNegative == rhsNegative && less) || _lhs == _rhs;
+        } else if(_relation == BVCompareRelation::SGT) {
+            return (! lhsNegative && rhsNegative) || (lhsNegative == rhsNegative && ! less && !(_lhs == _rhs));
+        }
+        assert(_relation == BVCompareRelation::SGE);
+        return (! lhsNegative && rhsNegative) || (lhsNegative == rhsNegative && ! less);
+    }
 } // namespace carl
@@ -108,14 +108,18 @@ namespace carl
             return mLhs.isInvalid() && mRhs.isInvalid();
         }
 		bool isTrue() const {
-			if (mLhs == mRhs) {
+			if (isConstant()) {
+				return isAlwaysConsistent();
+			} else if (mLhs == mRhs) {
 				return true;
 			} else if (mLhs.isConstant() && mRhs.isConstant()) {
 				return mLhs.value() == mRhs.value();
 			} else return false;
 		}
 		bool isFalse() const {
-			if (mLhs == mRhs) {
+			if (isConstant()) {
+				return isAlwaysInconsistent();
+			} else if (mLhs == mRhs) {
 				return false;
 			} else if (mLhs.isConstant() && mRhs.isConstant()) {
 				return !(mLhs.value() == mRhs.value());
@@ -214,6 +218,15 @@ namespace carl
             return 1 + mLhs.complexity() + mRhs.complexity();
         }
 	};
+
+	/**
+	 * Checks whether the given relation holds for two constants of the same width.
+	 * @param _lhs The left-hand side.
+	 * @param _relation The relation.
+	 * @param _rhs The right-hand side.
+	 * @return true, if the relation holds.
+	 */
+	bool evaluate(const BVValue& _lhs, BVCompareRelation _relation, const BVValue& _rhs);
 } // namespace carl
 
 
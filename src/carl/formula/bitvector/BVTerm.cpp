@@ -48,6 +48,11 @@ namespace carl
         return mpContent->hash();
     }
 
+    std::size_t BVTerm::id() const
+    {
+        return mpContent->mId;
+    }
+
     std::size_t BVTerm::width() const
     {
         return mpContent->width();
@@ -208,4 +213,53 @@ namespace carl
         return *(this->mpContent) < *(rhs.mpContent);
     }
 
+    BVValue evaluate(BVTermType _type, const BVValue& _operand, std::size_t _index)
+    {
+        switch(_type) {
+            case BVTermType::NOT: return ~_operand;
+            case BVTermType::NEG: return -_operand;
+            case BVTermType::LROTATE: return _operand.rotateLeft(_index);
+            case BVTermType::RROTATE: return _operand.rotateRight(_index);
+            case BVTermType::REPEAT: return _operand.repeat(_index);
+            case BVTermType::EXT_U: return _operand.extendUnsignedBy(_index);
+            case BVTermType::EXT_S: return _operand.extendSignedBy(_index);
+            default:
+                CARL_LOG_ERROR("carl.bitvector", "Cannot evaluate " << _type << " on a single operand.");
+                assert(false);
+                return _operand;
+        }
+    }
+
+    BVValue evaluate(BVTermType _type, const BVValue& _first, const BVValue& _second)
+    {
+        switch(_type) {
+            case BVTermType::CONCAT: return _first.concat(_second);
+            case BVTermType::AND: return _first & _second;
+            case BVTermType::OR: return _first | _second;
+            case BVTermType::XOR: return _first ^ _second;
+            case BVTermType::NAND: return ~(_first & _second);
+            case BVTermType::NOR: return ~(_first | _second);
+            case BVTermType::XNOR: return ~(_first ^ _second);
+            case BVTermType::ADD: return _first + _second;
+            case BVTermType::SUB: return _first - _second;
+            case BVTermType::MUL: return _first * _second;
+            case BVTermType::DIV_U: return _first / _second;
+            case BVTermType::DIV_S: return _first.divideSigned(_second);
+            case BVTermType::MOD_U: return _first % _second;
+            case BVTermType::MOD_S1: return _first.remSigned(_second);
+            case BVTermType::MOD_S2: return _first.modSigned(_second);
+            case BVTermType::EQ: {
+                assert(_first.width() == _second.width());
+                return BVValue(1, (_first == _second) ? 1 : 0);
+            }
+            case BVTermType::LSHIFT: return _first << _second;
+            case BVTermType::RSHIFT_LOGIC: return _first >> _second;
+            case BVTermType::RSHIFT_ARITH: return _first.rightShiftArithmetic(_second);
+            default:
+                CARL_LOG_ERROR("carl.bitvector", "Cannot evaluate " << _type << " on two operands.");
+                assert(false);
+                return _first;
+        }
+    }
+
 }
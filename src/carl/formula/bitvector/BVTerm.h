@@ -102,6 +102,7 @@ namespace carl
 
 	class BVTerm
 	{
+		friend class BVTermPool;
 	private:
 		const BVTermContent * mpContent;
 
@@ -128,6 +129,11 @@ namespace carl
 
 		std::size_t hash() const;
 
+		/**
+		 * @return The unique id of this term within the BVTermPool.
+		 */
+		std::size_t id() const;
+
 		std::size_t width() const;
 
 		BVTermType type() const;
@@ -170,6 +176,25 @@ namespace carl
 		BVTerm substitute(const std::map<BVVariable,BVTerm>& /*unused*/) const;
 	};
 
+	/**
+	 * Applies a unary operation to a constant.
+	 * @param _type The type of the operation, must be unary.
+	 * @param _operand The operand.
+	 * @param _index The index of the operation, e.g. the number of bits to rotate by.
+	 * @return The result of the operation.
+	 */
+	BVValue evaluate(BVTermType _type, const BVValue& _operand, std::size_t _index);
+
+	/**
+	 * Applies a binary operation to constants.
+	 * Note that the divisor of a division or remainder must not be zero.
+	 * @param _type The type of the operation, must be binary.
+	 * @param _first The first operand.
+	 * @param _second The second operand.
+	 * @return The result of the operation.
+	 */
+	BVValue evaluate(BVTermType _type, const BVValue& _first, const BVValue& _second);
+
 	struct BVUnaryContent
 	{
 		BVTerm mOperand;
@@ -5,6 +5,8 @@
 
 #include "BVTermPool.h"
 
+#include <climits>
+
 namespace carl
 {
     BVTermPool::BVTermPool():
@@ -29,34 +31,95 @@ namespace carl
         return this->add(new Term(_type, _variable));
     }
 
+    namespace
+    {
+        bool isCommutative(BVTermType _type)
+        {
+            return _type == BVTermType::AND || _type == BVTermType::OR || _type == BVTermType::XOR
+                || _type == BVTermType::NAND || _type == BVTermType::NOR || _type == BVTermType::XNOR
+                || _type == BVTermType::ADD || _type == BVTermType::MUL || _type == BVTermType::EQ;
+        }
+
+        bool isDivision(BVTermType _type)
+        {
+            return _type == BVTermType::DIV_U || _type == BVTermType::DIV_S || _type == BVTermType::MOD_U
+                || _type == BVTermType::MOD_S1 || _type == BVTermType::MOD_S2;
+        }
+
+        /// Checks whether the unsigned value of _value is at least _bound.
+        bool isAtLeast(const BVValue& _value, std::size_t _bound)
+        {
+            std::size_t value = 0;
+            for(std::size_t i = _value.width(); i-- > 0;) {
+                if(!_value[i]) continue;
+                if(i + 1 >= sizeof(std::size_t) * CHAR_BIT) return true;
+                value |= std::size_t(1) << i;
+            }
+            return value >= _bound;
+        }
+    }
+
+    BVTermPool::ConstTermPtr BVTermPool::lookup(const RewriteKey& _key) const
+    {
+        std::lock_guard<std::mutex> lock(mRewriteMutex);
+        auto it = mRewrites.find(_key);
+        return it == mRewrites.end() ? nullptr : it->second;
+    }
+
+    BVTermPool::ConstTermPtr BVTermPool::remember(const RewriteKey& _key, ConstTermPtr _term)
+    {
+        std::lock_guard<std::mutex> lock(mRewriteMutex);
+        mRewrites.emplace(_key, _term);
+        return _term;
+    }
+
+    BVTermPool::ConstTermPtr BVTermPool::constant(std::size_t _width, bool _ones)
+    {
+        BVValue value(_width);
+        return create(BVTermType::CONSTANT, _ones ? ~value : value);
+    }
+
     BVTermPool::ConstTermPtr BVTermPool::create(BVTermType _type, const BVTerm& _operand, const size_t _index)
     {
-        if (_operand.isConstant()) {
-            switch (_type) {
-                case BVTermType::NOT: {
-                    return create(BVTermType::CONSTANT, ~_operand.value());
-                }
-                case BVTermType::NEG: {
-                    return create(BVTermType::CONSTANT, -_operand.value());
-                }
-                case BVTermType::LROTATE: {
-                    return create(BVTermType::CONSTANT, _operand.value().rotateLeft(_index));
-                }
-                case BVTermType::RROTATE: {
-                    return create(BVTermType::CONSTANT, _operand.value().rotateRight(_index));
-                }
-                case BVTermType::REPEAT: {
-                    return create(BVTermType::CONSTANT, _operand.value().repeat(_index));
-                }
-                case BVTermType::EXT_U: {
-                    return create(BVTermType::CONSTANT, _operand.value().extendUnsignedBy(_index));
-                }
-                case BVTermType::EXT_S: {
-                    return create(BVTermType::CONSTANT, _operand.value().extendSignedBy(_index));
+        RewriteKey key{_type, _operand.mpContent, nullptr, _index, 0};
+        ConstTermPtr res = lookup(key);
+        if(res != nullptr) return res;
+        return remember(key, rewrite(_type, _operand, _index));
+    }
+
+    BVTermPool::ConstTermPtr BVTermPool::rewrite(BVTermType _type, const BVTerm& _operand, const size_t _index)
+    {
+        if(_operand.isConstant()) {
+            return create(BVTermType::CONSTANT, evaluate(_type, _operand.value(), _index));
+        }
+        switch(_type) {
+            case BVTermType::NOT:
+            case BVTermType::NEG: {
+                if(_operand.type() == _type) return _operand.operand().mpContent;
+                break;
+            }
+            case BVTermType::LROTATE:
+            case BVTermType::RROTATE: {
+                std::size_t index = _index % _operand.width();
+                if(index == 0) return _operand.mpContent;
+                if(_operand.type() == _type) {
+                    return create(_type, _operand.operand(), (index + _operand.index()) % _operand.width());
                 }
-                default:
-                    CARL_LOG_WARN("carl.bitvector", "No simplification for " << _type << " BVTerm.");
+                if(index != _index) return create(_type, _operand, index);
+                break;
+            }
+            case BVTermType::EXT_U:
+            case BVTermType::EXT_S: {
+                if(_index == 0) return _operand.mpContent;
+                if(_operand.type() == _type) return create(_type, _operand.operand(), _index + _operand.index());
+                break;
             }
+            case BVTermType::REPEAT: {
+                if(_index == 1) return _operand.mpContent;
+                break;
+            }
+            default:
+                break;
         }
         return this->add(new Term(_type, _operand, _index));
     }
@@ -64,94 +127,160 @@ namespace carl
     BVTermPool::ConstTermPtr BVTermPool::create(BVTermType _type, const BVTerm& _first, const BVTerm& _second)
     {
         // Catch expressions leading to an "undefined" result (i.e., division by zero)
-        if (_second.isConstant() && _second.value().isZero()) {
-            if(_type == BVTermType::DIV_U || _type == BVTermType::DIV_S || _type == BVTermType::MOD_U || _type == BVTermType::MOD_S1 || _type == BVTermType::MOD_S2) {
-                // Return a fresh bitvector variable that can take an arbitrary value
-                carl::Variable var = freshBitvectorVariable();
-                carl::Sort bvSort = carl::SortManager::getInstance().getSort("BitVec", std::vector<std::size_t>({_first.width()}));
-                carl::BVVariable bvVar(var, bvSort);
-                return create(BVTermType::VARIABLE, bvVar);
-            }
+        if (_second.isConstant() && _second.value().isZero() && isDivision(_type)) {
+            // Return a fresh bitvector variable that can take an arbitrary value
+            carl::Variable var = freshBitvectorVariable();
+            carl::Sort bvSort = carl::SortManager::getInstance().getSort("BitVec", std::vector<std::size_t>({_first.width()}));
+            carl::BVVariable bvVar(var, bvSort);
+            return create(BVTermType::VARIABLE, bvVar);
         }
 
+        RewriteKey key{_type, _first.mpContent, _second.mpContent, 0, 0};
+        ConstTermPtr res = lookup(key);
+        if(res != nullptr) return res;
+        return remember(key, rewrite(_type, _first, _second));
+    }
+
+    BVTermPool::ConstTermPtr BVTermPool::rewrite(BVTermType _type, const BVTerm& _first, const BVTerm& _second)
+    {
         // Evaluate term if both terms arguments are constant
         if (_first.isConstant() && _second.isConstant()) {
-            switch (_type) {
-                case BVTermType::CONCAT: {
-                    return create(BVTermType::CONSTANT, _first.value().concat(_second.value()));
-                }
-                case BVTermType::AND: {
-                    return create(BVTermType::CONSTANT, _first.value() & _second.value());
-                }
-                case BVTermType::OR: {
-                    return create(BVTermType::CONSTANT, _first.value() | _second.value());
-                }
-                case BVTermType::XOR: {
-                    return create(BVTermType::CONSTANT, _first.value() ^ _second.value());
-                }
-                case BVTermType::NAND: {
-                    return create(BVTermType::CONSTANT, ~(_first.value() & _second.value()));
-                }
-                case BVTermType::NOR: {
-                    return create(BVTermType::CONSTANT, ~(_first.value() | _second.value()));
-                }
-                case BVTermType::XNOR: {
-                    return create(BVTermType::CONSTANT, ~(_first.value() ^ _second.value()));
-                }
-                case BVTermType::ADD: {
-                    return create(BVTermType::CONSTANT, _first.value() + _second.value());
-                }
-                case BVTermType::SUB: {
-                    return create(BVTermType::CONSTANT, _first.value() - _second.value());
-                }
-                case BVTermType::MUL: {
-                    return create(BVTermType::CONSTANT, _first.value() * _second.value());
-                }
-                case BVTermType::DIV_U: {
-                    return create(BVTermType::CONSTANT, _first.value() / _second.value());
-                }
-                case BVTermType::DIV_S: {
-                    return create(BVTermType::CONSTANT, _first.value().divideSigned(_second.value()));
-                }
-                case BVTermType::MOD_U: {
-                    return create(BVTermType::CONSTANT, _first.value() % _second.value());
-                }
-                case BVTermType::MOD_S1: {
-                    return create(BVTermType::CONSTANT, _first.value().remSigned(_second.value()));
-                }
-                case BVTermType::MOD_S2: {
-                    return create(BVTermType::CONSTANT, _first.value().modSigned(_second.value()));
-                }
-                case BVTermType::EQ: {
-                    assert(_first.width() == _second.width());
-                    unsigned val = (_first.value() == _second.value()) ? 1 : 0;
-                    return create(BVTermType::CONSTANT, BVValue(1, val));
-                }
-                case BVTermType::LSHIFT: {
-                    return create(BVTermType::CONSTANT, _first.value() << _second.value());
-                }
-                case BVTermType::RSHIFT_LOGIC: {
-                    return create(BVTermType::CONSTANT, _first.value() >> _second.value());
-                }
-                case BVTermType::RSHIFT_ARITH: {
-                    return create(BVTermType::CONSTANT, _first.value().rightShiftArithmetic(_second.value()));
-                }
+            return create(BVTermType::CONSTANT, evaluate(_type, _first.value(), _second.value()));
+        }
+
+        // Normalize commutative operations: constants last, otherwise ordered by id
+        const BVTerm& first = isCommutative(_type) && (_first.isConstant() || (!_second.isConstant() && _second.id() < _first.id())) ? _second : _first;
+        const BVTerm& second = &first == &_first ? _second : _first;
+        std::size_t width = first.width();
+
+        if(first == second) {
+            switch(_type) {
+                case BVTermType::AND:
+                case BVTermType::OR: return first.mpContent;
+                case BVTermType::XOR:
+                case BVTermType::SUB: return constant(width, false);
+                case BVTermType::XNOR: return constant(width, true);
+                case BVTermType::NAND:
+                case BVTermType::NOR: return create(BVTermType::NOT, first);
+                case BVTermType::EQ: return constant(1, true);
+                default: break;
+            }
+        }
+
+        if(second.isConstant()) {
+            const BVValue& value = second.value();
+            bool zero = value.isZero();
+            bool ones = (~value).isZero();
+            bool one = value == BVValue(width, 1);
+            switch(_type) {
+                case BVTermType::AND:
+                    if(zero) return second.mpContent;
+                    if(ones) return first.mpContent;
+                    break;
+                case BVTermType::OR:
+                    if(zero) return first.mpContent;
+                    if(ones) return second.mpContent;
+                    break;
+                case BVTermType::XOR:
+                    if(zero) return first.mpContent;
+                    if(ones) return create(BVTermType::NOT, first);
+                    break;
+                case BVTermType::NAND:
+                    if(zero) return constant(width, true);
+                    if(ones) return create(BVTermType::NOT, first);
+                    break;
+                case BVTermType::NOR:
+                    if(zero) return create(BVTermType::NOT, first);
+                    if(ones) return constant(width, false);
+                    break;
+                case BVTermType::XNOR:
+                    if(zero) return create(BVTermType::NOT, first);
+                    if(ones) return first.mpContent;
+                    break;
+                case BVTermType::ADD:
+                case BVTermType::SUB:
+                    if(zero) return first.mpContent;
+                    break;
+                case BVTermType::MUL:
+                    if(zero) return second.mpContent;
+                    if(one) return first.mpContent;
+                    if(ones) return create(BVTermType::NEG, first);
+                    break;
+                case BVTermType::DIV_U:
+                case BVTermType::DIV_S:
+                    if(one) return first.mpContent;
+                    break;
+                case BVTermType::MOD_U:
+                case BVTermType::MOD_S1:
+                case BVTermType::MOD_S2:
+                    if(one) return constant(width, false);
+                    break;
+                case BVTermType::LSHIFT:
+                case BVTermType::RSHIFT_LOGIC:
+                case BVTermType::RSHIFT_ARITH:
+                    if(zero) return first.mpContent;
+                    if(_type != BVTermType::RSHIFT_ARITH && isAtLeast(value, width)) return constant(width, false);
+                    break;
                 default:
-                    CARL_LOG_WARN("carl.bitvector", "No simplification for " << _type << " BVTerm.");
+                    break;
+            }
+        }
+
+        if(first.isConstant() && first.value().isZero()) {
+            switch(_type) {
+                case BVTermType::SUB: return create(BVTermType::NEG, second);
+                case BVTermType::LSHIFT:
+                case BVTermType::RSHIFT_LOGIC:
+                case BVTermType::RSHIFT_ARITH: return first.mpContent;
+                case BVTermType::CONCAT: return create(BVTermType::EXT_U, second, first.width());
+                default: break;
             }
         }
 
-        return this->add(new Term(_type, _first, _second));
+        // Fuse concatenations of adjacent extractions
+        if(_type == BVTermType::CONCAT && first.type() == BVTermType::EXTRACT && second.type() == BVTermType::EXTRACT
+            && first.operand() == second.operand() && first.lowest() == second.highest() + 1) {
+            return create(BVTermType::EXTRACT, first.operand(), first.highest(), second.lowest());
+        }
+
+        return this->add(new Term(_type, first, second));
     }
 
     BVTermPool::ConstTermPtr BVTermPool::create(BVTermType _type, const BVTerm& _operand, const size_t _highest, const size_t _lowest)
     {
+        RewriteKey key{_type, _operand.mpContent, nullptr, _highest, _lowest};
+        ConstTermPtr res = lookup(key);
+        if(res != nullptr) return res;
+        return remember(key, rewrite(_type, _operand, _highest, _lowest));
+    }
+
+    BVTermPool::ConstTermPtr BVTermPool::rewrite(BVTermType _type, const BVTerm& _operand, const size_t _highest, const size_t _lowest)
+    {
+        assert(_type == BVTermType::EXTRACT);
         if(_operand.isConstant()) {
-            if(_type == BVTermType::EXTRACT) {
-                return create(BVTermType::CONSTANT, _operand.value().extract(_highest, _lowest));
-            } else {
-                CARL_LOG_WARN("carl.bitvector", "No simplification for " << _type << " BVTerm.");
+            return create(BVTermType::CONSTANT, _operand.value().extract(_highest, _lowest));
+        }
+        if(_lowest == 0 && _highest + 1 == _operand.width()) {
+            return _operand.mpContent;
+        }
+        switch(_operand.type()) {
+            case BVTermType::EXTRACT:
+                return create(_type, _operand.operand(), _highest + _operand.lowest(), _lowest + _operand.lowest());
+            case BVTermType::CONCAT: {
+                std::size_t low = _operand.second().width();
+                if(_highest < low) return create(_type, _operand.second(), _highest, _lowest);
+                if(_lowest >= low) return create(_type, _operand.first(), _highest - low, _lowest - low);
+                break;
+            }
+            case BVTermType::EXT_U:
+            case BVTermType::EXT_S: {
+                std::size_t low = _operand.operand().width();
+                if(_highest < low) return create(_type, _operand.operand(), _highest, _lowest);
+                if(_lowest >= low && _operand.type() == BVTermType::EXT_U) return constant(_highest - _lowest + 1, false);
+                break;
             }
+            default:
+                break;
         }
         return this->add(new Term(_type, _operand, _highest, _lowest));
     }
@@ -8,8 +8,20 @@
 #include "Pool.h"
 #include "BVTerm.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace carl
 {
+	/**
+	 * Pool of all bit vector terms.
+	 *
+	 * Terms are simplified when they are created: operations on constants are evaluated, operands of commutative
+	 * operations are ordered (constants last, otherwise by id), neutral and absorbing constants are removed, nested
+	 * extractions, rotations and extensions are merged and extractions are pushed into concatenations and extensions.
+	 * The result of every call to create() is cached by its arguments, hence constructing the same term again costs
+	 * only a single lookup. As terms are never removed from the pool, the cache stays valid.
+	 */
 	class BVTermPool : public Singleton<BVTermPool>, public Pool<BVTermContent>
 	{
 		friend Singleton<BVTermPool>;
@@ -20,7 +32,44 @@ namespace carl
 		typedef const Term* ConstTermPtr;
 	private:
 
+		/// Arguments of a call to create(), unused fields are zero.
+		struct RewriteKey
+		{
+			BVTermType mType;
+			ConstTermPtr mFirst;
+			ConstTermPtr mSecond;
+			std::size_t mHighest;
+			std::size_t mLowest;
+
+			bool operator==(const RewriteKey& _other) const
+			{
+				return mType == _other.mType && mFirst == _other.mFirst && mSecond == _other.mSecond && mHighest == _other.mHighest && mLowest == _other.mLowest;
+			}
+		};
+		struct RewriteKeyHash
+		{
+			std::size_t operator()(const RewriteKey& _key) const
+			{
+				std::size_t res = typeId(_key.mType);
+				res = res * 31 + std::hash<ConstTermPtr>()(_key.mFirst);
+				res = res * 31 + std::hash<ConstTermPtr>()(_key.mSecond);
+				res = res * 31 + _key.mHighest;
+				return res * 31 + _key.mLowest;
+			}
+		};
+
 		ConstTermPtr mpInvalid;
+		/// The terms returned by create() for the given arguments.
+		std::unordered_map<RewriteKey, ConstTermPtr, RewriteKeyHash> mRewrites;
+		mutable std::mutex mRewriteMutex;
+
+		ConstTermPtr lookup(const RewriteKey& _key) const;
+		ConstTermPtr remember(const RewriteKey& _key, ConstTermPtr _term);
+
+		ConstTermPtr constant(std::size_t _width, bool _ones);
+		ConstTermPtr rewrite(BVTermType _type, const BVTerm& _operand, const size_t _index);
+		ConstTermPtr rewrite(BVTermType _type, const BVTerm& _first, const BVTerm& _second);
+		ConstTermPtr rewrite(BVTermType _type, const BVTerm& _operand, const size_t _highest, const size_t _lowest);
 
 	public:
 
@@ -41,6 +90,15 @@ namespace carl
 		ConstTermPtr create(BVTermType _type, const BVTerm& _operand, const size_t _first, const size_t _last);
 
 		void assignId(TermPtr _term, std::size_t _id) override;
+
+		/**
+		 * @return The number of cached calls to create().
+		 */
+		std::size_t nrRewrites() const
+		{
+			std::lock_guard<std::mutex> lock(mRewriteMutex);
+			return mRewrites.size();
+		}
 	};
 }
 
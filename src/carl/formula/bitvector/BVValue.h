@@ -328,7 +328,7 @@ namespace carl
             } else if(firstNegative && ! secondNegative) {
                 return -u + _other;
             } else if(! firstNegative && secondNegative) {
-                return (*this) + _other;
+                return u + _other;
             } else {
                 return -u;
             }
@@ -5,6 +5,17 @@
 #include "ModelVariable.h"
 #include "ModelValue.h"
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/permutation_iterator.hpp>
+
 namespace carl
 {
 	/**
@@ -12,38 +23,139 @@ namespace carl
 	 * A variable can be assigned to different values that are represented by a ModelValue.
 	 * Most notably, a value may be a substitution based on the values of other variables.
 	 * If a variable that is used by a substitution for another variable is erased from the model, this substitution is evaluated and replaced by the result.
+	 *
+	 * The interface resembles a std::map, but the assignments are stored in a flat vector.
+	 * Assignments of variables are located via a sparse set indexed by the variable id, all other model variables via a hash map.
+	 * A separate vector holds the indices of the assignments sorted by their variables, iteration and printing follow this order as for a std::map.
+	 * Thus, at() and contains() take constant time, find() takes logarithmic time and inserting or erasing only moves indices.
+	 *
+	 * Unlike for a std::map, inserting or erasing an assignment invalidates all iterators and all references into the model, as for a std::vector.
+	 * The iterator returned by erase() points to the next assignment, hence erasing while iterating visits all remaining assignments.
 	 */
 	template<typename Rational, typename Poly>
 	class Model {
 	public:
-		//using Map = std::unordered_map<ModelVariable,ModelValue>;
 		using key_type = ModelVariable;
 		using mapped_type = ModelValue<Rational,Poly>;
-		using Map = std::map<key_type,mapped_type>;
-		static_assert(std::is_same<key_type, typename Map::key_type>::value, "Should be the same type");
-		static_assert(std::is_same<mapped_type, typename Map::mapped_type>::value, "Should be the same type");
+		using value_type = std::pair<key_type,mapped_type>;
+		using Map = std::vector<value_type>;
+		using Order = std::vector<std::size_t>;
+		using iterator = boost::permutation_iterator<typename Map::iterator, typename Order::const_iterator>;
+		using const_iterator = boost::permutation_iterator<typename Map::const_iterator, typename Order::const_iterator>;
 	private:
+		static constexpr std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
+		/// The assignments in the order of their insertion.
 		Map mData;
-		std::map<key_type, std::size_t> mUsedInSubstitution;
+		/// The indices of the assignments in mData, sorted by their variables.
+		Order mOrder;
+		/// Maps the slot of a variable, see slot(), to its index in mData or NO_INDEX.
+		std::vector<std::size_t> mSparse;
+		/// Maps all other model variables to their index in mData.
+		std::unordered_map<key_type, std::size_t> mIndex;
+		/// Number of variables in mIndex, i.e. variables whose slot is used by another variable with a different rank.
+		std::size_t mCollisions = 0;
+		/// Whether some value may be a substitution, is reset by resetCaches() if there is none.
+		mutable bool mMayContainSubstitutions = false;
+
+		static std::size_t slot(Variable v) {
+			return v.getId() * std::size_t(VariableType::TYPE_SIZE) + std::size_t(v.getType());
+		}
+		std::size_t indexOf(const key_type& key) const {
+			if (key.isVariable()) {
+				std::size_t s = slot(key.asVariable());
+				if (s < mSparse.size() && mSparse[s] != NO_INDEX && mData[mSparse[s]].first == key) return mSparse[s];
+				if (mCollisions == 0) return NO_INDEX;
+			}
+			auto it = mIndex.find(key);
+			if (it == mIndex.end()) return NO_INDEX;
+			return it->second;
+		}
+		/// Position of the given variable in mOrder, or of the first larger variable if it is not assigned.
+		std::size_t position(const key_type& key) const {
+			auto it = std::lower_bound(mOrder.begin(), mOrder.end(), key, [this](std::size_t index, const key_type& k) { return mData[index].first < k; });
+			return std::size_t(it - mOrder.begin());
+		}
+		iterator iteratorAt(std::size_t pos) {
+			return iterator(mData.begin(), mOrder.cbegin() + long(pos));
+		}
+		const_iterator iteratorAt(std::size_t pos) const {
+			return const_iterator(mData.cbegin(), mOrder.cbegin() + long(pos));
+		}
+		bool isInSparse(const key_type& key) const {
+			if (!key.isVariable()) return false;
+			return mCollisions == 0 || mIndex.find(key) == mIndex.end();
+		}
+		/// Stores the location of the new assignment at the given index.
+		void addIndex(std::size_t index) {
+			const key_type& key = mData[index].first;
+			if (key.isVariable()) {
+				std::size_t s = slot(key.asVariable());
+				if (s >= mSparse.size()) mSparse.resize(s + 1, NO_INDEX);
+				if (mSparse[s] == NO_INDEX) {
+					mSparse[s] = index;
+					return;
+				}
+				++mCollisions;
+			}
+			mIndex.emplace(key, index);
+		}
+		void removeIndex(const key_type& key) {
+			if (isInSparse(key)) {
+				mSparse[slot(key.asVariable())] = NO_INDEX;
+			} else {
+				mIndex.erase(key);
+				if (key.isVariable()) --mCollisions;
+			}
+		}
+		void updateIndex(std::size_t index) {
+			const key_type& key = mData[index].first;
+			if (isInSparse(key)) mSparse[slot(key.asVariable())] = index;
+			else mIndex[key] = index;
+		}
+		/// Hands out a mutable iterator, the value may be changed to a substitution through it.
+		iterator exposed(iterator it) {
+			if (it.base() != mOrder.cend()) mMayContainSubstitutions = true;
+			return it;
+		}
+		std::pair<iterator,bool> exposed(std::pair<iterator,bool> res) {
+			res.first = exposed(res.first);
+			return res;
+		}
+		template<typename... Args>
+		std::pair<iterator,bool> emplaceNew(const key_type& key, Args&& ...args) {
+			std::size_t pos = position(key);
+			if (indexOf(key) != NO_INDEX) return std::make_pair(iteratorAt(pos), false);
+			mData.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			addIndex(mData.size() - 1);
+			mOrder.insert(mOrder.begin() + long(pos), mData.size() - 1);
+			if (mData.back().second.isSubstitution()) mMayContainSubstitutions = true;
+			return std::make_pair(iteratorAt(pos), true);
+		}
 		void resetCaches() const {
+			if (!mMayContainSubstitutions) return;
+			bool found = false;
 			for (const auto& d: mData) {
 				if (d.second.isSubstitution()) {
 					d.second.asSubstitution()->resetCache();
+					found = true;
 				}
 			}
+			mMayContainSubstitutions = found;
 		}
 	public:
 		// Element access
 		const auto& at(const key_type& key) const {
-			return mData.at(key);
+			std::size_t index = indexOf(key);
+			if (index == NO_INDEX) throw std::out_of_range("carl::Model::at");
+			return mData[index].second;
 		}
 		
 		// Iterators
 		auto begin() const {
-			return mData.begin();
+			return iteratorAt(0);
 		}
 		auto end() const {
-			return mData.end();
+			return iteratorAt(mOrder.size());
 		}
 		// Capacity
 		auto empty() const {
@@ -55,49 +167,70 @@ namespace carl
 		// Modifiers
 		void clear() {
 			mData.clear();
+			mOrder.clear();
+			mSparse.clear();
+			mIndex.clear();
+			mCollisions = 0;
+			mMayContainSubstitutions = false;
 		}
 		template<typename P>
 		auto insert(const P& pair) {
 			resetCaches();
-			return mData.insert(pair);
+			return exposed(emplaceNew(pair.first, pair.second));
 		}
 		template<typename P>
-		auto insert(typename Map::const_iterator it, const P& pair) {
+		auto insert(const_iterator, const P& pair) {
 			resetCaches();
-			return mData.insert(it, pair);
+			return exposed(emplaceNew(pair.first, pair.second).first);
 		}
 		template<typename... Args>
 		auto emplace(const key_type& key, Args&& ...args) {
 			resetCaches();
-			return mData.emplace(key,std::forward<Args>(args)...);
+			return exposed(emplaceNew(key, std::forward<Args>(args)...));
 		}
 		template<typename... Args>
-		auto emplace_hint(typename Map::const_iterator it, const key_type& key, Args&& ...args) {
+		auto emplace_hint(const_iterator, const key_type& key, Args&& ...args) {
 			resetCaches();
-			return mData.emplace_hint(it, key,std::forward<Args>(args)...);
+			return exposed(emplaceNew(key, std::forward<Args>(args)...).first);
 		}
-		typename Map::iterator erase(const ModelVariable& variable) {
+		iterator erase(const ModelVariable& variable) {
 			resetCaches();
-			return erase(mData.find(variable));
+			return erase(find(variable));
 		}
-		typename Map::iterator erase(const typename Map::iterator& it) {
+		iterator erase(const iterator& it) {
 			resetCaches();
-			return erase(typename Map::const_iterator(it));
+			return erase(const_iterator(it));
 		}
-		typename Map::iterator erase(const typename Map::const_iterator& it) {
-			if (it == mData.end()) return mData.end();
-			for (auto& m: mData) {
-				const auto& val = m.second;
-				if (!val.isSubstitution()) continue;
-				const auto& subs = val.asSubstitution();
-				if (subs->dependsOn(it->first)) {
-					CARL_LOG_DEBUG("carl.formula.model", "Evaluating " << m.first << " ->  " << subs << " as " << it->first << " is removed from the model.");
-					// Prevent memory error due to deallocation in operator=()
-					auto tmp = subs->evaluate(*this);
-					m.second = tmp;
+		iterator erase(const const_iterator& it) {
+			std::size_t pos = std::size_t(it.base() - mOrder.cbegin());
+			if (pos == mOrder.size()) return iteratorAt(pos);
+			std::size_t index = mOrder[pos];
+			if (mMayContainSubstitutions) {
+				for (auto& m: mData) {
+					const auto& val = m.second;
+					if (!val.isSubstitution()) continue;
+					const auto& subs = val.asSubstitution();
+					if (subs->dependsOn(it->first)) {
+						CARL_LOG_DEBUG("carl.formula.model", "Evaluating " << m.first << " ->  " << subs << " as " << it->first << " is removed from the model.");
+						// Prevent memory error due to deallocation in operator=()
+						auto tmp = subs->evaluate(*this);
+						m.second = tmp;
+					}
 				}
 			}
-			return mData.erase(it);
+			removeIndex(mData[index].first);
+			mOrder.erase(mOrder.begin() + long(pos));
+			if (index + 1 != mData.size()) {
+				// move the last assignment into the erased slot
+				std::size_t last = position(mData.back().first);
+				mData[index] = std::move(mData.back());
+				mData.pop_back();
+				updateIndex(index);
+				mOrder[last] = index;
+			} else {
+				mData.pop_back();
+			}
+			return exposed(iteratorAt(pos));
 		}
         void clean() {
             for (auto& m: mData) {
@@ -109,53 +242,60 @@ namespace carl
 			}
         }
 		// Lookup
-		auto find(const typename Map::key_type& key) const {
-			return mData.find(key);
+		const_iterator find(const key_type& key) const {
+			if (indexOf(key) == NO_INDEX) return end();
+			return iteratorAt(position(key));
 		}
-		auto find(const typename Map::key_type& key) {
-			return mData.find(key);
+		iterator find(const key_type& key) {
+			if (indexOf(key) == NO_INDEX) return iteratorAt(mOrder.size());
+			return exposed(iteratorAt(position(key)));
 		}
 		
 		// Additional (w.r.t. std::map)
 		Model() {}
 		Model(const std::map<Variable, Rational>& assignment) {
 			for (const auto& a: assignment) {
-				mData.emplace(a.first, a.second);
+				emplaceNew(a.first, a.second);
 			}
 		}
 		template<typename Container>
 		bool contains(const Container& c) const {
 			for (const auto& var: c) {
-				if (mData.find(var) == mData.end()) return false;
+				if (indexOf(var) == NO_INDEX) return false;
 			}
 			return true;
 		}
 		template<typename T>
-		void assign(const typename Map::key_type& key, const T& t) {
-			auto it = mData.find(key);
-			if (it == mData.end()) mData.emplace(key, t);
-			else it->second = t;
+		void assign(const key_type& key, const T& t) {
+			std::size_t index = indexOf(key);
+			if (index == NO_INDEX) {
+				emplaceNew(key, t);
+			} else {
+				mData[index].second = t;
+				if (mData[index].second.isSubstitution()) mMayContainSubstitutions = true;
+			}
 		}
 		void update(const Model& model, bool disjoint = true) {
 			for (const auto& m: model) {
-				auto res = mData.insert(m);
+				auto res = emplaceNew(m.first, m.second);
 				if (disjoint) {
 					assert(res.second);
 				} else {
 					if (!res.second) {
 						res.first->second = m.second;
+						if (m.second.isSubstitution()) mMayContainSubstitutions = true;
 					}
 				}
 			}
 		}
-		const ModelValue<Rational,Poly>& evaluated(const typename Map::key_type& key) const {
+		const ModelValue<Rational,Poly>& evaluated(const key_type& key) const {
 			const auto& it = at(key);
 			if (it.isSubstitution()) return it.asSubstitution()->evaluate(*this);
 			else return it;
 		}
 		void print(std::ostream& os, bool simple = true) const {
 			os << "(model" << std::endl;
-			for (const auto& ass: mData) {
+			for (const auto& ass: *this) {
 				auto value = ass.second;
 				if (simple) value = evaluated(ass.first);
 
@@ -180,7 +320,7 @@ namespace carl
 		void printOneline(std::ostream& os, bool simple = false) const {
 			os << "{";
 			bool first = true;
-			for (const auto& ass: mData) {
+			for (const auto& ass: *this) {
 				if (!first) os << ", ";
 				auto value = ass.second;
 				if (simple) value = evaluated(ass.first);
@@ -203,6 +343,9 @@ namespace carl
 		}
 	};
 
+	template<typename Rational, typename Poly>
+	constexpr std::size_t Model<Rational,Poly>::NO_INDEX;
+
 	template<typename Rational, typename Poly>
 	std::ostream& operator<<(std::ostream& os, const Model<Rational,Poly>& model) {
 		model.printOneline(os);
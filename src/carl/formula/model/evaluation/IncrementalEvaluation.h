@@ -0,0 +1,240 @@
+/**
+ * @file IncrementalEvaluation.h
+ *
+ * Evaluation of a fixed set of formulas over a model that changes in few variables at a time.
+ */
+
+#pragma once
+
+#include "ModelEvaluation.h"
+
+#include "../../../core/logging.h"
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace carl {
+namespace model {
+
+/**
+ * Keeps the values of a set of formulas over a model up to date.
+ *
+ * For every formula, the variables it depends on are recorded. When the model changes, the evaluator must be told
+ * which variables have changed via changed(). update() then only re-evaluates the formulas that depend on these
+ * variables and reports those whose truth value has changed.
+ *
+ * Every formula is stored with a partial substitution: all variables that are assigned to a rational or Boolean value
+ * and have never been changed since the formula was added are substituted once. The first change of a variable makes it
+ * volatile, i.e. it is not substituted in advance anymore, and the partial substitutions that contain it are rebuilt.
+ * Hence, if only a few variables change repeatedly, evaluating a formula only substitutes these.
+ *
+ * Formulas depending on a variable whose value is a ModelSubstitution are re-evaluated on every update, as the
+ * substitution may depend on arbitrary other variables. Formulas containing uninterpreted equalities are re-evaluated
+ * whenever an uninterpreted function has changed.
+ */
+template<typename Rational, typename Poly>
+class IncrementalEvaluation
+{
+public:
+	using Index = std::size_t;
+private:
+	struct Entry {
+		/// The formula as it was added.
+		Formula<Poly> mFormula;
+		/// The formula with all stable variables substituted.
+		Formula<Poly> mPartial;
+		/// The variables of mFormula.
+		std::vector<Variable> mVariables;
+		ModelValue<Rational,Poly> mValue;
+		/// 1 if mValue is true, 0 if it is false and 2 otherwise, see satisfiedBy().
+		unsigned mTruth = 2;
+		bool mDirty = false;
+		bool mRebuild = true;
+		bool mUsesFunctions = false;
+		bool mIndirect = false;
+		explicit Entry(const Formula<Poly>& f): mFormula(f), mPartial(f) {}
+	};
+
+	const Model<Rational,Poly>& mModel;
+	std::vector<Entry> mEntries;
+	/// Maps every variable to the entries depending on it.
+	std::unordered_map<Variable, std::vector<Index>> mDependents;
+	/// Variables that have been changed at least once.
+	std::unordered_set<Variable> mVolatile;
+	std::vector<Index> mDirty;
+	/// Entries depending on a variable that is assigned to a substitution.
+	std::set<Index> mIndirect;
+	/// Entries containing uninterpreted equalities.
+	std::vector<Index> mFunctionUsers;
+	bool mFunctionsChanged = false;
+	std::size_t mNrEvaluations = 0;
+
+	void markDirty(Index i) {
+		if (mEntries[i].mDirty) return;
+		mEntries[i].mDirty = true;
+		mDirty.push_back(i);
+	}
+
+	/// Substitutes all assigned variables of the entry that are not volatile.
+	void rebuild(Entry& e) {
+		Model<Rational,Poly> stable;
+		for (auto var: e.mVariables) {
+			if (mVolatile.find(var) != mVolatile.end()) continue;
+			auto it = mModel.find(var);
+			if (it == mModel.end()) continue;
+			if (it->second.isRational() || it->second.isBool()) {
+				stable.emplace(var, it->second);
+			}
+		}
+		e.mPartial = stable.empty() ? e.mFormula : substitute(e.mFormula, stable);
+		e.mRebuild = false;
+		CARL_LOG_TRACE("carl.formula.model", "Partial substitution of " << e.mFormula << " is " << e.mPartial);
+	}
+
+	/// Evaluates the entry, returns whether its truth value has changed.
+	bool evaluate(Index i) {
+		Entry& e = mEntries[i];
+		if (e.mRebuild) rebuild(e);
+		bool indirect = false;
+		for (auto var: e.mVariables) {
+			auto it = mModel.find(var);
+			if (it != mModel.end() && it->second.isSubstitution()) {
+				indirect = true;
+				break;
+			}
+		}
+		if (indirect != e.mIndirect) {
+			e.mIndirect = indirect;
+			if (indirect) mIndirect.insert(i);
+			else mIndirect.erase(i);
+		}
+		++mNrEvaluations;
+		e.mValue = model::evaluate(e.mPartial, mModel);
+		unsigned truth = e.mValue.isBool() ? (e.mValue.asBool() ? 1 : 0) : 2;
+		bool res = truth != e.mTruth;
+		e.mTruth = truth;
+		return res;
+	}
+
+public:
+	/**
+	 * @param model The model, it is only read and must outlive this object.
+	 */
+	explicit IncrementalEvaluation(const Model<Rational,Poly>& model): mModel(model) {}
+
+	/**
+	 * Adds a formula and evaluates it over the current model.
+	 * @param f The formula.
+	 * @return The index of the formula.
+	 */
+	Index add(const Formula<Poly>& f) {
+		Index res = mEntries.size();
+		mEntries.emplace_back(f);
+		Entry& e = mEntries.back();
+		Variables vars;
+		f.allVars(vars);
+		e.mVariables.assign(vars.begin(), vars.end());
+		for (auto var: e.mVariables) {
+			mDependents[var].push_back(res);
+		}
+		if (f.propertyHolds(PROP_CONTAINS_UNINTERPRETED_EQUATIONS)) {
+			e.mUsesFunctions = true;
+			mFunctionUsers.push_back(res);
+		}
+		evaluate(res);
+		return res;
+	}
+
+	/**
+	 * Adds a constraint, see add(const Formula<Poly>&).
+	 */
+	Index add(const Constraint<Poly>& c) {
+		return add(Formula<Poly>(c));
+	}
+
+	/**
+	 * Notifies that the value of the given variable has been assigned, changed or removed from the model.
+	 */
+	void changed(const ModelVariable& var) {
+		Variable v;
+		if (var.isVariable()) v = var.asVariable();
+		else if (var.isBVVariable()) v = var.asBVVariable()();
+		else if (var.isUVariable()) v = var.asUVariable()();
+		else {
+			mFunctionsChanged = true;
+			return;
+		}
+		bool first = mVolatile.insert(v).second;
+		auto it = mDependents.find(v);
+		if (it == mDependents.end()) return;
+		for (Index i: it->second) {
+			if (first) mEntries[i].mRebuild = true;
+			markDirty(i);
+		}
+	}
+
+	/**
+	 * Re-evaluates all formulas that may be affected by the changes since the last update.
+	 * @return The indices of the formulas whose truth value has changed, in increasing order.
+	 */
+	std::vector<Index> update() {
+		for (Index i: mIndirect) markDirty(i);
+		if (mFunctionsChanged) {
+			for (Index i: mFunctionUsers) markDirty(i);
+			mFunctionsChanged = false;
+		}
+		std::vector<Index> res;
+		std::vector<Index> dirty;
+		std::swap(dirty, mDirty);
+		for (Index i: dirty) {
+			mEntries[i].mDirty = false;
+			if (evaluate(i)) res.push_back(i);
+		}
+		std::sort(res.begin(), res.end());
+		CARL_LOG_DEBUG("carl.formula.model", "Re-evaluated " << dirty.size() << " of " << mEntries.size() << " formulas, " << res.size() << " changed");
+		return res;
+	}
+
+	/**
+	 * Makes all variables stable again, i.e. the partial substitutions are rebuilt on the next evaluation.
+	 * This is useful if the set of variables that change has shifted.
+	 */
+	void stabilize() {
+		mVolatile.clear();
+		for (auto& e: mEntries) e.mRebuild = true;
+	}
+
+	std::size_t size() const {
+		return mEntries.size();
+	}
+	const Formula<Poly>& formula(Index i) const {
+		return mEntries[i].mFormula;
+	}
+	const std::vector<Variable>& variables(Index i) const {
+		return mEntries[i].mVariables;
+	}
+	/**
+	 * @return The value of the formula as of the last update.
+	 */
+	const ModelValue<Rational,Poly>& value(Index i) const {
+		return mEntries[i].mValue;
+	}
+	/**
+	 * @return 1 if the formula was true at the last update, 0 if it was false and 2 if it could not be decided.
+	 */
+	unsigned satisfied(Index i) const {
+		return mEntries[i].mTruth;
+	}
+	/**
+	 * @return The number of evaluations performed so far.
+	 */
+	std::size_t nrEvaluations() const {
+		return mNrEvaluations;
+	}
+};
+
+}
+}
@@ -4,6 +4,8 @@
 #include "../../bitvector/BVConstraint.h"
 #include "../../bitvector/BVTerm.h"
 
+#include <unordered_map>
+
 namespace carl {
 namespace model {
 
@@ -39,11 +41,67 @@ namespace model {
 		bvc = BVConstraint::create(bvc.relation(), substitute(bvc.lhs(), m), substitute(bvc.rhs(), m));
 	}
 	
+	/**
+	 * Computes the value of a bitvector term over a Model without constructing any intermediate terms.
+	 * @param res The value of the term.
+	 * @param bvt The term.
+	 * @param m The model.
+	 * @param cache The values of the subterms evaluated so far by their ids, shared subterms are evaluated only once.
+	 * @return false, if some variable is not assigned to a bitvector value or a division by zero occurs.
+	 */
+	template<typename Rational, typename Poly>
+	bool evaluateValue(BVValue& res, const BVTerm& bvt, const Model<Rational,Poly>& m, std::unordered_map<std::size_t, BVValue>& cache) {
+		BVTermType type = bvt.type();
+		if (type == BVTermType::CONSTANT) {
+			res = bvt.value();
+			return true;
+		} else if (type == BVTermType::VARIABLE) {
+			auto it = m.find(bvt.variable());
+			if (it == m.end() || !it->second.isBVValue()) return false;
+			res = it->second.asBVValue();
+			return true;
+		}
+		auto it = cache.find(bvt.id());
+		if (it != cache.end()) {
+			res = it->second;
+			return true;
+		}
+		if (typeIsUnary(type)) {
+			BVValue operand;
+			if (!evaluateValue(operand, bvt.operand(), m, cache)) return false;
+			res = carl::evaluate(type, operand, bvt.index());
+		} else if (typeIsBinary(type)) {
+			BVValue first;
+			BVValue second;
+			if (!evaluateValue(first, bvt.first(), m, cache)) return false;
+			if (!evaluateValue(second, bvt.second(), m, cache)) return false;
+			bool division = type == BVTermType::DIV_U || type == BVTermType::DIV_S || type == BVTermType::MOD_U || type == BVTermType::MOD_S1 || type == BVTermType::MOD_S2;
+			if (division && second.isZero()) return false;
+			res = carl::evaluate(type, first, second);
+		} else if (type == BVTermType::EXTRACT) {
+			BVValue operand;
+			if (!evaluateValue(operand, bvt.operand(), m, cache)) return false;
+			res = operand.extract(bvt.highest(), bvt.lowest());
+		} else {
+			return false;
+		}
+		cache.emplace(bvt.id(), res);
+		return true;
+	}
+
 	/**
 	 * Evaluates a bitvector term to a ModelValue over a Model.
+	 * If all variables are assigned, the value is computed directly, otherwise the model is substituted into the term.
 	 */
 	template<typename Rational, typename Poly>
 	void evaluate(ModelValue<Rational,Poly>& res, BVTerm& bvt, const Model<Rational,Poly>& m) {
+		std::unordered_map<std::size_t, BVValue> cache;
+		BVValue value;
+		if (evaluateValue(value, bvt, m, cache)) {
+			bvt = BVTerm(BVTermType::CONSTANT, value);
+			res = value;
+			return;
+		}
 		substituteIn(bvt, m);
 		if (bvt.type() == BVTermType::CONSTANT) {
 			res = bvt.value();
@@ -58,6 +116,17 @@ namespace model {
 	 */
 	template<typename Rational, typename Poly>
 	void evaluate(ModelValue<Rational,Poly>& res, BVConstraint& bvc, const Model<Rational,Poly>& m) {
+		if (!bvc.isConstant()) {
+			std::unordered_map<std::size_t, BVValue> cache;
+			BVValue lhs;
+			BVValue rhs;
+			if (evaluateValue(lhs, bvc.lhs(), m, cache) && evaluateValue(rhs, bvc.rhs(), m, cache)) {
+				bool value = carl::evaluate(lhs, bvc.relation(), rhs);
+				bvc = BVConstraint::create(value);
+				res = value;
+				return;
+			}
+		}
 		substituteIn(bvc, m);
 		if (bvc.isTrue()) res = true;
 		else if (bvc.isFalse()) res = false;
@@ -25,11 +25,16 @@ namespace model {
 	template<typename Rational, typename Poly>
 	void evaluate(ModelValue<Rational,Poly>& res, Constraint<Poly>& c, const Model<Rational,Poly>& m) {
 		Poly p = c.lhs();
-		evaluate(res, p, m);
-		if (res.isRational()) {
-			res = evaluate(res.asRational(), c.relation());
-		} else if (res.isRAN()) {
-			res = evaluate(res.asRAN().sgn(), c.relation());
+		substituteIn(p, m);
+		if (p.isNumber()) {
+			res = evaluate(p.constantPart(), c.relation());
+			return;
+		}
+		// Only the sign is needed, which avoids computing the value of p in most cases.
+		auto vars = p.gatherVariables();
+		auto map = collectRANIR(vars, m);
+		if (map.size() == vars.size()) {
+			res = evaluate(RealAlgebraicNumberEvaluation::evaluateSign(p, map), c.relation());
 		} else {
 			res = createSubstitution<Rational,Poly,ModelFormulaSubstitution<Rational,Poly>>(Formula<Poly>(Constraint<Poly>(p, c.relation())));
 		}
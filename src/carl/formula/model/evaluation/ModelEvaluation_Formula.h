@@ -14,7 +14,7 @@ namespace model {
 	template<typename Rational, typename Poly>
 	void substituteSubformulas(Formula<Poly>& f, const Model<Rational,Poly>& m) {
 		Formulas<Poly> res = f.subformulas();
-		for (auto& r: res) substitute(r, m);
+		for (auto& r: res) r = substitute(r, m);
 		f = Formula<Poly>(f.getType(), std::move(res));
 	}
 
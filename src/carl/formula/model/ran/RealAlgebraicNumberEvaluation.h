@@ -6,6 +6,7 @@
 #pragma once
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 
@@ -93,6 +94,260 @@ UnivariatePolynomial<Number> evaluateCoefficients(
 		std::map<Variable, Interval<Number>>& varToInterval
 );
 
+/**
+ * Evaluates many polynomials at the same point.
+ *
+ * All work that only depends on the point is done once: numeric components are collected for substitution,
+ * the defining polynomials of the interval represented components are converted for the resultant computations,
+ * and a single fresh variable is used for the results.
+ * The components are shared with the point, hence refinements made for one polynomial speed up the evaluation of all others.
+ *
+ * The defining polynomials are monic, hence every polynomial is first reduced modulo them, i.e. to its normal form in the field extension of the point.
+ * This lowers the degrees for the interval filter and the resultants, and decides polynomials that vanish in the extension without any resultant.
+ * Results are memoized per polynomial and per normal form, such that polynomials that agree at the point share the exact computation.
+ *
+ * Sign queries first evaluate the polynomial on the isolating intervals, which are refined adaptively,
+ * and only compute the exact value if this is inconclusive.
+ * If only a single interval represented component remains, the sign is computed directly from its defining polynomial without any resultant.
+ * Points with components in Thom encoding are passed on to evaluate(MultivariatePolynomial, RANMap).
+ */
+template<typename Number>
+class BatchEvaluation {
+public:
+	using Poly = MultivariatePolynomial<Number>;
+private:
+	/// Values of the numeric components.
+	std::map<Variable, Number> mNumeric;
+	/// Components that are not numeric.
+	RANMap<Number> mRANs;
+	/// Defining polynomials of the interval represented components.
+	std::map<Variable, UnivariatePolynomial<Poly>> mDefining;
+	/// Variable for the result of evaluations, created when it is needed first.
+	Variable mResultVariable = Variable::NO_VARIABLE;
+	bool mHasThom = false;
+	std::unordered_map<Poly, RealAlgebraicNumber<Number>> mResults;
+	std::size_t mNrFiltered = 0;
+	std::size_t mNrExact = 0;
+	std::size_t mSignRefinementRounds = 3;
+
+	void add(Variable::Arg v, const RealAlgebraicNumber<Number>& ran) {
+		if (ran.isNumeric()) {
+			mNumeric.emplace(v, ran.value());
+		} else {
+			mRANs.emplace(v, ran);
+			if (ran.isInterval()) {
+				mDefining.emplace(v, UnivariatePolynomial<Poly>(v, ran.getIRPolynomial().template convert<Poly>().coefficients()));
+			} else {
+				mHasThom = true;
+			}
+		}
+	}
+	/// Moves components that have become numeric due to refinements.
+	bool updateNumeric() {
+		bool changed = false;
+		for (auto it = mRANs.begin(); it != mRANs.end();) {
+			if (it->second.isNumeric()) {
+				mNumeric.emplace(it->first, it->second.value());
+				mDefining.erase(it->first);
+				it = mRANs.erase(it);
+				changed = true;
+			} else {
+				++it;
+			}
+		}
+		return changed;
+	}
+	Poly substituteNumeric(const Poly& p) const {
+		if (mNumeric.empty()) return p;
+		return p.substitute(mNumeric);
+	}
+	/// Reduces p modulo the defining polynomials of the interval represented components.
+	Poly reduce(const Poly& p) const {
+		Poly res = p;
+		for (const auto& d: mDefining) {
+			if (res.degree(d.first) < d.second.degree()) continue;
+			// the defining polynomials are monic, hence the pseudo-remainder is the remainder
+			assert(isOne(d.second.lcoeff()));
+			res = Poly(res.toUnivariatePolynomial(d.first).prem(d.second));
+		}
+		return res;
+	}
+	std::map<Variable, Interval<Number>> intervals(const std::set<Variable>& vars) const {
+		std::map<Variable, Interval<Number>> res;
+		for (auto v: vars) {
+			auto it = mRANs.find(v);
+			assert(it != mRANs.end());
+			res.emplace(v, it->second.getInterval());
+		}
+		return res;
+	}
+	/// Refines all components of the given variables once, returns false if some became numeric.
+	bool refine(const std::set<Variable>& vars) {
+		for (auto v: vars) mRANs.at(v).refine();
+		return !updateNumeric();
+	}
+
+	RealAlgebraicNumber<Number> compute(const Poly& p) {
+		Poly pol = reduce(substituteNumeric(p));
+		if (pol.isNumber()) return RealAlgebraicNumber<Number>(pol.constantPart());
+		auto it = mResults.find(pol);
+		if (it != mResults.end()) return it->second;
+		std::set<Variable> vars = pol.gatherVariables();
+		if (mHasThom) {
+			RANMap<Number> m;
+			for (auto v: vars) m.emplace(v, mRANs.at(v));
+			return RealAlgebraicNumberEvaluation::evaluate(pol, m);
+		}
+		auto res = computeExact(pol, vars);
+		mResults.emplace(pol, res);
+		return res;
+	}
+	/// Computes the value of the reduced polynomial pol in the variables vars by resultants.
+	RealAlgebraicNumber<Number> computeExact(const Poly& pol, const std::set<Variable>& vars) {
+		if (vars.size() == 1) {
+			const auto& ran = mRANs.at(*vars.begin());
+			if (ran.sgn(pol.toUnivariatePolynomial(*vars.begin()).toNumberCoefficients()) == Sign::ZERO) {
+				++mNrExact;
+				return RealAlgebraicNumber<Number>(constant_zero<Number>::get());
+			}
+		}
+		if (mResultVariable == Variable::NO_VARIABLE) mResultVariable = freshRealVariable();
+		UnivariatePolynomial<Poly> tmp(mResultVariable, {-pol, Poly(1)});
+		for (auto v: vars) {
+			tmp = tmp.switchVariable(v).resultant(mDefining.at(v));
+		}
+		UnivariatePolynomial<Number> res = tmp.switchVariable(mResultVariable).toNumberCoefficients();
+		CARL_LOG_DEBUG("carl.ran", "Result polynomial of " << pol << " is " << res);
+		assert(!res.isZero());
+		Interval<Number> interval = IntervalEvaluation::evaluate(pol, intervals(vars));
+		while (
+			res.sgn(interval.lower()) == Sign::ZERO ||
+			res.sgn(interval.upper()) == Sign::ZERO ||
+			res.countRealRoots(interval) != 1) {
+			if (!refine(vars)) return compute(pol);
+			interval = IntervalEvaluation::evaluate(pol, intervals(vars));
+		}
+		++mNrExact;
+		return RealAlgebraicNumber<Number>(res, interval);
+	}
+
+public:
+	/**
+	 * @param point Values for the variables.
+	 * @param variables The variables, in the order of the components of point.
+	 */
+	BatchEvaluation(const RealAlgebraicPoint<Number>& point, const std::vector<Variable>& variables) {
+		assert(point.dim() == variables.size());
+		for (std::size_t i = 0; i < point.dim(); i++) add(variables[i], point[i]);
+	}
+	explicit BatchEvaluation(const RANMap<Number>& m) {
+		for (const auto& a: m) add(a.first, a.second);
+	}
+
+	/**
+	 * Evaluates the given polynomial, all its variables must be assigned.
+	 */
+	RealAlgebraicNumber<Number> evaluate(const Poly& p) {
+		auto it = mResults.find(p);
+		if (it != mResults.end()) return it->second;
+		auto res = compute(p);
+		mResults.emplace(p, res);
+		return res;
+	}
+	std::vector<RealAlgebraicNumber<Number>> evaluate(const std::vector<Poly>& polys) {
+		std::vector<RealAlgebraicNumber<Number>> res;
+		res.reserve(polys.size());
+		for (const auto& p: polys) res.push_back(evaluate(p));
+		return res;
+	}
+
+	/**
+	 * Computes the sign of the given polynomial, all its variables must be assigned.
+	 */
+	Sign sgn(const Poly& p) {
+		auto it = mResults.find(p);
+		if (it != mResults.end()) return it->second.sgn();
+		if (mHasThom) return evaluate(p).sgn();
+		Poly pol = reduce(substituteNumeric(p));
+		if (pol.isNumber()) return carl::sgn(pol.constantPart());
+		it = mResults.find(pol);
+		if (it != mResults.end()) return it->second.sgn();
+		std::set<Variable> vars = pol.gatherVariables();
+		// Escalate the refinement: 1, 2, 4, ... refinements of every component in each round.
+		std::size_t refinements = 1;
+		for (std::size_t round = 0; ; ++round) {
+			Interval<Number> interval = IntervalEvaluation::evaluate(pol, intervals(vars));
+			if (interval.isZero()) return Sign::ZERO;
+			if (interval.sgn() != Sign::ZERO) {
+				++mNrFiltered;
+				return interval.sgn();
+			}
+			if (round == mSignRefinementRounds) break;
+			for (std::size_t i = 0; i < refinements; ++i) {
+				// Some component became numeric, start over with the new substitution.
+				if (!refine(vars)) return sgn(p);
+			}
+			refinements *= 2;
+		}
+		CARL_LOG_DEBUG("carl.ran", "Interval evaluation of " << pol << " is inconclusive, computing the sign exactly");
+		if (vars.size() == 1) {
+			++mNrExact;
+			return mRANs.at(*vars.begin()).sgn(pol.toUnivariatePolynomial(*vars.begin()).toNumberCoefficients());
+		}
+		// The exact value is computed, and counted, by compute().
+		return evaluate(p).sgn();
+	}
+	/**
+	 * Sets the number of rounds of refinements that are tried before the sign is computed exactly.
+	 * In round i, every component is refined 2^i times.
+	 */
+	void setSignRefinementRounds(std::size_t rounds) {
+		mSignRefinementRounds = rounds;
+	}
+	std::vector<Sign> sgn(const std::vector<Poly>& polys) {
+		std::vector<Sign> res;
+		res.reserve(polys.size());
+		for (const auto& p: polys) res.push_back(sgn(p));
+		return res;
+	}
+
+	/**
+	 * @return The number of sign queries answered by the interval filter.
+	 */
+	std::size_t nrFiltered() const {
+		return mNrFiltered;
+	}
+	/**
+	 * @return The number of exact computations.
+	 */
+	std::size_t nrExact() const {
+		return mNrExact;
+	}
+};
+
+/**
+ * Computes the sign of the given polynomial at the given point, without constructing the value itself if possible.
+ * @see BatchEvaluation::sgn
+ * @param p Polynomial to be evaluated
+ * @param point Values for variables
+ * @param variables Variables to be assigned
+ * @return Sign of p at the point
+ */
+template<typename Number>
+Sign evaluateSign(const MultivariatePolynomial<Number>& p, const RealAlgebraicPoint<Number>& point, const std::vector<Variable>& variables) {
+	return BatchEvaluation<Number>(point, variables).sgn(p);
+}
+/**
+ * Computes the sign of the given polynomial with the given values for the variables, without constructing the value itself if possible.
+ * @see BatchEvaluation::sgn
+ * @param p Polynomial to be evaluated
+ * @param m Variable assignment
+ * @return Sign of p under m
+ */
+template<typename Number>
+Sign evaluateSign(const MultivariatePolynomial<Number>& p, const RANMap<Number>& m) {
+	return BatchEvaluation<Number>(m).sgn(p);
+}
 
 ////////////////////////////////////////
 ////////////////////////////////////////
@@ -2,6 +2,7 @@
 
 #include "../../core/logging.h"
 
+#include "../CNFConverter.h"
 #include "../Formula.h"
 
 #include <iostream>
@@ -36,54 +37,37 @@ private:
 		return 0;
 	}
 	
-	bool addDisjunction(const Formula<Pol>& f) {
-		if (f.getType() == BOOL || f.getType() == NOT) {
-			long long lit = getLiteral(f);
-			if (lit == 0) return false;
-			mClauses.emplace_back(1, lit);
-			return true;
-		}
-		if (f.getType() == OR) {
-			std::vector<long long> clause;
-			for (const auto& sub: f) {
-				if (sub.getType() == BOOL || sub.getType() == NOT) {
-					long long lit = getLiteral(sub);
-					if (lit == 0) return false;
-					clause.push_back(lit);
-				} else {
-					CARL_LOG_ERROR("carl.dimacs", "Added formula to DIMACSExporter has a clause that is not pure-boolean: " << f);
-					return false;
-				}
-			}
-			mClauses.push_back(std::move(clause));
-			return true;
-		}
-		CARL_LOG_ERROR("carl.dimacs", "Added formula to DIMACSExporter has a clause that is not pure-boolean: " << f);
-		return false;
-	}
-	
 public:
 	bool operator()(const Formula<Pol>& formula) {
-		Formula<Pol> f = formula.toCNF();
-		if (f.getType() == TRUE) {
+		if (formula.getType() == TRUE) {
 			CARL_LOG_INFO("carl.dimacs", "Added TRUE to DIMACSExporter. Skipping...");
 			return true;
 		}
-		if (f.getType() == FALSE) {
+		if (formula.getType() == FALSE) {
 			CARL_LOG_WARN("carl.dimacs", "Added FALSE to DIMACSExporter. Skipping...");
 			return true;
 		}
-		if (f.getType() == OR || f.getType() == BOOL || f.getType() == NOT) {
-			return addDisjunction(f);
-		}
-		if (f.getType() == AND) {
-			for (const auto& sub: f) {
-				if (!addDisjunction(sub)) return false;
+		// The clauses are streamed into mClauses without constructing the CNF as a formula.
+		bool pureBoolean = true;
+		CNFConverter<Pol> converter([this,&pureBoolean](const typename CNFConverter<Pol>::Clause& clause) {
+			if (!pureBoolean) return;
+			std::vector<long long> lits;
+			lits.reserve(clause.size());
+			for (const auto& l: clause) {
+				long long lit = getLiteral(l);
+				if (lit == 0) {
+					pureBoolean = false;
+					return;
+				}
+				lits.push_back(lit);
 			}
-			return true;
+			mClauses.push_back(std::move(lits));
+		});
+		converter.add(formula);
+		if (!pureBoolean) {
+			CARL_LOG_ERROR("carl.dimacs", "Added formula to DIMACSExporter that is not convertible to pure-boolean cnf: " << formula);
 		}
-		CARL_LOG_ERROR("carl.dimacs", "Added formula to DIMACSExporter that is not convertible to pure-boolean cnf: " << formula);
-		return false;
+		return pureBoolean;
 	}
 	void clear() {
 		mVariables.clear();
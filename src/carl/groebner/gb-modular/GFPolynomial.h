@@ -0,0 +1,212 @@
+/**
+ * @file GFPolynomial.h
+ * @ingroup gb
+ *
+ * A lightweight sparse polynomial over a prime field, used by the modular Groebner basis driver.
+ */
+
+#pragma once
+
+#include "../../core/Monomial.h"
+#include "../../numbers/GFNumber.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace carl
+{
+
+/**
+ * Sparse polynomial with coefficients from GF(p).
+ *
+ * The terms are stored in ascending order with respect to the monomial ordering, i.e. the leading term is the last one.
+ * As monomials are pooled, two monomials are equal if and only if their pointers are equal.
+ * All operations construct coefficients via the GFNumber constructor and thereby keep them reduced modulo p.
+ * @ingroup gb
+ */
+template<typename Integer, typename Ordering>
+class GFPolynomial
+{
+public:
+	using Coeff = GFNumber<Integer>;
+	using TermType = std::pair<Monomial::Arg, Coeff>;
+private:
+	std::vector<TermType> mTerms;
+public:
+	GFPolynomial() = default;
+	explicit GFPolynomial(std::vector<TermType>&& terms): mTerms(std::move(terms)) {}
+
+	/**
+	 * Maps an integral polynomial to GF(p). Terms whose coefficients vanish modulo p are removed.
+	 */
+	template<typename Polynomial>
+	static GFPolynomial fromPolynomial(const Polynomial& p, const GaloisField<Integer>* gf) {
+		GFPolynomial res;
+		res.mTerms.reserve(p.nrTerms());
+		for (const auto& t: p) {
+			assert(isInteger(t.coeff()));
+			Coeff c(getNum(t.coeff()), gf);
+			if (!c.isZero()) res.mTerms.emplace_back(t.monomial(), c);
+		}
+		// The terms of p are not necessarily ordered, except for the leading term.
+		std::sort(res.mTerms.begin(), res.mTerms.end(), [](const TermType& lhs, const TermType& rhs){
+			return Ordering::less(lhs.first, rhs.first);
+		});
+		return res;
+	}
+
+	bool isZero() const {
+		return mTerms.empty();
+	}
+	bool isConstant() const {
+		return mTerms.empty() || (mTerms.size() == 1 && !mTerms.back().first);
+	}
+	std::size_t nrTerms() const {
+		return mTerms.size();
+	}
+	const Monomial::Arg& lmon() const {
+		assert(!isZero());
+		return mTerms.back().first;
+	}
+	const Coeff& lcoeff() const {
+		assert(!isZero());
+		return mTerms.back().second;
+	}
+	const std::vector<TermType>& terms() const {
+		return mTerms;
+	}
+
+	/**
+	 * Divides all coefficients by the leading coefficient.
+	 */
+	void makeMonic() {
+		if (isZero() || lcoeff().isOne()) return;
+		Coeff inv = lcoeff().inverse();
+		for (auto& t: mTerms) t.second = t.second * inv;
+	}
+
+	/**
+	 * Computes lhs - c * m * rhs by merging the two term lists.
+	 */
+	static GFPolynomial subtractMultiple(const GFPolynomial& lhs, const Coeff& c, const Monomial::Arg& m, const GFPolynomial& rhs) {
+		std::vector<TermType> res;
+		res.reserve(lhs.mTerms.size() + rhs.mTerms.size());
+		auto lit = lhs.mTerms.begin();
+		auto rit = rhs.mTerms.begin();
+		while (lit != lhs.mTerms.end() || rit != rhs.mTerms.end()) {
+			if (rit == rhs.mTerms.end()) {
+				res.push_back(*lit++);
+				continue;
+			}
+			Monomial::Arg rmon = m * rit->first;
+			if (lit == lhs.mTerms.end()) {
+				res.emplace_back(rmon, -(c * rit->second));
+				++rit;
+				continue;
+			}
+			switch (Ordering::compare(lit->first, rmon)) {
+				case CompareResult::LESS:
+					res.push_back(*lit++);
+					break;
+				case CompareResult::GREATER:
+					res.emplace_back(rmon, -(c * rit->second));
+					++rit;
+					break;
+				case CompareResult::EQUAL: {
+					Coeff diff = lit->second - c * rit->second;
+					if (!diff.isZero()) res.emplace_back(rmon, diff);
+					++lit;
+					++rit;
+					break;
+				}
+			}
+		}
+		return GFPolynomial(std::move(res));
+	}
+
+	/**
+	 * Computes the S-polynomial of two monic polynomials.
+	 */
+	static GFPolynomial SPolynomial(const GFPolynomial& p, const GFPolynomial& q) {
+		assert(!p.isZero() && !q.isZero());
+		assert(p.lcoeff().isOne() && q.lcoeff().isOne());
+		Monomial::Arg lcm = Monomial::lcm(p.lmon(), q.lmon());
+		GFPolynomial scaled;
+		scaled.mTerms.reserve(p.mTerms.size());
+		Monomial::Arg pfactor = quotient(lcm, p.lmon());
+		// The leading terms cancel, hence we drop them right away.
+		for (std::size_t i = 0; i + 1 < p.mTerms.size(); ++i) {
+			scaled.mTerms.emplace_back(pfactor * p.mTerms[i].first, p.mTerms[i].second);
+		}
+		GFPolynomial qtail;
+		qtail.mTerms.assign(q.mTerms.begin(), q.mTerms.end() - 1);
+		return subtractMultiple(scaled, Coeff(Integer(1), p.lcoeff().gf()), quotient(lcm, q.lmon()), qtail);
+	}
+
+	/**
+	 * Fully reduces this polynomial with respect to the given monic polynomials.
+	 * @param divisors Pointers to the (monic) divisors.
+	 */
+	GFPolynomial reduce(const std::vector<const GFPolynomial*>& divisors) const {
+		GFPolynomial rest(*this);
+		std::vector<TermType> remainder;
+		while (!rest.isZero()) {
+			const Monomial::Arg& lm = rest.lmon();
+			const GFPolynomial* divisor = nullptr;
+			for (const auto& d: divisors) {
+				if (divides(d->lmon(), lm)) {
+					divisor = d;
+					break;
+				}
+			}
+			if (divisor == nullptr) {
+				remainder.push_back(rest.mTerms.back());
+				rest.mTerms.pop_back();
+			} else {
+				Coeff c = rest.lcoeff();
+				GFPolynomial tail;
+				tail.mTerms.assign(divisor->mTerms.begin(), divisor->mTerms.end() - 1);
+				Monomial::Arg factor = quotient(lm, divisor->lmon());
+				rest.mTerms.pop_back();
+				rest = subtractMultiple(rest, c, factor, tail);
+			}
+		}
+		std::reverse(remainder.begin(), remainder.end());
+		return GFPolynomial(std::move(remainder));
+	}
+
+	/**
+	 * Checks whether the (possibly constant) monomial d divides m.
+	 */
+	static bool divides(const Monomial::Arg& d, const Monomial::Arg& m) {
+		if (!d) return true;
+		if (!m) return false;
+		return m->divisible(d);
+	}
+
+	/**
+	 * Computes m / d, assuming that d divides m.
+	 */
+	static Monomial::Arg quotient(const Monomial::Arg& m, const Monomial::Arg& d) {
+		if (!d) return m;
+		assert(m);
+		Monomial::Arg res;
+		bool works = m->divide(d, res);
+		assert(works);
+		(void)works;
+		return res;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const GFPolynomial& p) {
+		if (p.isZero()) return os << "0";
+		for (auto it = p.mTerms.rbegin(); it != p.mTerms.rend(); ++it) {
+			if (it != p.mTerms.rbegin()) os << " + ";
+			os << it->second.representingInteger();
+			if (it->first) os << "*" << it->first;
+		}
+		return os;
+	}
+};
+
+}
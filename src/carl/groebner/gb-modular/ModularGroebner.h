@@ -0,0 +1,233 @@
+/**
+ * @file ModularGroebner.h
+ * @ingroup gb
+ *
+ * Multi-modular computation of reduced Groebner bases over the rationals.
+ */
+
+#pragma once
+
+#include "../GBProcedure.h"
+#include "../gb-buchberger/Buchberger.h"
+#include "GFPolynomial.h"
+
+#include "../../numbers/GaloisField.h"
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <vector>
+
+namespace carl
+{
+
+/**
+ * Settings for the modular Groebner basis computation.
+ * @ingroup gb
+ */
+struct ModularGBSettings
+{
+	/// The search for primes starts above this number.
+	unsigned firstPrime = (1u << 25);
+	/// Give up (and use the rational Buchberger algorithm) after this many primes.
+	std::size_t maxPrimes = 64;
+	/// Record the useful pairs for the first prime and only replay these for all other primes.
+	bool useTrace = true;
+	/// Check the reconstructed basis with exact arithmetic before accepting it.
+	bool verify = true;
+	/// Also prove that the reconstructed basis lies in the input ideal by replaying the useful pairs over the rationals.
+	/// This costs about as much as a rational Buchberger run without the pairs that reduce to zero.
+	bool verifyMembership = false;
+};
+
+/**
+ * Statistics collected by the modular Groebner basis computation.
+ * @ingroup gb
+ */
+struct ModularGBStatistics
+{
+	/// Number of primes for which a basis was computed.
+	std::size_t primesUsed = 0;
+	/// Number of primes that were skipped as they divide some leading coefficient.
+	std::size_t primesSkipped = 0;
+	/// Number of primes whose basis had different leading monomials.
+	std::size_t primesUnlucky = 0;
+	/// Number of times replaying the trace failed.
+	std::size_t traceFailures = 0;
+	/// Number of reconstructed candidates that failed the verification.
+	std::size_t verificationFailures = 0;
+	/// Whether we had to fall back to the rational computation.
+	bool usedFallback = false;
+};
+
+/**
+ * The trace of a Buchberger run modulo some prime.
+ * It stores the pairs whose S-polynomials did not reduce to zero, in the order they were processed, together with the leading monomials of the resulting remainders.
+ * @ingroup gb
+ */
+struct GBTrace
+{
+	/// Number of input polynomials.
+	std::size_t nrInputs = 0;
+	/// Useful pairs, given as indices of the intermediate basis.
+	std::vector<std::pair<std::size_t, std::size_t>> pairs;
+	/// Leading monomials of the remainders of the useful pairs.
+	std::vector<Monomial::Arg> leadingMonomials;
+
+	bool empty() const {
+		return pairs.empty() && nrInputs == 0;
+	}
+	void clear() {
+		nrInputs = 0;
+		pairs.clear();
+		leadingMonomials.clear();
+	}
+};
+
+/**
+ * Computes the reduced Groebner basis of an ideal over the rationals by computing reduced Groebner bases modulo several primes.
+ *
+ * The coefficients of the bases modulo p are combined using the chinese remainder theorem and mapped back to the rationals using rational reconstruction.
+ * Once the reconstruction is stable, the candidate is verified: all input polynomials must reduce to zero and all S-polynomials of the candidate must reduce to zero.
+ * This shows that the candidate is a Groebner basis of an ideal containing the input ideal.
+ * Both ideals are equal if at least one of the accepted primes is lucky, i.e. its modular basis is the image of the rational basis, as the leading monomials of the candidate are those of the modular bases.
+ * Only finitely many primes are unlucky.
+ * If verifyMembership is set, this is proven instead: the useful pairs of the last prime are replayed over the rationals, which yields elements of the input ideal,
+ * and all polynomials of the candidate must reduce to zero modulo these.
+ * This makes the verification about as expensive as a rational Buchberger run without the pairs that reduce to zero.
+ * Primes whose bases have different leading monomials are considered unlucky and are discarded by a majority vote.
+ *
+ * If useTrace is set, the first prime is processed with a full Buchberger run that records which pairs were useful.
+ * For all other primes, only these pairs are processed in the same order.
+ * If the replay fails (some remainder is zero or has a different leading monomial), the prime is processed with a full run instead.
+ *
+ * If no verified basis is found within maxPrimes primes, the basis is computed by the rational Buchberger algorithm.
+ * @ingroup gb
+ */
+template<typename Polynomial>
+class ModularGroebner
+{
+public:
+	using Coeff = typename Polynomial::CoeffType;
+	using Integer = typename IntegralType<Coeff>::type;
+	using Ordering = typename Polynomial::OrderedBy;
+	using ModPolynomial = GFPolynomial<Integer, Ordering>;
+private:
+	/// The input polynomials.
+	std::vector<Polynomial> mInput;
+	/// The input polynomials, scaled to have integral coprime coefficients.
+	std::vector<Polynomial> mIntegralInput;
+	/// The resulting reduced Groebner basis.
+	std::vector<Polynomial> mBasis;
+	ModularGBSettings mSettings;
+	ModularGBStatistics mStatistics;
+	GBTrace mTrace;
+
+	/// Leading monomials of the currently accepted modular bases.
+	std::vector<Monomial::Arg> mSignature;
+	/// Number of primes combined into mImages.
+	std::size_t mNrAccepted = 0;
+	/// Number of primes rejected since the last accepted one.
+	std::size_t mNrRejected = 0;
+	/// Product of the accepted primes.
+	Integer mModulus;
+	/// Coefficients of the accepted bases modulo mModulus.
+	std::vector<std::map<Monomial::Arg, Integer, Ordering>> mImages;
+	/// The last successfully reconstructed candidate.
+	std::vector<Polynomial> mCandidate;
+public:
+	explicit ModularGroebner(const ModularGBSettings& settings = ModularGBSettings()):
+		mSettings(settings), mModulus(1)
+	{}
+
+	/**
+	 * Add a polynomial to the generators of the ideal.
+	 * @param p The polynomial to be added.
+	 */
+	void addPolynomial(const Polynomial& p) {
+		if (!p.isZero()) mInput.push_back(p);
+	}
+
+	/**
+	 * Calculate the reduced Groebner basis of the ideal generated by the added polynomials.
+	 */
+	void calculate();
+
+	/**
+	 * Get the reduced Groebner basis, sorted by the leading terms.
+	 * @return The polynomials of the basis.
+	 */
+	const std::vector<Polynomial>& getBasisPolynomials() const {
+		return mBasis;
+	}
+
+	/**
+	 * Get the ideal that is generated by the reduced Groebner basis.
+	 * @return The ideal.
+	 */
+	Ideal<Polynomial> getIdeal() const {
+		Ideal<Polynomial> res;
+		for (const auto& p: mBasis) res.addGenerator(p);
+		return res;
+	}
+
+	const ModularGBStatistics& statistics() const {
+		return mStatistics;
+	}
+
+	const GBTrace& trace() const {
+		return mTrace;
+	}
+
+	/**
+	 * Computes the reduced Groebner basis of the given polynomials modulo p using the Buchberger algorithm.
+	 * If trace is not nullptr, the useful pairs are recorded into it.
+	 * @param input Monic input polynomials over GF(p).
+	 * @param trace Trace to record into, may be nullptr.
+	 * @return The reduced Groebner basis, sorted by leading monomials.
+	 */
+	static std::vector<ModPolynomial> buchberger(const std::vector<ModPolynomial>& input, GBTrace* trace);
+
+	/**
+	 * Replays a trace modulo p.
+	 * @param input Monic input polynomials over GF(p).
+	 * @param trace The trace to replay.
+	 * @param result Stores the reduced Groebner basis, sorted by leading monomials.
+	 * @return false, if the trace could not be replayed for this prime.
+	 */
+	static bool replay(const std::vector<ModPolynomial>& input, const GBTrace& trace, std::vector<ModPolynomial>& result);
+
+	/**
+	 * Reconstructs a fraction r/s from its image modulo m, such that |r|,|s| <= sqrt(m/2).
+	 * @param a The image, 0 <= a < m.
+	 * @param m The modulus.
+	 * @param res Stores the fraction.
+	 * @return false, if no such fraction exists.
+	 */
+	static bool rationalReconstruction(const Integer& a, const Integer& m, Coeff& res);
+
+	/**
+	 * Returns the smallest prime larger than n.
+	 */
+	static unsigned nextPrime(unsigned n);
+
+private:
+	/// Computes the reduced basis modulo p. Returns false, if p divides some leading coefficient.
+	bool computeModular(unsigned p, std::vector<ModPolynomial>& result);
+	/// Combines a basis modulo p with mImages. Returns false, if p is considered unlucky.
+	bool combine(unsigned p, const std::vector<ModPolynomial>& basis);
+	/// Reconstructs rational coefficients from mImages into candidate.
+	bool reconstruct(std::vector<Polynomial>& candidate) const;
+	/// Checks that candidate is a Groebner basis of the input ideal.
+	bool verify(const std::vector<Polynomial>& candidate) const;
+	/// Checks that candidate lies in the input ideal by replaying mTrace over the rationals, see verifyMembership.
+	bool inInputIdeal(const std::vector<Polynomial>& candidate) const;
+	/// Computes the basis using the rational Buchberger algorithm.
+	void fallback();
+	/// Minimizes and interreduces a Groebner basis modulo p.
+	static std::vector<ModPolynomial> reduceBasis(std::vector<ModPolynomial>&& basis);
+};
+
+}
+
+#include "ModularGroebner.tpp"
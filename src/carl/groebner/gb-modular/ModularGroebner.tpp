@@ -0,0 +1,403 @@
+/**
+ * @file ModularGroebner.tpp
+ * @ingroup gb
+ */
+
+#pragma once
+
+#include "ModularGroebner.h"
+
+#include <set>
+#include <tuple>
+
+namespace carl
+{
+
+template<typename Polynomial>
+void ModularGroebner<Polynomial>::calculate()
+{
+	CARL_LOG_INFO("carl.gb.modular", "Calculate gb of " << mInput);
+	mBasis.clear();
+	mIntegralInput.clear();
+	mTrace.clear();
+	mSignature.clear();
+	mImages.clear();
+	mCandidate.clear();
+	mNrAccepted = 0;
+	mNrRejected = 0;
+	mModulus = Integer(1);
+	mStatistics = ModularGBStatistics();
+	if (mInput.empty()) return;
+
+	for (const auto& p: mInput) {
+		mIntegralInput.push_back(p.coprimeCoefficients());
+	}
+
+	unsigned prime = mSettings.firstPrime;
+	for (std::size_t n = 0; n < mSettings.maxPrimes; ++n) {
+		prime = nextPrime(prime);
+		std::vector<ModPolynomial> basis;
+		if (!computeModular(prime, basis)) {
+			CARL_LOG_DEBUG("carl.gb.modular", prime << " divides a leading coefficient, skipping it");
+			mStatistics.primesSkipped++;
+			continue;
+		}
+		mStatistics.primesUsed++;
+		CARL_LOG_DEBUG("carl.gb.modular", "Basis modulo " << prime << ": " << basis);
+		if (!combine(prime, basis)) continue;
+
+		std::vector<Polynomial> candidate;
+		if (!reconstruct(candidate)) continue;
+		if (candidate != mCandidate) {
+			// Wait until the reconstruction is stable.
+			mCandidate = std::move(candidate);
+			continue;
+		}
+		CARL_LOG_DEBUG("carl.gb.modular", "Candidate after " << mNrAccepted << " primes: " << candidate);
+		if (!mSettings.verify || verify(candidate)) {
+			mBasis = std::move(candidate);
+			return;
+		}
+		CARL_LOG_DEBUG("carl.gb.modular", "Verification failed for " << candidate);
+		mStatistics.verificationFailures++;
+		mCandidate.clear();
+	}
+	fallback();
+}
+
+template<typename Polynomial>
+bool ModularGroebner<Polynomial>::computeModular(unsigned p, std::vector<ModPolynomial>& result)
+{
+	const GaloisField<Integer>* gf = GaloisFieldManager<Integer>::getInstance().getField(p);
+	Integer modulus(p);
+	std::vector<ModPolynomial> input;
+	input.reserve(mIntegralInput.size());
+	for (const auto& q: mIntegralInput) {
+		if (carl::isZero(carl::mod(getNum(q.lcoeff()), modulus))) return false;
+		input.push_back(ModPolynomial::fromPolynomial(q, gf));
+		input.back().makeMonic();
+	}
+	if (!mSettings.useTrace) {
+		// The trace is still needed if the verification replays it over the rationals.
+		mTrace.clear();
+		result = buchberger(input, mSettings.verifyMembership ? &mTrace : nullptr);
+		return true;
+	}
+	if (!mTrace.empty()) {
+		if (replay(input, mTrace, result)) return true;
+		CARL_LOG_DEBUG("carl.gb.modular", "Replaying the trace failed for " << p);
+		mStatistics.traceFailures++;
+	}
+	// Record a new trace, the old one was either empty or does not work for this prime.
+	mTrace.clear();
+	result = buchberger(input, &mTrace);
+	return true;
+}
+
+template<typename Polynomial>
+bool ModularGroebner<Polynomial>::combine(unsigned p, const std::vector<ModPolynomial>& basis)
+{
+	std::vector<Monomial::Arg> signature;
+	for (const auto& b: basis) signature.push_back(b.lmon());
+	if (mNrAccepted > 0 && signature != mSignature) {
+		mStatistics.primesUnlucky++;
+		mNrRejected++;
+		// Majority vote: keep the current images unless the rejected primes outnumber them.
+		if (mNrRejected <= mNrAccepted) return false;
+		CARL_LOG_DEBUG("carl.gb.modular", "Discarding the images of " << mNrAccepted << " primes");
+		mNrAccepted = 0;
+	}
+	Integer prime(p);
+	if (mNrAccepted == 0) {
+		mSignature = std::move(signature);
+		mModulus = prime;
+		mImages.assign(basis.size(), std::map<Monomial::Arg, Integer, Ordering>());
+		mCandidate.clear();
+		for (std::size_t i = 0; i < basis.size(); ++i) {
+			for (const auto& t: basis[i].terms()) {
+				Integer c = carl::mod(t.second.representingInteger(), prime);
+				if (c < 0) c += prime;
+				mImages[i].emplace(t.first, c);
+			}
+		}
+	} else {
+		// Chinese remaindering: x = r + M * ((s - r) * M^-1 mod p)
+		const GaloisField<Integer>* gf = basis.front().lcoeff().gf();
+		Integer inv = GFNumber<Integer>(mModulus, gf).inverse().representingInteger();
+		for (std::size_t i = 0; i < basis.size(); ++i) {
+			// Monomials that are missing in one of the images have coefficient zero there.
+			std::map<Monomial::Arg, Integer, Ordering> residues;
+			for (const auto& t: basis[i].terms()) {
+				residues.emplace(t.first, t.second.representingInteger());
+				mImages[i].emplace(t.first, Integer(0));
+			}
+			for (auto& image: mImages[i]) {
+				auto it = residues.find(image.first);
+				Integer s = (it == residues.end()) ? Integer(0) : it->second;
+				Integer d = carl::mod(Integer((s - image.second) * inv), prime);
+				if (d < 0) d += prime;
+				image.second += mModulus * d;
+			}
+		}
+		mModulus *= prime;
+	}
+	mNrAccepted++;
+	mNrRejected = 0;
+	return true;
+}
+
+template<typename Polynomial>
+bool ModularGroebner<Polynomial>::reconstruct(std::vector<Polynomial>& candidate) const
+{
+	candidate.clear();
+	for (const auto& image: mImages) {
+		typename Polynomial::TermsType terms;
+		for (const auto& t: image) {
+			if (carl::isZero(t.second)) continue;
+			Coeff c;
+			if (!rationalReconstruction(t.second, mModulus, c)) return false;
+			terms.emplace_back(c, t.first);
+		}
+		candidate.emplace_back(std::move(terms), false, false);
+	}
+	return true;
+}
+
+template<typename Polynomial>
+bool ModularGroebner<Polynomial>::verify(const std::vector<Polynomial>& candidate) const
+{
+	Ideal<Polynomial> ideal;
+	for (const auto& g: candidate) ideal.addGenerator(g);
+	for (const auto& f: mInput) {
+		Reductor<Polynomial, Polynomial> reductor(ideal, f);
+		if (!reductor.fullReduce().isZero()) return false;
+	}
+	for (std::size_t i = 0; i < candidate.size(); ++i) {
+		for (std::size_t j = i + 1; j < candidate.size(); ++j) {
+			const Monomial::Arg& mi = candidate[i].lmon();
+			const Monomial::Arg& mj = candidate[j].lmon();
+			// Buchberger's first criterion
+			if (mi && mj && Monomial::lcm(mi, mj)->tdeg() == mi->tdeg() + mj->tdeg()) continue;
+			Reductor<Polynomial, Polynomial> reductor(ideal, Polynomial::SPolynomial(candidate[i], candidate[j]));
+			if (!reductor.fullReduce().isZero()) return false;
+		}
+	}
+	return !mSettings.verifyMembership || inInputIdeal(candidate);
+}
+
+template<typename Polynomial>
+bool ModularGroebner<Polynomial>::inInputIdeal(const std::vector<Polynomial>& candidate) const
+{
+	if (mTrace.nrInputs != mIntegralInput.size()) return false;
+	// Every generator is an S-polynomial of ideal elements reduced by ideal elements, hence lies in the input ideal.
+	// The generators are normalized, as the reductor expects monic divisors.
+	Ideal<Polynomial> ideal;
+	// The generator for every element of the modular basis, none if it vanished over the rationals.
+	std::vector<boost::optional<std::size_t>> generators;
+	for (const auto& p: mIntegralInput) {
+		if (p.isConstant()) return true;
+		generators.emplace_back(ideal.addGenerator(p.normalize()));
+	}
+	for (const auto& pair: mTrace.pairs) {
+		if (pair.first >= generators.size() || pair.second >= generators.size()) return false;
+		const auto& i = generators[pair.first];
+		const auto& j = generators[pair.second];
+		if (!i || !j) {
+			generators.emplace_back();
+			continue;
+		}
+		Reductor<Polynomial, Polynomial> reductor(ideal, Polynomial::SPolynomial(ideal.getGenerator(*i), ideal.getGenerator(*j)));
+		Polynomial remainder = reductor.fullReduce();
+		if (remainder.isZero()) {
+			// This pair is useless over the rationals, the other generators may still suffice.
+			generators.emplace_back();
+			continue;
+		}
+		if (remainder.isConstant()) return true;
+		generators.emplace_back(ideal.addGenerator(remainder.normalize()));
+	}
+	for (const auto& g: candidate) {
+		Reductor<Polynomial, Polynomial> reductor(ideal, g);
+		if (!reductor.fullReduce().isZero()) return false;
+	}
+	return true;
+}
+
+template<typename Polynomial>
+void ModularGroebner<Polynomial>::fallback()
+{
+	CARL_LOG_INFO("carl.gb.modular", "No verified basis after " << mSettings.maxPrimes << " primes, using the rational Buchberger algorithm");
+	mStatistics.usedFallback = true;
+	GBProcedure<Polynomial, Buchberger, StdAdding> gbobject;
+	for (const auto& p: mInput) gbobject.addPolynomial(p);
+	gbobject.reduceInput();
+	gbobject.calculate();
+	mBasis = gbobject.getBasisPolynomials();
+}
+
+template<typename Polynomial>
+std::vector<typename ModularGroebner<Polynomial>::ModPolynomial> ModularGroebner<Polynomial>::buchberger(const std::vector<ModPolynomial>& input, GBTrace* trace)
+{
+	using PairEntry = std::tuple<Monomial::Arg, std::size_t, std::size_t>;
+	// Normal strategy: process the pair with the smallest lcm first.
+	auto pairLess = [](const PairEntry& lhs, const PairEntry& rhs) {
+		switch (Ordering::compare(std::get<0>(lhs), std::get<0>(rhs))) {
+			case CompareResult::LESS: return true;
+			case CompareResult::GREATER: return false;
+			default: return std::make_pair(std::get<1>(lhs), std::get<2>(lhs)) < std::make_pair(std::get<1>(rhs), std::get<2>(rhs));
+		}
+	};
+	std::set<PairEntry, decltype(pairLess)> queue(pairLess);
+	std::set<std::pair<std::size_t, std::size_t>> pending;
+	std::vector<ModPolynomial> basis;
+
+	auto add = [&](const ModPolynomial& p) {
+		std::size_t index = basis.size();
+		basis.push_back(p);
+		for (std::size_t i = 0; i < index; ++i) {
+			queue.emplace(Monomial::lcm(basis[i].lmon(), p.lmon()), i, index);
+			pending.emplace(i, index);
+		}
+	};
+	auto isPending = [&pending](std::size_t i, std::size_t j) {
+		return pending.count(std::make_pair(std::min(i, j), std::max(i, j))) > 0;
+	};
+
+	if (trace != nullptr) trace->nrInputs = input.size();
+	for (const auto& p: input) {
+		if (p.isZero()) continue;
+		if (p.isConstant()) return {p};
+		add(p);
+	}
+	while (!queue.empty()) {
+		Monomial::Arg lcm;
+		std::size_t i, j;
+		std::tie(lcm, i, j) = *queue.begin();
+		queue.erase(queue.begin());
+		pending.erase(std::make_pair(i, j));
+		// Buchberger's first criterion
+		if (lcm->tdeg() == basis[i].lmon()->tdeg() + basis[j].lmon()->tdeg()) continue;
+		// Buchberger's second criterion
+		bool chain = false;
+		for (std::size_t k = 0; !chain && k < basis.size(); ++k) {
+			if (k == i || k == j) continue;
+			chain = ModPolynomial::divides(basis[k].lmon(), lcm) && !isPending(i, k) && !isPending(j, k);
+		}
+		if (chain) continue;
+
+		std::vector<const ModPolynomial*> divisors;
+		for (const auto& b: basis) divisors.push_back(&b);
+		ModPolynomial remainder = ModPolynomial::SPolynomial(basis[i], basis[j]).reduce(divisors);
+		if (remainder.isZero()) continue;
+		remainder.makeMonic();
+		if (trace != nullptr) {
+			trace->pairs.emplace_back(i, j);
+			trace->leadingMonomials.push_back(remainder.lmon());
+		}
+		if (remainder.isConstant()) return {remainder};
+		add(remainder);
+	}
+	return reduceBasis(std::move(basis));
+}
+
+template<typename Polynomial>
+bool ModularGroebner<Polynomial>::replay(const std::vector<ModPolynomial>& input, const GBTrace& trace, std::vector<ModPolynomial>& result)
+{
+	if (input.size() != trace.nrInputs) return false;
+	std::vector<ModPolynomial> basis;
+	for (const auto& p: input) {
+		if (p.isZero()) continue;
+		if (p.isConstant()) {
+			result = {p};
+			return true;
+		}
+		basis.push_back(p);
+	}
+	for (std::size_t n = 0; n < trace.pairs.size(); ++n) {
+		std::size_t i = trace.pairs[n].first;
+		std::size_t j = trace.pairs[n].second;
+		if (i >= basis.size() || j >= basis.size()) return false;
+		std::vector<const ModPolynomial*> divisors;
+		for (const auto& b: basis) divisors.push_back(&b);
+		ModPolynomial remainder = ModPolynomial::SPolynomial(basis[i], basis[j]).reduce(divisors);
+		if (remainder.isZero() || remainder.lmon() != trace.leadingMonomials[n]) return false;
+		remainder.makeMonic();
+		if (remainder.isConstant()) {
+			result = {remainder};
+			return true;
+		}
+		basis.push_back(std::move(remainder));
+	}
+	result = reduceBasis(std::move(basis));
+	return true;
+}
+
+template<typename Polynomial>
+std::vector<typename ModularGroebner<Polynomial>::ModPolynomial> ModularGroebner<Polynomial>::reduceBasis(std::vector<ModPolynomial>&& basis)
+{
+	// Make the basis minimal. For equal leading monomials, we keep the first one.
+	std::vector<bool> redundant(basis.size(), false);
+	for (std::size_t i = 0; i < basis.size(); ++i) {
+		for (std::size_t j = 0; !redundant[i] && j < basis.size(); ++j) {
+			if (i == j) continue;
+			if (basis[j].lmon() == basis[i].lmon()) redundant[i] = j < i;
+			else redundant[i] = ModPolynomial::divides(basis[j].lmon(), basis[i].lmon());
+		}
+	}
+	std::vector<ModPolynomial> minimal;
+	for (std::size_t i = 0; i < basis.size(); ++i) {
+		if (!redundant[i]) minimal.push_back(std::move(basis[i]));
+	}
+	std::sort(minimal.begin(), minimal.end(), [](const ModPolynomial& lhs, const ModPolynomial& rhs){
+		return Ordering::less(lhs.lmon(), rhs.lmon());
+	});
+	// Interreduce, this does not change the leading monomials.
+	std::vector<ModPolynomial> result;
+	for (std::size_t i = 0; i < minimal.size(); ++i) {
+		std::vector<const ModPolynomial*> divisors;
+		for (std::size_t j = 0; j < minimal.size(); ++j) {
+			if (i != j) divisors.push_back(&minimal[j]);
+		}
+		result.push_back(minimal[i].reduce(divisors));
+		assert(result.back().lmon() == minimal[i].lmon());
+		result.back().makeMonic();
+	}
+	return result;
+}
+
+template<typename Polynomial>
+bool ModularGroebner<Polynomial>::rationalReconstruction(const Integer& a, const Integer& m, Coeff& res)
+{
+	Integer r0 = m;
+	Integer r1 = a;
+	Integer s0(0);
+	Integer s1(1);
+	// Extended euclidean algorithm until r1 <= sqrt(m/2)
+	while (Integer(2 * r1 * r1) > m) {
+		Integer q = carl::quotient(r0, r1);
+		Integer tmp = r0 - q * r1;
+		r0 = r1;
+		r1 = tmp;
+		tmp = s0 - q * s1;
+		s0 = s1;
+		s1 = tmp;
+	}
+	if (Integer(2 * s1 * s1) > m) return false;
+	if (carl::isZero(s1) || carl::gcd(r1, carl::abs(s1)) != Integer(1)) return false;
+	res = Coeff(r1) / Coeff(s1);
+	return true;
+}
+
+template<typename Polynomial>
+unsigned ModularGroebner<Polynomial>::nextPrime(unsigned n)
+{
+	for (unsigned candidate = (n % 2 == 0) ? n + 1 : n + 2; ; candidate += 2) {
+		bool isPrime = true;
+		for (unsigned d = 3; isPrime && static_cast<unsigned long>(d) * d <= candidate; d += 2) {
+			isPrime = (candidate % d != 0);
+		}
+		if (isPrime) return candidate;
+	}
+}
+
+}
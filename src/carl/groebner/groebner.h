@@ -9,4 +9,5 @@
 
 #include "GBProcedure.h"
 #include "gb-buchberger/Buchberger.h"
+#include "gb-modular/ModularGroebner.h"
 #include "Reductor.h"
\ No newline at end of file
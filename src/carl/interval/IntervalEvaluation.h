@@ -15,6 +15,8 @@
 #include "../core/FactorizedPolynomial.h"
 #include "../core/MultivariatePolynomial.h"
 
+#include <memory>
+
 
 
 namespace carl
@@ -49,6 +51,11 @@ public:
 	
 	template<typename PolynomialType, typename Number, class strategy>
 	static Interval<Number> evaluate(const MultivariateHorner<PolynomialType, strategy>& mvH, const std::map<Variable, Interval<Number>>& map);
+
+	template<typename PolynomialType, typename Number, class strategy>
+	static Interval<Number> evaluate(const std::shared_ptr<const MultivariateHorner<PolynomialType, strategy>>& mvH, const std::map<Variable, Interval<Number>>& map) {
+		return evaluate(*mvH, map);
+	}
     
 private:
 
@@ -177,7 +184,7 @@ inline Interval<Number> IntervalEvaluation::evaluate(const MultivariateHorner<Po
 	if (mvH.getVariable() != Variable::NO_VARIABLE){
 		assert(map.count(mvH.getVariable()) > 0);
 		Interval<Number> res = Interval<Number>::emptyInterval();
-		const Interval<Number> varValue = map.find(mvH.getVariable())->second;
+		const Interval<Number>& varValue = map.find(mvH.getVariable())->second;
 
 		
 
@@ -78,12 +78,18 @@ private:
 		return symmetricModulo(n);
 	}
 	
+	/**
+	 * Returns the representative of n from [-(p^k-1)/2, (p^k-1)/2].
+	 * The representative is unique, hence it can be compared directly.
+	 */
 	IntegerType symmetricModulo(const IntegerType& n) const	{
-		if (n > mMaxValue) {
-			return carl::mod(IntegerType(n-mModulus), mPK) - mMaxValue;
-		} else {
-			return carl::mod(n, mPK);
+		IntegerType res = carl::mod(n, mPK);
+		if (res > mMaxValue) {
+			res -= mPK;
+		} else if (res < IntegerType(-mMaxValue)) {
+			res += mPK;
 		}
+		return res;
 	}
 	
 	friend bool operator==(const GaloisField& lhs, const GaloisField& rhs) {
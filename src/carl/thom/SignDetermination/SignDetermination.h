@@ -15,6 +15,7 @@
 #include <cmath>
 #include <iterator>
 #include <list>
+#include <map>
 #include <queue>
 
 
@@ -39,6 +40,11 @@ private:
 	std::list<uint> mAdaHelper;
 	Eigen::MatrixXf mMatrix;
 	bool mNeedsUpdate;
+	// sign conditions realized by the polynomials given to getSigns(), valid until the next polynomial is added
+	std::map<Polynomial, std::list<SignCondition>> mSignCache;
+	// decompositions of the kronecker product of mMatrix with the matrix for the signs realized by a new polynomial,
+	// indexed by the bitmask of these signs (zero, positive, negative), valid until mMatrix changes
+	std::map<uint, Eigen::PartialPivLU<Eigen::MatrixXf>> mDecompositions;
 	
 	
 	
@@ -52,7 +58,9 @@ public:
 		mAda(),
 		mAdaHelper(),
 		mMatrix(),
-		mNeedsUpdate(false)
+		mNeedsUpdate(false),
+		mSignCache(),
+		mDecompositions()
 	{}
 
 	
@@ -67,7 +75,9 @@ public:
 		mAda(other.mAda),
 		mAdaHelper(other.mAdaHelper),
 		mMatrix(other.mMatrix),
-		mNeedsUpdate(other.mNeedsUpdate)
+		mNeedsUpdate(other.mNeedsUpdate),
+		mSignCache(other.mSignCache),
+		mDecompositions(other.mDecompositions)
 	{}
 	
 	uint sizeOfZeroSet() const {
@@ -277,6 +287,7 @@ private:
 		}
 		mAda = newAda;
 		mMatrix = adaptedMat(mAda, mSigns);
+		mDecompositions.clear();
 		CARL_LOG_ASSERT("carl.thom.sign", Eigen::FullPivLU<Eigen::MatrixXf>(mMatrix).rank() == mMatrix.cols(), "mMatrix must be invertible!");
 		mProducts = adaptedProducts;
 		mNeedsUpdate = false;
@@ -315,9 +326,10 @@ private:
 		int cpos = (taq1 + taq2) / 2; // ensured to be an exact division
 		int cneg = (taq2 - taq1) / 2;
 		// the order in which elements are added to currSigns is important
-		if(czer != 0) currSigns.emplace_back(1, Sign::ZERO);
-		if(cpos != 0) currSigns.emplace_back(1, Sign::POSITIVE);
-		if(cneg != 0) currSigns.emplace_back(1, Sign::NEGATIVE);
+		uint pattern = 0;
+		if(czer != 0) { currSigns.emplace_back(1, Sign::ZERO); pattern |= 1; }
+		if(cpos != 0) { currSigns.emplace_back(1, Sign::POSITIVE); pattern |= 2; }
+		if(cneg != 0) { currSigns.emplace_back(1, Sign::NEGATIVE); pattern |= 4; }
 		currAda = {{0}, {1}, {2}};
 		currAda.resize(currSigns.size());
 		currProducts.resize(currSigns.size());     
@@ -341,10 +353,14 @@ private:
 			index++;
 		}
 		
-		Eigen::MatrixXf M_prime = kroneckerProduct(currM, mMatrix);
-		CARL_LOG_ASSERT("carl.thom.sign", Eigen::FullPivLU<Eigen::MatrixXf>(M_prime).rank() == M_prime.cols(), "M_prime must be invertible!");
-		Eigen::PartialPivLU<Eigen::MatrixXf> dec(M_prime);
-		Eigen::VectorXf c = dec.solve(dprime);
+		// M_prime only depends on the signs realized by p, hence its decomposition is reused for further polynomials
+		auto decIt = mDecompositions.find(pattern);
+		if(decIt == mDecompositions.end()) {
+			Eigen::MatrixXf M_prime = kroneckerProduct(currM, mMatrix);
+			CARL_LOG_ASSERT("carl.thom.sign", Eigen::FullPivLU<Eigen::MatrixXf>(M_prime).rank() == M_prime.cols(), "M_prime must be invertible!");
+			decIt = mDecompositions.emplace(pattern, Eigen::PartialPivLU<Eigen::MatrixXf>(M_prime)).first;
+		}
+		Eigen::VectorXf c = decIt->second.solve(dprime);
 		CARL_LOG_ASSERT("carl.thom.sign", (uint)c.size() == currSigns.size() * mSigns.size(), "failure in sign determination");
 		
 		std::list<SignCondition> newSigns;
@@ -379,11 +395,14 @@ public:
 	 * MAIN INTERFACES
 	 */
 	std::list<SignCondition> getSigns(const Polynomial& p) {
+		auto it = mSignCache.find(p);
+		if(it != mSignCache.end()) return it->second;
 		std::list<Polynomial> dummyProducts;
 		std::list<Alpha> dummyAda;
 		std::list<uint> dummyHelper;
 		Eigen::MatrixXf dummyMatrix;
 		std::list<SignCondition> newSigns = getSigns(p, dummyProducts, dummyAda, dummyHelper, dummyMatrix);
+		mSignCache.emplace(p, newSigns);
 		return newSigns;
 	}
 	
@@ -399,6 +418,8 @@ public:
 			mMatrix = newMatrix;
 			mNeedsUpdate = false;
 		}
+		mSignCache.clear();
+		mDecompositions.clear();
 		mP.push_front(p);
 		mSigns = newSigns;
 		mProducts = newProducts;
@@ -9,6 +9,7 @@
 
 #include <eigen3/Eigen/Dense>
 #include <cmath>
+#include <utility>
 #include <vector>
 
 namespace carl {
@@ -91,4 +92,61 @@ std::vector<Coeff> charPol(const CoeffMatrix<Coeff>& m) {
 	return res;
 }
 
+/*
+ * Computes the characteristic polynomial det(X*I - m) by reducing m to upper Hessenberg form, see
+ * algorithm 2.2.9 in "A Course in Computational Algebraic Number Theory" by Cohen.
+ * Uses O(n^3) field operations and no matrix products, hence it is preferable to charPol() for exact coefficients.
+ * The result contains the coefficients in increasing order of the exponents.
+ */
+template<typename Coeff>
+std::vector<Coeff> charPolHessenberg(CoeffMatrix<Coeff> m) {
+	CARL_LOG_FUNC("carl.thom.tarski", "");
+	Eigen::Index n = m.cols();
+	CARL_LOG_ASSERT("carl.thom.tarski", n == m.rows(), "can only compute characteristic polynomial of square matrix");
+	CARL_LOG_INFO("carl.thom.tarski", "input has size " << n << "x" << n);
+	
+	// reduce m to upper Hessenberg form by similarity transformations
+	for(Eigen::Index col = 1; col + 1 < n; col++) {
+		Eigen::Index pivot = col;
+		while(pivot < n && carl::isZero(m(pivot, col - 1))) pivot++;
+		if(pivot == n) continue;
+		if(pivot != col) {
+			for(Eigen::Index j = 0; j < n; j++) std::swap(m(pivot, j), m(col, j));
+			for(Eigen::Index j = 0; j < n; j++) std::swap(m(j, pivot), m(j, col));
+		}
+		for(Eigen::Index i = col + 1; i < n; i++) {
+			if(carl::isZero(m(i, col - 1))) continue;
+			Coeff u = m(i, col - 1) / m(col, col - 1);
+			for(Eigen::Index j = 0; j < n; j++) m(i, j) -= u * m(col, j);
+			for(Eigen::Index j = 0; j < n; j++) m(j, col) += u * m(j, i);
+		}
+	}
+	
+	// p[k] is the characteristic polynomial of the leading k x k submatrix
+	std::vector<std::vector<Coeff>> p(std::size_t(n) + 1);
+	p[0] = {Coeff(1)};
+	for(Eigen::Index k = 1; k <= n; k++) {
+		std::vector<Coeff>& cur = p[std::size_t(k)];
+		const std::vector<Coeff>& prev = p[std::size_t(k - 1)];
+		// (X - m(k-1,k-1)) * p[k-1]
+		cur.assign(std::size_t(k) + 1, Coeff(0));
+		for(std::size_t e = 0; e < prev.size(); e++) {
+			cur[e + 1] += prev[e];
+			cur[e] -= m(k - 1, k - 1) * prev[e];
+		}
+		Coeff t(1);
+		for(Eigen::Index i = 1; i < k; i++) {
+			t *= m(k - i, k - i - 1);
+			if(carl::isZero(t)) break;
+			Coeff factor = m(k - i - 1, k - 1) * t;
+			const std::vector<Coeff>& lower = p[std::size_t(k - i - 1)];
+			for(std::size_t e = 0; e < lower.size(); e++) {
+				cur[e] -= factor * lower[e];
+			}
+		}
+	}
+	CARL_LOG_INFO("carl.thom.tarski", "done computing the char pol ... ");
+	return p.back();
+}
+
 } // namespace carl
@@ -31,14 +31,14 @@ private:
 public:
         GroebnerBase() : mBase() {}
         
+        // the basis is computed modulo several primes to avoid the coefficient growth over the rationals
         template<typename InputIt>
         GroebnerBase(InputIt first, InputIt last) {
-                GBProcedure<Polynomial, Buchberger, StdAdding> gbobject;
+                ModularGroebner<Polynomial> gbobject;
                 while(first != last) {
                         gbobject.addPolynomial(*first);
                         first++;
                 }
-                gbobject.reduceInput();
                 gbobject.calculate();
                 mBase = std::make_shared<Ideal<Polynomial>>(gbobject.getIdeal());
         }
@@ -62,6 +62,8 @@ public:
 	struct TableContent {
 		BaseRepresentation<Number> br;
 		IndexPairs pairs;
+		// the trace of the multiplication by the monomial
+		Number trace;
 	};
 private:
 
@@ -74,13 +76,17 @@ private:
 	// the groebner base object is used to compute reductions
 	GroebnerBase<Number> mGb;
 	
+	// the traces of the multiplications by the elements of the base
+	std::vector<Number> mBaseTraces;
+	
 public:
 	
-	MultiplicationTable() : mTable(), mBase(), mGb() {}
+	MultiplicationTable() : mTable(), mBase(), mGb(), mBaseTraces() {}
 	
 	explicit MultiplicationTable(const GroebnerBase<Number>& gb) : mGb(gb){
 		CARL_LOG_ASSERT("carl.thom.tarski.table", gb.hasFiniteMon(), "tried to set up a multiplication table on infinite basis");
 		init(gb);
+		initTraces();
 		CARL_LOG_TRACE("carl.thom.tarski.table", "done setting up multiplication table:\n" << *this);
 	}
 	
@@ -134,14 +140,13 @@ public:
 	}
 	
 	
+	/*
+	 * the trace is linear, hence it is computed from the traces of the base elements
+	 */
 	Number trace(const BaseRepresentation<Number>& f) const {
 		Number res(0);
 		for(const auto& index_coeff : f) {
-			for(uint i = 0; i < mBase.size(); i++) {
-				Monomial prod = mBase[index_coeff.first] * mBase[i];
-				BaseRepresentation<Number> prod_br = this->getEntry(prod).br;
-				res += index_coeff.second * prod_br.get(i);
-			}		   
+			res += index_coeff.second * mBaseTraces[index_coeff.first];
 		}
 		return res;
 	}
@@ -151,6 +156,19 @@ public:
 	
 private:
 	
+	// computes the traces of the base elements and of all monomials in the table
+	void initTraces() {
+		mBaseTraces.assign(mBase.size(), Number(0));
+		for(uint k = 0; k < mBase.size(); k++) {
+			for(uint i = 0; i < mBase.size(); i++) {
+				mBaseTraces[k] += this->getEntry(mBase[k] * mBase[i]).br.get(i);
+			}
+		}
+		for(auto& entry : mTable) {
+			entry.second.trace = this->trace(entry.second.br);
+		}
+	}
+	
 	// returns a list of all pairs of indicdes (i,j) such that base_i * base_j == c
 	IndexPairs indexPairs(const Monomial& c) const {
 		IndexPairs res;
@@ -186,7 +204,7 @@ private:
 		for(uint i = 0; i < Mon.size(); i++) {
 			BaseRepresentation<Number> baseRepr;
 			baseRepr[i] = Number(1); 
-			mTable[Mon[i]] = {baseRepr, indexPairs(Mon[i])};
+			mTable[Mon[i]] = {baseRepr, indexPairs(Mon[i]), Number(0)};
 		}
 		
 		// ---- step 1 ----
@@ -211,7 +229,7 @@ private:
 				if(!baseRepr.isZero()) {
 					pairs = indexPairs(m);
 				}
-				mTable[m] = {baseRepr, pairs};
+				mTable[m] = {baseRepr, pairs, Number(0)};
 				//CARL_LOG_TRACE("carl.thom.tarski", "mTable = " << mTable);			     
 			}
 			else {
@@ -254,7 +272,7 @@ private:
 				if(!baseRepr.isZero()) {
 					pairs = indexPairs(m);
 				}
-				mTable[m] = {baseRepr, pairs};
+				mTable[m] = {baseRepr, pairs, Number(0)};
 			}
 		}
 		
@@ -287,7 +305,7 @@ private:
 				if(!baseRepr.isZero()) {
 					pairs = indexPairs(m);
 				}
-				mTable[m] = {baseRepr, pairs};
+				mTable[m] = {baseRepr, pairs, Number(0)};
 			}
 		}
 	}
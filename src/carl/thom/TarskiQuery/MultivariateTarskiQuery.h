@@ -8,53 +8,69 @@
 #pragma once
 
 #include "../../core/Sign.h"
+#include "../../util/ThreadPool.h"
 #include "CharPol.h"
 #include "MultiplicationTable.h"
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 namespace carl {
         
         
+/*
+ * Computes the Hermite matrix of Q, i.e. the matrix of the quadratic form (a, b) -> Tr(Q*a*b) with respect to the base of the quotient ring.
+ * 
+ * Instead of multiplying Q with every product of base elements, Tr(Q*b_k) is computed once for every base element b_k
+ * from the traces stored in the table, which only needs the entries for b_l * b_k of the monomials b_l of Q.
+ * As Tr(Q*m) = sum_k NF(m)_k * Tr(Q*b_k), every entry of the matrix is then a sparse dot product with the normal form of b_i * b_j.
+ * Both loops run on the shared thread pool.
+ */
 template<typename Number>
-int multivariateTarskiQuery(const MultivariatePolynomial<Number>& Q, const MultiplicationTable<Number>& table) {
-        CARL_LOG_FUNC("carl.thom.tarski", "Q = " << Q);
+CoeffMatrix<Number> hermiteMatrix(const MultivariatePolynomial<Number>& Q, const MultiplicationTable<Number>& table) {
+        using Table = MultiplicationTable<Number>;
         BaseRepresentation<Number> q = table.reduce(Q);
-        std::vector<typename MultiplicationTable<Number>::Monomial> base = table.getBase();
-        // compute the traces...
-        CoeffMatrix<Number> m(base.size(), base.size());
-        CARL_LOG_INFO("carl.thom.tarski", "base size is " << base.size());
-        CARL_LOG_INFO("carl.thom.tarski", "setting up the matrix now ...");
-        for(const auto& entry : table) {
-                BaseRepresentation<Number> Qc = table.multiply(q, entry.second.br);
-                Number t = table.trace(Qc);
-                for (const auto& pair : entry.second.pairs) {
-                        m(long(pair.first), long(pair.second)) = t;
-                }
-        }
+        const std::vector<typename Table::Monomial>& base = table.getBase();
         
-        /*
-        for(uint i = 0; i < base.size(); i++) {
-                for(uint j = i; j < base.size(); j++) {    
-                        BaseRepresentation<Number> prod = table.getEntry(base[i] * base[j]).br;
-                        BaseRepresentation<Number> Qc = table.multiply(q, prod);
-                        //BaseRepresentation<Number> Qc = table.reduce(base[i] * base[j] * Q);
-                        Number t = table.trace(Qc);
-                        m(i, j) = t;
-                        m(j, i) = t;
+        ThreadPool& pool = ThreadPool::shared();
+        // traces of Q*b_k
+        std::vector<Number> qTraces(base.size(), Number(0));
+        pool.parallelFor(base.size(), [&](std::size_t k){
+                for(const auto& index_coeff : q) {
+                        qTraces[k] += index_coeff.second * table.getEntry(base[index_coeff.first] * base[k]).trace;
                 }
+        });
+        
+        std::vector<const typename Table::TableContent*> entries;
+        entries.reserve(std::size_t(std::distance(table.begin(), table.end())));
+        for(const auto& entry : table) {
+                if(!entry.second.pairs.empty()) entries.push_back(&entry.second);
         }
-        */
-        /*
-        for(uint i = 0; i < base.size(); i++) {
-                for(uint j = i; j < base.size(); j++) {
-                        std::cout << m(i, j) << "\t\t";
+        CoeffMatrix<Number> m = CoeffMatrix<Number>::Zero(long(base.size()), long(base.size()));
+        // the entries have disjoint index pairs, hence they can be processed independently
+        pool.parallelFor(entries.size(), [&](std::size_t e){
+                Number t(0);
+                for(const auto& index_coeff : entries[e]->br) {
+                        t += index_coeff.second * qTraces[index_coeff.first];
                 }
-                std::cout << std::endl;
-        }
-        std::cout << std::endl;
-        */
+                for(const auto& pair : entries[e]->pairs) {
+                        m(long(pair.first), long(pair.second)) = t;
+                }
+        });
+        return m;
+}
         
+template<typename Number>
+int multivariateTarskiQuery(const MultivariatePolynomial<Number>& Q, const MultiplicationTable<Number>& table) {
+        CARL_LOG_FUNC("carl.thom.tarski", "Q = " << Q);
+        CARL_LOG_INFO("carl.thom.tarski", "base size is " << table.getBase().size());
+        CARL_LOG_INFO("carl.thom.tarski", "setting up the matrix now ...");
+        CoeffMatrix<Number> m = hermiteMatrix(Q, table);
         CARL_LOG_INFO("carl.thom.tarski", "... done setting up matrix.");
-        std::vector<Number> cp = charPol(m);
+        
+        // the number of positive minus the number of negative eigenvalues of the symmetric matrix m
+        std::vector<Number> cp = charPolHessenberg(m);
         CARL_LOG_TRACE("carl.thom.tarski", "char pol: " << cp);
         int v1 = int(signVariations(cp.begin(), cp.end(), sgn<Number>));
         for(uint i = 1; i < cp.size(); i += 2) {
@@ -7,7 +7,19 @@
 
 #pragma once
 
+#include "../../config.h"
+#include "../../util/LRUCache.h"
+#include "../../util/Singleton.h"
+#include "../../util/hash.h"
+
+#include <algorithm>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <vector>
+#ifdef THREAD_SAFE
+#include <mutex>
+#endif
 
 #include "MultiplicationTable.h"
 #include "MultivariateTarskiQuery.h"
@@ -15,18 +27,14 @@
 
 
 namespace carl {
-        
+
 /*
- * The Tarski query manager is a class designed to manage the computation of Tarski queries.
- * 
- */ 
+ * The data a Tarski query manager needs for a fixed zero set, i.e. the polynomials defining the zero set
+ * (or the multiplication table of the quotient ring) and the results of all queries computed so far.
+ * It only depends on the zero set and is shared by all managers on the same zero set, see TarskiQueryCache.
+ */
 template<typename Number>
-class TarskiQueryManager {
-
-public:
-        using QueryResultType = int;
-        
-private:
+struct TarskiQueryZeroSet {
         using Polynomial = MultivariatePolynomial<Number>;
         
         // for the univariate case
@@ -37,21 +45,22 @@ private:
         MultiplicationTable<Number> mTab;
         bool mTrivialGb;
         
-        mutable std::map<Polynomial, QueryResultType> mCache;
+        // query results for normalized polynomials
+        std::map<Polynomial, int> mQueries;
+#ifdef THREAD_SAFE
+        std::mutex mMutex;
+#endif
         
-public:
-        TarskiQueryManager() : mZ(Variable::NO_VARIABLE), mDer(Variable::NO_VARIABLE), mTab(), mTrivialGb(false), mCache() {}
+        TarskiQueryZeroSet() : mZ(Variable::NO_VARIABLE), mDer(Variable::NO_VARIABLE), mTab(), mTrivialGb(false), mQueries() {}
         
         template<typename InputIt>
-        TarskiQueryManager(InputIt first, InputIt last) : TarskiQueryManager() {
-                CARL_LOG_TRACE("carl.thom.tarski.manager", "setting up a taq manager on " << std::vector<Polynomial>(first, last));
+        TarskiQueryZeroSet(InputIt first, InputIt last) : TarskiQueryZeroSet() {
                 // univariate manager
                 if(std::distance(first, last) == 1 && first->isUnivariate()) {
                         CARL_LOG_TRACE("carl.thom.tarski.manager", "as a UNIVARIATE manager");
                         mZ = first->toUnivariatePolynomial();
                         CARL_LOG_ASSERT("carl.thom.tarski.manager", !mZ.isZero(), "");
                         mDer = mZ.derivative();
-                        CARL_LOG_ASSERT("carl.thom.tarski.manager", this->isUnivariateManager(), "");
                 }
                 // multivariate manager
                 else {
@@ -68,10 +77,96 @@ public:
                                 }
                                 mTab = MultiplicationTable<Number>(gb);
                         }
-                        CARL_LOG_ASSERT("carl.thom.tarski.manager", !this->isUnivariateManager(), "");
                 }
         }
         
+        bool isUnivariate() const {
+                return !mZ.isZero();
+        }
+};
+
+/*
+ * Stores the zero set data of Tarski query managers, such that the Groebner base, the multiplication table
+ * and the query results for a system of polynomials are computed only once, no matter how many managers are set up on it.
+ * During the lifting phase of a CAD, the same systems occur for every comparison and evaluation of Thom encodings
+ * over the same sample point.
+ * The number of systems is bounded, the least recently used system is evicted first; managers that are still in use keep their data.
+ */
+template<typename Number>
+class TarskiQueryCache : public Singleton<TarskiQueryCache<Number>> {
+        friend Singleton<TarskiQueryCache<Number>>;
+        using Polynomial = MultivariatePolynomial<Number>;
+        
+        struct ZeroSetHash {
+                std::size_t operator()(const std::vector<Polynomial>& polys) const {
+                        std::size_t seed = 0;
+                        for(const auto& p : polys) hash_add(seed, p);
+                        return seed;
+                }
+        };
+        
+        LRUCache<std::vector<Polynomial>, std::shared_ptr<TarskiQueryZeroSet<Number>>, ZeroSetHash> mZeroSets;
+        
+        TarskiQueryCache() : mZeroSets(1000) {}
+public:
+        /*
+         * Returns the data for the zero set of the given polynomials, sets it up if it is not cached yet.
+         */
+        template<typename InputIt>
+        std::shared_ptr<TarskiQueryZeroSet<Number>> get(InputIt first, InputIt last) {
+                std::vector<Polynomial> key(first, last);
+                std::sort(key.begin(), key.end());
+                // the order of the polynomials matters for the groebner base computation, hence the input order is used
+                return mZeroSets.get(key, [first, last](){ return std::make_shared<TarskiQueryZeroSet<Number>>(first, last); });
+        }
+        
+        void setCapacity(std::size_t capacity) {
+                mZeroSets.setCapacity(capacity);
+        }
+        
+        void clear() {
+                mZeroSets.clear();
+        }
+        
+        std::size_t size() const {
+                return mZeroSets.size();
+        }
+        
+        std::size_t hits() const {
+                return mZeroSets.hits();
+        }
+        
+        std::size_t misses() const {
+                return mZeroSets.misses();
+        }
+};
+        
+/*
+ * The Tarski query manager is a class designed to manage the computation of Tarski queries.
+ * Managers on the same zero set share their data and query results, see TarskiQueryCache.
+ */ 
+template<typename Number>
+class TarskiQueryManager {
+
+public:
+        using QueryResultType = int;
+        
+private:
+        using Polynomial = MultivariatePolynomial<Number>;
+        
+        std::shared_ptr<TarskiQueryZeroSet<Number>> mData;
+        
+public:
+        TarskiQueryManager() : mData(std::make_shared<TarskiQueryZeroSet<Number>>()) {}
+        
+        template<typename InputIt>
+        TarskiQueryManager(InputIt first, InputIt last) :
+                mData(TarskiQueryCache<Number>::getInstance().get(first, last))
+        {
+                CARL_LOG_TRACE("carl.thom.tarski.manager", "setting up a taq manager on " << std::vector<Polynomial>(first, last));
+                CARL_LOG_ASSERT("carl.thom.tarski.manager", this->isUnivariateManager() == (std::distance(first, last) == 1 && first->isUnivariate()), "");
+        }
+        
         QueryResultType operator()(const Polynomial& p) const {
                 CARL_LOG_TRACE("carl.thom.tarski.manager", "computing taq on " << p << " ... ");
                 if(p.isZero()) return 0;
@@ -87,19 +182,19 @@ public:
                 if(this->isUnivariateManager()) {
                         CARL_LOG_ASSERT("carl.thom.tarski.manager", p.isUnivariate(), "");
                         UnivariatePolynomial<Number> pUniv(Variable::NO_VARIABLE);
-                        if(p.isConstant()) pUniv = UnivariatePolynomial<Number>(mZ.mainVar(), p.lcoeff());
+                        if(p.isConstant()) pUniv = UnivariatePolynomial<Number>(mData->mZ.mainVar(), p.lcoeff());
                         else pUniv = p.toUnivariatePolynomial();
-                        CARL_LOG_ASSERT("carl.thom.tarski.manager", pUniv.mainVar() == mZ.mainVar(),
-                                "cannot compute tarski query of " << p << " on " << mZ);
-                        res = univariateTarskiQuery(pUniv, mZ, mDer);
+                        CARL_LOG_ASSERT("carl.thom.tarski.manager", pUniv.mainVar() == mData->mZ.mainVar(),
+                                "cannot compute tarski query of " << p << " on " << mData->mZ);
+                        res = univariateTarskiQuery(pUniv, mData->mZ, mData->mDer);
                 }
                 
                 // multivariate manager
                 else {
-                        if(mTrivialGb) res = 0;
+                        if(mData->mTrivialGb) res = 0;
                         else {
                         // todo: check if variables in p are also in the polynomials defining the zero set
-                                res = multivariateTarskiQuery(p, mTab);
+                                res = multivariateTarskiQuery(p, mData->mTab);
                         }
                 }
                 cache(p, res);
@@ -117,25 +212,33 @@ public:
                         return a * b;
                 }
                 else {
-                        return mTab.baseReprToPolynomial(mTab.reduce(a * b));
+                        return mData->mTab.baseReprToPolynomial(mData->mTab.reduce(a * b));
                 }
                 
         }
         
-
+        /*
+         * returns the number of query results computed on the zero set so far
+         */
+        std::size_t cachedQueries() const {
+                return mData->mQueries.size();
+        }
         
 private:
         
         bool isUnivariateManager() const {
-                return !mZ.isZero();
+                return mData->isUnivariate();
         }
         
         /*
          * looks for the normalization of p in the cache
          */
         bool getCached(const Polynomial& p, QueryResultType& res) const {
-                auto it = mCache.find(p.normalize());
-                if(it != mCache.end()) {
+#ifdef THREAD_SAFE
+                std::lock_guard<std::mutex> lock(mData->mMutex);
+#endif
+                auto it = mData->mQueries.find(p.normalize());
+                if(it != mData->mQueries.end()) {
 						res = int(sgn(p.lcoeff())) * (it->second);
                         return true;
                 }
@@ -146,7 +249,10 @@ private:
          * writes normalized p with correspoding result in cache
          */
         void cache(const Polynomial& p, const QueryResultType res) const {
-                mCache.insert(std::make_pair(p.normalize(), int(sgn(p.lcoeff())) * res));
+#ifdef THREAD_SAFE
+                std::lock_guard<std::mutex> lock(mData->mMutex);
+#endif
+                mData->mQueries.insert(std::make_pair(p.normalize(), int(sgn(p.lcoeff())) * res));
         }
         
 }; // class TarskiQueryManager
@@ -0,0 +1,530 @@
+/**
+ * @file ConcurrentPointerSet.h
+ *
+ * A hash set of pointers that supports lookups without locking.
+ */
+
+#pragma once
+
+#include "../config.h"
+#include "Common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace carl {
+
+namespace detail {
+
+/**
+ * Tracks the threads that currently read from some ConcurrentPointerSet using epochs.
+ *
+ * Every thread owns a record that holds the epoch in which it entered its outermost read section, or zero if it does not read.
+ * The records are aligned to cache lines and only written by their owner, hence entering and leaving a read section does not contend with other threads.
+ * Retired objects are tagged with the current epoch and can be disposed once every running reader has entered in a later epoch.
+ *
+ * There is a single instance for all sets, a read section on one set thereby only delays the disposal in other sets.
+ * Records of exited threads are reused by new threads, they are never freed.
+ */
+class ReaderEpochs
+{
+private:
+	struct alignas(64) Record {
+		/// Epoch of the running read section or zero.
+		std::atomic<std::size_t> mEpoch;
+		/// Whether some thread owns this record.
+		std::atomic<bool> mInUse;
+		/// Nesting depth of the read sections, only accessed by the owner.
+		std::size_t mDepth = 0;
+		Record* mNext = nullptr;
+		Record(): mEpoch(0), mInUse(true) {}
+	};
+	/// Gives the record back when its thread exits.
+	struct Owner {
+		Record* mRecord = nullptr;
+		~Owner() {
+			if (mRecord == nullptr) return;
+			mRecord->mEpoch.store(0, std::memory_order_release);
+			mRecord->mInUse.store(false, std::memory_order_release);
+		}
+	};
+	std::atomic<Record*> mRecords;
+	std::atomic<std::size_t> mEpoch;
+
+	ReaderEpochs(): mRecords(nullptr), mEpoch(1) {}
+
+	Record* acquireRecord() {
+		for (Record* r = mRecords.load(std::memory_order_acquire); r != nullptr; r = r->mNext) {
+			bool inUse = false;
+			if (!r->mInUse.load(std::memory_order_relaxed) && r->mInUse.compare_exchange_strong(inUse, true)) {
+				return r;
+			}
+		}
+		Record* r = new Record();
+		r->mNext = mRecords.load(std::memory_order_relaxed);
+		while (!mRecords.compare_exchange_weak(r->mNext, r));
+		return r;
+	}
+	Record& local() {
+		static thread_local Owner owner;
+		if (owner.mRecord == nullptr) owner.mRecord = acquireRecord();
+		return *owner.mRecord;
+	}
+public:
+	/**
+	 * The instance is never destructed, as records may be given back by threads exiting after the static destructors have run.
+	 */
+	static ReaderEpochs& instance() {
+		static ReaderEpochs* epochs = new ReaderEpochs();
+		return *epochs;
+	}
+
+	/**
+	 * Enters a read section of the calling thread. Read sections may be nested.
+	 */
+	void enter() {
+		Record& r = local();
+		if (r.mDepth++ > 0) return;
+		r.mEpoch.store(mEpoch.load(), std::memory_order_relaxed);
+		// Publish the epoch before anything is read, pairs with the fence in oldestReader().
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+	/**
+	 * Leaves a read section of the calling thread.
+	 */
+	void leave() {
+		Record& r = local();
+		assert(r.mDepth > 0);
+		if (--r.mDepth > 0) return;
+		r.mEpoch.store(0, std::memory_order_release);
+	}
+
+	/**
+	 * Must be called after the object has been removed from all places a reader may find it.
+	 * @return The epoch to tag a retired object with.
+	 */
+	std::size_t current() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return mEpoch.load();
+	}
+
+	/**
+	 * Advances the epoch and determines the oldest running read section.
+	 * Objects retired in an epoch before the returned one can not be read anymore.
+	 * @return The smallest epoch of a running read section or the maximum value if there is none.
+	 */
+	std::size_t oldestReader() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::size_t res = std::numeric_limits<std::size_t>::max();
+		for (Record* r = mRecords.load(std::memory_order_acquire); r != nullptr; r = r->mNext) {
+			std::size_t e = r->mEpoch.load(std::memory_order_acquire);
+			if (e != 0 && e < res) res = e;
+		}
+		mEpoch.fetch_add(1);
+		return res;
+	}
+};
+
+}
+
+/**
+ * A set of pointers to objects that are compared by value, similar to FastPointerSet.
+ *
+ * The set is split into shards, each of which is an open addressing hash table with linear probing.
+ * Lookups do not take any lock: they read the current table of the shard and only rely on atomic loads.
+ * Insertions and removals are serialized per shard.
+ * Removed entries are replaced by a tombstone and tables that have been replaced by a larger one are retired.
+ *
+ * As a concurrent lookup may still read an object that has just been removed, the memory of removed objects must not be reused immediately.
+ * Removed objects are therefore handed to retire() and only passed to the disposal function given to collect() once every lookup
+ * that was running when they were retired has finished. This is tracked with the epochs of detail::ReaderEpochs.
+ *
+ * A lookup only returns an object if the given acquire function succeeds on it.
+ * This allows the owner to atomically take a reference and to reject objects that are about to be removed.
+ */
+template<typename T, typename Hash = pointerHash<T>, typename Equal = pointerEqual<T>, std::size_t Shards = 64>
+class ConcurrentPointerSet
+{
+	static_assert((Shards & (Shards - 1)) == 0, "The number of shards must be a power of two.");
+private:
+	struct Table {
+		std::size_t mMask;
+		std::unique_ptr<std::atomic<const T*>[]> mSlots;
+		explicit Table(std::size_t capacity): mMask(capacity - 1), mSlots(new std::atomic<const T*>[capacity]) {
+			for (std::size_t i = 0; i < capacity; ++i) {
+				mSlots[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+		std::size_t capacity() const {
+			return mMask + 1;
+		}
+	};
+	struct Shard {
+		std::atomic<Table*> mTable;
+		std::size_t mSize = 0;
+		std::size_t mTombstones = 0;
+#ifdef THREAD_SAFE
+		mutable std::mutex mMutex;
+#endif
+		Shard(): mTable(nullptr) {}
+	};
+	Shard mShards[Shards];
+	std::atomic<std::size_t> mSize;
+	/// Retired objects and tables together with the epoch they have been retired in.
+	std::vector<std::pair<const T*, std::size_t>> mRetired;
+	std::vector<std::pair<Table*, std::size_t>> mRetiredTables;
+#ifdef THREAD_SAFE
+	mutable std::mutex mRetiredMutex;
+	#define CONCURRENT_POINTER_SET_LOCK_GUARD(m) std::lock_guard<std::mutex> lock(m);
+#else
+	#define CONCURRENT_POINTER_SET_LOCK_GUARD(m)
+#endif
+
+	static const T* tombstone() {
+		static typename std::aligned_storage<sizeof(T), alignof(T)>::type marker;
+		return reinterpret_cast<const T*>(&marker);
+	}
+
+	/// Scrambles the hash value, as the hash values of many types are not well distributed in the lower bits.
+	static std::size_t mix(std::size_t h) {
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ULL;
+		h ^= h >> 33;
+		return h;
+	}
+
+	static std::size_t initialCapacity(std::size_t expected) {
+		std::size_t res = 16;
+		while (res * 3 < expected * 4) res *= 2;
+		return res;
+	}
+
+	/// Finds the slot that holds an object equal to key or the first empty slot. Must be called with the shard locked.
+	template<typename Acquire>
+	const T* findLocked(const Table* table, std::size_t h, const T* key, Acquire&& acquire, std::size_t& freeSlot) const {
+		freeSlot = table->capacity();
+		for (std::size_t i = h & table->mMask;; i = (i + 1) & table->mMask) {
+			const T* cur = table->mSlots[i].load(std::memory_order_relaxed);
+			if (cur == nullptr) {
+				if (freeSlot == table->capacity()) freeSlot = i;
+				return nullptr;
+			}
+			if (cur == tombstone()) {
+				if (freeSlot == table->capacity()) freeSlot = i;
+			} else if (Equal()(cur, key) && acquire(cur)) {
+				return cur;
+			}
+		}
+	}
+
+	/// Moves all entries to a new table with enough space. Must be called with the shard locked.
+	void grow(Shard& shard) {
+		Table* old = shard.mTable.load(std::memory_order_relaxed);
+		Table* table = new Table(initialCapacity(2 * (shard.mSize + 1)));
+		for (std::size_t i = 0; i < old->capacity(); ++i) {
+			const T* cur = old->mSlots[i].load(std::memory_order_relaxed);
+			if (cur == nullptr || cur == tombstone()) continue;
+			std::size_t j = mix(Hash()(cur)) / Shards;
+			for (j &= table->mMask; table->mSlots[j].load(std::memory_order_relaxed) != nullptr; j = (j + 1) & table->mMask);
+			table->mSlots[j].store(cur, std::memory_order_relaxed);
+		}
+		shard.mTombstones = 0;
+		shard.mTable.store(table, std::memory_order_release);
+		std::size_t epoch = detail::ReaderEpochs::instance().current();
+		CONCURRENT_POINTER_SET_LOCK_GUARD(mRetiredMutex)
+		mRetiredTables.emplace_back(old, epoch);
+	}
+
+	/// Moves the entries that have been retired before the given epoch from retired to the result.
+	template<typename E>
+	static std::vector<E> takeRetiredBefore(std::vector<std::pair<E, std::size_t>>& retired, std::size_t epoch) {
+		std::vector<E> res;
+		auto it = std::partition(retired.begin(), retired.end(), [epoch](const std::pair<E, std::size_t>& r){ return r.second >= epoch; });
+		for (auto i = it; i != retired.end(); ++i) res.push_back(i->first);
+		retired.erase(it, retired.end());
+		return res;
+	}
+
+public:
+	/**
+	 * Prevents the disposal of objects retired while it exists, just like a running lookup.
+	 * This allows to safely access an object that may be removed and retired concurrently.
+	 */
+	class Pin {
+	public:
+		explicit Pin(const ConcurrentPointerSet&) {
+			detail::ReaderEpochs::instance().enter();
+		}
+		Pin(const Pin&) = delete;
+		Pin& operator=(const Pin&) = delete;
+		~Pin() {
+			detail::ReaderEpochs::instance().leave();
+		}
+	};
+
+	/**
+	 * Iterates over the objects of the set without locking.
+	 * The iteration is weakly consistent: objects that are inserted or removed concurrently may or may not be visited.
+	 * An iterator obtained from begin() holds a pin, hence the visited objects are not disposed while it exists.
+	 * As the pin belongs to the calling thread, an iterator must not be passed to another thread.
+	 */
+	class const_iterator {
+		friend ConcurrentPointerSet;
+	private:
+		const ConcurrentPointerSet* mSet = nullptr;
+		std::shared_ptr<Pin> mPin;
+		std::size_t mShard = Shards;
+		const Table* mTable = nullptr;
+		std::size_t mSlot = 0;
+		const T* mCurrent = nullptr;
+
+		/// Moves to the next object, starting at the current slot.
+		void settle() {
+			while (mShard < Shards) {
+				if (mTable == nullptr) {
+					mTable = mSet->mShards[mShard].mTable.load(std::memory_order_acquire);
+					mSlot = 0;
+				}
+				for (; mSlot < mTable->capacity(); ++mSlot) {
+					mCurrent = mTable->mSlots[mSlot].load(std::memory_order_acquire);
+					if (mCurrent != nullptr && mCurrent != tombstone()) return;
+				}
+				++mShard;
+				mTable = nullptr;
+			}
+			mSlot = 0;
+			mCurrent = nullptr;
+			mPin.reset();
+		}
+		explicit const_iterator(const ConcurrentPointerSet* set): mSet(set), mPin(std::make_shared<Pin>(*set)), mShard(0) {
+			settle();
+		}
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef const T* value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const T* const* pointer;
+		typedef const T* const& reference;
+
+		const_iterator() = default;
+		reference operator*() const {
+			return mCurrent;
+		}
+		pointer operator->() const {
+			return &mCurrent;
+		}
+		const_iterator& operator++() {
+			++mSlot;
+			settle();
+			return *this;
+		}
+		const_iterator operator++(int) {
+			const_iterator res = *this;
+			++(*this);
+			return res;
+		}
+		bool operator==(const const_iterator& it) const {
+			return mShard == it.mShard && mSlot == it.mSlot;
+		}
+		bool operator!=(const const_iterator& it) const {
+			return !(*this == it);
+		}
+	};
+
+	/**
+	 * @param capacity The expected number of objects.
+	 */
+	explicit ConcurrentPointerSet(std::size_t capacity = 0): mSize(0) {
+		for (auto& shard: mShards) {
+			shard.mTable.store(new Table(initialCapacity(capacity / Shards)), std::memory_order_relaxed);
+		}
+	}
+	ConcurrentPointerSet(const ConcurrentPointerSet&) = delete;
+	ConcurrentPointerSet& operator=(const ConcurrentPointerSet&) = delete;
+	~ConcurrentPointerSet() {
+		for (auto& shard: mShards) {
+			delete shard.mTable.load();
+		}
+		for (const auto& t: mRetiredTables) delete t.first;
+	}
+
+	std::size_t size() const {
+		return mSize.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @return The number of retired objects that have not been disposed yet.
+	 */
+	std::size_t retired() const {
+		CONCURRENT_POINTER_SET_LOCK_GUARD(mRetiredMutex)
+		return mRetired.size();
+	}
+
+	const_iterator begin() const {
+		return const_iterator(this);
+	}
+	const_iterator end() const {
+		return const_iterator();
+	}
+
+	/**
+	 * Looks for an object equal to key without taking any lock.
+	 * @param key The object to look for.
+	 * @param acquire Called on an equal object, the object is only returned if this returns true.
+	 * @return The object found or nullptr.
+	 */
+	template<typename Acquire>
+	const T* find(const T* key, Acquire&& acquire) const {
+		std::size_t h = mix(Hash()(key));
+		Pin pin(*this);
+		const Shard& shard = mShards[h & (Shards - 1)];
+		const Table* table = shard.mTable.load(std::memory_order_acquire);
+		h /= Shards;
+		for (std::size_t i = h & table->mMask;; i = (i + 1) & table->mMask) {
+			const T* cur = table->mSlots[i].load(std::memory_order_acquire);
+			if (cur == nullptr) return nullptr;
+			if (cur != tombstone() && Equal()(cur, key) && acquire(cur)) {
+				return cur;
+			}
+		}
+	}
+
+	/**
+	 * Inserts the given object, if no equal object is contained.
+	 * @param key The object to insert.
+	 * @param acquire Called on an equal object, the object is only considered if this returns true.
+	 * @param prepare Called on key before it is published, if it is inserted.
+	 * @return The object found or key and whether key has been inserted.
+	 */
+	template<typename Acquire, typename Prepare>
+	std::pair<const T*, bool> insert(const T* key, Acquire&& acquire, Prepare&& prepare) {
+		std::size_t h = mix(Hash()(key));
+		Shard& shard = mShards[h & (Shards - 1)];
+		h /= Shards;
+		CONCURRENT_POINTER_SET_LOCK_GUARD(shard.mMutex)
+		Table* table = shard.mTable.load(std::memory_order_relaxed);
+		std::size_t slot;
+		const T* found = findLocked(table, h, key, acquire, slot);
+		if (found != nullptr) return std::make_pair(found, false);
+		bool reusesTombstone = table->mSlots[slot].load(std::memory_order_relaxed) == tombstone();
+		if (!reusesTombstone && 4 * (shard.mSize + shard.mTombstones + 1) > 3 * table->capacity()) {
+			grow(shard);
+			table = shard.mTable.load(std::memory_order_relaxed);
+			for (slot = h & table->mMask; table->mSlots[slot].load(std::memory_order_relaxed) != nullptr; slot = (slot + 1) & table->mMask);
+		}
+		prepare(key);
+		if (reusesTombstone) --shard.mTombstones;
+		++shard.mSize;
+		++mSize;
+		table->mSlots[slot].store(key, std::memory_order_release);
+		return std::make_pair(key, true);
+	}
+
+	/**
+	 * Removes the given object, if the given function agrees.
+	 * The object must be handed to retire() afterwards, if it shall be disposed.
+	 * @param object The object to remove, must be contained in the set.
+	 * @param kill Called with the shard locked, the object is only removed if this returns true.
+	 * @return true, if the object has been removed.
+	 */
+	template<typename Kill>
+	bool erase(const T* object, Kill&& kill) {
+		std::size_t h = mix(Hash()(object));
+		Shard& shard = mShards[h & (Shards - 1)];
+		h /= Shards;
+		CONCURRENT_POINTER_SET_LOCK_GUARD(shard.mMutex)
+		if (!kill(object)) return false;
+		Table* table = shard.mTable.load(std::memory_order_relaxed);
+		for (std::size_t i = h & table->mMask;; i = (i + 1) & table->mMask) {
+			const T* cur = table->mSlots[i].load(std::memory_order_relaxed);
+			assert(cur != nullptr);
+			if (cur == object) {
+				table->mSlots[i].store(tombstone(), std::memory_order_release);
+				break;
+			}
+		}
+		--shard.mSize;
+		++shard.mTombstones;
+		--mSize;
+		return true;
+	}
+
+	/**
+	 * Schedules a removed object for disposal.
+	 */
+	void retire(const T* object) {
+		std::size_t epoch = detail::ReaderEpochs::instance().current();
+		CONCURRENT_POINTER_SET_LOCK_GUARD(mRetiredMutex)
+		mRetired.emplace_back(object, epoch);
+	}
+
+	/**
+	 * Disposes all retired objects and tables that no running lookup or existing pin may access anymore.
+	 * Disposing an object may remove and retire further objects, these are disposed as well if possible.
+	 * Nested calls from within dispose return immediately.
+	 * @param dispose Called on every retired object.
+	 */
+	template<typename Dispose>
+	void collect(Dispose&& dispose) {
+		static thread_local bool collecting = false;
+		if (collecting) return;
+		collecting = true;
+		while (true) {
+			std::vector<std::pair<const T*, std::size_t>> retiredObjects;
+			std::vector<std::pair<Table*, std::size_t>> retiredTables;
+			{
+				CONCURRENT_POINTER_SET_LOCK_GUARD(mRetiredMutex)
+				std::swap(retiredObjects, mRetired);
+				std::swap(retiredTables, mRetiredTables);
+			}
+			if (retiredObjects.empty() && retiredTables.empty()) break;
+			// Only entries taken before determining the oldest reader are safe to dispose.
+			std::size_t oldest = detail::ReaderEpochs::instance().oldestReader();
+			std::vector<const T*> objects = takeRetiredBefore(retiredObjects, oldest);
+			std::vector<Table*> tables = takeRetiredBefore(retiredTables, oldest);
+			if (!retiredObjects.empty() || !retiredTables.empty()) {
+				// Some lookup may still read these, try again later.
+				CONCURRENT_POINTER_SET_LOCK_GUARD(mRetiredMutex)
+				mRetired.insert(mRetired.end(), retiredObjects.begin(), retiredObjects.end());
+				mRetiredTables.insert(mRetiredTables.end(), retiredTables.begin(), retiredTables.end());
+			}
+			if (objects.empty() && tables.empty()) break;
+			for (Table* t: tables) delete t;
+			for (const T* o: objects) dispose(o);
+		}
+		collecting = false;
+	}
+
+	/**
+	 * Collects all objects of the set on which acquire succeeds. The shards are locked one after another.
+	 * @param acquire Called on every object with its shard locked.
+	 * @return The acquired objects.
+	 */
+	template<typename Acquire>
+	std::vector<const T*> snapshot(Acquire&& acquire) const {
+		std::vector<const T*> res;
+		res.reserve(size());
+		for (auto& shard: mShards) {
+			CONCURRENT_POINTER_SET_LOCK_GUARD(shard.mMutex)
+			const Table* table = shard.mTable.load(std::memory_order_relaxed);
+			for (std::size_t i = 0; i < table->capacity(); ++i) {
+				const T* cur = table->mSlots[i].load(std::memory_order_relaxed);
+				if (cur != nullptr && cur != tombstone() && acquire(cur)) res.push_back(cur);
+			}
+		}
+		return res;
+	}
+	#undef CONCURRENT_POINTER_SET_LOCK_GUARD
+};
+
+}
@@ -0,0 +1,113 @@
+/**
+ * @file CopyOnWriteVector.h
+ *
+ * A vector whose elements are shared between copies until they are modified.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+namespace carl {
+
+/**
+ * Stores a sequence of elements that are shared with all copies of the vector.
+ *
+ * Copying the vector only copies pointers to the elements.
+ * An element is copied when it is modified while another vector still refers to it, hence a copy only pays for the elements that are modified afterwards.
+ * Read access is only possible via the const methods, all modifications of an element go through modify().
+ * References to an element obtained from a const method refer to the old element once it is copied by modify().
+ * The vector is not thread safe, modify() must not be called concurrently with other accesses to the same element.
+ */
+template<typename T>
+class CopyOnWriteVector
+{
+private:
+	std::vector<std::shared_ptr<T>> mElements;
+
+public:
+	typedef boost::indirect_iterator<typename std::vector<std::shared_ptr<T>>::const_iterator, const T> const_iterator;
+
+	CopyOnWriteVector() = default;
+	/**
+	 * Creates a vector of the given number of copies of value.
+	 */
+	CopyOnWriteVector(std::size_t count, const T& value) {
+		insert(0, count, value);
+	}
+
+	std::size_t size() const {
+		return mElements.size();
+	}
+	bool empty() const {
+		return mElements.empty();
+	}
+
+	const T& operator[](std::size_t i) const {
+		assert(i < mElements.size());
+		return *mElements[i];
+	}
+	const T& front() const {
+		assert(!mElements.empty());
+		return *mElements.front();
+	}
+	const T& back() const {
+		assert(!mElements.empty());
+		return *mElements.back();
+	}
+	const_iterator begin() const {
+		return const_iterator(mElements.begin());
+	}
+	const_iterator end() const {
+		return const_iterator(mElements.end());
+	}
+
+	/**
+	 * Gives write access to the element at position i, copying it first if it is shared with another vector.
+	 * @param i Position.
+	 * @return Element at position i, only referred to by this vector.
+	 */
+	T& modify(std::size_t i) {
+		assert(i < mElements.size());
+		if (mElements[i].use_count() > 1) {
+			mElements[i] = std::make_shared<T>(*mElements[i]);
+		}
+		return *mElements[i];
+	}
+	/**
+	 * @param i Position.
+	 * @param v Other vector.
+	 * @return true if the element at position i is the same object as the element at position i of v.
+	 */
+	bool shares(std::size_t i, const CopyOnWriteVector& v) const {
+		return i < mElements.size() && i < v.mElements.size() && mElements[i] == v.mElements[i];
+	}
+
+	/**
+	 * Inserts count copies of value before position pos, the elements at pos and after are moved to the back without being copied.
+	 */
+	void insert(std::size_t pos, std::size_t count, const T& value) {
+		assert(pos <= mElements.size());
+		std::vector<std::shared_ptr<T>> elements;
+		elements.reserve(count);
+		for (std::size_t i = 0; i < count; i++) {
+			elements.push_back(std::make_shared<T>(value));
+		}
+		mElements.insert(mElements.begin() + long(pos), elements.begin(), elements.end());
+	}
+	template<typename... Args>
+	void emplace_back(Args&&... args) {
+		mElements.push_back(std::make_shared<T>(std::forward<Args>(args)...));
+	}
+	void clear() {
+		mElements.clear();
+	}
+};
+
+}
@@ -1,7 +1,21 @@
 #pragma once
 
+#include "Bitset.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
 namespace carl {
 
+/**
+ * Represents a number of intervals (or other items, identified by their index) and a set of elements of type T, each of which covers some of the intervals.
+ * If the elements cover all intervals, they conflict and a conflicting core is a subset of the elements that still covers all intervals.
+ *
+ * All operations work on whole blocks of the bitsets, hence the cost of an operation is proportional to the number of intervals divided by the block size.
+ */
 template<typename T>
 class Covering {
 	template<typename TT>
@@ -9,6 +23,75 @@ class Covering {
 private:
 	std::map<T, carl::Bitset> mData;
 	carl::Bitset mOkay;
+
+	/**
+	 * Removes all elements from core whose intervals are covered by the other elements of core.
+	 * The elements are checked in reverse order, hence elements added to the core later are kept rather than earlier ones.
+	 */
+	void makeIrredundant(std::vector<std::pair<T, const carl::Bitset*>>& core) const {
+		for (std::size_t i = core.size(); i-- > 0;) {
+			carl::Bitset others;
+			for (std::size_t j = 0; j < core.size(); j++) {
+				if (j != i) others |= *core[j].second;
+			}
+			if (core[i].second->is_subset_of(others)) core.erase(core.begin() + (long)i);
+		}
+	}
+
+	/**
+	 * Branch and bound search for a smaller core: selects the first uncovered interval and tries all elements covering it.
+	 * @param uncovered Intervals not yet covered.
+	 * @param current Elements selected so far.
+	 * @param best Smallest core found so far.
+	 * @param nodes Remaining number of search nodes.
+	 * @return false if the search was aborted as it exceeded the number of nodes.
+	 */
+	bool search(const carl::Bitset& uncovered, std::vector<std::pair<T, const carl::Bitset*>>& current, std::vector<std::pair<T, const carl::Bitset*>>& best, std::size_t& nodes) const {
+		if (uncovered.none()) {
+			best = current;
+			return true;
+		}
+		if (current.size() + 1 >= best.size()) return true;
+		if (nodes == 0) return false;
+		nodes--;
+		std::size_t interval = uncovered.find_first();
+		// elements covering the interval, those covering the most uncovered intervals first
+		std::vector<std::pair<std::size_t, std::pair<T, const carl::Bitset*>>> candidates;
+		for (const auto& d: mData) {
+			if (!d.second.test(interval)) continue;
+			candidates.emplace_back((d.second & uncovered).count(), std::make_pair(d.first, &d.second));
+		}
+		std::stable_sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b){ return a.first > b.first; });
+		for (const auto& c: candidates) {
+			current.push_back(c.second);
+			carl::Bitset rest = uncovered;
+			rest -= *c.second.second;
+			bool completed = search(rest, current, best, nodes);
+			current.pop_back();
+			if (!completed) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Computes a core greedily: repeatedly selects the element that covers the most uncovered intervals, then removes redundant elements.
+	 */
+	std::vector<std::pair<T, const carl::Bitset*>> greedyCore() const {
+		std::vector<std::pair<T, const carl::Bitset*>> res;
+		std::vector<std::pair<T, carl::Bitset>> data(mData.begin(), mData.end());
+		carl::Bitset uncovered = coverable();
+		while (uncovered.any()) {
+			auto maxit = std::max_element(data.begin(), data.end(), [](const auto& a, const auto& b){ return a.second.count() < b.second.count(); });
+			uncovered -= maxit->second;
+			res.emplace_back(maxit->first, &mData.at(maxit->first));
+			data.erase(maxit);
+			for (auto& d: data) {
+				d.second &= uncovered;
+			}
+		}
+		makeIrredundant(res);
+		return res;
+	}
 public:
 	Covering(std::size_t intervals) {
 		mOkay.resize(intervals, true);
@@ -23,22 +106,35 @@ public:
 	std::size_t satisfyingInterval() const {
 		return mOkay.find_first();
 	}
+	/**
+	 * @return The intervals covered by some element.
+	 */
+	carl::Bitset coverable() const {
+		carl::Bitset res;
+		for (const auto& d: mData) res |= d.second;
+		return res;
+	}
+	/**
+	 * Computes a core that covers all coverable intervals and appends it to core.
+	 * The core is computed greedily and is irredundant, i.e. no element can be removed from it.
+	 * @param core Output.
+	 */
 	void buildConflictingCore(std::vector<T>& core) const {
-		std::map<T, carl::Bitset> data = mData;
-		carl::Bitset covered;
-		covered.resize(mOkay.size(), true);
-		while (covered.any()) {
-			auto maxit = data.begin();
-			for (auto it = data.begin(); it != data.end(); it++) {
-				if (maxit->second.count() < it->second.count()) maxit = it;
-			}
-			core.push_back(maxit->first);
-			covered -= maxit->second;
-			data.erase(maxit);
-			for (auto& d: data) {
-				d.second &= covered;
-			}
-		}
+		for (const auto& c: greedyCore()) core.push_back(c.first);
+	}
+	/**
+	 * Computes a core of minimum size that covers all coverable intervals and appends it to core.
+	 * The search starts with the greedy core and is aborted after the given number of search nodes, in which case the smallest core found so far is used.
+	 * @param core Output.
+	 * @param maxNodes Maximum number of search nodes.
+	 * @return true if the core is of minimum size.
+	 */
+	bool buildMinimumConflictingCore(std::vector<T>& core, std::size_t maxNodes = 10000) const {
+		auto best = greedyCore();
+		std::vector<std::pair<T, const carl::Bitset*>> current;
+		bool exact = best.size() <= 1 || search(coverable(), current, best, maxNodes);
+		for (const auto& c: best) core.push_back(c.first);
+		return exact;
 	}
 };
 template<typename TT>
@@ -0,0 +1,130 @@
+/**
+ * @file LRUCache.h
+ *
+ * A bounded cache of computed values that evicts the least recently used entry first.
+ */
+
+#pragma once
+
+#include "../config.h"
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace carl {
+
+/**
+ * Maps keys to values that are expensive to compute, storing at most a given number of entries.
+ *
+ * If the cache is full, the least recently used entry is evicted, such that entries that are used frequently stay in the cache.
+ * A value is computed without holding the lock, such that concurrent lookups of different entries do not wait for each other.
+ * If another thread has stored a value for the same key in the meantime, its value is returned instead, hence all callers share the same value.
+ * Values are returned by copy and are usually shared pointers or small containers.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class LRUCache
+{
+private:
+	typedef std::list<std::pair<Key, Value>> Entries;
+
+	/// Entries, the most recently used one first.
+	Entries mEntries;
+	std::unordered_map<Key, typename Entries::iterator, Hash, Equal> mIndex;
+	std::size_t mCapacity;
+	std::size_t mHits = 0;
+	std::size_t mMisses = 0;
+#ifdef THREAD_SAFE
+	mutable std::mutex mMutex;
+	#define LRU_CACHE_LOCK_GUARD std::lock_guard<std::mutex> lock(mMutex);
+#else
+	#define LRU_CACHE_LOCK_GUARD
+#endif
+
+	void shrink() {
+		while (mEntries.size() > mCapacity) {
+			mIndex.erase(mEntries.back().first);
+			mEntries.pop_back();
+		}
+	}
+
+public:
+	explicit LRUCache(std::size_t capacity): mCapacity(capacity) {}
+	LRUCache(const LRUCache&) = delete;
+	LRUCache& operator=(const LRUCache&) = delete;
+
+	/**
+	 * Returns the value for the given key. If it is not stored yet, it is computed by compute() and stored.
+	 * @param key Key.
+	 * @param compute Function computing the value.
+	 * @return Value for the key.
+	 */
+	template<typename F>
+	Value get(const Key& key, F&& compute) {
+		{
+			LRU_CACHE_LOCK_GUARD
+			auto it = mIndex.find(key);
+			if (it != mIndex.end()) {
+				mHits++;
+				mEntries.splice(mEntries.begin(), mEntries, it->second);
+				return it->second->second;
+			}
+			mMisses++;
+		}
+		Value value = compute();
+		LRU_CACHE_LOCK_GUARD
+		auto it = mIndex.find(key);
+		if (it != mIndex.end()) {
+			mEntries.splice(mEntries.begin(), mEntries, it->second);
+			return it->second->second;
+		}
+		if (mCapacity > 0) {
+			mEntries.emplace_front(key, value);
+			mIndex.emplace(key, mEntries.begin());
+			shrink();
+		}
+		return value;
+	}
+
+	/**
+	 * Sets the maximal number of entries, evicting the least recently used ones if necessary.
+	 * @param capacity Maximal number of entries.
+	 */
+	void setCapacity(std::size_t capacity) {
+		LRU_CACHE_LOCK_GUARD
+		mCapacity = capacity;
+		shrink();
+	}
+	std::size_t capacity() const {
+		return mCapacity;
+	}
+	std::size_t size() const {
+		LRU_CACHE_LOCK_GUARD
+		return mEntries.size();
+	}
+	std::size_t hits() const {
+		LRU_CACHE_LOCK_GUARD
+		return mHits;
+	}
+	std::size_t misses() const {
+		LRU_CACHE_LOCK_GUARD
+		return mMisses;
+	}
+
+	/**
+	 * Removes all entries and resets the statistics.
+	 */
+	void clear() {
+		LRU_CACHE_LOCK_GUARD
+		mIndex.clear();
+		mEntries.clear();
+		mHits = 0;
+		mMisses = 0;
+	}
+	#undef LRU_CACHE_LOCK_GUARD
+};
+
+}
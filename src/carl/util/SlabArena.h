@@ -0,0 +1,300 @@
+/**
+ * @file SlabArena.h
+ *
+ * A slab allocator for objects of a single type whose memory is grouped into generations.
+ */
+
+#pragma once
+
+#include "../config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Allocates objects of type T from slabs holding SlabSize objects each.
+ *
+ * Freed objects are put into a free list of their slab and their memory is reused by later allocations.
+ * Every slab belongs to a generation and an allocation on behalf of some generation only uses slabs of this generation.
+ * Once a generation has been released, its slabs are returned to the system as soon as they do not contain any live objects.
+ * This allows to give back the memory used by some client, e.g. a solver instance, once it has finished.
+ *
+ * Every thread keeps a single spare slot that is used for the next allocation of the same generation without locking.
+ * Objects that are constructed speculatively and thrown away right away, e.g. the candidates for a hash-consing lookup,
+ * can be handed back with discard() and thereby never touch the lock.
+ * The spare slots are registered with their arena: they are given back when their thread exits and when their generation is released.
+ *
+ * Objects that are still alive when the arena is destroyed are not destructed, their memory is freed nevertheless.
+ */
+template<typename T, std::size_t SlabSize = 512>
+class SlabArena
+{
+private:
+	struct Slab;
+	struct Slot {
+		/// The storage of the object, must be the first member.
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type mStorage;
+		/// The slab this slot belongs to.
+		Slab* mSlab;
+		/// The next free slot within the same slab.
+		Slot* mNext;
+	};
+	struct Slab {
+		std::size_t mGeneration;
+		/// Number of allocated slots, including spare slots of some thread.
+		std::size_t mLive = 0;
+		/// Number of slots that have been used at least once.
+		std::size_t mUsed = 0;
+		/// Whether this slab is contained in the list of available slabs of its generation.
+		bool mAvailable = true;
+		Slot* mFreeList = nullptr;
+		Slot mSlots[SlabSize];
+		explicit Slab(std::size_t generation): mGeneration(generation) {}
+		bool full() const {
+			return mFreeList == nullptr && mUsed == SlabSize;
+		}
+	};
+	struct Generation {
+		std::vector<Slab*> mSlabs;
+		/// Slabs that may have free slots.
+		std::vector<Slab*> mAvailable;
+		bool mReleased = false;
+	};
+	/**
+	 * The spare slot of a thread. It is registered with the arena it belongs to, as long as it is attached to one.
+	 * The slot is only taken atomically, as the arena may take it from another thread when its generation is released.
+	 */
+	struct Spare {
+		SlabArena* mArena = nullptr;
+		std::atomic<Slot*> mSlot;
+		Spare(): mSlot(nullptr) {}
+		~Spare() {
+			if (mArena != nullptr) mArena->detach(*this);
+		}
+	};
+	static thread_local Spare tSpare;
+
+	std::unordered_map<std::size_t, Generation> mGenerations;
+	std::size_t mNextGeneration = 1;
+	std::size_t mNrSlabs = 0;
+	/// The spare slots of all threads attached to this arena.
+	std::vector<Spare*> mSpares;
+#ifdef THREAD_SAFE
+	mutable std::mutex mMutex;
+	#define SLAB_ARENA_LOCK_GUARD std::lock_guard<std::mutex> lock(mMutex);
+#else
+	#define SLAB_ARENA_LOCK_GUARD
+#endif
+
+	static Slot* toSlot(const T* object) {
+		return reinterpret_cast<Slot*>(const_cast<T*>(object));
+	}
+
+	Slot* allocateSlot(std::size_t generation) {
+		Spare& spare = tSpare;
+		if (spare.mArena == this && spare.mSlot.load(std::memory_order_relaxed) != nullptr) {
+			Slot* res = spare.mSlot.exchange(nullptr, std::memory_order_acquire);
+			if (res != nullptr) {
+				if (res->mSlab->mGeneration == generation) return res;
+				// The spare slot belongs to another generation, give it back.
+				deallocateSlot(res);
+			}
+		}
+		SLAB_ARENA_LOCK_GUARD
+		Generation& gen = mGenerations[generation];
+		assert(!gen.mReleased);
+		while (!gen.mAvailable.empty() && gen.mAvailable.back()->full()) {
+			gen.mAvailable.back()->mAvailable = false;
+			gen.mAvailable.pop_back();
+		}
+		if (gen.mAvailable.empty()) {
+			gen.mSlabs.push_back(new Slab(generation));
+			gen.mAvailable.push_back(gen.mSlabs.back());
+			++mNrSlabs;
+		}
+		Slab* slab = gen.mAvailable.back();
+		Slot* res;
+		if (slab->mFreeList != nullptr) {
+			res = slab->mFreeList;
+			slab->mFreeList = res->mNext;
+		} else {
+			res = &slab->mSlots[slab->mUsed];
+			res->mSlab = slab;
+			++slab->mUsed;
+		}
+		++slab->mLive;
+		return res;
+	}
+
+	void deallocateSlot(Slot* slot) {
+		SLAB_ARENA_LOCK_GUARD
+		deallocateSlotLocked(slot);
+	}
+
+	/// Frees the given slot, the arena must be locked.
+	void deallocateSlotLocked(Slot* slot) {
+		Slab* slab = slot->mSlab;
+		assert(slab->mLive > 0);
+		--slab->mLive;
+		slot->mNext = slab->mFreeList;
+		slab->mFreeList = slot;
+		auto git = mGenerations.find(slab->mGeneration);
+		assert(git != mGenerations.end());
+		if (git->second.mReleased) {
+			if (slab->mLive == 0) {
+				freeSlab(git->second, slab);
+				if (git->second.mSlabs.empty()) mGenerations.erase(git);
+			}
+		} else if (!slab->mAvailable) {
+			slab->mAvailable = true;
+			git->second.mAvailable.push_back(slab);
+		}
+	}
+
+	void freeSlab(Generation& gen, Slab* slab) {
+		gen.mSlabs.erase(std::find(gen.mSlabs.begin(), gen.mSlabs.end(), slab));
+		delete slab;
+		--mNrSlabs;
+	}
+
+	/// Registers the spare slot of the calling thread with this arena. The spare slot must be empty.
+	void attach(Spare& spare) {
+		if (spare.mArena == this) return;
+		if (spare.mArena != nullptr) spare.mArena->detach(spare);
+		SLAB_ARENA_LOCK_GUARD
+		mSpares.push_back(&spare);
+		spare.mArena = this;
+	}
+
+	/// Gives back the slot of the given spare and unregisters it.
+	void detach(Spare& spare) {
+		SLAB_ARENA_LOCK_GUARD
+		Slot* slot = spare.mSlot.exchange(nullptr, std::memory_order_acquire);
+		if (slot != nullptr) deallocateSlotLocked(slot);
+		mSpares.erase(std::find(mSpares.begin(), mSpares.end(), &spare));
+		spare.mArena = nullptr;
+	}
+
+public:
+	SlabArena() = default;
+	SlabArena(const SlabArena&) = delete;
+	SlabArena& operator=(const SlabArena&) = delete;
+	/**
+	 * The arena must not be used by any other thread anymore.
+	 */
+	~SlabArena() {
+		for (Spare* spare: mSpares) {
+			spare->mSlot.store(nullptr, std::memory_order_relaxed);
+			spare->mArena = nullptr;
+		}
+		for (auto& gen: mGenerations) {
+			for (Slab* slab: gen.second.mSlabs) delete slab;
+		}
+	}
+
+	/**
+	 * Allocates memory for an object in the given generation. The object must be constructed by the caller using placement new.
+	 * @param generation The generation to allocate from.
+	 * @return Memory for an object of type T.
+	 */
+	void* allocate(std::size_t generation) {
+		return &allocateSlot(generation)->mStorage;
+	}
+
+	/**
+	 * Constructs a new object in the given generation.
+	 * @param generation The generation to allocate from.
+	 * @param args The arguments for the constructor of T.
+	 * @return The new object.
+	 */
+	template<typename... Args>
+	T* create(std::size_t generation, Args&&... args) {
+		return new (allocate(generation)) T(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Destructs the given object and frees its memory.
+	 */
+	void destroy(const T* object) {
+		object->~T();
+		deallocateSlot(toSlot(object));
+	}
+
+	/**
+	 * Destructs the given object and keeps its memory as the spare slot of the calling thread, if this thread has none yet.
+	 */
+	void discard(const T* object) {
+		object->~T();
+		Slot* slot = toSlot(object);
+		Spare& spare = tSpare;
+		if (spare.mSlot.load(std::memory_order_relaxed) == nullptr) {
+			attach(spare);
+			Slot* expected = nullptr;
+			if (spare.mSlot.compare_exchange_strong(expected, slot, std::memory_order_release)) return;
+		}
+		deallocateSlot(slot);
+	}
+
+	/**
+	 * @return A generation that has not been used before.
+	 */
+	std::size_t newGeneration() {
+		SLAB_ARENA_LOCK_GUARD
+		std::size_t res = mNextGeneration++;
+		mGenerations[res];
+		return res;
+	}
+
+	/**
+	 * Releases the given generation: no further objects may be allocated from it and its slabs are freed once they are empty.
+	 * The spare slots of all threads that belong to this generation are given back.
+	 * @param generation The generation to release.
+	 */
+	void releaseGeneration(std::size_t generation) {
+		SLAB_ARENA_LOCK_GUARD
+		for (Spare* spare: mSpares) {
+			Slot* slot = spare->mSlot.load(std::memory_order_acquire);
+			if (slot == nullptr || slot->mSlab->mGeneration != generation) continue;
+			// The owner may have taken the slot concurrently.
+			if (spare->mSlot.compare_exchange_strong(slot, nullptr, std::memory_order_acquire)) {
+				deallocateSlotLocked(slot);
+			}
+		}
+		auto git = mGenerations.find(generation);
+		if (git == mGenerations.end()) return;
+		git->second.mReleased = true;
+		git->second.mAvailable.clear();
+		std::vector<Slab*> empty;
+		for (Slab* slab: git->second.mSlabs) {
+			if (slab->mLive == 0) empty.push_back(slab);
+		}
+		for (Slab* slab: empty) {
+			freeSlab(git->second, slab);
+		}
+		if (git->second.mSlabs.empty()) mGenerations.erase(git);
+	}
+
+	/**
+	 * @return The number of slabs currently allocated.
+	 */
+	std::size_t nrSlabs() const {
+		SLAB_ARENA_LOCK_GUARD
+		return mNrSlabs;
+	}
+	#undef SLAB_ARENA_LOCK_GUARD
+};
+
+template<typename T, std::size_t SlabSize>
+thread_local typename SlabArena<T, SlabSize>::Spare SlabArena<T, SlabSize>::tSpare;
+
+}
@@ -0,0 +1,164 @@
+/**
+ * @file ThreadPool.h
+ *
+ * A fixed set of worker threads that execute the iterations of loops.
+ */
+
+#pragma once
+
+#include "../config.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Executes the iterations of a loop on a fixed set of worker threads.
+ *
+ * The workers are started once and wait for the next loop in between, hence a pool can be reused for many small loops.
+ * The iterations are handed out one by one via an atomic counter and the calling thread participates in the loop, such that uneven iterations are balanced automatically.
+ *
+ * Polynomial arithmetic relies on shared pools, for example the MonomialPool, that are only protected if carl is built with THREAD_SAFE.
+ * Otherwise, no workers are started and all loops are executed by the calling thread.
+ *
+ * Only one loop is distributed over the workers at a time.
+ * A loop that is started while another one is running, concurrently or from within an iteration, is executed by its calling thread alone.
+ */
+class ThreadPool
+{
+private:
+#ifdef THREAD_SAFE
+	std::vector<std::thread> mWorkers;
+	std::mutex mMutex;
+	/// Signals a new loop or the shutdown to the workers.
+	std::condition_variable mStart;
+	/// Signals the end of the current loop to the caller.
+	std::condition_variable mDone;
+	/// Body of the current loop.
+	const std::function<void(std::size_t)>* mTask = nullptr;
+	/// Number of iterations of the current loop.
+	std::size_t mSize = 0;
+	/// Next iteration that has not been handed out yet.
+	std::atomic<std::size_t> mNext;
+	/// Number of workers that have not finished the current loop.
+	std::size_t mActive = 0;
+	/// Number of loops started so far.
+	std::size_t mGeneration = 0;
+	bool mStop = false;
+	/// Whether the workers execute a loop.
+	std::atomic<bool> mBusy;
+
+	void run() {
+		for (std::size_t i = mNext++; i < mSize; i = mNext++) {
+			(*mTask)(i);
+		}
+	}
+
+	void work() {
+		std::size_t generation = 0;
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (true) {
+			mStart.wait(lock, [&](){ return mStop || mGeneration != generation; });
+			if (mStop) return;
+			generation = mGeneration;
+			lock.unlock();
+			run();
+			lock.lock();
+			if (--mActive == 0) mDone.notify_all();
+		}
+	}
+#endif
+public:
+	/**
+	 * Starts the workers.
+	 * @param threads Total number of threads executing a loop, including the caller. 0 selects the number of hardware threads.
+	 */
+	explicit ThreadPool(std::size_t threads = 0)
+#ifdef THREAD_SAFE
+		: mNext(0), mBusy(false)
+	{
+		if (threads == 0) threads = std::thread::hardware_concurrency();
+		for (std::size_t i = 1; i < threads; i++) {
+			mWorkers.emplace_back([this](){ work(); });
+		}
+	}
+#else
+	{
+		(void)threads;
+	}
+#endif
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	~ThreadPool() {
+#ifdef THREAD_SAFE
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStop = true;
+		}
+		mStart.notify_all();
+		for (auto& w: mWorkers) w.join();
+#endif
+	}
+
+	/**
+	 * A pool for algorithms that do not manage a pool on their own, using the number of hardware threads.
+	 */
+	static ThreadPool& shared() {
+		static ThreadPool pool;
+		return pool;
+	}
+
+	/**
+	 * @return Number of threads executing a loop, including the caller.
+	 */
+	std::size_t size() const {
+#ifdef THREAD_SAFE
+		return mWorkers.size() + 1;
+#else
+		return 1;
+#endif
+	}
+
+	/**
+	 * Calls f(i) for all i in [0, n) and returns once all calls have finished.
+	 * The order of the calls is unspecified, hence f must only write to data owned by iteration i.
+	 * @param n Number of iterations.
+	 * @param f Loop body.
+	 */
+	template<typename F>
+	void parallelFor(std::size_t n, F&& f) {
+#ifdef THREAD_SAFE
+		if (mWorkers.empty() || n <= 1 || mBusy.exchange(true, std::memory_order_acquire)) {
+			for (std::size_t i = 0; i < n; i++) f(i);
+			return;
+		}
+		std::function<void(std::size_t)> task(std::ref(f));
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mTask = &task;
+			mSize = n;
+			mNext = 0;
+			mActive = mWorkers.size();
+			mGeneration++;
+		}
+		mStart.notify_all();
+		run();
+		std::unique_lock<std::mutex> lock(mMutex);
+		mDone.wait(lock, [&](){ return mActive == 0; });
+		mTask = nullptr;
+		mBusy.store(false, std::memory_order_release);
+#else
+		for (std::size_t i = 0; i < n; i++) f(i);
+#endif
+	}
+};
+
+}
@@ -11,9 +11,13 @@
 #include <limits>
 #include <stack>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "../io/streamingOperators.h"
+#include "CopyOnWriteVector.h"
 
 namespace carl {
 
@@ -21,6 +25,16 @@ namespace carl {
  * This class represents a tree.
  *
  * It tries to stick to the STL style as close as possible.
+ *
+ * The nodes are stored in a vector and refer to each other by their indices.
+ * The values are stored in a separate vector with the same indices, such that walking the tree only touches the small nodes.
+ * The slot of an erased element holds no value and is reused for a new element of the same depth.
+ *
+ * Both vectors consist of chunks of chunkSize elements that are shared between copies of the tree.
+ * Every chunk is reserved for the elements of a single depth, hence the elements of one depth are close to each other in memory.
+ * Children are not stored in contiguous ranges, as new elements may be inserted between existing siblings.
+ * Copying a tree only copies one pointer per chunk, a chunk is copied once it is modified while another tree still refers to it.
+ * Writing to a chunk includes dereferencing a non-const iterator, hence references obtained that way stay valid until the tree is copied again.
  */
 template<typename T>
 class tree {
@@ -35,15 +49,14 @@ public:
 	using value_type = T;
 	struct Node {
 		std::size_t id;
-		mutable T data;
 		std::size_t parent;
 		std::size_t previousSibling = MAXINT;
 		std::size_t nextSibling = MAXINT;
 		std::size_t firstChild = MAXINT;
 		std::size_t lastChild = MAXINT;
 		std::size_t depth = MAXINT;
-		Node(std::size_t _id, const T& _data, std::size_t _parent, std::size_t _depth):
-			id(_id), data(_data), parent(_parent), depth(_depth)
+		Node(std::size_t _id, std::size_t _parent, std::size_t _depth):
+			id(_id), parent(_parent), depth(_depth)
 		{
 		}
 		bool operator==(const Node& n) {
@@ -54,19 +67,70 @@ public:
 			//for (auto& c: children) nodes[c].updateDepth(newDepth + 1);
 		}
 	};
-	friend std::ostream& operator<<(std::ostream& os, const Node& n) {
+	/**
+	 * Prints the indices a node refers to, the value is printed by tree::printNode().
+	 */
+	static std::ostream& printIndices(std::ostream& os, const Node& n) {
 		int id = (int)n.id;
 		int parent = (n.parent == MAXINT ? -1 : (int)n.parent);
 		int firstChild = (n.firstChild == MAXINT ? -1 : (int)n.firstChild);
 		int lastChild = (n.lastChild == MAXINT ? -1 : (int)n.lastChild);
 		int previousSibling = (n.previousSibling == MAXINT ? -1 : (int)n.previousSibling);
 		int nextSibling = (n.nextSibling == MAXINT ? -1 : (int)n.nextSibling);
-		os << "(" << n.data << " @ " << id << ", " << parent << ", " << firstChild << ":" << lastChild << ", " << previousSibling << " <-> " << nextSibling << ")\n";
-
-		return os;
+		return os << id << ", " << parent << ", " << firstChild << ":" << lastChild << ", " << previousSibling << " <-> " << nextSibling;
+	}
+	friend std::ostream& operator<<(std::ostream& os, const Node& n) {
+		os << "(";
+		return printIndices(os, n) << ")\n";
 	}
-	std::vector<Node> nodes;
-	std::size_t emptyNodes = MAXINT;
+	/// Number of elements per shared chunk of nodes and values.
+	static const std::size_t chunkSize = 64;
+	/**
+	 * Vector of elements stored in chunks that are shared with the copies of the tree.
+	 * The non-const methods copy the chunk they access if it is shared.
+	 */
+	template<typename E>
+	class ChunkedVector {
+	private:
+		CopyOnWriteVector<std::vector<E>> mChunks;
+		std::size_t mSize = 0;
+	public:
+		std::size_t size() const {
+			return mSize;
+		}
+		bool empty() const {
+			return mSize == 0;
+		}
+		const E& operator[](std::size_t i) const {
+			assert(i < mSize);
+			return mChunks[i / chunkSize][i % chunkSize];
+		}
+		E& operator[](std::size_t i) {
+			assert(i < mSize);
+			return mChunks.modify(i / chunkSize)[i % chunkSize];
+		}
+		template<typename... Args>
+		void emplace_back(Args&&... args) {
+			if (mSize % chunkSize == 0) {
+				mChunks.emplace_back();
+				mChunks.modify(mChunks.size() - 1).reserve(chunkSize);
+			}
+			mChunks.modify(mChunks.size() - 1).emplace_back(std::forward<Args>(args)...);
+			mSize++;
+		}
+		void push_back(const E& e) {
+			emplace_back(e);
+		}
+		void clear() {
+			mChunks.clear();
+			mSize = 0;
+		}
+	};
+	ChunkedVector<Node> nodes;
+	/// Values of the nodes, by the index of the node. Unused slots hold no value.
+	mutable ChunkedVector<boost::optional<T>> values;
+	/// Unused slots for every depth, linked by their nextSibling.
+	std::vector<std::size_t> emptyNodes;
 protected:
 	/**
 	 * This is the base class for all iterators.
@@ -110,19 +174,21 @@ protected:
 		}
 		T& operator*() {
 			assert(current != MAXINT);
-			return mTree->nodes[current].data;
+			return *mTree->values[current];
 		}
 		const T& operator*() const {
 			assert(current != MAXINT);
-			return mTree->nodes[current].data;
+			const auto& values = mTree->values;
+			return *values[current];
 		}
 		T* operator->() {
 			assert(current != MAXINT);
-			return &(mTree->nodes[current].data);
+			return mTree->values[current].get_ptr();
 		}
 		T const * operator->() const {
 			assert(current != MAXINT);
-			return &(mTree->nodes[current].data);
+			const auto& values = mTree->values;
+			return values[current].get_ptr();
 		}
 
 		template<typename I = Iterator>
@@ -387,25 +453,14 @@ public:
 				while (it.current != MAXINT && it.depth() != _depth) ++it;
 				this->current = it.current;
 			} else {
-				PreorderIterator<reverse> it(this->mTree, this->current);
-				while (it.current != MAXINT && it.depth() != _depth) ++it;
-				this->current = it.current;
+				this->current = this->mTree->nextAtDepth(this->current, _depth, false);
 			}
 		}
 		DepthIterator& next() {
 			if (this->current == MAXINT) {
 				this->current = this->mTree->begin_depth(depth).current;
 			} else if (this->mTree->nodes[this->current].nextSibling == MAXINT) {
-				std::size_t target = this->mTree->nodes[this->current].depth;
-				while (this->mTree->nodes[this->current].nextSibling == MAXINT) {
-					this->current = this->mTree->nodes[this->current].parent;
-					if (this->current == MAXINT) return *this;
-				}
-				PreorderIterator<reverse> it(this->mTree, this->mTree->nodes[this->current].nextSibling);
-				for (; it.current != MAXINT; it++) {
-					if (it.depth() == target) break;
-				}
-				this->current = it.current;
+				this->current = this->mTree->nextAtDepth(this->current, this->mTree->nodes[this->current].depth, true);
 			} else {
 				this->current = this->mTree->nodes[this->current].nextSibling;
 			}
@@ -565,9 +620,22 @@ public:
 	tree& operator=(const tree& t) = default;
 	tree& operator=(tree&& t) noexcept = default;
 
+	/**
+	 * Prints the element with the given index together with the indices of its node.
+	 * @param os Output stream.
+	 * @param id Index of a used element.
+	 * @return os.
+	 */
+	std::ostream& printNode(std::ostream& os, std::size_t id) const {
+		assert(nodes[id].depth != MAXINT);
+		os << "(" << *values[id] << " @ ";
+		return printIndices(os, nodes[id]) << ")\n";
+	}
 	void debug() const {
 		std::cout << "emptyNodes: " << emptyNodes << std::endl;
-		std::cout << this->nodes << std::endl;
+		for (std::size_t id = 0; id < nodes.size(); id++) {
+			if (nodes[id].depth != MAXINT) printNode(std::cout, id);
+		}
 	}
 
 	iterator begin() const {
@@ -739,8 +807,9 @@ public:
 	 * @return Iterator to the root.
 	 */
 	PreorderIterator<> setRoot(const T& data) {
-		if (nodes.empty()) nodes.emplace_back(0, data, MAXINT, 0);
-		else nodes[0].data = data;
+		if (nodes.empty()) {
+			createNode(data, MAXINT, 0);
+		} else values[0] = data;
 		return PreorderIterator<>(this, 0);
 	}
 	/**
@@ -748,7 +817,8 @@ public:
 	 */
 	void clear() {
 		nodes.clear();
-		emptyNodes = MAXINT;
+		values.clear();
+		emptyNodes.clear();
 	}
 	/**
 	 * Add the given data as last child of the root element.
@@ -807,7 +877,10 @@ public:
 	 * @return Iterator to root of inserted subtree.
 	 */
 	PreorderIterator<> append(tree&& tree) {
-		if (nodes.empty()) std::swap(nodes, tree.nodes);
+		if (nodes.empty()) {
+			std::swap(nodes, tree.nodes);
+			std::swap(values, tree.values);
+		}
 		return append(PreorderIterator<>(0), std::move(tree));
 	}
 	/**
@@ -832,7 +905,7 @@ public:
 
 	template<typename Iterator>
 	const Iterator& replace(const Iterator& position, const T& data) {
-		nodes[position.current].data = data;
+		values[position.current] = data;
 		return position;
 	}
 
@@ -875,20 +948,46 @@ public:
 		eraseChildren(position.current);
 	}
 private:
-	std::size_t newNode(const T& data, std::size_t parent, std::size_t depth) {
-		std::size_t newID = 0;
-		if (emptyNodes == MAXINT) {
-			nodes.emplace_back(nodes.size(), data, parent, depth);
-			newID = nodes.size() - 1;
-		} else {
-			newID = emptyNodes;
-			emptyNodes = nodes[emptyNodes].nextSibling;
-			nodes[newID].data = data;
-			nodes[newID].parent = parent;
-			nodes[newID].depth = depth;
+	/**
+	 * Searches the next element of the given depth in pre-order, starting with start itself unless skipStart is set.
+	 * Elements below the given depth are skipped.
+	 */
+	std::size_t nextAtDepth(std::size_t start, std::size_t depth, bool skipStart) const {
+		std::size_t cur = start;
+		while (cur != MAXINT) {
+			if (!skipStart && nodes[cur].depth == depth) return cur;
+			skipStart = false;
+			if (nodes[cur].depth < depth && nodes[cur].firstChild != MAXINT) {
+				cur = nodes[cur].firstChild;
+				continue;
+			}
+			while (cur != MAXINT && nodes[cur].nextSibling == MAXINT) cur = nodes[cur].parent;
+			if (cur != MAXINT) cur = nodes[cur].nextSibling;
 		}
+		return MAXINT;
+	}
+	std::size_t newNode(const T& data, std::size_t parent, std::size_t depth) {
+		if (depth >= emptyNodes.size()) emptyNodes.resize(depth + 1, MAXINT);
+		if (emptyNodes[depth] == MAXINT) newChunk(depth);
+		std::size_t newID = emptyNodes[depth];
+		emptyNodes[depth] = nodes[newID].nextSibling;
+		values[newID] = data;
+		nodes[newID].parent = parent;
+		nodes[newID].depth = depth;
 		return newID;
 	}
+	/**
+	 * Adds a chunk of unused slots for elements of the given depth.
+	 */
+	void newChunk(std::size_t depth) {
+		std::size_t first = nodes.size();
+		for (std::size_t id = first; id < first + chunkSize; id++) {
+			nodes.emplace_back(id, MAXINT, MAXINT);
+			nodes[id].nextSibling = (id + 1 < first + chunkSize) ? id + 1 : emptyNodes[depth];
+			values.emplace_back();
+		}
+		emptyNodes[depth] = first;
+	}
 	std::size_t createNode(const T& data, std::size_t parent, std::size_t depth) {
 		std::size_t res = newNode(data, parent, depth);
 		nodes[res].nextSibling = MAXINT;
@@ -917,10 +1016,13 @@ private:
 	}
 	void eraseNode(std::size_t id) {
 		eraseChildren(id);
-		nodes[id].nextSibling = emptyNodes;
+		std::size_t depth = nodes[id].depth;
+		nodes[id].nextSibling = emptyNodes[depth];
 		nodes[id].previousSibling = MAXINT;
 		nodes[id].depth = MAXINT;
-		emptyNodes = id;
+		// release the resources of the value right away
+		values[id] = boost::none;
+		emptyNodes[depth] = id;
 	}
 
 public:
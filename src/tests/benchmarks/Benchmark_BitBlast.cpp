@@ -0,0 +1,80 @@
+#include "gtest/gtest.h"
+
+#include "framework/Benchmark.h"
+#include "carl/core/VariablePool.h"
+#include "carl/formula/SortManager.h"
+#include "carl/formula/bitvector/BVBitBlaster.h"
+#include "carl/formula/bitvector/BVConstraintPool.h"
+#include "BenchmarkTest.h"
+#include "framework/BenchmarkGenerator.h"
+
+using namespace carl;
+
+namespace carl {
+
+	//##### Generator
+	/**
+	 * Generates the constraint x * y = c for fresh variables of width 8 * bi.degree and a random constant c.
+	 * If Constant is true, y is a random constant as well.
+	 */
+	template<bool Constant>
+	struct MultiplicationGenerator: public BaseGenerator {
+		typedef std::tuple<BVConstraint> type;
+		Sort sort;
+		std::size_t width;
+		MultiplicationGenerator(const BenchmarkInformation& bi): BaseGenerator(bi), width(8 * bi.degree) {
+			Sort bv = SortManager::getInstance().getSort("BitVec");
+			sort = SortManager::getInstance().index(bv, {width});
+		}
+		BVTerm randomConstant() const {
+			BVValue value(width);
+			for (std::size_t i = 0; i < width; i++) value[i] = g.uniDist(2) == 1;
+			return BVTerm(BVTermType::CONSTANT, value);
+		}
+		type operator()() const {
+			BVTerm x(BVTermType::VARIABLE, BVVariable(freshBitvectorVariable(), sort));
+			BVTerm y = Constant ? randomConstant() : BVTerm(BVTermType::VARIABLE, BVVariable(freshBitvectorVariable(), sort));
+			return std::make_tuple(BVConstraint::create(BVCompareRelation::EQ, BVTerm(BVTermType::MUL, x, y), randomConstant()));
+		}
+	};
+
+	//##### Executor
+	/**
+	 * Bit-blasts the constraint, counting the clauses without storing them.
+	 * Returns the number of clauses.
+	 */
+	struct BitBlastExecutor {
+		std::size_t operator()(const std::tuple<BVConstraint>& args) {
+			BVBitBlaster bb([](const BVBitBlaster::Clause&){});
+			bb.assertConstraint(std::get<0>(args));
+			return bb.nrClauses();
+		}
+	};
+}
+
+/**
+ * Measures the time to bit-blast wide multiplications of two variables and of a variable with a constant.
+ * The size of the resulting CNF is printed for every width.
+ */
+TEST_F(BenchmarkTest, BitBlastMultiplication)
+{
+	SortManager::getInstance().clear();
+	Sort bv = SortManager::getInstance().addSort("BitVec");
+	SortManager::getInstance().makeSortIndexable(bv, 1, VariableType::VT_BITVECTOR);
+
+	BenchmarkInformation bi(BenchmarkSelection::Random, 1);
+	bi.n = 10;
+	for (bi.degree = 1; bi.degree <= 8; bi.degree *= 2) {
+		Benchmark<MultiplicationGenerator<false>, BitBlastExecutor, std::size_t> variable(bi, "Variable");
+		Benchmark<MultiplicationGenerator<true>, BitBlastExecutor, std::size_t> constant(bi, "Constant");
+		BenchmarkResult res = variable.result();
+		for (const auto& r: constant.result()) res.insert(r);
+		file.push(res, bi.degree);
+
+		for (bool c: {false, true}) {
+			BitBlastExecutor e;
+			std::size_t clauses = c ? e(MultiplicationGenerator<true>(bi)()) : e(MultiplicationGenerator<false>(bi)());
+			std::cout << "Width " << 8 * bi.degree << (c ? ", constant factor: " : ": ") << clauses << " clauses" << std::endl;
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include <set>
+
+#include "framework/Benchmark.h"
+#include "carl/core/MultivariatePolynomial.h"
+#include "carl/core/rootfinder/RootFinder.h"
+#include "carl/thom/ThomRootFinder.h"
+#include "BenchmarkTest.h"
+#include "framework/BenchmarkGenerator.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+namespace carl {
+
+	//##### Generator
+	/**
+	 * Generates univariate polynomials with bi.degree distinct rational roots and two irrational roots.
+	 */
+	template<typename C>
+	struct RootsGenerator: public BaseGenerator {
+		typedef std::tuple<CMP<C>,CVAR> type;
+		RootsGenerator(const BenchmarkInformation& bi): BaseGenerator(bi) {}
+		type operator()() const {
+			static const int nonSquares[] = {2, 3, 5, 6, 7, 8};
+			auto v = g.randomVariable();
+			CMP<C> res = CMP<C>(v) * v - C(nonSquares[g.uniDist(6)]);
+			std::set<C> roots;
+			while (roots.size() < bi.degree) {
+				roots.insert(C(int(g.uniDist(41)) - 20) / C(int(g.uniDist(3)) + 1));
+			}
+			for (const auto& r: roots) {
+				res *= CMP<C>(v) - r;
+			}
+			return std::make_tuple(res, v);
+		}
+	};
+
+	//##### Executor
+	/**
+	 * Isolates the real roots, compares adjacent roots and determines the sign of the derivative at every root.
+	 * Returns the number of roots where the polynomial is increasing.
+	 */
+	struct IntervalRootsExecutor {
+		template<typename Coeff>
+		std::size_t operator()(const std::tuple<CMP<Coeff>,CVAR>& args) {
+			auto p = std::get<0>(args).toUnivariatePolynomial(std::get<1>(args)).toNumberCoefficients();
+			auto der = p.derivative();
+			auto roots = rootfinder::realRoots(p);
+			std::size_t res = 0;
+			for (std::size_t i = 0; i < roots.size(); i++) {
+				if (i > 0) assert(roots[i-1] < roots[i]);
+				if (roots[i].sgn(der) == Sign::POSITIVE) res++;
+			}
+			return res;
+		}
+	};
+	struct ThomRootsExecutor {
+		template<typename Coeff>
+		std::size_t operator()(const std::tuple<CMP<Coeff>,CVAR>& args) {
+			auto der = std::get<0>(args).derivative(std::get<1>(args));
+			auto roots = realRootsThom(std::get<0>(args), std::get<1>(args));
+			std::size_t res = 0;
+			for (auto it = roots.begin(); it != roots.end(); it++) {
+				if (it != roots.begin()) assert(*std::prev(it) < *it);
+				if (it->signOnPolynomial(der) == Sign::POSITIVE) res++;
+			}
+			return res;
+		}
+	};
+}
+
+/**
+ * Compares the interval and the Thom representation of real algebraic numbers on the same inputs.
+ * The Thom backend is run twice, the second run reuses the cached Tarski queries of the first one.
+ */
+TEST_F(BenchmarkTest, RealRoots)
+{
+	BenchmarkInformation bi(BenchmarkSelection::Random, 1);
+	bi.n = 20;
+	for (bi.degree = 1; bi.degree < 6; bi.degree++) {
+		TarskiQueryCache<Rational>::getInstance().clear();
+		Benchmark<RootsGenerator<Rational>, IntervalRootsExecutor, std::size_t> interval(bi, "Interval");
+		Benchmark<RootsGenerator<Rational>, ThomRootsExecutor, std::size_t> thom(bi, "Thom");
+		Benchmark<RootsGenerator<Rational>, ThomRootsExecutor, std::size_t> thomCached(bi, "Thom cached");
+		BenchmarkResult res = interval.result();
+		for (const auto& r: {thom.result(), thomCached.result()}) {
+			res.insert(r.begin(), r.end());
+		}
+		file.push(res, bi.degree);
+	}
+}
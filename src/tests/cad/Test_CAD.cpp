@@ -1,12 +1,19 @@
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <list>
+#include <set>
+#include <string>
 #include <vector>
 
+#include <boost/optional/optional_io.hpp>
+
 #include "carl/core/logging.h"
 #include "carl/cad/CAD.h"
 #include "carl/cad/Constraint.h"
+#include "carl/cad/SingleCell.h"
 #include "carl/util/platform.h"
 
 
@@ -251,6 +258,430 @@ TEST_F(CADTest, Check9)
 	for (auto c: cons) EXPECT_TRUE(c.satisfiedBy(r, cad.getVariables()));
 }
 
+TEST_F(CADTest, ParallelProjection)
+{
+	carl::cad::CADSettings setting = carl::cad::CADSettings::getSettings(carl::cad::NOTBOUNDED);
+	carl::CAD<Rational> sequential(setting);
+	setting.projectionThreads = 4;
+	carl::CAD<Rational> parallel(setting);
+	for (auto c: {&sequential, &parallel}) {
+		for (std::size_t i: {3, 4, 5, 8}) c->addPolynomial(this->p[i], {x, y, z});
+		c->completeElimination();
+	}
+	auto find = [](const carl::cad::EliminationSet<Rational>& s, const carl::CAD<Rational>::UPolynomial* p) {
+		for (auto q: s.getPolynomials()) {
+			if (*p == *q) return q;
+		}
+		return static_cast<const carl::CAD<Rational>::UPolynomial*>(nullptr);
+	};
+	// the parents of q as pairs of polynomial values, such that the sets of both CAD objects can be compared
+	auto parents = [](const carl::cad::EliminationSet<Rational>& s, const carl::CAD<Rational>::UPolynomial* q) {
+		auto str = [](const carl::CAD<Rational>::UPolynomial* p) {
+			if (p == nullptr) return std::string();
+			std::stringstream ss;
+			ss << *p;
+			return ss.str();
+		};
+		std::set<std::pair<std::string, std::string>> res;
+		auto list = s.getParentsOf(q);
+		for (auto it = list.begin(); it != list.end(); std::advance(it, 2)) {
+			auto first = str(*it);
+			auto second = str(*std::next(it));
+			res.emplace(std::min(first, second), std::max(first, second));
+		}
+		return res;
+	};
+	std::size_t levels = parallel.getEliminationSets().size();
+	ASSERT_EQ(sequential.getEliminationSets().size(), levels);
+	for (std::size_t l = 0; l < levels; l++) {
+		const auto& seq = sequential.getEliminationSet(l);
+		const auto& par = parallel.getEliminationSet(l);
+		EXPECT_EQ(seq.size(), par.size());
+		for (auto q: par.getPolynomials()) {
+			auto s = find(seq, q);
+			ASSERT_TRUE(s != nullptr) << *q;
+			EXPECT_EQ(parents(seq, s), parents(par, q)) << *q;
+		}
+		if (l + 1 < levels) {
+			EXPECT_TRUE(par.emptySingleEliminationQueue());
+			EXPECT_TRUE(par.emptyPairedEliminationQueue());
+		}
+	}
+
+	// the incremental elimination within check projects whole levels as well
+	carl::CAD<Rational> checked(setting);
+	RealAlgebraicPoint<Rational> r;
+	for (std::size_t i: {3, 4, 5}) checked.addPolynomial(this->p[i], {x, y, z});
+	checked.prepareElimination();
+	std::vector<Constraint> cons({
+		Constraint(this->p[3], Sign::NEGATIVE, {x,y,z}),
+		Constraint(this->p[4], Sign::POSITIVE, {x,y,z}),
+		Constraint(this->p[5], Sign::POSITIVE, {x,y,z})
+	});
+	EXPECT_EQ(carl::cad::Answer::True, checked.check(cons, r, this->bounds));
+	for (auto c: cons) EXPECT_TRUE(c.satisfiedBy(r, checked.getVariables()));
+}
+
+TEST_F(CADTest, ProjectionCache)
+{
+	auto& cache = carl::cad::ProjectionCache<Rational>::getInstance();
+	cache.clear();
+	carl::cad::CADSettings setting = carl::cad::CADSettings::getSettings(carl::cad::NOTBOUNDED);
+	carl::CAD<Rational> uncached(setting);
+	setting.useProjectionCache = true;
+	carl::CAD<Rational> first(setting);
+	carl::CAD<Rational> second(setting);
+	for (auto c: {&uncached, &first}) {
+		for (std::size_t i: {3, 4, 8}) c->addPolynomial(this->p[i], {x, y, z});
+		c->completeElimination();
+	}
+	std::size_t hits = cache.hits();
+	std::size_t misses = cache.misses();
+	EXPECT_LT(0, misses);
+	// an overlapping set of polynomials only computes the new projections
+	for (std::size_t i: {3, 4, 5}) second.addPolynomial(this->p[i], {x, y, z});
+	second.completeElimination();
+	EXPECT_LT(hits, cache.hits());
+	EXPECT_LT(cache.misses(), 2 * misses);
+
+	auto contains = [](const carl::cad::EliminationSet<Rational>& s, const carl::CAD<Rational>::UPolynomial* p) {
+		for (auto q: s.getPolynomials()) {
+			if (*p == *q || *p == -*q) return true;
+		}
+		return false;
+	};
+	for (std::size_t l = 0; l < first.getEliminationSets().size(); l++) {
+		for (auto q: first.getEliminationSet(l).getPolynomials()) {
+			EXPECT_TRUE(contains(uncached.getEliminationSet(l), q)) << *q;
+		}
+		EXPECT_EQ(uncached.getEliminationSet(l).size(), first.getEliminationSet(l).size());
+	}
+
+	cache.setCapacity(2);
+	EXPECT_EQ(2, cache.size());
+	cache.setCapacity(10000);
+	cache.clear();
+}
+
+TEST_F(CADTest, SingleCell)
+{
+	typedef carl::RealAlgebraicNumber<Rational> RAN;
+	typedef carl::cad::SingleCell<Rational>::Assignment Assignment;
+	auto point = [&](const Rational& a, const Rational& b) {
+		return Assignment({{x, RAN(a)}, {y, RAN(b)}});
+	};
+	std::vector<Polynomial> polys({this->p[0], this->p[2]});
+	carl::cad::SingleCell<Rational> sc({x, y});
+
+	// sector between the line and the upper half of the circle
+	Assignment sample = point(0, Rational(1)/2);
+	auto cell = sc.construct(polys, sample);
+	ASSERT_EQ(2, cell.components.size());
+	EXPECT_FALSE(cell.components[1].section);
+	EXPECT_TRUE(cell.contains(sample));
+	for (const auto& q: {point(Rational(1)/10, Rational(1)/2), point(0, Rational(3)/4), point(Rational(-1)/2, Rational(1)/5)}) {
+		EXPECT_TRUE(cell.contains(q));
+		for (const auto& poly: polys) {
+			EXPECT_EQ(RealAlgebraicNumberEvaluation::evaluateSign(poly, sample), RealAlgebraicNumberEvaluation::evaluateSign(poly, q));
+		}
+	}
+	EXPECT_FALSE(cell.contains(point(0, Rational(-1)/2)));
+	EXPECT_FALSE(cell.contains(point(Rational(9)/10, Rational(19)/20)));
+	EXPECT_FALSE(cell.contains(point(0, 2)));
+
+	// section on the line
+	sample = point(0, 0);
+	cell = sc.construct(polys, sample);
+	ASSERT_EQ(2, cell.components.size());
+	EXPECT_TRUE(cell.components[1].section);
+	EXPECT_TRUE(cell.contains(sample));
+	EXPECT_TRUE(cell.contains(point(Rational(1)/10, Rational(1)/10)));
+	EXPECT_FALSE(cell.contains(point(Rational(1)/10, Rational(1)/5)));
+
+	// polynomials with the common factor y - x
+	Polynomial line = this->p[2];
+	polys.assign({line * (Polynomial(y) + Polynomial(x)), line * Polynomial(y)});
+	sample = point(Rational(1)/2, Rational(1)/4);
+	cell = sc.construct(polys, sample);
+	EXPECT_TRUE(cell.contains(sample));
+	EXPECT_TRUE(cell.contains(point(Rational(1)/3, Rational(1)/10)));
+	EXPECT_FALSE(cell.contains(point(Rational(1)/2, Rational(3)/4)));
+	EXPECT_FALSE(cell.contains(point(Rational(-1)/2, Rational(1)/4)));
+}
+
+TEST_F(CADTest, ParallelLifting)
+{
+	carl::cad::CADSettings setting = carl::cad::CADSettings::getSettings(carl::cad::NOTBOUNDED);
+	carl::cad::CADSettings parallelSetting = setting;
+	parallelSetting.liftingThreads = 4;
+	auto check = [&](const carl::cad::CADSettings& s, const std::vector<std::size_t>& polys, std::vector<Constraint> cons, RealAlgebraicPoint<Rational>& r, std::string& graph) {
+		carl::CAD<Rational> cad(s);
+		for (std::size_t i: polys) cad.addPolynomial(this->p[i], {x, y, z, w});
+		cad.prepareElimination();
+		carl::cad::ConflictGraph<Rational> cg;
+		auto answer = cad.check(cons, r, cg, this->bounds);
+		std::stringstream ss;
+		ss << cg;
+		graph = ss.str();
+		return answer;
+	};
+	// satisfiable: the first satisfying sample in the sample ordering is found
+	std::vector<Constraint> sat({
+		Constraint(this->p[9], Sign::NEGATIVE, {x,y,z,w}),
+		Constraint(this->p[10], Sign::ZERO, {x,y,z,w}),
+		Constraint(this->p[11], Sign::POSITIVE, {x,y,z,w}),
+		Constraint(this->p[12], Sign::ZERO, {x,y,z,w})
+	});
+	// unsatisfiable: all samples are checked
+	std::vector<Constraint> unsat({
+		Constraint(this->p[9], Sign::NEGATIVE, {x,y,z,w}),
+		Constraint(this->p[10], Sign::ZERO, {x,y,z,w}),
+		Constraint(this->p[11], Sign::ZERO, {x,y,z,w}),
+		Constraint(this->p[9], Sign::POSITIVE, {x,y,z,w})
+	});
+	for (const auto& cons: {sat, unsat}) {
+		RealAlgebraicPoint<Rational> rs, rp;
+		std::string gs, gp;
+		auto as = check(setting, {9, 10, 11, 12}, cons, rs, gs);
+		auto ap = check(parallelSetting, {9, 10, 11, 12}, cons, rp, gp);
+		EXPECT_EQ(as, ap);
+		EXPECT_EQ(gs, gp);
+		if (ap == carl::cad::Answer::True) {
+			ASSERT_EQ(rs.dim(), rp.dim());
+			for (std::size_t i = 0; i < rp.dim(); i++) EXPECT_TRUE(rs[i] == rp[i]);
+			for (auto c: cons) EXPECT_TRUE(c.satisfiedBy(rp, {x, y, z, w}));
+		}
+	}
+}
+
+TEST_F(CADTest, EquationalProjection)
+{
+	carl::cad::CADSettings setting = carl::cad::CADSettings::getSettings(carl::cad::NOTBOUNDED);
+	carl::cad::CADSettings equational = setting;
+	equational.equationalProjection = true;
+	auto size = [](const carl::CAD<Rational>& cad) {
+		std::size_t res = 0;
+		for (const auto& s: cad.getEliminationSets()) res += s.size();
+		return res;
+	};
+	// x^2 + y^2 + z^2 = 1, x^2 + y^2 = 0 and x^3 + y^3 + z^3 > 1 is unsatisfiable, hence all projections are computed
+	std::vector<Constraint> withEquations({
+		Constraint(this->p[3], Sign::ZERO, {x,y,z}),
+		Constraint(this->p[4], Sign::ZERO, {x,y,z}),
+		Constraint(this->p[8], Sign::POSITIVE, {x,y,z})
+	});
+	std::vector<Constraint> withoutEquations({
+		Constraint(this->p[3], Sign::POSITIVE, {x,y,z}),
+		Constraint(this->p[4], Sign::NEGATIVE, {x,y,z}),
+		Constraint(this->p[8], Sign::POSITIVE, {x,y,z})
+	});
+	carl::CAD<Rational> full(setting);
+	carl::CAD<Rational> restricted(equational);
+	for (auto c: {&full, &restricted}) {
+		for (std::size_t i: {3, 4, 8}) c->addPolynomial(this->p[i], {x, y, z});
+	}
+	RealAlgebraicPoint<Rational> r;
+	EXPECT_EQ(carl::cad::Answer::False, full.check(withEquations, r, this->bounds));
+	EXPECT_EQ(carl::cad::Answer::False, restricted.check(withEquations, r, this->bounds));
+	EXPECT_LT(size(restricted), size(full));
+
+	// x^2 + y^2 + z^2 = 1, x^3 + y^3 + z^3 = 1 and x^2 + y^2 < 0 is unsatisfiable, the resultants of both equations are equations of the next level
+	std::vector<Constraint> twoEquations({
+		Constraint(this->p[3], Sign::ZERO, {x,y,z}),
+		Constraint(this->p[8], Sign::ZERO, {x,y,z}),
+		Constraint(this->p[4], Sign::NEGATIVE, {x,y,z})
+	});
+	std::vector<Constraint> oneEquation({
+		Constraint(this->p[3], Sign::ZERO, {x,y,z}),
+		Constraint(this->p[8], Sign::POSITIVE, {x,y,z}),
+		Constraint(this->p[4], Sign::NEGATIVE, {x,y,z})
+	});
+	carl::CAD<Rational> propagating(equational);
+	for (std::size_t i: {3, 4, 8}) propagating.addPolynomial(this->p[i], {x, y, z});
+	EXPECT_EQ(carl::cad::Answer::False, propagating.check(twoEquations, r, this->bounds));
+	std::size_t propagated = propagating.getEliminationSet(1).getEquations().size();
+	EXPECT_LT(0, propagated);
+	// the equations of the lower levels are recovered from the projections computed so far
+	EXPECT_EQ(carl::cad::Answer::False, propagating.check(oneEquation, r, this->bounds));
+	EXPECT_EQ(carl::cad::Answer::False, propagating.check(twoEquations, r, this->bounds));
+	EXPECT_EQ(propagated, propagating.getEliminationSet(1).getEquations().size());
+
+	// x = 5 and x^2 + (y-3)^2 < 1 is unsatisfiable, but the disk alone is not:
+	// the samples only represent the section of the equation, hence the equation is part of the conflict
+	Polynomial line({Term<Rational>(x), Term<Rational>(-5)});
+	Polynomial disk({Term<Rational>(x)*x, Term<Rational>(y)*y, Term<Rational>(-6)*y, Term<Rational>(8)});
+	std::vector<Constraint> lineAndDisk({
+		Constraint(line, Sign::ZERO, {x,y}),
+		Constraint(disk, Sign::NEGATIVE, {x,y})
+	});
+	carl::cad::CADSettings conflicting = equational;
+	conflicting.computeConflictGraph = true;
+	carl::CAD<Rational> conflict(conflicting);
+	conflict.addPolynomial(line, {x, y});
+	conflict.addPolynomial(disk, {x, y});
+	carl::cad::ConflictGraph<Rational> cg;
+	EXPECT_EQ(carl::cad::Answer::False, conflict.check(lineAndDisk, r, cg, this->bounds));
+	EXPECT_EQ(1, conflict.getEliminationSet(0).getEquations().size());
+	std::size_t lineID = cg.getConstraint(lineAndDisk[0]);
+	std::size_t diskID = cg.getConstraint(lineAndDisk[1]);
+	EXPECT_TRUE(cg.isRequired(lineID));
+	EXPECT_FALSE(cg.isRequired(diskID));
+	for (bool exact: {false, true}) {
+		auto cover = cg.computeCover(exact);
+		EXPECT_TRUE(std::find(cover.begin(), cover.end(), lineID) != cover.end());
+		EXPECT_TRUE(std::find(cover.begin(), cover.end(), diskID) != cover.end());
+	}
+
+	// xy + z = 0 is nullified for y = z = 0, hence the projection is not restricted
+	Polynomial nullified({Term<Rational>(x)*y, Term<Rational>(z)});
+	std::vector<Constraint> withNullified({
+		Constraint(nullified, Sign::ZERO, {x,y,z}),
+		Constraint(this->p[3], Sign::NEGATIVE, {x,y,z})
+	});
+	carl::CAD<Rational> fallback(equational);
+	fallback.addPolynomial(nullified, {x, y, z});
+	fallback.addPolynomial(this->p[3], {x, y, z});
+	EXPECT_EQ(carl::cad::Answer::True, fallback.check(withNullified, r, this->bounds));
+	EXPECT_TRUE(fallback.getEliminationSet(0).getEquations().empty());
+
+	// without equations, the skipped projections are computed as well
+	EXPECT_EQ(carl::cad::Answer::False, full.check(withoutEquations, r, this->bounds));
+	EXPECT_EQ(carl::cad::Answer::False, restricted.check(withoutEquations, r, this->bounds));
+	EXPECT_EQ(size(full), size(restricted));
+}
+
+TEST_F(CADTest, Snapshot)
+{
+	auto sizes = [](const carl::CAD<Rational>& cad) {
+		std::vector<std::size_t> res;
+		for (const auto& s: cad.getEliminationSets()) res.push_back(s.size());
+		res.push_back(cad.samples().size());
+		return res;
+	};
+	RealAlgebraicPoint<Rational> r;
+	std::vector<Constraint> first({
+		Constraint(this->p[0], Sign::ZERO, {x,y}),
+		Constraint(this->p[1], Sign::ZERO, {x,y})
+	});
+	std::vector<Constraint> second({
+		Constraint(this->p[0], Sign::ZERO, {x,y}),
+		Constraint(this->p[1], Sign::ZERO, {x,y}),
+		Constraint(this->p[2], Sign::ZERO, {x,y})
+	});
+	this->cad.addPolynomial(this->p[0], {x, y});
+	this->cad.addPolynomial(this->p[1], {x, y});
+	EXPECT_EQ(carl::cad::Answer::True, cad.check(first, r, this->bounds));
+	auto before = sizes(this->cad);
+	auto s1 = this->cad.snapshot();
+	EXPECT_TRUE(s1.valid());
+
+	// push a new polynomial and pop it again
+	this->cad.addPolynomial(this->p[2], {x, y});
+	EXPECT_EQ(carl::cad::Answer::False, cad.check(second, r, this->bounds));
+	auto after = sizes(this->cad);
+	EXPECT_NE(before, after);
+	auto s2 = this->cad.snapshot();
+	this->cad.restore(s1);
+	EXPECT_EQ(before, sizes(this->cad));
+	EXPECT_EQ(carl::cad::Answer::True, cad.check(first, r, this->bounds));
+	for (auto c: first) EXPECT_TRUE(c.satisfiedBy(r, cad.getVariables()));
+
+	// the snapshot is not affected by checks after restoring it
+	this->cad.addPolynomial(this->p[2], {x, y});
+	EXPECT_EQ(carl::cad::Answer::False, cad.check(second, r, this->bounds));
+	this->cad.restore(s1);
+	EXPECT_EQ(before, sizes(this->cad));
+
+	// the last reference to a snapshot is moved into the CAD
+	this->cad.restore(std::move(s2));
+	EXPECT_FALSE(s2.valid());
+	EXPECT_EQ(after, sizes(this->cad));
+	EXPECT_EQ(carl::cad::Answer::False, cad.check(second, r, this->bounds));
+	this->cad.restore(s1);
+	EXPECT_EQ(carl::cad::Answer::True, cad.check(first, r, this->bounds));
+
+	// restoring shares the elimination levels instead of copying them, they are copied when they are modified
+	this->cad.restore(s1);
+	auto levels = this->cad.getEliminationSets();
+	for (std::size_t l = 0; l < levels.size(); l++) {
+		EXPECT_TRUE(levels.shares(l, this->cad.getEliminationSets()));
+	}
+	this->cad.addPolynomial(this->p[2], {x, y});
+	EXPECT_EQ(carl::cad::Answer::False, cad.check(second, r, this->bounds));
+	std::vector<std::size_t> shared;
+	for (const auto& s: levels) shared.push_back(s.size());
+	before.pop_back();
+	EXPECT_EQ(before, shared);
+}
+
+TEST_F(CADTest, RootsInBox)
+{
+	typedef carl::Interval<Rational> Interval;
+	auto first = [](const carl::CAD<Rational>& cad) {
+		return *cad.getEliminationSet(0).getPolynomials().begin();
+	};
+	auto box = [](const Interval& i) {
+		return carl::CAD<Rational>::BoundMap({{0, i}});
+	};
+	{
+		// x^2 - 2
+		carl::CAD<Rational> cad;
+		cad.addPolynomial(this->p[9], {x});
+		cad.prepareElimination();
+		auto q = first(cad);
+		// decided by interval evaluation
+		EXPECT_EQ(boost::optional<bool>(false), cad.hasRootsInBox(q, box(Interval(0, carl::BoundType::WEAK, 1, carl::BoundType::WEAK)), 0));
+		EXPECT_EQ(boost::optional<bool>(false), cad.hasRootsInBox(q, box(Interval(Rational(3)/2, carl::BoundType::WEAK, 2, carl::BoundType::WEAK)), 0));
+		// decided by root counting
+		EXPECT_EQ(boost::optional<bool>(true), cad.hasRootsInBox(q, box(Interval(1, carl::BoundType::WEAK, 2, carl::BoundType::WEAK)), 0));
+		EXPECT_EQ(boost::optional<bool>(true), cad.hasRootsInBox(q, box(Interval(-2, carl::BoundType::STRICT, 2, carl::BoundType::STRICT)), 0));
+		// undecided without bounds
+		EXPECT_EQ(boost::none, cad.hasRootsInBox(q, carl::CAD<Rational>::BoundMap(), 0));
+	}
+	{
+		// x^2 - 2x + 3/2 has no real roots, but interval evaluation over [0, 2] yields [-5/2, 11/2]
+		carl::CAD<Rational> cad;
+		cad.addPolynomial(Polynomial({Term<Rational>(x)*x, Term<Rational>(-2)*x, Term<Rational>(Rational(3)/2)}), {x});
+		cad.prepareElimination();
+		EXPECT_EQ(boost::optional<bool>(false), cad.hasRootsInBox(first(cad), box(Interval(0, carl::BoundType::WEAK, 2, carl::BoundType::WEAK)), 0));
+	}
+	{
+		// x^2 + y^2 - 1
+		carl::CAD<Rational> cad;
+		cad.addPolynomial(this->p[0], {x, y});
+		cad.prepareElimination();
+		auto q = first(cad);
+		carl::CAD<Rational>::BoundMap outside({{0, Interval(2, carl::BoundType::WEAK, 3, carl::BoundType::WEAK)}, {1, Interval(2, carl::BoundType::WEAK, 3, carl::BoundType::WEAK)}});
+		carl::CAD<Rational>::BoundMap inside({{0, Interval(0, carl::BoundType::WEAK, 1, carl::BoundType::WEAK)}, {1, Interval(0, carl::BoundType::WEAK, 1, carl::BoundType::WEAK)}});
+		EXPECT_EQ(boost::optional<bool>(false), cad.hasRootsInBox(q, outside, 0));
+		EXPECT_EQ(boost::none, cad.hasRootsInBox(q, inside, 0));
+	}
+
+	// the pre-filter does not change the result of a bounded check
+	carl::cad::CADSettings setting = carl::cad::CADSettings::getSettings(carl::cad::BOUNDED);
+	carl::cad::CADSettings exact = setting;
+	exact.prefilterByIntervals = false;
+	std::vector<Constraint> cons({
+		Constraint(this->p[0], Sign::NEGATIVE, {x,y}),
+		Constraint(this->p[2], Sign::ZERO, {x,y})
+	});
+	for (const auto& b: {Interval(2, carl::BoundType::WEAK, 3, carl::BoundType::WEAK), Interval(0, carl::BoundType::STRICT, 1, carl::BoundType::WEAK)}) {
+		carl::CAD<Rational>::BoundMap bounds({{0, b}, {1, b}});
+		carl::CAD<Rational> filtered(setting);
+		carl::CAD<Rational> unfiltered(exact);
+		RealAlgebraicPoint<Rational> r1, r2;
+		for (auto c: {&filtered, &unfiltered}) {
+			c->addPolynomial(this->p[0], {x, y});
+			c->addPolynomial(this->p[2], {x, y});
+		}
+		auto res = filtered.check(cons, r1, bounds);
+		EXPECT_EQ(unfiltered.check(cons, r2, bounds), res);
+		if (res == carl::cad::Answer::True) {
+			for (auto c: cons) EXPECT_TRUE(c.satisfiedBy(r1, filtered.getVariables()));
+		}
+	}
+}
+
 TEST_F(CADTest, CheckInt)
 {
 	RealAlgebraicPoint<Rational> r;
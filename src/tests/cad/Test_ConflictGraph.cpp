@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <list>
+#include <sstream>
+#include <vector>
 
 #include "carl/cad/ConflictGraph.h"
 #include "carl/util/platform.h"
@@ -10,7 +12,128 @@
 
 using namespace carl;
 
+typedef cad::Constraint<Rational> Constraint;
+typedef MultivariatePolynomial<Rational> MPolynomial;
+
+namespace {
+	/// Creates the constraints x > 0, x > 1, ...
+	std::vector<Constraint> constraints(carl::Variable x, std::size_t n) {
+		std::vector<Constraint> res;
+		for (std::size_t i = 0; i < n; i++) {
+			res.emplace_back(MPolynomial(x) - Rational(i), Sign::POSITIVE, std::vector<carl::Variable>({x}));
+		}
+		return res;
+	}
+}
+
 TEST(ConflictGraph, BasicOperations)
 {
-    cad::ConflictGraph<Rational> cg;
+	carl::Variable x = freshRealVariable("x");
+	auto cons = constraints(x, 3);
+	cad::ConflictGraph<Rational> cg;
+	for (const auto& c: cons) cg.getConstraint(c);
+	EXPECT_EQ(3, cg.constraintCount());
+	EXPECT_EQ(1, cg.getConstraint(cons[1]));
+	EXPECT_EQ(cons[2], cg.getConstraint(2));
+	EXPECT_FALSE(cg.hasRemainingSamples());
+
+	// enough samples to span several blocks
+	for (std::size_t s = 0; s < 200; s++) {
+		EXPECT_EQ(s, cg.newSample());
+		cg.set(s % 3, s, true);
+		if (s % 5 == 0) cg.set((s + 1) % 3, s, true);
+	}
+	EXPECT_EQ(200, cg.sampleCount());
+	EXPECT_TRUE(cg.get(0, 0));
+	EXPECT_TRUE(cg.get(1, 0));
+	EXPECT_FALSE(cg.get(2, 0));
+	EXPECT_TRUE(cg.get(1, 199));
+	EXPECT_TRUE(cg.hasRemainingSamples());
+
+	cg.set(1, 0, false);
+	EXPECT_FALSE(cg.get(1, 0));
+	EXPECT_EQ(80, cg.degree(0));
+	EXPECT_EQ(0, cg.getMaxDegreeConstraint());
+
+	cg.selectConstraint(0);
+	EXPECT_EQ(0, cg.degree(0));
+	EXPECT_FALSE(cg.get(2, 5));
+	EXPECT_TRUE(cg.get(1, 1));
+
+	cg.removeConstraint(cons[0]);
+	EXPECT_EQ(2, cg.constraintCount());
+	EXPECT_EQ(0, cg.getConstraint(cons[1]));
+	EXPECT_EQ(cons[2], cg.getConstraint(1));
+	EXPECT_TRUE(cg.get(0, 1));
+	EXPECT_TRUE(cg.get(0, 199));
+
+	cg.selectConstraint(0);
+	cg.selectConstraint(1);
+	EXPECT_FALSE(cg.hasRemainingSamples());
+}
+
+TEST(ConflictGraph, Cover)
+{
+	carl::Variable x = freshRealVariable("x");
+	auto cons = constraints(x, 5);
+	cad::ConflictGraph<Rational> cg;
+	for (const auto& c: cons) cg.getConstraint(c);
+	for (std::size_t s = 0; s < 14; s++) cg.newSample();
+	// the greedy cover selects the largest set first and ends up with three constraints, while the last two suffice
+	for (std::size_t s: {0, 1, 2, 3, 7, 8, 9, 10}) cg.set(0, s, true);
+	for (std::size_t s: {4, 5, 11, 12}) cg.set(1, s, true);
+	for (std::size_t s: {6, 13}) cg.set(2, s, true);
+	for (std::size_t s = 0; s < 7; s++) cg.set(3, s, true);
+	for (std::size_t s = 7; s < 14; s++) cg.set(4, s, true);
+
+	EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), cg.computeCover());
+	EXPECT_EQ(std::vector<std::size_t>({3, 4}), cg.computeCover(true));
+	// without any search nodes, the exact mode falls back to the greedy cover
+	EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), cg.computeCover(true, 0));
+
+	// samples violated by no constraint are not covered
+	cg.newSample();
+	EXPECT_EQ(std::vector<std::size_t>({3, 4}), cg.computeCover(true));
+
+	// required constraints are part of every cover, the others only cover the remaining samples: {0, 1} and {3, 4} are both minimal
+	cg.require(2);
+	EXPECT_TRUE(cg.isRequired(2));
+	EXPECT_FALSE(cg.isRequired(3));
+	EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), cg.computeCover());
+	EXPECT_EQ(std::vector<std::size_t>({0, 1, 2}), cg.computeCover(true));
+	cg.removeConstraint(cons[0]);
+	EXPECT_TRUE(cg.isRequired(1));
+	EXPECT_FALSE(cg.isRequired(2));
+}
+
+TEST(ConflictGraph, Copy)
+{
+	carl::Variable x = freshRealVariable("x");
+	auto cons = constraints(x, 3);
+	cad::ConflictGraph<Rational> cg;
+	{
+		cad::ConflictGraph<Rational> source;
+		for (const auto& c: cons) source.getConstraint(c);
+		source.set(1, source.newSample(), true);
+		source.require(2);
+		cg = source;
+		source.removeConstraint(cons[0]);
+	}
+	// the copy does not refer to the destroyed source
+	EXPECT_EQ(3, cg.constraintCount());
+	EXPECT_EQ(cons[0], cg.getConstraint(0));
+	EXPECT_TRUE(cg.get(1, 0));
+	EXPECT_TRUE(cg.isRequired(2));
+	std::stringstream ss;
+	ss << cg;
+	EXPECT_NE(std::string::npos, ss.str().find("(required)"));
+
+	cad::ConflictGraph<Rational> moved(std::move(cg));
+	moved.removeConstraint(cons[0]);
+	EXPECT_EQ(2, moved.constraintCount());
+	EXPECT_EQ(cons[1], moved.getConstraint(0));
+	EXPECT_TRUE(moved.get(0, 0));
+	cg = std::move(moved);
+	EXPECT_EQ(cons[2], cg.getConstraint(1));
+	EXPECT_EQ(1, cg.getConstraint(cons[2]));
 }
@@ -40,3 +40,74 @@ TEST(SampleSet, SampleComparator)
 	
 	expectRightOrder(samples, comp);
 }
+
+TEST(SampleSet, Batch)
+{
+	typedef RealAlgebraicNumber<Rational> RAN;
+	carl::Variable x = freshRealVariable("x");
+	UnivariatePolynomial<Rational> p(x, {-2, 0, 1});
+	RAN sqrt2(p, Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT), true);
+
+	cad::SampleSet<Rational> s(cad::SampleOrdering::IntRatRoot);
+	s.insert(RAN(Rational(1)/2, false));
+	s.insert(RAN(2, false));
+	auto res = s.insertBatch({RAN(3, true), sqrt2, RAN(0, true), RAN(2, true), RAN(3, true), RAN(-1, false)});
+	ASSERT_EQ(6, res.size());
+	// results are ordered by value
+	EXPECT_TRUE(std::get<1>(res[0]));
+	EXPECT_TRUE(std::get<1>(res[1]));
+	EXPECT_TRUE(std::get<1>(res[2]));
+	// 2 replaces the existing sample as it is a root
+	EXPECT_FALSE(std::get<1>(res[3]));
+	EXPECT_TRUE(std::get<2>(res[3]));
+	EXPECT_TRUE(std::get<0>(res[3])->isRoot());
+	EXPECT_TRUE(std::get<1>(res[4]));
+	// 3 is contained in the batch twice
+	EXPECT_FALSE(std::get<1>(res[5]));
+	EXPECT_FALSE(std::get<2>(res[5]));
+	EXPECT_TRUE(std::get<0>(res[4]) == std::get<0>(res[5]));
+
+	std::vector<RAN> values({RAN(-1), RAN(0), RAN(Rational(1)/2), sqrt2, RAN(2), RAN(3)});
+	ASSERT_EQ(values.size(), s.samples().size());
+	for (std::size_t i = 0; i < values.size(); i++) {
+		EXPECT_TRUE(values[i] == s.samples()[i]);
+	}
+	EXPECT_TRUE(s.contains(sqrt2));
+	EXPECT_FALSE(s.contains(RAN(1)));
+
+	// integers first, then rationals, then the root, each by value
+	std::vector<RAN> order({RAN(3), RAN(2), RAN(0), RAN(-1), RAN(Rational(1)/2), sqrt2});
+	for (const auto& o: order) {
+		ASSERT_FALSE(s.empty());
+		EXPECT_TRUE(o == s.next());
+		s.pop();
+	}
+	EXPECT_TRUE(s.empty());
+}
+
+TEST(SampleSet, Heap)
+{
+	typedef RealAlgebraicNumber<Rational> RAN;
+	cad::SampleSet<Rational> s(cad::SampleOrdering::IntRatSize);
+	cad::SampleSet<Rational>::SampleComparator comp(cad::SampleOrdering::IntRatSize);
+	std::vector<RAN> values;
+	for (int i = 0; i < 50; i++) {
+		values.emplace_back(Rational((i * 37) % 101) / ((i % 7) + 1), i % 3 == 0);
+	}
+	s.insert(values.begin(), values.begin() + 20);
+	for (auto it = values.begin() + 20; it != values.end(); it++) s.insert(*it);
+	// remove some samples by their position
+	auto it = s.begin();
+	it++;
+	s.remove(it);
+	s.remove(s.begin());
+
+	std::vector<RAN> expected(s.samples());
+	std::sort(expected.begin(), expected.end(), [&comp](const RAN& a, const RAN& b){ return comp(b, a); });
+	for (const auto& e: expected) {
+		ASSERT_FALSE(s.empty());
+		EXPECT_TRUE(e == s.next());
+		s.pop();
+	}
+	EXPECT_TRUE(s.empty());
+}
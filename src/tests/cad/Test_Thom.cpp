@@ -271,3 +271,81 @@ TEST(Thom, Evaluation) {
         std::map<Variable, RAN> m4 = {std::make_pair(x, RAN(sqrt2x)), std::make_pair(y, RAN(realRootsPoly5.front())), std::make_pair(z, RAN(sqrt2z))};
         EXPECT_TRUE(evaluateTE(poly4, m4).sgn() == Sign::NEGATIVE);
 }
+
+TEST(Thom, Caching) {
+        typedef MultivariatePolynomial<Rational> Polynomial;
+        typedef ThomEncoding<Rational> TE;
+        Variable x = freshRealVariable("x");
+        Variable y = freshRealVariable("y");
+        
+        Polynomial poly1({Rational(1)*x*x, Term<Rational>(Rational(-2))});      // x² - 2
+        Polynomial poly2({Rational(1)*x*x, Rational(1)*y*y, Term<Rational>(Rational(-3))});     // x² + y² - 3
+        
+        auto& cache = TarskiQueryCache<Rational>::getInstance();
+        cache.clear();
+        std::list<TE> roots1 = realRootsThom(poly1, x);
+        ASSERT_EQ(roots1.size(), 2);
+        std::map<Variable, TE> m = {std::make_pair(x, roots1.back())};
+        std::list<TE> roots2 = realRootsThom(poly2, y, m);
+        EXPECT_EQ(roots2.size(), 2);
+        
+        // Lifting over the same point again only reuses the zero sets.
+        std::size_t zeroSets = cache.size();
+        std::size_t misses = cache.misses();
+        std::list<TE> roots2again = realRootsThom(poly2, y, m);
+        EXPECT_EQ(zeroSets, cache.size());
+        EXPECT_EQ(misses, cache.misses());
+        ASSERT_EQ(roots2.size(), roots2again.size());
+        EXPECT_TRUE(roots2.front() == roots2again.front());
+        EXPECT_TRUE(roots2.back() == roots2again.back());
+        EXPECT_TRUE(roots2.front() < roots2again.back());
+        
+        // Repeated sign queries give the same result.
+        Polynomial q({Rational(1)*y, Rational(-1)*x});                          // y - x
+        EXPECT_EQ(roots2.back().signOnPolynomial(q), Sign::NEGATIVE);
+        EXPECT_EQ(roots2.back().signOnPolynomial(q), Sign::NEGATIVE);
+        EXPECT_EQ(roots2.front().signOnPolynomial(q), Sign::NEGATIVE);
+        
+        // Managers on the same zero set share their query results.
+        std::vector<Polynomial> zeroSet = {poly1};
+        TarskiQueryManager<Rational> taq1(zeroSet.begin(), zeroSet.end());
+        TarskiQueryManager<Rational> taq2(zeroSet.begin(), zeroSet.end());
+        EXPECT_EQ(taq1(Rational(1)), 2);
+        std::size_t queries = taq2.cachedQueries();
+        EXPECT_GT(queries, 0);
+        EXPECT_EQ(taq2(Rational(1)), 2);
+        EXPECT_EQ(queries, taq2.cachedQueries());
+        
+        // Shrinking the cache keeps the most recently used zero set.
+        cache.setCapacity(1);
+        EXPECT_EQ(1, cache.size());
+        misses = cache.misses();
+        TarskiQueryManager<Rational> taq3(zeroSet.begin(), zeroSet.end());
+        EXPECT_EQ(misses, cache.misses());
+        cache.setCapacity(1000);
+}
+
+TEST(Thom, CharPol) {
+        // a matrix that needs pivoting and one that is already in Hessenberg form
+        CoeffMatrix<Rational> m1(4, 4);
+        m1 << 1, 2, 0, 3,
+              0, 1, 4, 1,
+              2, 0, 0, 1,
+              1, 1, 1, 5;
+        CoeffMatrix<Rational> m2(3, 3);
+        m2 << 2, 1, 0,
+              1, 3, 1,
+              0, 1, 4;
+        CoeffMatrix<Rational> m3(5, 5);
+        for (long i = 0; i < 5; i++) {
+                for (long j = 0; j < 5; j++) {
+                        m3(i, j) = Rational((i * 7 + j * 3) % 5) - Rational(2) + (i == j ? Rational(1)/Rational(2) : Rational(0));
+                }
+        }
+        for (const auto& m: {m1, m2, m3}) {
+                EXPECT_EQ(charPol(m), charPolHessenberg(m));
+        }
+        // (X-2)(X-3)(X-4) - (X-2) - (X-4)
+        std::vector<Rational> expected = {Rational(-18), Rational(24), Rational(-9), Rational(1)};
+        EXPECT_EQ(expected, charPolHessenberg(m2));
+}
@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "carl/core/EvaluationProgram.h"
+#include "carl/core/VariablePool.h"
+
+#include "../Common.h"
+
+#include <random>
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+TEST(EvaluationProgram, Constant)
+{
+	EvaluationProgram<Pol> prog(Pol(Rational(Rational(3)/2)));
+	EXPECT_TRUE(prog.variables().empty());
+	EXPECT_EQ(Rational(3)/2, prog.evaluate(std::vector<Rational>()));
+	EvaluationProgram<Pol> zero(Pol(0));
+	EXPECT_EQ(Rational(0), zero.evaluate(std::vector<Rational>()));
+}
+
+TEST(EvaluationProgram, Evaluate)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	std::vector<Pol> polys({
+		Pol(x),
+		Pol(x) * x * x * y - Rational(2) * x * z + Rational(Rational(1)/3),
+		(Pol(x) + y) * (Pol(x) - z) * (Pol(y) + z + Rational(5)),
+		Pol(x) * x * x * x * x * x * x + Rational(7) * y * y * z * z * z - Rational(Rational(3)/4) * x * y * z,
+		Pol(z) * z - Rational(1)
+	});
+	std::vector<Variable> vars({x, y, z});
+	std::sort(vars.begin(), vars.end());
+	std::vector<EvaluationProgram<Pol>> progs;
+	for (const auto& p: polys) progs.emplace_back(p, vars);
+
+	std::mt19937 rand(4);
+	std::uniform_int_distribution<int> dist(-20, 20);
+	std::vector<Rational> values(vars.size());
+	std::vector<Rational> registers;
+	for (int i = 0; i < 50; ++i) {
+		std::map<Variable, Rational> assignment;
+		for (std::size_t s = 0; s < vars.size(); ++s) {
+			values[s] = Rational(Rational(dist(rand)) / (dist(rand) % 5 == 0 ? 1 : 3));
+			assignment[vars[s]] = values[s];
+		}
+		for (std::size_t j = 0; j < polys.size(); ++j) {
+			Rational expected = polys[j].evaluate(assignment);
+			EXPECT_EQ(expected, progs[j].evaluate(values, registers)) << polys[j];
+			EXPECT_EQ(expected, progs[j].evaluate(values)) << polys[j];
+			EXPECT_EQ(expected, progs[j].evaluate(assignment)) << polys[j];
+			EXPECT_EQ(carl::evaluate(expected, Relation::LESS), progs[j].satisfies(values, Relation::LESS));
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+#include "carl/core/MultivariateHorner.h"
+#include "carl/core/VariablePool.h"
+#include "carl/interval/IntervalEvaluation.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+
+namespace {
+
+struct CostModelStrategy: public strategy {
+	static constexpr variableSelectionHeurisics selectionType = COST_MODEL;
+};
+
+/// Number of additions and multiplications needed to evaluate the scheme, powers count as exponent - 1 multiplications.
+template<typename Strategy>
+std::size_t operations(const MultivariateHorner<Pol, Strategy>& h) {
+	if (h.getVariable() == Variable::NO_VARIABLE) return 0;
+	std::size_t res = h.getExponent() - 1;
+	if (h.getDependent()) res += 1 + operations(*h.getDependent());
+	else if (!isOne(h.getDepConstant())) res += 1;
+	if (h.getIndependent()) res += 1 + operations(*h.getIndependent());
+	else if (!isZero(h.getIndepConstant())) res += 1;
+	return res;
+}
+
+}
+
+TEST(MultivariateHorner, CostModel)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	// All variables occur in three terms and the greedy strategy takes the last one, but factoring out y shares the high powers of y.
+	Pol p = Pol(x) + Pol(x) * z + Pol(x) * y * y * y * y + Pol(y) * y * y * y * y * z + Pol(y) * y * y * y * z * z;
+	MultivariateHorner<Pol, strategy> greedy(p);
+	MultivariateHorner<Pol, CostModelStrategy> cost(p);
+	EXPECT_EQ(z, greedy.getVariable());
+	EXPECT_EQ(y, cost.getVariable());
+	EXPECT_EQ(13, operations(greedy));
+	EXPECT_EQ(10, operations(cost));
+
+	std::map<Variable, Interval<Rational>> map;
+	map[x] = Interval<Rational>(Rational(2));
+	map[y] = Interval<Rational>(Rational(-3));
+	map[z] = Interval<Rational>(Rational(5));
+	std::map<Variable, Rational> values({{x, Rational(2)}, {y, Rational(-3)}, {z, Rational(5)}});
+	EXPECT_EQ(Interval<Rational>(p.evaluate(values)), IntervalEvaluation::evaluate(cost, map));
+}
+
+TEST(MultivariateHorner, Cache)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Pol p = Pol(x) * x * y + Pol(x) * y + Rational(3);
+	auto& cache = MultivariateHornerCache<Pol, CostModelStrategy>::getInstance();
+	cache.clear();
+	auto h1 = cachedHornerScheme<CostModelStrategy>(p);
+	auto h2 = cachedHornerScheme<CostModelStrategy>(Pol(x) * x * y + Pol(x) * y + Rational(3));
+	EXPECT_EQ(h1.get(), h2.get());
+	EXPECT_EQ(1, cache.size());
+	EXPECT_EQ(1, cache.hits());
+
+	std::map<Variable, Interval<double>> map;
+	map[x] = Interval<double>(1.0, 2.0);
+	map[y] = Interval<double>(-1.0, 1.0);
+	EXPECT_EQ(IntervalEvaluation::evaluate(*h1, map), IntervalEvaluation::evaluate(h1, map));
+	EXPECT_TRUE(IntervalEvaluation::evaluate(h1, map).contains(3.0));
+
+	cache.setCapacity(1);
+	auto h3 = cachedHornerScheme<CostModelStrategy>(Pol(y) + Rational(1));
+	EXPECT_EQ(1, cache.size());
+	EXPECT_NE(h1.get(), h3.get());
+	cache.setCapacity(10000);
+}
@@ -67,3 +67,78 @@ TEST(RealAlgebraicNumber, Evaluation2)
 	auto res = RealAlgebraicNumberEvaluation::evaluate(MultivariatePolynomial<Rational>(mp), point, vars);
 	std::cerr << res << std::endl;
 }
+
+TEST(RealAlgebraicNumber, BatchEvaluation)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	// x = sqrt(2), y = -sqrt(3), z = 1/2
+	RealAlgebraicNumber<Rational> rx(UnivariatePolynomial<Rational>(x, {Rational(-2), Rational(0), Rational(1)}), Interval<Rational>(Rational(1), BoundType::STRICT, Rational(2), BoundType::STRICT));
+	RealAlgebraicNumber<Rational> ry(UnivariatePolynomial<Rational>(y, {Rational(-3), Rational(0), Rational(1)}), Interval<Rational>(Rational(-2), BoundType::STRICT, Rational(-1), BoundType::STRICT));
+	RealAlgebraicNumber<Rational> rz(Rational(1)/2);
+	std::vector<Variable> vars({x, y, z});
+	RealAlgebraicPoint<Rational> point({rx, ry, rz});
+
+	typedef MultivariatePolynomial<Rational> Pol;
+	std::vector<Pol> polys({
+		Pol(x) * x - Rational(2),
+		Pol(x) * y + Rational(2),
+		Pol(x) * y + Rational(3),
+		Pol(x) + y,
+		Pol(x) * z - Rational(1),
+		Pol(y) * y * z,
+		Pol(x) * x * y * y - Rational(6)
+	});
+	std::vector<Sign> expected({Sign::ZERO, Sign::NEGATIVE, Sign::POSITIVE, Sign::NEGATIVE, Sign::NEGATIVE, Sign::POSITIVE, Sign::ZERO});
+
+	RealAlgebraicNumberEvaluation::BatchEvaluation<Rational> batch(point, vars);
+	EXPECT_EQ(expected, batch.sgn(polys));
+	EXPECT_GT(batch.nrFiltered(), 0);
+	auto values = batch.evaluate(polys);
+	for (std::size_t i = 0; i < polys.size(); ++i) {
+		EXPECT_EQ(expected[i], values[i].sgn()) << polys[i];
+		auto single = RealAlgebraicNumberEvaluation::evaluate(polys[i], point, vars);
+		EXPECT_EQ(single.sgn(), values[i].sgn()) << polys[i];
+	}
+	// Results are memoized.
+	std::size_t exact = batch.nrExact();
+	batch.evaluate(polys);
+	EXPECT_EQ(exact, batch.nrExact());
+	// x^3 + y and 2x + y have the same normal form in the field extension, hence the value is only computed once.
+	auto cubic = batch.evaluate(Pol(x) * x * x + y);
+	EXPECT_EQ(exact + 1, batch.nrExact());
+	EXPECT_TRUE(cubic == batch.evaluate(Pol(x) * Rational(2) + y));
+	EXPECT_EQ(exact + 1, batch.nrExact());
+	EXPECT_EQ(Sign::POSITIVE, cubic.sgn());
+}
+
+TEST(RealAlgebraicNumber, EvaluateSign)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	typedef MultivariatePolynomial<Rational> Pol;
+	// x = sqrt(2), y = sqrt(3), both with coarse isolating intervals.
+	RealAlgebraicNumber<Rational> rx(UnivariatePolynomial<Rational>(x, {Rational(-2), Rational(0), Rational(1)}), Interval<Rational>(Rational(1), BoundType::STRICT, Rational(2), BoundType::STRICT));
+	RealAlgebraicNumber<Rational> ry(UnivariatePolynomial<Rational>(y, {Rational(-3), Rational(0), Rational(1)}), Interval<Rational>(Rational(1), BoundType::STRICT, Rational(2), BoundType::STRICT));
+	std::vector<Variable> vars({x, y});
+	RealAlgebraicPoint<Rational> point({rx, ry});
+
+	// Decided by refinement: sqrt(3) - sqrt(2) is about 0.318.
+	EXPECT_EQ(Sign::POSITIVE, RealAlgebraicNumberEvaluation::evaluateSign(Pol(y) - x, point, vars));
+	EXPECT_EQ(Sign::NEGATIVE, RealAlgebraicNumberEvaluation::evaluateSign(Pol(x) - Rational(Rational(283)/200), point, vars));
+	// Zero, which intervals can not decide.
+	EXPECT_EQ(Sign::ZERO, RealAlgebraicNumberEvaluation::evaluateSign(Pol(x) * x - Rational(2), point, vars));
+	EXPECT_EQ(Sign::ZERO, RealAlgebraicNumberEvaluation::evaluateSign(Pol(x) * x * y * y - Rational(6), point, vars));
+
+	RealAlgebraicNumberEvaluation::RANMap<Rational> m({{x, rx}, {y, ry}});
+	EXPECT_EQ(Sign::NEGATIVE, RealAlgebraicNumberEvaluation::evaluateSign(Pol(x) * y - Rational(Rational(245)/100), m));
+	EXPECT_EQ(Sign::POSITIVE, RealAlgebraicNumberEvaluation::evaluateSign(Pol(x) * y - Rational(Rational(244)/100), m));
+
+	// Without refinement, only the exact computation decides.
+	RealAlgebraicNumberEvaluation::BatchEvaluation<Rational> batch(point, vars);
+	batch.setSignRefinementRounds(0);
+	EXPECT_EQ(Sign::POSITIVE, batch.sgn(Pol(y) - x));
+	EXPECT_EQ(Sign::POSITIVE, batch.sgn(Pol(x) + y));
+	EXPECT_GE(batch.nrFiltered(), 1);
+}
@@ -0,0 +1,214 @@
+#include "gtest/gtest.h"
+#include "../../carl/formula/bitvector/BVBitBlaster.h"
+#include "../../carl/formula/bitvector/BVConstraintPool.h"
+#include "../../carl/core/VariablePool.h"
+#include "../../carl/formula/SortManager.h"
+
+#include <functional>
+#include <sstream>
+
+using namespace carl;
+
+namespace {
+	const std::size_t width = 4;
+	const unsigned mask = (1u << width) - 1;
+
+	/**
+	 * Fixes the bits of the variables and determines all other variables by unit propagation.
+	 * Returns false on a conflict.
+	 */
+	bool propagate(const std::vector<BVBitBlaster::Clause>& clauses, std::vector<int>& values) {
+		auto value = [&](BVBitBlaster::Literal l) { return l > 0 ? values[std::size_t(l)] : -values[std::size_t(-l)]; };
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			for (const auto& c: clauses) {
+				BVBitBlaster::Literal open = 0;
+				std::size_t nrOpen = 0;
+				bool satisfied = false;
+				for (auto l: c) {
+					if (value(l) > 0) satisfied = true;
+					else if (value(l) == 0) { open = l; nrOpen++; }
+				}
+				if (satisfied) continue;
+				if (nrOpen == 0) return false;
+				if (nrOpen == 1) {
+					values[std::size_t(std::abs(open))] = open > 0 ? 1 : -1;
+					changed = true;
+				}
+			}
+		}
+		return true;
+	}
+
+	struct Circuit {
+		std::vector<BVBitBlaster::Clause> clauses;
+		BVBitBlaster blaster;
+		Circuit(): blaster([this](const BVBitBlaster::Clause& c){ clauses.push_back(c); }) {}
+
+		/// Evaluates the given bits with the variables fixed to the given values.
+		unsigned evaluate(const BVBitBlaster::Bits& bits, const std::map<BVVariable,unsigned>& assignment) {
+			std::vector<int> values(blaster.nrVariables() + 1, 0);
+			for (const auto& a: assignment) {
+				const auto& vb = blaster.bits(a.first);
+				for (std::size_t i = 0; i < vb.size(); i++) {
+					values[std::size_t(vb[i])] = ((a.second >> i) & 1) ? 1 : -1;
+				}
+			}
+			EXPECT_TRUE(propagate(clauses, values));
+			unsigned res = 0;
+			for (std::size_t i = 0; i < bits.size(); i++) {
+				auto l = bits[i];
+				int v = l > 0 ? values[std::size_t(l)] : -values[std::size_t(-l)];
+				EXPECT_NE(v, 0);
+				if (v > 0) res |= 1u << i;
+			}
+			return res;
+		}
+	};
+
+	unsigned msb(unsigned x) { return (x >> (width - 1)) & 1; }
+	int toSigned(unsigned x) { return msb(x) ? int(x) - int(mask + 1) : int(x); }
+	unsigned neg(unsigned x) { return (~x + 1) & mask; }
+	unsigned absolute(unsigned x) { return msb(x) ? neg(x) : x; }
+	unsigned udiv(unsigned x, unsigned y) { return y == 0 ? mask : x / y; }
+	unsigned urem(unsigned x, unsigned y) { return y == 0 ? x : x % y; }
+}
+
+class BVBitBlasterTest: public ::testing::Test {
+protected:
+	Sort bvSort;
+	BVVariable a;
+	BVVariable b;
+	BVTerm ta;
+	BVTerm tb;
+	BVBitBlasterTest() {
+		SortManager::getInstance().clear();
+		Sort sort = SortManager::getInstance().addSort("BitVec");
+		SortManager::getInstance().makeSortIndexable(sort, 1, VariableType::VT_BITVECTOR);
+		bvSort = SortManager::getInstance().index(sort, {width});
+		a = BVVariable(freshBitvectorVariable("a"), bvSort);
+		b = BVVariable(freshBitvectorVariable("b"), bvSort);
+		ta = BVTerm(BVTermType::VARIABLE, a);
+		tb = BVTerm(BVTermType::VARIABLE, b);
+	}
+};
+
+TEST_F(BVBitBlasterTest, Terms)
+{
+	std::vector<std::pair<BVTermType, std::function<unsigned(unsigned,unsigned)>>> ops = {
+		{BVTermType::AND, [](unsigned x, unsigned y){ return x & y; }},
+		{BVTermType::OR, [](unsigned x, unsigned y){ return x | y; }},
+		{BVTermType::XOR, [](unsigned x, unsigned y){ return x ^ y; }},
+		{BVTermType::NAND, [](unsigned x, unsigned y){ return ~(x & y) & mask; }},
+		{BVTermType::NOR, [](unsigned x, unsigned y){ return ~(x | y) & mask; }},
+		{BVTermType::XNOR, [](unsigned x, unsigned y){ return ~(x ^ y) & mask; }},
+		{BVTermType::ADD, [](unsigned x, unsigned y){ return (x + y) & mask; }},
+		{BVTermType::SUB, [](unsigned x, unsigned y){ return (x - y) & mask; }},
+		{BVTermType::MUL, [](unsigned x, unsigned y){ return (x * y) & mask; }},
+		{BVTermType::DIV_U, udiv},
+		{BVTermType::MOD_U, urem},
+		{BVTermType::DIV_S, [](unsigned x, unsigned y){
+			unsigned q = udiv(absolute(x), absolute(y));
+			return msb(x) != msb(y) ? neg(q) : q;
+		}},
+		{BVTermType::MOD_S1, [](unsigned x, unsigned y){
+			unsigned r = urem(absolute(x), absolute(y));
+			return msb(x) ? neg(r) : r;
+		}},
+		{BVTermType::MOD_S2, [](unsigned x, unsigned y){
+			unsigned r = urem(absolute(x), absolute(y));
+			if (r == 0 || (!msb(x) && !msb(y))) return r;
+			if (msb(x) && msb(y)) return neg(r);
+			if (msb(x)) return (neg(r) + y) & mask;
+			return (r + y) & mask;
+		}},
+		{BVTermType::EQ, [](unsigned x, unsigned y){ return x == y ? 1u : 0u; }},
+		{BVTermType::LSHIFT, [](unsigned x, unsigned y){ return y >= width ? 0 : (x << y) & mask; }},
+		{BVTermType::RSHIFT_LOGIC, [](unsigned x, unsigned y){ return y >= width ? 0 : x >> y; }},
+		{BVTermType::RSHIFT_ARITH, [](unsigned x, unsigned y){
+			return unsigned(toSigned(x) >> std::min(y, unsigned(width - 1))) & mask;
+		}},
+		{BVTermType::CONCAT, [](unsigned x, unsigned y){ return (x << width) | y; }},
+	};
+	for (const auto& op: ops) {
+		Circuit c;
+		BVTerm t(op.first, ta, tb);
+		auto bits = c.blaster.blast(t);
+		for (unsigned x = 0; x <= mask; x++) {
+			for (unsigned y = 0; y <= mask; y++) {
+				EXPECT_EQ(op.second(x, y), c.evaluate(bits, {{a, x}, {b, y}})) << op.first << " " << x << " " << y;
+			}
+		}
+	}
+
+	std::vector<std::pair<BVTerm, std::function<unsigned(unsigned)>>> unary = {
+		{BVTerm(BVTermType::NOT, ta), [](unsigned x){ return ~x & mask; }},
+		{BVTerm(BVTermType::NEG, ta), neg},
+		{BVTerm(BVTermType::EXTRACT, ta, 2, 1), [](unsigned x){ return (x >> 1) & 3; }},
+		{BVTerm(BVTermType::LROTATE, ta, 1), [](unsigned x){ return ((x << 1) | (x >> (width - 1))) & mask; }},
+		{BVTerm(BVTermType::RROTATE, ta, 1), [](unsigned x){ return ((x >> 1) | (x << (width - 1))) & mask; }},
+		{BVTerm(BVTermType::EXT_U, ta, 2), [](unsigned x){ return x; }},
+		{BVTerm(BVTermType::EXT_S, ta, 2), [](unsigned x){ return msb(x) ? x | 0x30 : x; }},
+		{BVTerm(BVTermType::REPEAT, ta, 2), [](unsigned x){ return (x << width) | x; }},
+		{BVTerm(BVTermType::MUL, ta, BVTerm(BVTermType::CONSTANT, BVValue(width, 5))), [](unsigned x){ return (x * 5) & mask; }},
+	};
+	for (const auto& u: unary) {
+		Circuit c;
+		auto bits = c.blaster.blast(u.first);
+		for (unsigned x = 0; x <= mask; x++) {
+			EXPECT_EQ(u.second(x), c.evaluate(bits, {{a, x}})) << u.first << " " << x;
+		}
+	}
+}
+
+TEST_F(BVBitBlasterTest, Constraints)
+{
+	std::vector<std::pair<BVCompareRelation, std::function<bool(unsigned,unsigned)>>> rels = {
+		{BVCompareRelation::EQ, [](unsigned x, unsigned y){ return x == y; }},
+		{BVCompareRelation::NEQ, [](unsigned x, unsigned y){ return x != y; }},
+		{BVCompareRelation::ULT, [](unsigned x, unsigned y){ return x < y; }},
+		{BVCompareRelation::ULE, [](unsigned x, unsigned y){ return x <= y; }},
+		{BVCompareRelation::UGT, [](unsigned x, unsigned y){ return x > y; }},
+		{BVCompareRelation::UGE, [](unsigned x, unsigned y){ return x >= y; }},
+		{BVCompareRelation::SLT, [](unsigned x, unsigned y){ return toSigned(x) < toSigned(y); }},
+		{BVCompareRelation::SLE, [](unsigned x, unsigned y){ return toSigned(x) <= toSigned(y); }},
+		{BVCompareRelation::SGT, [](unsigned x, unsigned y){ return toSigned(x) > toSigned(y); }},
+		{BVCompareRelation::SGE, [](unsigned x, unsigned y){ return toSigned(x) >= toSigned(y); }},
+	};
+	for (const auto& r: rels) {
+		Circuit c;
+		auto lit = c.blaster.blast(BVConstraint::create(r.first, ta, tb));
+		for (unsigned x = 0; x <= mask; x++) {
+			for (unsigned y = 0; y <= mask; y++) {
+				EXPECT_EQ(r.second(x, y) ? 1u : 0u, c.evaluate({lit}, {{a, x}, {b, y}})) << r.first << " " << x << " " << y;
+			}
+		}
+	}
+
+	BVBitBlaster bb;
+	EXPECT_EQ(1, bb.blast(BVConstraint::create(true)));
+	EXPECT_EQ(-1, bb.blast(BVConstraint::create(false)));
+}
+
+TEST_F(BVBitBlasterTest, Sharing)
+{
+	BVTerm sum(BVTermType::ADD, ta, tb);
+	BVTerm prod(BVTermType::MUL, sum, sum);
+	BVBitBlaster bb;
+	bb.blast(sum);
+	std::size_t clauses = bb.nrClauses();
+	std::size_t variables = bb.nrVariables();
+	bb.blast(BVTerm(BVTermType::ADD, ta, tb));
+	EXPECT_EQ(clauses, bb.nrClauses());
+	EXPECT_EQ(variables, bb.nrVariables());
+	bb.assertConstraint(BVConstraint::create(BVCompareRelation::EQ, prod, BVTerm(BVTermType::CONSTANT, BVValue(width, 9))));
+	EXPECT_LT(clauses, bb.nrClauses());
+	EXPECT_EQ(width, bb.bits(a).size());
+
+	std::stringstream ss;
+	ss << bb;
+	std::string header;
+	std::getline(ss, header);
+	EXPECT_EQ("p cnf " + std::to_string(bb.nrVariables()) + " " + std::to_string(bb.nrClauses()), header);
+}
@@ -39,3 +39,56 @@ TEST(BVTerm, Variable)
 	EXPECT_FALSE(bvt.isInvalid());
 	EXPECT_EQ(bvv, bvt.variable());
 }
+
+TEST(BVTerm, Rewriting)
+{
+	carl::SortManager& sm = carl::SortManager::getInstance();
+	sm.clear();
+	carl::Sort bvSort = sm.addSort("BitVec", carl::VariableType::VT_UNINTERPRETED);
+	sm.makeSortIndexable(bvSort, 1, carl::VariableType::VT_BITVECTOR);
+	bvSort = carl::getSort("BitVec", std::vector<std::size_t>({8}));
+	carl::BVTerm a(carl::BVTermType::VARIABLE, carl::BVVariable(carl::freshBitvectorVariable("a"), bvSort));
+	carl::BVTerm b(carl::BVTermType::VARIABLE, carl::BVVariable(carl::freshBitvectorVariable("b"), bvSort));
+	carl::BVTerm zero(carl::BVTermType::CONSTANT, carl::BVValue(8, 0));
+	carl::BVTerm one(carl::BVTermType::CONSTANT, carl::BVValue(8, 1));
+	carl::BVTerm ones(carl::BVTermType::CONSTANT, ~carl::BVValue(8, 0));
+
+	// Constant folding
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::CONSTANT, carl::BVValue(8, 2)), carl::BVTerm(carl::BVTermType::ADD, one, one));
+	// Commutative operations are normalized
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::MUL, a, b), carl::BVTerm(carl::BVTermType::MUL, b, a));
+	carl::BVTerm sum(carl::BVTermType::ADD, carl::BVTerm(carl::BVTermType::CONSTANT, carl::BVValue(8, 3)), a);
+	EXPECT_EQ(a, sum.first());
+	EXPECT_TRUE(sum.second().isConstant());
+	EXPECT_FALSE(carl::BVTerm(carl::BVTermType::SUB, a, b) == carl::BVTerm(carl::BVTermType::SUB, b, a));
+
+	// Neutral and absorbing elements
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::ADD, zero, a));
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::MUL, a, one));
+	EXPECT_EQ(zero, carl::BVTerm(carl::BVTermType::MUL, a, zero));
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::AND, a, ones));
+	EXPECT_EQ(zero, carl::BVTerm(carl::BVTermType::AND, zero, a));
+	EXPECT_EQ(ones, carl::BVTerm(carl::BVTermType::OR, a, ones));
+	EXPECT_EQ(zero, carl::BVTerm(carl::BVTermType::XOR, a, a));
+	EXPECT_EQ(zero, carl::BVTerm(carl::BVTermType::SUB, a, a));
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::DIV_U, a, one));
+	EXPECT_EQ(zero, carl::BVTerm(carl::BVTermType::LSHIFT, a, carl::BVTerm(carl::BVTermType::CONSTANT, carl::BVValue(8, 8))));
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::NEG, b), carl::BVTerm(carl::BVTermType::SUB, zero, b));
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::NOT, carl::BVTerm(carl::BVTermType::NOT, a)));
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::LROTATE, a, 3), carl::BVTerm(carl::BVTermType::LROTATE, carl::BVTerm(carl::BVTermType::LROTATE, a, 9), 2));
+
+	// Extractions
+	carl::BVTerm ab(carl::BVTermType::CONCAT, a, b);
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::EXTRACT, ab, 15, 8));
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::EXTRACT, b, 5, 2), carl::BVTerm(carl::BVTermType::EXTRACT, ab, 5, 2));
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::EXTRACT, a, 4, 3), carl::BVTerm(carl::BVTermType::EXTRACT, carl::BVTerm(carl::BVTermType::EXTRACT, a, 6, 2), 2, 1));
+	EXPECT_EQ(a, carl::BVTerm(carl::BVTermType::CONCAT, carl::BVTerm(carl::BVTermType::EXTRACT, a, 7, 3), carl::BVTerm(carl::BVTermType::EXTRACT, a, 2, 0)));
+	carl::BVTerm extended(carl::BVTermType::CONCAT, zero, a);
+	EXPECT_EQ(carl::BVTermType::EXT_U, extended.type());
+	EXPECT_EQ(carl::BVTerm(carl::BVTermType::CONSTANT, carl::BVValue(4, 0)), carl::BVTerm(carl::BVTermType::EXTRACT, extended, 12, 9));
+
+	// Constructing the same term again is answered by the rewrite cache
+	std::size_t rewrites = carl::BVTermPool::getInstance().nrRewrites();
+	carl::BVTerm(carl::BVTermType::EXTRACT, ab, 5, 2);
+	EXPECT_EQ(rewrites, carl::BVTermPool::getInstance().nrRewrites());
+}
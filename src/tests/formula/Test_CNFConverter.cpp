@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+#include "../../carl/core/VariablePool.h"
+#include "../../carl/formula/CNFConverter.h"
+#include "../../carl/formula/Formula.h"
+#include "../../carl/formula/parser/DIMACSExporter.h"
+
+#include "../Common.h"
+
+#include <map>
+#include <sstream>
+
+using namespace carl;
+
+typedef MultivariatePolynomial<Rational> Pol;
+typedef Formula<Pol> FormulaT;
+typedef CNFConverter<Pol>::Clause Clause;
+
+namespace {
+
+bool evaluate(const FormulaT& f, const std::map<Variable, bool>& assignment) {
+	switch (f.getType()) {
+		case TRUE: return true;
+		case FALSE: return false;
+		case BOOL: return assignment.at(f.boolean());
+		case NOT: return !evaluate(f.subformula(), assignment);
+		case IMPLIES: return !evaluate(f.premise(), assignment) || evaluate(f.conclusion(), assignment);
+		case ITE: return evaluate(f.condition(), assignment) ? evaluate(f.firstCase(), assignment) : evaluate(f.secondCase(), assignment);
+		case AND: {
+			for (const auto& sub: f.subformulas()) if (!evaluate(sub, assignment)) return false;
+			return true;
+		}
+		case OR: {
+			for (const auto& sub: f.subformulas()) if (evaluate(sub, assignment)) return true;
+			return false;
+		}
+		case XOR: {
+			bool res = false;
+			for (const auto& sub: f.subformulas()) res = res != evaluate(sub, assignment);
+			return res;
+		}
+		case IFF: {
+			bool first = evaluate(f.subformulas().front(), assignment);
+			for (const auto& sub: f.subformulas()) if (evaluate(sub, assignment) != first) return false;
+			return true;
+		}
+		default:
+			assert(false);
+			return false;
+	}
+}
+
+bool satisfies(const std::vector<Clause>& clauses, const std::map<Variable, bool>& assignment) {
+	for (const auto& clause: clauses) {
+		bool sat = false;
+		for (const auto& l: clause) sat = sat || evaluate(l, assignment);
+		if (!sat) return false;
+	}
+	return true;
+}
+
+/**
+ * Checks that for every assignment of the given variables, the formula holds if and only if
+ * the assignment can be extended to the Tseitin variables such that all clauses hold.
+ */
+void checkEquisatisfiable(const FormulaT& f, const std::vector<Variable>& vars) {
+	std::vector<Clause> clauses;
+	CNFConverter<Pol> converter([&clauses](const Clause& c){ clauses.push_back(c); });
+	converter.add(f);
+	EXPECT_EQ(clauses.size(), converter.nrClauses());
+	Variables all;
+	for (const auto& c: clauses) {
+		for (const auto& l: c) {
+			EXPECT_TRUE(l.isLiteral());
+			l.booleanVars(all);
+		}
+	}
+	std::vector<Variable> aux;
+	for (auto v: all) {
+		if (std::find(vars.begin(), vars.end(), v) == vars.end()) aux.push_back(v);
+	}
+	ASSERT_LE(aux.size(), 16);
+	for (std::size_t a = 0; a < (std::size_t(1) << vars.size()); ++a) {
+		std::map<Variable, bool> assignment;
+		for (std::size_t i = 0; i < vars.size(); ++i) assignment[vars[i]] = (a >> i) & 1;
+		bool extensible = false;
+		for (std::size_t b = 0; b < (std::size_t(1) << aux.size()) && !extensible; ++b) {
+			for (std::size_t i = 0; i < aux.size(); ++i) assignment[aux[i]] = (b >> i) & 1;
+			extensible = satisfies(clauses, assignment);
+		}
+		EXPECT_EQ(evaluate(f, assignment), extensible) << f << " under assignment " << a;
+	}
+}
+
+}
+
+TEST(CNFConverter, Clauses)
+{
+	Variable a = freshBooleanVariable("a");
+	Variable b = freshBooleanVariable("b");
+	Variable c = freshBooleanVariable("c");
+	FormulaT fa(a), fb(b), fc(c);
+	std::vector<Clause> clauses;
+	CNFConverter<Pol> converter([&clauses](const Clause& cl){ clauses.push_back(cl); });
+
+	// A conjunction of clauses is emitted as is.
+	EXPECT_TRUE(converter.add(FormulaT(AND, {FormulaT(OR, {fa, fb}), FormulaT(OR, {fa.negated(), fc}), fb})));
+	EXPECT_EQ(3, clauses.size());
+
+	// Only one direction is encoded for the conjunction, which occurs positively.
+	clauses.clear();
+	EXPECT_TRUE(converter.add(FormulaT(OR, {FormulaT(AND, {fa, fb}), fc})));
+	EXPECT_EQ(3, clauses.size());
+
+	// The definition of the same conjunction is not emitted again.
+	clauses.clear();
+	EXPECT_TRUE(converter.add(FormulaT(OR, {FormulaT(AND, {fa, fb}), fc.negated()})));
+	EXPECT_EQ(1, clauses.size());
+
+	// Tautologies are dropped.
+	clauses.clear();
+	EXPECT_TRUE(converter.add(FormulaT(IMPLIES, {fa, fa})));
+	EXPECT_EQ(0, clauses.size());
+
+	// Contradictions lead to the empty clause.
+	EXPECT_FALSE(converter.add(FormulaT(NOT, FormulaT(OR, {fa, fa.negated()}))));
+	ASSERT_FALSE(clauses.empty());
+	EXPECT_TRUE(clauses.back().empty());
+}
+
+TEST(CNFConverter, Equisatisfiable)
+{
+	Variable a = freshBooleanVariable("a");
+	Variable b = freshBooleanVariable("b");
+	Variable c = freshBooleanVariable("c");
+	Variable d = freshBooleanVariable("d");
+	std::vector<Variable> vars({a, b, c, d});
+	FormulaT fa(a), fb(b), fc(c), fd(d);
+
+	checkEquisatisfiable(FormulaT(OR, {FormulaT(AND, {fa, fb}), FormulaT(AND, {fc, fd.negated()})}), vars);
+	checkEquisatisfiable(FormulaT(NOT, FormulaT(OR, {FormulaT(AND, {fa, fb}), fc})), vars);
+	checkEquisatisfiable(FormulaT(IFF, {FormulaT(AND, {fa, fb}), FormulaT(OR, {fc, fd})}), vars);
+	checkEquisatisfiable(FormulaT(IFF, {fa, fb, FormulaT(OR, {fc, fd})}), vars);
+	checkEquisatisfiable(FormulaT(NOT, FormulaT(IFF, {fa, fb, fc})), vars);
+	checkEquisatisfiable(FormulaT(XOR, {fa, FormulaT(AND, {fb, fc}), fd}), vars);
+	checkEquisatisfiable(FormulaT(NOT, FormulaT(XOR, {fa, fb})), vars);
+	checkEquisatisfiable(FormulaT(ITE, {FormulaT(OR, {fa, fb}), FormulaT(AND, {fc, fd}), FormulaT(NOT, fc)}), vars);
+	checkEquisatisfiable(FormulaT(NOT, FormulaT(ITE, {fa, fb, FormulaT(IMPLIES, {fc, fd})})), vars);
+	checkEquisatisfiable(FormulaT(IMPLIES, {FormulaT(OR, {fa, FormulaT(AND, {fb, fc})}), FormulaT(XOR, {fc, fd})}), vars);
+}
+
+TEST(CNFConverter, DIMACS)
+{
+	Variable a = freshBooleanVariable("a");
+	Variable b = freshBooleanVariable("b");
+	DIMACSExporter<Pol> exporter;
+	EXPECT_TRUE(exporter(FormulaT(AND, {FormulaT(OR, {FormulaT(a), FormulaT(b)}), FormulaT(NOT, FormulaT(a))})));
+	std::stringstream ss;
+	ss << exporter;
+	EXPECT_EQ("p cnf 2 2\n", ss.str().substr(0, 10));
+}
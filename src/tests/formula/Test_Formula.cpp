@@ -361,3 +361,120 @@ TEST(Formula, ConstraintSimplication)
         EXPECT_EQ(ref, FormulaT(FormulaType::NOT, FormulaT(-Pol(x), Relation::GREATER)));
     }
 }
+
+TEST(Formula, ConstraintVariableInformation)
+{
+    Variable x = freshRealVariable("x");
+    Variable y = freshRealVariable("y");
+    Variable z = freshRealVariable("z");
+    Pol px( x );
+    Pol py( y );
+    // x^3*y + 2*x*y^2 - y + 1 = 0
+    Constr c( px*px*px*py + Rational(2)*px*py*py - py + Rational(1), carl::Relation::EQ );
+    EXPECT_EQ( 3, c.maxDegree( x ) );
+    EXPECT_EQ( 1, c.minDegree( x ) );
+    EXPECT_EQ( 2, c.occurences( x ) );
+    EXPECT_EQ( 2, c.maxDegree( y ) );
+    EXPECT_EQ( 3, c.occurences( y ) );
+    EXPECT_EQ( 0, c.maxDegree( z ) );
+    EXPECT_EQ( 0, c.occurences( z ) );
+    EXPECT_EQ( 3, c.maxDegree() );
+    EXPECT_FALSE( c.varInfo( y ).hasCoeff() );
+    const auto& info = c.varInfo( y, true );
+    EXPECT_TRUE( info.hasCoeff() );
+    EXPECT_EQ( &info, &c.varInfo( y ) );
+    EXPECT_EQ( 2, info.maxDegree() );
+    EXPECT_EQ( Rational(2)*px, c.coefficient( y, 2 ) );
+    EXPECT_EQ( px*px*px - Rational(1), c.coefficient( y, 1 ) );
+    EXPECT_EQ( Pol( Rational(0) ), c.coefficient( x, 2 ) );
+}
+
+TEST(Formula, ConstraintPoolSharing)
+{
+    auto& pool = ConstraintPool<Pol>::getInstance();
+    Variable x = freshRealVariable("x");
+    Variable y = freshRealVariable("y");
+    std::size_t before = pool.size();
+    {
+        Constr c1( Pol( x ) * Pol( y ) - Rational(1), carl::Relation::LESS );
+        EXPECT_FALSE( pool.lastConstructedConstraintWasKnown() );
+        Constr c2( Pol( y ) * Pol( x ) - Rational(1), carl::Relation::LESS );
+        EXPECT_TRUE( pool.lastConstructedConstraintWasKnown() );
+        EXPECT_EQ( c1.id(), c2.id() );
+        EXPECT_EQ( before + 1, pool.size() );
+        EXPECT_EQ( before + 1, pool.allConstraints().size() );
+        EXPECT_EQ( before + 1, std::size_t( std::distance( pool.begin(), pool.end() ) ) );
+    }
+    // The constraint is freed again.
+    EXPECT_EQ( before, pool.size() );
+    EXPECT_TRUE( Constr( true ).isConsistent() );
+    EXPECT_EQ( before, pool.size() );
+}
+
+TEST(Formula, PoolSharing)
+{
+    auto& pool = FormulaPool<Pol>::getInstance();
+    Variable a = freshBooleanVariable("a");
+    Variable b = freshBooleanVariable("b");
+    std::size_t before = pool.size();
+    {
+        FormulaT f1(AND, {FormulaT(a), FormulaT(b)});
+        FormulaT f2(AND, {FormulaT(b), FormulaT(a)});
+        EXPECT_EQ(f1.getId(), f2.getId());
+        EXPECT_EQ(f1.getId() + 1, FormulaT(NOT, f1).getId());
+        EXPECT_EQ(before + 3, pool.size());
+    }
+    // All formulas are freed again.
+    EXPECT_EQ(before, pool.size());
+    {
+        FormulaT f1(AND, {FormulaT(a), FormulaT(b)});
+        EXPECT_EQ(before + 3, pool.size());
+    }
+    EXPECT_EQ(before, pool.size());
+}
+
+TEST(Formula, PoolGenerations)
+{
+    auto& pool = FormulaPool<Pol>::getInstance();
+    Variable a = freshBooleanVariable("a");
+    FormulaT outlived;
+    std::size_t before = pool.size();
+    std::size_t generation = pool.beginGeneration();
+    {
+        std::vector<FormulaT> formulas;
+        for (std::size_t i = 0; i < 1000; ++i) {
+            formulas.emplace_back(OR, FormulaT(a), FormulaT(freshBooleanVariable()));
+        }
+        outlived = formulas.back();
+    }
+    pool.releaseGeneration(generation);
+    // The formula created within the generation is still valid.
+    EXPECT_EQ(OR, outlived.getType());
+    EXPECT_EQ(before + 3, pool.size());
+    outlived = FormulaT(a);
+    EXPECT_EQ(before + 1, pool.size());
+}
+
+TEST(Formula, SubstituteShared)
+{
+    Variable x = freshRealVariable("x");
+    Variable y = freshRealVariable("y");
+    // Every level uses the previous one twice, hence the tree has 2^40 leaves while the DAG is small.
+    FormulaT f( Pol( x ), Relation::LESS );
+    FormulaT g( Pol( y ), Relation::LESS );
+    for (std::size_t i = 0; i < 40; ++i) {
+        FormulaT b( freshBooleanVariable() );
+        FormulaT c( freshBooleanVariable() );
+        f = FormulaT( AND, { FormulaT( OR, { f, b } ), FormulaT( OR, { f, c } ) } );
+        g = FormulaT( AND, { FormulaT( OR, { g, b } ), FormulaT( OR, { g, c } ) } );
+    }
+    std::map<Variable, Pol> replacements;
+    replacements.emplace( x, Pol( y ) );
+    EXPECT_EQ( g, f.substitute( replacements ) );
+
+    FormulaSubstitutor<FormulaT> substitutor( true );
+    EXPECT_EQ( g, substitutor.substitute( f, replacements ) );
+    // The results for the shared subformulas are reused.
+    EXPECT_EQ( g, substitutor.substitute( f, replacements ) );
+    EXPECT_EQ( f, substitutor.substitute( g, y, Pol( x ) ) );
+}
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include <algorithm>
+
 #include <carl/core/MultivariatePolynomial.h>
 #include <carl/formula/model/Model.h>
 
@@ -43,3 +45,93 @@ TYPED_TEST(Model, ModelSubstitution)
 	EXPECT_TRUE(m.at(x).asRational() == TypeParam(3));
 	EXPECT_TRUE(m.at(y).isSubstitution());
 }
+
+TYPED_TEST(Model, Lookup)
+{
+	using Poly = carl::MultivariatePolynomial<TypeParam>;
+	using ModelPolySubs = carl::ModelPolynomialSubstitution<TypeParam,Poly>;
+
+	std::vector<carl::Variable> vars;
+	for (std::size_t i = 0; i < 100; ++i) vars.push_back(carl::freshRealVariable());
+	carl::Variable b = carl::freshBooleanVariable();
+	carl::Model<TypeParam,Poly> m;
+	for (std::size_t i = 0; i < vars.size(); ++i) {
+		EXPECT_TRUE(m.emplace(vars[i], TypeParam(i)).second);
+	}
+	EXPECT_FALSE(m.emplace(vars[3], TypeParam(7)).second);
+	m.assign(b, true);
+	EXPECT_EQ(101, m.size());
+	EXPECT_TRUE(m.find(carl::freshRealVariable()) == m.end());
+
+	// Iteration is sorted by the variables.
+	std::vector<carl::ModelVariable> keys;
+	for (const auto& a: m) keys.push_back(a.first);
+	EXPECT_EQ(m.size(), keys.size());
+	EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+	for (std::size_t j = 0; j < vars.size(); j += 2) m.erase(vars[j]);
+	EXPECT_EQ(51, m.size());
+	for (std::size_t j = 0; j < vars.size(); ++j) {
+		auto it = m.find(vars[j]);
+		if (j % 2 == 0) {
+			EXPECT_TRUE(it == m.end());
+		} else {
+			ASSERT_TRUE(it != m.end());
+			EXPECT_EQ(TypeParam(j), it->second.asRational());
+		}
+	}
+	EXPECT_TRUE(m.at(b).asBool());
+
+	// Substitutions are evaluated when their variables are removed.
+	m.assign(vars[0], carl::createSubstitution<TypeParam,Poly,ModelPolySubs>(Poly(vars[1]) * vars[3]));
+	EXPECT_TRUE(m.at(vars[0]).isSubstitution());
+	EXPECT_EQ(TypeParam(3), m.evaluated(vars[0]).asRational());
+	m.erase(vars[1]);
+	EXPECT_TRUE(m.at(vars[0]).isRational());
+	EXPECT_EQ(TypeParam(3), m.at(vars[0]).asRational());
+
+	carl::Model<TypeParam,Poly> copy(m);
+	m.clear();
+	EXPECT_TRUE(m.empty());
+	EXPECT_TRUE(m.find(vars[3]) == m.end());
+	EXPECT_TRUE(copy.find(vars[3]) != copy.end());
+}
+
+TYPED_TEST(Model, Erase)
+{
+	using Poly = carl::MultivariatePolynomial<TypeParam>;
+	using ModelPolySubs = carl::ModelPolynomialSubstitution<TypeParam,Poly>;
+
+	std::vector<carl::Variable> vars;
+	for (std::size_t i = 0; i < 10; ++i) vars.push_back(carl::freshRealVariable());
+	carl::Model<TypeParam,Poly> m;
+	for (std::size_t i = vars.size(); i > 0; --i) m.emplace(vars[i - 1], TypeParam(i - 1));
+	EXPECT_EQ(carl::ModelVariable(vars[0]), m.begin()->first);
+
+	// Erasing keeps the remaining assignments sorted.
+	m.erase(vars[2]);
+	EXPECT_EQ(carl::ModelVariable(vars[3]), (m.begin() + 2)->first);
+	EXPECT_EQ(carl::ModelVariable(vars[9]), (m.begin() + 8)->first);
+	for (std::size_t i = 0; i < vars.size(); ++i) {
+		if (i == 2) EXPECT_TRUE(m.find(vars[i]) == m.end());
+		else EXPECT_EQ(TypeParam(i), m.at(vars[i]).asRational());
+	}
+
+	// Erasing while iterating visits all remaining assignments.
+	std::size_t visited = 0;
+	for (auto it = m.find(vars[0]); it != m.end();) {
+		++visited;
+		if (it->second.asRational() < TypeParam(5)) it = m.erase(it);
+		else ++it;
+	}
+	EXPECT_EQ(9, visited);
+	EXPECT_EQ(5, m.size());
+
+	// A value changed to a substitution through the iterator returned by emplace is known to the model.
+	auto res = m.emplace(vars[5], TypeParam(0));
+	EXPECT_FALSE(res.second);
+	res.first->second = carl::createSubstitution<TypeParam,Poly,ModelPolySubs>(Poly(vars[6]) + vars[7]);
+	m.erase(vars[6]);
+	ASSERT_TRUE(m.at(vars[5]).isRational());
+	EXPECT_EQ(TypeParam(13), m.at(vars[5]).asRational());
+}
@@ -3,6 +3,7 @@
 #include <carl/formula/Formula.h>
 #include <carl/formula/model/Model.h>
 #include <carl/formula/model/evaluation/ModelEvaluation.h>
+#include <carl/formula/model/evaluation/IncrementalEvaluation.h>
 
 #include "../Common.h"
 
@@ -15,6 +16,7 @@ typedef Formula<Pol> FormulaT;
 typedef Interval<Rational> IntervalT;
 typedef RealAlgebraicNumber<Rational> RANT;
 typedef Model<Rational,Pol> ModelT;
+typedef ModelValue<Rational,Pol> ModelValueT;
 
 TEST(ModelEvaluation, Formula)
 {
@@ -48,3 +50,94 @@ TEST(ModelEvaluation, EvaluateRANIR)
 	EXPECT_TRUE(res.isBool());
 	EXPECT_TRUE(res.asBool());
 }
+
+TEST(ModelEvaluation, Incremental)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+	Variable z = freshRealVariable("z");
+	Variable b = freshBooleanVariable("b");
+	ModelT m;
+	m.assign(x, Rational(1));
+	m.assign(y, Rational(2));
+	m.assign(z, Rational(3));
+	m.assign(b, true);
+	model::IncrementalEvaluation<Rational,Pol> eval(m);
+	auto c1 = eval.add(ConstraintT(Pol(x) + Pol(y) - Rational(4), Relation::LESS));
+	auto c2 = eval.add(ConstraintT(Pol(y) * Pol(z) - Rational(6), Relation::EQ));
+	auto c3 = eval.add(FormulaT(FormulaType::AND, {FormulaT(b), FormulaT(ConstraintT(Pol(z), Relation::GREATER))}));
+	EXPECT_EQ(1, eval.satisfied(c1));
+	EXPECT_EQ(1, eval.satisfied(c2));
+	EXPECT_EQ(1, eval.satisfied(c3));
+	std::size_t evaluations = eval.nrEvaluations();
+
+	// Only the constraint on x is affected.
+	m.assign(x, Rational(5));
+	eval.changed(x);
+	EXPECT_EQ(std::vector<std::size_t>({c1}), eval.update());
+	EXPECT_EQ(evaluations + 1, eval.nrEvaluations());
+	EXPECT_EQ(0, eval.satisfied(c1));
+
+	// Nothing changed, nothing is evaluated.
+	EXPECT_TRUE(eval.update().empty());
+	EXPECT_EQ(evaluations + 1, eval.nrEvaluations());
+
+	m.assign(x, Rational(1));
+	m.assign(z, Rational(-1));
+	eval.changed(x);
+	eval.changed(z);
+	EXPECT_EQ(std::vector<std::size_t>({c1, c2, c3}), eval.update());
+	EXPECT_EQ(1, eval.satisfied(c1));
+	EXPECT_EQ(0, eval.satisfied(c2));
+	EXPECT_EQ(0, eval.satisfied(c3));
+
+	// Reassigning a value that does not change the truth values is not reported.
+	m.assign(z, Rational(-2));
+	eval.changed(z);
+	EXPECT_TRUE(eval.update().empty());
+
+	// Removing a variable makes the constraint undecided.
+	m.erase(y);
+	eval.changed(y);
+	EXPECT_EQ(std::vector<std::size_t>({c1, c2}), eval.update());
+	EXPECT_EQ(2, eval.satisfied(c1));
+	EXPECT_EQ(2, eval.satisfied(c2));
+
+	m.assign(b, false);
+	m.assign(y, Rational(3));
+	m.assign(z, Rational(2));
+	eval.changed(b);
+	eval.changed(y);
+	eval.changed(z);
+	eval.stabilize();
+	EXPECT_EQ(std::vector<std::size_t>({c1, c2}), eval.update());
+	EXPECT_EQ(0, eval.satisfied(c1));
+	EXPECT_EQ(1, eval.satisfied(c2));
+	EXPECT_EQ(0, eval.satisfied(c3));
+	for (std::size_t i = 0; i < eval.size(); ++i) {
+		EXPECT_EQ(model::satisfiedBy(eval.formula(i), m), eval.satisfied(i));
+	}
+}
+
+TEST(ModelEvaluation, Bitvector)
+{
+	SortManager::getInstance().clear();
+	Sort bvSort = SortManager::getInstance().addSort("BitVec", VariableType::VT_UNINTERPRETED);
+	SortManager::getInstance().makeSortIndexable(bvSort, 1, VariableType::VT_BITVECTOR);
+	bvSort = getSort("BitVec", std::vector<std::size_t>({8}));
+	BVVariable a(freshBitvectorVariable("a"), bvSort);
+	BVVariable b(freshBitvectorVariable("b"), bvSort);
+	BVTerm ta(BVTermType::VARIABLE, a);
+	BVTerm tb(BVTermType::VARIABLE, b);
+	BVTerm sum(BVTermType::ADD, ta, tb);
+	BVTerm prod(BVTermType::MUL, sum, sum);
+
+	ModelT m;
+	m.emplace(a, BVValue(8, 10));
+	m.emplace(b, BVValue(8, 252));
+	EXPECT_EQ(ModelValueT(BVValue(8, 36)), model::evaluate(prod, m));
+	EXPECT_EQ(ModelValueT(BVValue(8, 254)), model::evaluate(BVTerm(BVTermType::MOD_S2, ta, tb), m));
+	EXPECT_EQ(ModelValueT(true), model::evaluate(BVConstraint::create(BVCompareRelation::SLT, tb, ta), m));
+	EXPECT_EQ(ModelValueT(false), model::evaluate(BVConstraint::create(BVCompareRelation::ULT, tb, ta), m));
+	EXPECT_EQ(ModelValueT(false), model::evaluate(BVConstraint::create(BVCompareRelation::EQ, prod, sum), m));
+}
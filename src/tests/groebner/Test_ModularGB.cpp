@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include "carl/groebner/groebner.h"
+#include "carl/groebner/benchmarks/cyclic.h"
+#include "carl/groebner/benchmarks/katsura.h"
+
+#include "../Common.h"
+
+using namespace carl;
+
+using Poly = MultivariatePolynomial<Rational>;
+
+namespace {
+	std::vector<Poly> rationalGB(const std::vector<Poly>& input) {
+		GBProcedure<Poly, Buchberger, StdAdding> gbobject;
+		for (const auto& p: input) gbobject.addPolynomial(p);
+		gbobject.reduceInput();
+		gbobject.calculate();
+		return gbobject.getBasisPolynomials();
+	}
+	std::vector<Poly> modularGB(const std::vector<Poly>& input, const ModularGBSettings& settings = ModularGBSettings()) {
+		ModularGroebner<Poly> gbobject(settings);
+		for (const auto& p: input) gbobject.addPolynomial(p);
+		gbobject.calculate();
+		EXPECT_FALSE(gbobject.statistics().usedFallback);
+		return gbobject.getBasisPolynomials();
+	}
+}
+
+TEST(ModularGB, RationalReconstruction)
+{
+	mpz_class m = mpz_class(1000003) * mpz_class(1000033);
+	// -3/7 mod m
+	mpz_class inv7;
+	mpz_invert(inv7.get_mpz_t(), mpz_class(7).get_mpz_t(), m.get_mpz_t());
+	mpz_class a = carl::mod(mpz_class(-3 * inv7), m);
+	if (a < 0) a += m;
+	Rational res;
+	EXPECT_TRUE(ModularGroebner<Poly>::rationalReconstruction(a, m, res));
+	EXPECT_EQ(Rational(-3, 7), res);
+}
+
+TEST(ModularGB, T1)
+{
+	Variable x = freshRealVariable("x");
+	Variable y = freshRealVariable("y");
+
+	Poly f1({(Rational)1*x*x*x, (Rational)-2*x*y});
+	Poly f2({(Rational)1*x*x*y, (Rational)-2*y*y, (Rational)1*x});
+	Poly F1({(Rational)1*x*x});
+	Poly F2({(Rational)1*y*y, (Rational)-1*(Rational)1/(Rational)2*x});
+	Poly F3({(Rational)1*x*y});
+
+	std::vector<Poly> basis = modularGB({f1, f2});
+	ASSERT_EQ(3, basis.size());
+	EXPECT_EQ(F1, basis[0]);
+	EXPECT_EQ(F3, basis[1]);
+	EXPECT_EQ(F2, basis[2]);
+}
+
+TEST(ModularGB, Trivial)
+{
+	Variable x = freshRealVariable("x");
+	Poly f1({(Rational)2*x, Term<Rational>((Rational)-1)});
+	Poly f2({(Rational)3*x, Term<Rational>((Rational)-1)});
+	std::vector<Poly> basis = modularGB({f1, f2});
+	ASSERT_EQ(1, basis.size());
+	EXPECT_TRUE(basis[0].isOne());
+}
+
+TEST(ModularGB, Benchmarks)
+{
+	for (unsigned i = 2; i < 4; ++i) {
+		auto input = benchmarks::cyclic<Rational, GrLexOrdering, StdMultivariatePolynomialPolicies<>>(i);
+		EXPECT_EQ(rationalGB(input), modularGB(input));
+	}
+	for (unsigned i = 2; i < 5; ++i) {
+		auto input = benchmarks::katsura<Rational, GrLexOrdering, StdMultivariatePolynomialPolicies<>>(i);
+		EXPECT_EQ(rationalGB(input), modularGB(input));
+		ModularGBSettings settings;
+		settings.useTrace = false;
+		EXPECT_EQ(rationalGB(input), modularGB(input, settings));
+		settings.useTrace = true;
+		settings.verifyMembership = true;
+		EXPECT_EQ(rationalGB(input), modularGB(input, settings));
+	}
+}
+
+TEST(ModularGB, Trace)
+{
+	auto input = benchmarks::katsura<Rational, GrLexOrdering, StdMultivariatePolynomialPolicies<>>(4);
+	ModularGroebner<Poly> gbobject;
+	for (const auto& p: input) gbobject.addPolynomial(p);
+	gbobject.calculate();
+	EXPECT_FALSE(gbobject.trace().empty());
+	EXPECT_EQ(input.size(), gbobject.trace().nrInputs);
+	EXPECT_EQ(gbobject.trace().pairs.size(), gbobject.trace().leadingMonomials.size());
+	EXPECT_EQ(0, gbobject.statistics().traceFailures);
+	EXPECT_EQ(rationalGB(input), gbobject.getBasisPolynomials());
+
+	// Proving the ideal membership replays the trace, hence it is recorded without useTrace as well.
+	ModularGBSettings settings;
+	settings.useTrace = false;
+	settings.verifyMembership = true;
+	ModularGroebner<Poly> untraced(settings);
+	for (const auto& p: input) untraced.addPolynomial(p);
+	untraced.calculate();
+	EXPECT_EQ(input.size(), untraced.trace().nrInputs);
+	EXPECT_FALSE(untraced.statistics().usedFallback);
+	EXPECT_EQ(rationalGB(input), untraced.getBasisPolynomials());
+}
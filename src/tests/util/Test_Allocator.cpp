@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include <sstream>
+
 #include "carl/util/carlTree.h"
 
 using namespace carl;
@@ -41,3 +43,106 @@ TEST(Allocator, Basic)
 	for (auto i = t.begin_path(i1); i != t.end_path(); ++i) std::cout << *i << ", ";
 	std::cout << std::endl;
 }
+
+TEST(Allocator, Depth)
+{
+	// a tree with three levels below the root, each node with up to three children
+	carl::tree<int> t;
+	t.setRoot(0);
+	std::vector<carl::tree<int>::iterator> level({t.begin()});
+	int value = 1;
+	for (std::size_t depth = 1; depth <= 3; depth++) {
+		std::vector<carl::tree<int>::iterator> next;
+		for (const auto& parent: level) {
+			for (int i = 0; i < (value % 4); i++) next.push_back(t.append(parent, value++));
+			value++;
+		}
+		level = next;
+	}
+	t.erase(level.front());
+
+	for (std::size_t depth = 0; depth <= 4; depth++) {
+		std::vector<int> expected;
+		for (auto i = t.begin_preorder(); i != t.end_preorder(); ++i) {
+			if (i.depth() == depth) expected.push_back(*i);
+		}
+		std::vector<int> actual;
+		for (auto i = t.begin_depth(depth); i != t.end_depth(); ++i) actual.push_back(*i);
+		EXPECT_EQ(expected, actual);
+	}
+
+	// erased nodes are reused by new nodes of the same depth
+	std::size_t size = t.nodes.size();
+	auto i = t.append(t.get_parent(level.back()), -1);
+	EXPECT_EQ(size, t.nodes.size());
+	EXPECT_EQ(level.front().current, i.current);
+	EXPECT_EQ(-1, *i);
+	EXPECT_EQ(t.get_parent(level.back()).current, t.get_parent(i).current);
+
+	// the elements of a depth are stored in the chunks of this depth
+	for (std::size_t depth = 0; depth <= 3; depth++) {
+		for (auto j = t.begin_depth(depth); j != t.end_depth(); ++j) {
+			EXPECT_EQ(t.begin_depth(depth).current / t.chunkSize, j.current / t.chunkSize);
+		}
+	}
+
+	std::stringstream ss;
+	t.printNode(ss, i.current);
+	EXPECT_EQ("(-1 @ ", ss.str().substr(0, 6));
+}
+
+namespace {
+	struct NoDefault {
+		int value;
+		explicit NoDefault(int v): value(v) {}
+	};
+}
+
+TEST(Allocator, NoDefaultConstructor)
+{
+	carl::tree<NoDefault> t;
+	t.setRoot(NoDefault(0));
+	auto i1 = t.append(t.begin(), NoDefault(1));
+	t.append(t.begin(), NoDefault(2));
+	t.erase(i1);
+	auto i3 = t.append(t.begin(), NoDefault(3));
+	EXPECT_EQ(i1.current, i3.current);
+	std::vector<int> values;
+	for (auto i = t.begin_preorder(); i != t.end_preorder(); ++i) values.push_back(i->value);
+	EXPECT_EQ(std::vector<int>({0, 2, 3}), values);
+}
+
+TEST(Allocator, Copy)
+{
+	carl::tree<int> t;
+	t.setRoot(0);
+	std::vector<carl::tree<int>::iterator> leaves;
+	for (int i = 1; i <= 200; i++) leaves.push_back(t.append(t.begin(), i));
+	std::stringstream before;
+	before << t;
+
+	// the copy shares the chunks of t, modifying it must not change t
+	carl::tree<int> copy(t);
+	std::vector<carl::tree<int>::iterator> copyLeaves;
+	for (auto i = copy.begin_children(copy.begin()); i != copy.end_children(copy.begin()); ++i) copyLeaves.push_back(i);
+	copy.erase(copyLeaves[10]);
+	copy.replace(copyLeaves[150], -1);
+	copy.append(copyLeaves[70], -2);
+	for (int i = 201; i <= 300; i++) copy.append(i);
+	std::stringstream after;
+	after << t;
+	EXPECT_EQ(before.str(), after.str());
+
+	std::vector<int> values;
+	for (auto i = copy.begin_children(copy.begin()); i != copy.end_children(copy.begin()); ++i) values.push_back(*i);
+	EXPECT_EQ(299u, values.size());
+	EXPECT_EQ(10, values[9]);
+	EXPECT_EQ(12, values[10]);
+	EXPECT_EQ(-1, values[149]);
+	EXPECT_EQ(300, values.back());
+
+	// modifying t does not change the copy either
+	*leaves[70] = -3;
+	EXPECT_EQ(-3, *leaves[70]);
+	EXPECT_EQ(71, *copyLeaves[70]);
+}
@@ -0,0 +1,187 @@
+#include "gtest/gtest.h"
+
+#include "carl/util/ConcurrentPointerSet.h"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace carl;
+
+TEST(ConcurrentPointerSet, Basics)
+{
+	ConcurrentPointerSet<int> set;
+	auto always = [](const int*){ return true; };
+	auto nothing = [](const int*){};
+	std::vector<std::unique_ptr<int>> values;
+	for (int i = 0; i < 1000; ++i) values.emplace_back(new int(i));
+	for (const auto& v: values) {
+		auto res = set.insert(v.get(), always, nothing);
+		EXPECT_TRUE(res.second);
+	}
+	EXPECT_EQ(1000u, set.size());
+
+	int key = 17;
+	EXPECT_EQ(values[17].get(), set.find(&key, always));
+	EXPECT_EQ(nullptr, set.find(&key, [](const int*){ return false; }));
+	auto res = set.insert(&key, always, nothing);
+	EXPECT_FALSE(res.second);
+	EXPECT_EQ(values[17].get(), res.first);
+
+	EXPECT_FALSE(set.erase(values[17].get(), [](const int*){ return false; }));
+	EXPECT_TRUE(set.erase(values[17].get(), always));
+	set.retire(values[17].get());
+	EXPECT_EQ(999u, set.size());
+	EXPECT_EQ(nullptr, set.find(&key, always));
+
+	std::size_t disposed = 0;
+	set.collect([&disposed](const int* v){ EXPECT_EQ(17, *v); ++disposed; });
+	EXPECT_EQ(1u, disposed);
+	EXPECT_EQ(999u, set.snapshot(always).size());
+
+	res = set.insert(&key, always, nothing);
+	EXPECT_TRUE(res.second);
+	EXPECT_EQ(&key, set.find(values[17].get(), always));
+}
+
+TEST(ConcurrentPointerSet, Pins)
+{
+	typedef ConcurrentPointerSet<int>::Pin Pin;
+	ConcurrentPointerSet<int> set;
+	auto always = [](const int*){ return true; };
+	std::unique_ptr<int> value(new int(3));
+	set.insert(value.get(), always, [](const int*){});
+	std::size_t disposed = 0;
+	auto dispose = [&disposed](const int*){ ++disposed; };
+
+	// Overlapping pins of two threads, as they occur with concurrent lookups, such that there is always some pin.
+	std::promise<void> pinned;
+	std::promise<void> unpin;
+	std::thread other([&]() {
+		Pin pin(set);
+		pinned.set_value();
+		unpin.get_future().wait();
+	});
+	pinned.get_future().wait();
+	set.erase(value.get(), always);
+	set.retire(value.get());
+	set.collect(dispose);
+	// The pin of the other thread may still access the retired object.
+	EXPECT_EQ(0u, disposed);
+	EXPECT_EQ(1u, set.retired());
+	{
+		Pin pin(set);
+		unpin.set_value();
+		other.join();
+		// This pin was created after the object was retired.
+		set.collect(dispose);
+		EXPECT_EQ(1u, disposed);
+		EXPECT_EQ(0u, set.retired());
+	}
+}
+
+#ifdef THREAD_SAFE
+namespace {
+	struct Entry {
+		int value;
+		mutable std::atomic<std::size_t> usages;
+		mutable std::atomic<bool> disposed;
+		Entry(int v): value(v), usages(1), disposed(false) {}
+	};
+	struct EntryHash {
+		std::size_t operator()(const Entry* e) const {
+			return std::hash<int>()(e->value);
+		}
+	};
+	struct EntryEqual {
+		bool operator()(const Entry* a, const Entry* b) const {
+			return a->value == b->value;
+		}
+	};
+	bool acquireEntry(const Entry* e) {
+		EXPECT_FALSE(e->disposed.load());
+		std::size_t usages = e->usages.load();
+		do {
+			if (usages == 0) return false;
+		} while (!e->usages.compare_exchange_weak(usages, usages + 1));
+		return true;
+	}
+}
+
+TEST(ConcurrentPointerSet, Concurrent)
+{
+	typedef ConcurrentPointerSet<Entry, EntryHash, EntryEqual, 4> Set;
+	const int values = 64;
+	const int threads = 8;
+	const int iterations = 20000;
+	Set set;
+	std::mutex graveyardMutex;
+	std::vector<const Entry*> graveyard;
+	std::atomic<std::size_t> created(0);
+	auto dispose = [&](const Entry* e) {
+		EXPECT_EQ(0u, e->usages.load());
+		EXPECT_FALSE(e->disposed.exchange(true));
+		std::lock_guard<std::mutex> lock(graveyardMutex);
+		graveyard.push_back(e);
+	};
+	auto release = [&set](const Entry* e) {
+		while (true) {
+			std::size_t usages = e->usages.load();
+			if (usages > 1) {
+				if (e->usages.compare_exchange_weak(usages, usages - 1)) return;
+				continue;
+			}
+			if (set.erase(e, [](const Entry* x){ std::size_t one = 1; return x->usages.compare_exchange_strong(one, 0); })) {
+				set.retire(e);
+				return;
+			}
+		}
+	};
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; ++t) {
+		workers.emplace_back([&, t]() {
+			std::vector<const Entry*> held(values, nullptr);
+			for (int i = 0; i < iterations; ++i) {
+				int v = (i * 7 + t * 13) % values;
+				Entry key(v);
+				const Entry* found = set.find(&key, acquireEntry);
+				if (found == nullptr) {
+					Entry* candidate = new Entry(v);
+					auto res = set.insert(candidate, acquireEntry, [&created](const Entry*){ ++created; });
+					if (!res.second) delete candidate;
+					found = res.first;
+				}
+				EXPECT_EQ(v, found->value);
+				if (held[std::size_t(v)] != nullptr) {
+					// The same content always yields the same object while it is in use.
+					EXPECT_EQ(held[std::size_t(v)], found);
+					release(found);
+					release(held[std::size_t(v)]);
+					held[std::size_t(v)] = nullptr;
+				} else {
+					held[std::size_t(v)] = found;
+				}
+				if (i % 64 == 0) set.collect(dispose);
+			}
+			for (const Entry* e: held) {
+				if (e != nullptr) release(e);
+			}
+			set.collect(dispose);
+		});
+	}
+	for (auto& w: workers) w.join();
+	{
+		std::lock_guard<std::mutex> lock(graveyardMutex);
+		// Memory has been freed while the workers were running.
+		EXPECT_LT(0u, graveyard.size());
+	}
+	set.collect(dispose);
+	EXPECT_EQ(0u, set.size());
+	EXPECT_EQ(0u, set.retired());
+	EXPECT_EQ(created.load(), graveyard.size());
+	for (const Entry* e: graveyard) delete e;
+}
+#endif
@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+
+#include "carl/util/CopyOnWriteVector.h"
+
+#include <string>
+
+using namespace carl;
+
+TEST(CopyOnWriteVector, Sharing)
+{
+	CopyOnWriteVector<std::string> v(3, "a");
+	v.modify(1) = "b";
+	v.modify(2) = "c";
+	CopyOnWriteVector<std::string> copy = v;
+	for (std::size_t i = 0; i < v.size(); i++) {
+		EXPECT_TRUE(v.shares(i, copy));
+	}
+	// only the modified element is copied
+	v.modify(1) += "b";
+	EXPECT_EQ("bb", v[1]);
+	EXPECT_EQ("b", copy[1]);
+	EXPECT_TRUE(v.shares(0, copy));
+	EXPECT_FALSE(v.shares(1, copy));
+	EXPECT_TRUE(v.shares(2, copy));
+	// an element that is not shared anymore is modified in place
+	const std::string* element = &v[1];
+	v.modify(1) += "b";
+	EXPECT_EQ(element, &v[1]);
+
+	// inserting does not copy the existing elements
+	v.insert(0, 2, "x");
+	EXPECT_EQ(5u, v.size());
+	EXPECT_EQ("x", v.front());
+	EXPECT_EQ("c", v.back());
+	EXPECT_EQ(&copy[2], &v[4]);
+	std::string all;
+	for (const auto& s: v) all += s;
+	EXPECT_EQ("xxabbbc", all);
+
+	copy = v;
+	v.clear();
+	EXPECT_TRUE(v.empty());
+	EXPECT_EQ(5u, copy.size());
+}
@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+
+#include "carl/util/LRUCache.h"
+
+#include <string>
+
+using namespace carl;
+
+TEST(LRUCache, Eviction)
+{
+	LRUCache<int, std::string> cache(2);
+	std::size_t computed = 0;
+	auto get = [&](int key) {
+		return cache.get(key, [&](){ ++computed; return std::to_string(key); });
+	};
+	EXPECT_EQ("1", get(1));
+	EXPECT_EQ("2", get(2));
+	EXPECT_EQ("1", get(1));
+	EXPECT_EQ(2u, computed);
+	EXPECT_EQ(1u, cache.hits());
+	// 2 is the least recently used entry.
+	EXPECT_EQ("3", get(3));
+	EXPECT_EQ(2u, cache.size());
+	EXPECT_EQ("1", get(1));
+	EXPECT_EQ(3u, computed);
+	EXPECT_EQ("2", get(2));
+	EXPECT_EQ(4u, computed);
+
+	cache.setCapacity(1);
+	EXPECT_EQ(1u, cache.size());
+	EXPECT_EQ("2", get(2));
+	EXPECT_EQ(4u, computed);
+	cache.clear();
+	EXPECT_EQ(0u, cache.size());
+	EXPECT_EQ(0u, cache.hits());
+	EXPECT_EQ(0u, cache.misses());
+}
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+
+#include "carl/util/SlabArena.h"
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace carl;
+
+namespace {
+	struct Counted {
+		static std::atomic<int> alive;
+		int value;
+		explicit Counted(int v): value(v) { ++alive; }
+		~Counted() { --alive; }
+	};
+	std::atomic<int> Counted::alive(0);
+}
+
+TEST(SlabArena, Reuse)
+{
+	SlabArena<Counted, 4> arena;
+	std::vector<Counted*> objects;
+	for (int i = 0; i < 10; ++i) objects.push_back(arena.create(0, i));
+	EXPECT_EQ(10, Counted::alive.load());
+	EXPECT_EQ(3u, arena.nrSlabs());
+	for (int i = 0; i < 10; ++i) EXPECT_EQ(i, objects[std::size_t(i)]->value);
+	for (auto o: objects) arena.destroy(o);
+	EXPECT_EQ(0, Counted::alive.load());
+	objects.clear();
+	for (int i = 0; i < 10; ++i) objects.push_back(arena.create(0, i));
+	EXPECT_EQ(3u, arena.nrSlabs());
+	for (auto o: objects) arena.destroy(o);
+}
+
+TEST(SlabArena, Discard)
+{
+	SlabArena<Counted, 4> arena;
+	Counted* a = arena.create(0, 1);
+	arena.discard(a);
+	EXPECT_EQ(0, Counted::alive.load());
+	Counted* b = arena.create(0, 2);
+	EXPECT_EQ(static_cast<void*>(a), static_cast<void*>(b));
+	arena.destroy(b);
+}
+
+TEST(SlabArena, Generations)
+{
+	SlabArena<Counted, 4> arena;
+	Counted* base = arena.create(0, 0);
+	std::size_t gen = arena.newGeneration();
+	std::vector<Counted*> objects;
+	for (int i = 0; i < 8; ++i) objects.push_back(arena.create(gen, i));
+	EXPECT_EQ(3u, arena.nrSlabs());
+	for (std::size_t i = 0; i < 4; ++i) arena.destroy(objects[i]);
+	arena.releaseGeneration(gen);
+	EXPECT_EQ(2u, arena.nrSlabs());
+	for (std::size_t i = 4; i < 8; ++i) arena.destroy(objects[i]);
+	EXPECT_EQ(1u, arena.nrSlabs());
+	arena.destroy(base);
+	EXPECT_EQ(0, Counted::alive.load());
+}
+
+TEST(SlabArena, SpareOfOtherThread)
+{
+	SlabArena<Counted, 4> arena;
+	std::size_t gen = arena.newGeneration();
+	std::promise<void> discarded;
+	std::promise<void> released;
+	// The thread keeps the slot of the discarded object as its spare slot while the generation is released.
+	std::thread worker([&]() {
+		arena.discard(arena.create(gen, 1));
+		discarded.set_value();
+		released.get_future().wait();
+	});
+	discarded.get_future().wait();
+	EXPECT_EQ(1u, arena.nrSlabs());
+	arena.releaseGeneration(gen);
+	EXPECT_EQ(0u, arena.nrSlabs());
+	released.set_value();
+	worker.join();
+	EXPECT_EQ(0, Counted::alive.load());
+}
+
+TEST(SlabArena, SpareOnThreadExit)
+{
+	SlabArena<Counted, 4> arena;
+	std::size_t gen = arena.newGeneration();
+	Counted* base = arena.create(0, 0);
+	std::thread worker([&]() {
+		arena.discard(arena.create(gen, 1));
+	});
+	worker.join();
+	// The spare slot has been given back when the thread exited.
+	arena.releaseGeneration(gen);
+	EXPECT_EQ(1u, arena.nrSlabs());
+	arena.destroy(base);
+}
+
+#ifdef THREAD_SAFE
+TEST(SlabArena, Concurrent)
+{
+	SlabArena<Counted, 16> arena;
+	std::vector<std::size_t> generations;
+	for (int t = 0; t < 8; ++t) generations.push_back(arena.newGeneration());
+	std::vector<std::thread> workers;
+	for (std::size_t t = 0; t < generations.size(); ++t) {
+		workers.emplace_back([&arena, &generations, t]() {
+			std::vector<Counted*> objects;
+			for (int i = 0; i < 10000; ++i) {
+				Counted* c = arena.create(generations[t], i);
+				if (i % 3 == 0) arena.discard(c);
+				else objects.push_back(c);
+				if (objects.size() > 100) {
+					for (auto o: objects) arena.destroy(o);
+					objects.clear();
+				}
+			}
+			for (auto o: objects) arena.destroy(o);
+			// Release the generation while the other threads still hold spare slots.
+			arena.releaseGeneration(generations[t]);
+		});
+	}
+	for (auto& w: workers) w.join();
+	EXPECT_EQ(0u, arena.nrSlabs());
+}
+#endif
@@ -0,0 +1,27 @@
+#include "gtest/gtest.h"
+
+#include "carl/util/ThreadPool.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace carl;
+
+TEST(ThreadPool, ParallelFor)
+{
+	ThreadPool pool(4);
+	std::vector<std::size_t> res(1000, 0);
+	pool.parallelFor(res.size(), [&res](std::size_t i){ res[i] = i * i; });
+	for (std::size_t i = 0; i < res.size(); ++i) EXPECT_EQ(i * i, res[i]);
+}
+
+TEST(ThreadPool, Nested)
+{
+	ThreadPool& pool = ThreadPool::shared();
+	std::atomic<std::size_t> sum(0);
+	// The inner loops are executed by the threads running the outer iterations.
+	pool.parallelFor(16, [&](std::size_t i){
+		pool.parallelFor(16, [&](std::size_t j){ sum += i * j; });
+	});
+	EXPECT_EQ(120u * 120u, sum.load());
+}